@@ -0,0 +1,154 @@
+/**
+ * @file ArmorCopyBench.cpp
+ * @brief 每帧30个检测结果时，原Armor与ArmorObservation的拷贝、去重耗时及堆分配次数对比
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>原去重算法改用LegacyDedup.h
+ * </table>
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "ArmorBase.h"
+#include "BenchUtil.h"
+#include "LegacyDedup.h"
+
+namespace {
+constexpr int ITERATIONS = 5000;
+constexpr int NUM_DETECTIONS = 30;
+
+std::atomic<long> g_allocations{0};  // 全局operator new调用次数
+
+// 拆分前的Armor布局，作为对照组
+class LegacyArmor {
+   public:
+    cv::Point2f m_topLeft, m_topRight, m_centerLeft, m_centerRight, m_bottomLeft, m_bottomRight, m_centerUV,
+        m_carCenterUV, m_predictPosUV;
+    double m_confidence;
+    int m_classID = -1;
+    hitcrt::Pattern m_pattern = hitcrt::Pattern::UNKNOWN;
+    hitcrt::TimePoint m_timeStamp;
+    double m_time = 0;
+    float m_currPitchRAD = 0.0, m_currYawRAD = 0.0, m_currRollRAD = 0.0;
+    float m_width, m_height, m_aspectRatio, m_product = 0;
+    hitcrt::Size m_size;
+    double m_horizontalDistance = 0.0;
+    float m_dislikeValue;
+    std::vector<float> m_weights;
+    double m_lastR, m_lastY;
+    Eigen::MatrixXd m_rotVec, m_transVec, m_rotVec1;
+    double m_yawToC, m_yawToR, m_pitchToR, m_rollToR, m_yawToR1;
+    std::vector<float> m_reprojectionErrorVector;
+    Eigen::MatrixXd m_pointCH, m_pointGH, m_pointG3, m_pointR3;
+    Eigen::Matrix3d m_rotRoll, m_rotYaw, m_rotPitch;
+    Eigen::MatrixXd m_R2G, m_G2C;
+    Eigen::MatrixXd m_filtMatrix, m_filtMatrixCar, m_filtPos;
+    cv::Point3d m_predictXYZ;
+    double m_calcPitchRAD = 0.0, m_calcYawRAD = 0.0, m_filtPitchDEG = 0.0, m_filtYawDEG = 0.0, m_predPitchDEG = 0.0,
+                                 m_predYawDEG = 0.0, m_filtYawToR;
+};
+
+// 模拟解算后的状态：动态矩阵和vector都已分配
+void solve(LegacyArmor &armor) {
+    armor.m_weights.assign(4, 0.5f);
+    armor.m_reprojectionErrorVector.assign(2, 0.1f);
+    armor.m_rotVec = armor.m_transVec = armor.m_rotVec1 = Eigen::MatrixXd::Zero(3, 1);
+    armor.m_pointCH = armor.m_pointGH = Eigen::MatrixXd::Zero(4, 1);
+    armor.m_pointG3 = armor.m_pointR3 = armor.m_filtPos = Eigen::MatrixXd::Zero(3, 1);
+    armor.m_R2G = armor.m_G2C = Eigen::MatrixXd::Identity(4, 4);
+    armor.m_filtMatrix = armor.m_filtMatrixCar = Eigen::MatrixXd::Zero(6, 1);
+}
+
+template <typename ArmorT>
+void fill(ArmorT &armor, const int i) {
+    // 每3个检测结果重叠一次，去重时有结果被抑制
+    const float x = 40.0f * (i / 3) + (i % 3) * 0.5f, y = 30.0f * (i % 5);
+    armor.m_topLeft = cv::Point2f(x, y);
+    armor.m_bottomLeft = cv::Point2f(x, y + 12.0f);
+    armor.m_bottomRight = cv::Point2f(x + 25.0f, y + 12.0f);
+    armor.m_topRight = cv::Point2f(x + 25.0f, y);
+    armor.m_centerUV = cv::Point2f(x + 12.5f, y + 6.0f);
+    armor.m_confidence = 0.95f - 0.01f * i;
+    armor.m_classID = (i / 3) % 9;
+    armor.m_pattern = hitcrt::Pattern::INFANTRY_3;
+}
+
+/**
+ * @brief 一种装甲板类型的测试：按apply的方式拷贝进全部结果和输出结果，再去重
+ */
+template <typename ArmorT>
+void runCase(const char *name, const std::vector<ArmorT> &source) {
+    std::vector<ArmorT> all, output;
+    all.reserve(NUM_DETECTIONS);
+    output.reserve(NUM_DETECTIONS);
+    auto copy = [&] {
+        all.clear();
+        output.clear();
+        for (const auto &armor : source) {
+            all.push_back(armor);
+            output.push_back(armor);
+        }
+    };
+
+    copy();
+    const long before = g_allocations.load();
+    copy();
+    const long copyAllocations = g_allocations.load() - before;
+    const long nmsBefore = g_allocations.load();
+    hitcrt::bench::legacyFilterDuplicateByClassIOU(output, 0.5f);
+    const long nmsAllocations = g_allocations.load() - nmsBefore;
+
+    std::printf("%s: sizeof = %zu bytes, copy allocations/frame = %ld, nms allocations/frame = %ld, kept = %zu\n",
+                name, sizeof(ArmorT), copyAllocations, nmsAllocations, output.size());
+    hitcrt::bench::print(hitcrt::bench::run(std::string(name) + " copy", ITERATIONS, copy));
+    hitcrt::bench::print(hitcrt::bench::run(std::string(name) + " copy+nms", ITERATIONS, [&] {
+        copy();
+        hitcrt::bench::legacyFilterDuplicateByClassIOU(output, 0.5f);
+    }));
+}
+}  // namespace
+
+void *operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+// 用法：armorCopyBench
+// 去重仍是原算法（每帧有分配），这里只比较记录本身的拷贝代价
+int main() {
+    std::vector<LegacyArmor> legacy(NUM_DETECTIONS), legacySolved(NUM_DETECTIONS);
+    std::vector<hitcrt::Armor> armors(NUM_DETECTIONS);
+    std::vector<hitcrt::ArmorObservation> observations(NUM_DETECTIONS);
+    for (int i = 0; i < NUM_DETECTIONS; ++i) {
+        fill(legacy[i], i);
+        fill(legacySolved[i], i);
+        solve(legacySolved[i]);
+        fill(armors[i], i);
+        fill(observations[i], i);
+    }
+
+    std::printf("%d detections per frame\n", NUM_DETECTIONS);
+    runCase("legacy Armor (unsolved)", legacy);
+    runCase("legacy Armor (solved)", legacySolved);
+    runCase("Armor (unsolved)", armors);
+    runCase("ArmorObservation", observations);
+    return 0;
+}
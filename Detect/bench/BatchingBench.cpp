@@ -0,0 +1,98 @@
+/**
+ * @file BatchingBench.cpp
+ * @brief 多相机批量推理：模拟后端上对比批量与逐路串行推理的总帧率
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>收集/分发检查移到test/BatchingTest.cpp，后端改用FakePoseBackend.h
+ * </table>
+ */
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "BatchingDetector.h"
+#include "FakePoseBackend.h"
+
+namespace {
+using namespace std::chrono_literals;
+
+constexpr int NUM_SOURCES = 4;
+constexpr int MAX_BATCH = 4;
+constexpr int FRAMES_PER_SOURCE = 100;
+constexpr int NET_SIZE = 640;
+// 模拟GPU耗时：每次推理的固定开销 + 每张图的开销，批量推理摊薄固定开销
+constexpr auto FIXED_LATENCY = 4ms;
+constexpr auto PER_IMAGE_LATENCY = 1ms;
+
+std::shared_ptr<hitcrt::ArmorDetectorNN> makeDetector() {
+    auto backend = std::make_unique<hitcrt::bench::PixelCodedBackend>(MAX_BATCH, FIXED_LATENCY, PER_IMAGE_LATENCY);
+    return std::make_shared<hitcrt::ArmorDetectorNN>(std::make_unique<deploy::PoseModel>(std::move(backend)), 0.5f);
+}
+
+// 每路每帧的图像：第一个像素为路号，第二个像素为帧号，模拟后端据此给出类别和x坐标
+cv::Mat makeImage(const int source, const int frame) {
+    cv::Mat image(NET_SIZE, NET_SIZE, CV_8UC3, cv::Scalar::all(0));
+    image.data[0] = static_cast<uint8_t>(source);
+    image.data[1] = static_cast<uint8_t>(frame);
+    return image;
+}
+}  // namespace
+
+// 用法：batchingBench
+int main() {
+    const hitcrt::RecvInfoBase recvInfo(0.0, 0.0, 0.0, 25.0, hitcrt::BLUE, true);  // 敌方蓝色，类别0-8
+    const hitcrt::TimePoint epoch = hitcrt::Clock::now();
+
+    // 逐路串行：每帧单独推理
+    auto sequential = makeDetector();
+    const auto sequentialStart = hitcrt::Clock::now();
+    std::vector<hitcrt::Armor> armors;
+    for (int f = 0; f < FRAMES_PER_SOURCE; ++f) {
+        for (int s = 0; s < NUM_SOURCES; ++s) {
+            sequential->apply(hitcrt::Frame(makeImage(s, f), epoch), recvInfo, hitcrt::ROI(), armors);
+        }
+    }
+    const double sequentialSeconds = std::chrono::duration<double>(hitcrt::Clock::now() - sequentialStart).count();
+
+    // 批量：每路一个线程
+    hitcrt::BatchingDetector batching(makeDetector(), NUM_SOURCES, 2ms);
+    const auto batchStart = hitcrt::Clock::now();
+    std::vector<std::thread> cameras;
+    for (int s = 0; s < NUM_SOURCES; ++s) {
+        cameras.emplace_back([&, s] {
+            std::vector<hitcrt::Armor> result;
+            for (int f = 0; f < FRAMES_PER_SOURCE; ++f) {
+                const cv::Mat image = makeImage(s, f);
+                batching.detect(s, hitcrt::Frame(image, epoch + std::chrono::milliseconds(1000 * s + f)), recvInfo,
+                                result);
+            }
+        });
+    }
+    for (auto &camera : cameras) {
+        camera.join();
+    }
+    const double batchSeconds = std::chrono::duration<double>(hitcrt::Clock::now() - batchStart).count();
+    batching.stop();
+
+    const auto stats = batching.stats();
+    const int totalFrames = NUM_SOURCES * FRAMES_PER_SOURCE;
+    std::printf("%d sources x %d frames, mock latency %lld ms + %lld ms/image, max batch %d\n", NUM_SOURCES,
+                FRAMES_PER_SOURCE, static_cast<long long>(FIXED_LATENCY.count()),
+                static_cast<long long>(PER_IMAGE_LATENCY.count()), MAX_BATCH);
+    std::printf("batches: %llu, mean batch size: %.2f, full: %llu, deadline: %llu\n",
+                static_cast<unsigned long long>(stats.m_batches), stats.meanBatchSize(),
+                static_cast<unsigned long long>(stats.m_fullBatches),
+                static_cast<unsigned long long>(stats.m_deadlineBatches));
+    std::printf("sequential: %.1f fps total\n", totalFrames / sequentialSeconds);
+    std::printf("batched   : %.1f fps total\n", totalFrames / batchSeconds);
+    return 0;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file BayerBench.cpp
+ * @brief Bayer原图预处理：2x2合并去马赛克与letterbox融合核与cvtColor+letterbox的耗时对比
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>正确性检查移到test/BayerTest.cpp
+ * </table>
+ */
+#include <cstdint>
+#include <cstdio>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "infer/affine.hpp"
+#include "infer/cpu_warpaffine.hpp"
+
+namespace {
+constexpr int SRC_WIDTH = 1280;
+constexpr int SRC_HEIGHT = 1024;
+constexpr int DST_SIZE = 640;
+constexpr int ITERATIONS = 200;
+}  // namespace
+
+// 用法：bayerBench
+// 在1280x1024->640x640上对比单线程耗时
+int main() {
+    cv::setNumThreads(1);
+    cv::Mat raw(SRC_HEIGHT, SRC_WIDTH, CV_8UC1);
+    cv::randu(raw, cv::Scalar::all(0), cv::Scalar::all(256));
+
+    deploy::AffineTransform transform;
+    transform.updateMatrix(SRC_WIDTH, SRC_HEIGHT, DST_SIZE, DST_SIZE);
+    const deploy::float3 matrix[2] = {transform.matrix[0], transform.matrix[1]};
+    deploy::ProcessConfig config;
+    config.enableSwapRB();
+
+    const size_t plane = static_cast<size_t>(DST_SIZE) * DST_SIZE;
+    std::vector<float> blob(3 * plane);
+    std::vector<uint16_t> blob_half(3 * plane);
+
+    // 改造前：相机线程cvtColor到全分辨率BGR，预处理再letterbox（OpenCV实现）
+    cv::Mat bgr, letterbox;
+    std::vector<cv::Mat> channels(3);
+    const cv::Matx23f warp(matrix[0].x, matrix[0].y, matrix[0].z, matrix[1].x, matrix[1].y, matrix[1].z);
+    hitcrt::bench::print(hitcrt::bench::run("cvtColor EA + opencv letterbox", ITERATIONS, [&] {
+        cv::cvtColor(raw, bgr, cv::COLOR_BayerBG2BGR_EA);
+        cv::warpAffine(bgr, letterbox, warp, cv::Size(DST_SIZE, DST_SIZE), cv::INTER_LINEAR | cv::WARP_INVERSE_MAP,
+                       cv::BORDER_CONSTANT, cv::Scalar::all(config.border_value));
+        cv::split(letterbox, channels);
+        for (int c = 0; c < 3; ++c) {
+            cv::Mat out(DST_SIZE, DST_SIZE, CV_32F, blob.data() + c * plane);
+            channels[2 - c].convertTo(out, CV_32F, config.alpha.x, config.beta.x);
+        }
+    }));
+    hitcrt::bench::print(hitcrt::bench::run("cvtColor EA + fused bgr kernel", ITERATIONS, [&] {
+        cv::cvtColor(raw, bgr, cv::COLOR_BayerBG2BGR_EA);
+        deploy::cpuWarpAffine(bgr.data, SRC_WIDTH, SRC_HEIGHT, blob.data(), DST_SIZE, DST_SIZE, matrix, config);
+    }));
+    hitcrt::bench::print(hitcrt::bench::run("fused bayer kernel fp32", ITERATIONS, [&] {
+        deploy::cpuBayerWarpAffine(raw.data, SRC_WIDTH, SRC_HEIGHT, blob.data(), DST_SIZE, DST_SIZE, matrix, config);
+    }));
+    hitcrt::bench::print(hitcrt::bench::run("fused bayer kernel fp16", ITERATIONS, [&] {
+        deploy::cpuBayerWarpAffine(raw.data, SRC_WIDTH, SRC_HEIGHT, blob_half.data(), DST_SIZE, DST_SIZE, matrix,
+                                   config, deploy::PlanarType::Float16);
+    }));
+    std::printf("full-resolution BGR image skipped per frame: %.1f MB\n",
+                SRC_WIDTH * SRC_HEIGHT * 3 / (1024.0 * 1024.0));
+    return 0;
+}
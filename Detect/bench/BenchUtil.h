@@ -0,0 +1,78 @@
+/**
+ * @file BenchUtil.h
+ * @brief 性能测试程序共用的计时与输出工具
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace hitcrt::bench {
+
+/**
+ * @brief 单项测试结果，单位us
+ */
+struct BenchResult {
+    std::string name;
+    double min = 0.0;
+    double mean = 0.0;
+    double median = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+/**
+ * @brief 先预热再重复执行func，每次单独计时
+ * @param[in] name          测试名
+ * @param[in] iterations    计时次数
+ * @param[in] func          被测函数
+ * @param[in] warmup        预热次数
+ * @return BenchResult
+ */
+inline BenchResult run(const std::string &name, const int iterations, const std::function<void()> &func,
+                       const int warmup = 10) {
+    for (int i = 0; i < warmup; ++i) {
+        func();
+    }
+    std::vector<double> us(iterations);
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto stop = std::chrono::steady_clock::now();
+        us[i] = std::chrono::duration<double, std::micro>(stop - start).count();
+    }
+    std::sort(us.begin(), us.end());
+    BenchResult result;
+    result.name = name;
+    result.min = us.front();
+    result.max = us.back();
+    result.mean = std::accumulate(us.begin(), us.end(), 0.0) / us.size();
+    result.median = us[us.size() / 2];
+    result.p99 = us[std::min(us.size() - 1, static_cast<size_t>(us.size() * 0.99))];
+    return result;
+}
+
+/**
+ * @brief 格式化输出一项结果
+ */
+inline void print(const BenchResult &result) {
+    std::printf("%-36s min = %9.2f us, mean = %9.2f us, median = %9.2f us, p99 = %9.2f us, max = %9.2f us\n",
+                result.name.c_str(), result.min, result.mean, result.median, result.p99, result.max);
+}
+
+}  // namespace hitcrt::bench
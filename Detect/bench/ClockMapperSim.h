@@ -0,0 +1,141 @@
+/**
+ * @file ClockMapperSim.h
+ * @brief 时钟域映射的合成时钟：带漂移的源时钟和带抖动的收到时刻，性能测试和单元测试共用
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "ClockMapper.h"
+
+namespace hitcrt::bench {
+using camera::ClockMapper;
+using camera::TimePoint;
+using Ns = std::chrono::nanoseconds;
+
+// 200fps，最短耗时3ms，指数抖动均值0.5ms，1%的帧卡顿20ms；按回调时刻打戳的误差即抖动本身
+constexpr int64_t FRAME_PERIOD_NS = 5000000;   // 200fps
+constexpr int64_t MIN_LATENCY_NS = 3000000;    // 曝光结束到回调的最短耗时
+constexpr double JITTER_MEAN_NS = 500000.0;    // 排队抖动，指数分布
+constexpr double SPIKE_RATE = 0.01;            // 偶尔卡顿一次
+constexpr int64_t SPIKE_NS = 20000000;
+
+/**
+ * @brief 合成时钟：源时钟 = (本机真实时刻 - 本机原点) * (1 - drift) + 源原点
+ */
+class SynthClock {
+   public:
+    SynthClock(const double driftPpm, const int64_t sourceOrigin, const unsigned seed)
+        : m_rate(1.0 - driftPpm * 1e-6), m_sourceOrigin(sourceOrigin), m_random(seed) {}
+
+    // 第i帧曝光结束的本机真实时刻，ns
+    int64_t exposeHost(const int64_t i) const { return HOST_ORIGIN + i * FRAME_PERIOD_NS; }
+    int64_t source(const int64_t i) const {
+        return m_sourceOrigin + static_cast<int64_t>(std::llround(static_cast<double>(i * FRAME_PERIOD_NS) * m_rate));
+    }
+    // 回调时刻：最短耗时 + 抖动，偶尔卡顿
+    int64_t receiveHost(const int64_t i) {
+        std::exponential_distribution<double> jitter(1.0 / JITTER_MEAN_NS);
+        std::uniform_real_distribution<double> spike(0.0, 1.0);
+        int64_t delay = MIN_LATENCY_NS + static_cast<int64_t>(jitter(m_random));
+        if (spike(m_random) < SPIKE_RATE) {
+            delay += SPIKE_NS;
+        }
+        return exposeHost(i) + delay;
+    }
+
+    static constexpr int64_t HOST_ORIGIN = 1000000000000LL;  // 本机开机约1000s
+
+   private:
+    double m_rate;
+    int64_t m_sourceOrigin;
+    std::mt19937 m_random;
+};
+
+inline TimePoint at(const int64_t ns) { return TimePoint(std::chrono::duration_cast<TimePoint::duration>(Ns(ns))); }
+inline int64_t nsOf(const TimePoint& time) { return std::chrono::duration_cast<Ns>(time.time_since_epoch()).count(); }
+
+/**
+ * @brief 误差统计，单位us
+ */
+struct ErrorStat {
+    double m_mean = 0.0;
+    double m_p99 = 0.0;
+    double m_max = 0.0;
+};
+
+inline ErrorStat statOf(std::vector<double> errors) {
+    ErrorStat stat;
+    if (errors.empty()) {
+        return stat;
+    }
+    for (double& error : errors) {
+        error = std::abs(error);
+        stat.m_mean += error;
+    }
+    std::sort(errors.begin(), errors.end());
+    stat.m_mean /= static_cast<double>(errors.size());
+    stat.m_p99 = errors[errors.size() * 99 / 100];
+    stat.m_max = errors.back();
+    return stat;
+}
+
+/**
+ * @brief 跑一段合成时钟，收敛后统计映射误差
+ * @param[in] driftPpm  源时钟漂移
+ * @param[in] seconds   时长
+ * @param[out] mapped   映射时刻减曝光结束时刻的误差
+ * @param[out] received 回调时刻减曝光结束时刻的误差
+ */
+inline double runClock(const double driftPpm, const int seconds, std::vector<double>& mapped, std::vector<double>& received) {
+    SynthClock clock(driftPpm, 123456789012345LL, 7);
+    ClockMapper mapper;
+    mapper.setLatency(Ns(MIN_LATENCY_NS));
+    const int64_t frames = seconds * 1000000000LL / FRAME_PERIOD_NS;
+    const int64_t warmup = frames / 4;
+    for (int64_t i = 0; i < frames; ++i) {
+        const int64_t receive = clock.receiveHost(i);
+        const TimePoint time = mapper.update(clock.source(i), at(receive));
+        if (i >= warmup) {
+            mapped.push_back((nsOf(time) - clock.exposeHost(i)) / 1000.0);
+            received.push_back((receive - MIN_LATENCY_NS - clock.exposeHost(i)) / 1000.0);
+        }
+    }
+    return mapper.driftPpm();
+}
+
+/**
+ * @brief 相机重启：源时钟归零后继续喂帧
+ * @param[in,out] mapper    映射器
+ * @return 重启后最后一帧的映射误差，ns
+ */
+inline int64_t runReset(ClockMapper& mapper) {
+    mapper.setLatency(Ns(MIN_LATENCY_NS));
+    SynthClock before(30.0, 5000000000LL, 3);
+    SynthClock after(30.0, 0, 4);
+    for (int64_t i = 0; i < 2000; ++i) {
+        mapper.update(before.source(i), at(before.receiveHost(i)));
+    }
+    int64_t lastError = 0;
+    for (int64_t i = 2000; i < 4000; ++i) {
+        const TimePoint time = mapper.update(after.source(i - 2000), at(after.receiveHost(i)));
+        lastError = nsOf(time) - after.exposeHost(i);
+    }
+    return lastError;
+}
+}  // namespace hitcrt::bench
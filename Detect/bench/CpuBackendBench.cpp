@@ -0,0 +1,69 @@
+/**
+ * @file CpuBackendBench.cpp
+ * @brief OpenCV DNN CPU后端的单帧推理耗时，可与TensorRT引擎对比检测结果数量
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <string>
+
+#include "BenchUtil.h"
+#include "model.hpp"
+
+namespace {
+constexpr int ITERATIONS = 200;
+}  // namespace
+
+// 用法：cpuBackendBench <model.onnx> [image] [threads] [engine]
+// 给出engine时在同一张图上再跑一次TensorRT后端，对比两种后端的检测结果数量
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::printf("usage: %s <model.onnx> [image] [threads] [engine]\n", argv[0]);
+        return 1;
+    }
+    cv::Mat image = argc > 2 ? cv::imread(argv[2]) : cv::Mat(1024, 1280, CV_8UC3, cv::Scalar(114, 114, 114));
+    if (image.empty()) {
+        std::printf("failed to read image %s\n", argv[2]);
+        return 1;
+    }
+    deploy::Image input(image.data, image.cols, image.rows);
+
+    // OpenCV线程池是进程级的，后端不设置，由这里设置一次
+    const int threads = argc > 3 ? std::atoi(argv[3]) : 0;
+    if (threads > 0) {
+        cv::setNumThreads(threads);
+    }
+
+    deploy::InferOption option;
+    option.enableSwapRB();
+    option.setBackend(deploy::BackendType::OpenCV);
+    deploy::PoseModel cpuModel(argv[1], option);
+
+    deploy::PoseResView result;
+    std::printf("Frame %dx%d BGR8, %d iterations\n", image.cols, image.rows, ITERATIONS);
+    hitcrt::bench::print(hitcrt::bench::run("OpenCV DNN CPU predict", ITERATIONS,
+                                            [&]() { cpuModel.predict(input, result); }));
+    std::printf("cpu detections: %d\n", result.num);
+
+    if (argc > 4) {
+        deploy::InferOption trtOption;
+        trtOption.enableSwapRB();
+        trtOption.setBackend(deploy::BackendType::TensorRT);
+        deploy::PoseModel trtModel(argv[4], trtOption);
+        hitcrt::bench::print(hitcrt::bench::run("TensorRT predict", ITERATIONS,
+                                                [&]() { trtModel.predict(input, result); }));
+        std::printf("trt detections: %d\n", result.num);
+    }
+    return 0;
+}
@@ -0,0 +1,369 @@
+/**
+ * @file DetectBench.cpp
+ * @brief 检测器CPU热路径的Google Benchmark套件：后处理、去重、坐标映射、装甲板拷贝、帧交接、Bayer转换和结果绘制
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>OpenCV线程数改为在main中统一设置
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>加入原去重算法的对照组
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>模拟后端改用FakePoseBackend.h
+ * </table>
+ */
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <opencv2/imgproc.hpp>
+#include <random>
+#include <streambuf>
+#include <vector>
+
+#include "ArmorDetectorNN.h"
+#include "ArmorNMS.h"
+#include "ArmorOverlay.h"
+#include "FakePoseBackend.h"
+#include "FrameRing.h"
+#include "LatestFrameMailbox.h"
+#include "LegacyDedup.h"
+#include "StagePipeline.h"
+#include "infer/affine.hpp"
+#include "infer/cpu_warpaffine.hpp"
+
+/*
+ * 用法：
+ *   detect_bench                                                   控制台表格
+ *   detect_bench --benchmark_out=detect.json --benchmark_out_format=json   同时写JSON，便于前后两次对比
+ *   detect_bench --benchmark_filter=Decode                         只跑名字匹配的项
+ * 输入全部是固定种子生成的合成数据，推理换成不做计算的后端，不需要GPU和引擎文件，两次运行的结果可以直接对比。
+ */
+
+namespace {
+constexpr int IMAGE_WIDTH = 1280;
+constexpr int IMAGE_HEIGHT = 1024;
+constexpr int NET_SIZE = 640;
+constexpr int MAX_DETECTIONS = 100;
+constexpr int NUM_KEYPOINTS = 4;
+constexpr int KEYPOINT_DIM = 2;
+constexpr unsigned SEED = 20261017;
+
+/**
+ * @brief 合成的一组装甲板：若干个目标，每个目标带几个抖动的重复框，类别红蓝各半，坐标在网络输入空间
+ */
+struct Detections {
+    std::vector<float> boxes;
+    std::vector<float> scores;
+    std::vector<int> classes;
+    std::vector<float> kpts;
+};
+
+Detections makeDetections(const int num) {
+    std::mt19937 rng(SEED);
+    std::uniform_real_distribution<float> position(40.0f, NET_SIZE - 80.0f), jitter(-1.5f, 1.5f), score(0.45f, 0.99f);
+    Detections detections;
+    const int targets = std::max(1, num / 3);
+    std::vector<cv::Point2f> centers(targets);
+    for (auto &center : centers) {
+        center = cv::Point2f(position(rng), position(rng));
+    }
+    for (int i = 0; i < num; ++i) {
+        const int target = i % targets;
+        const cv::Point2f c = centers[target] + cv::Point2f(jitter(rng), jitter(rng));
+        const float w = 15.0f, h = 6.0f;
+        detections.boxes.insert(detections.boxes.end(), {c.x - w, c.y - h, c.x + w, c.y + h});
+        // 左上、左下、右下、右上，与ArmorDetectorNN::decode的顺序一致
+        detections.kpts.insert(detections.kpts.end(), {c.x - w, c.y - h, c.x - w, c.y + h, c.x + w, c.y + h, c.x + w, c.y - h});
+        detections.scores.push_back(score(rng));
+        detections.classes.push_back((target % 2 == 0 ? 0 : 9) + target % 9);
+    }
+    return detections;
+}
+
+std::unique_ptr<deploy::PoseModel> makeModel(const int num) {
+    auto backend = std::make_unique<hitcrt::bench::FakePoseBackend>(1, MAX_DETECTIONS, NET_SIZE);
+    const int count = std::min(num, MAX_DETECTIONS);
+    const Detections detections = makeDetections(count);
+    for (int i = 0; i < count; ++i) {
+        backend->setDetection(0, i, detections.classes[i], detections.scores[i], &detections.boxes[i * 4],
+                              &detections.kpts[i * NUM_KEYPOINTS * KEYPOINT_DIM]);
+    }
+    backend->setNum(0, count);
+    return std::make_unique<deploy::PoseModel>(std::move(backend));
+}
+
+const cv::Mat &bgrImage() {
+    static const cv::Mat image(IMAGE_HEIGHT, IMAGE_WIDTH, CV_8UC3, cv::Scalar(40, 40, 40));
+    return image;
+}
+
+const hitcrt::RecvInfoBase &recvInfo() {
+    static const hitcrt::RecvInfoBase info(0.0, 0.0, 0.0, 25.0, hitcrt::BLUE, true);  // 敌方蓝色，类别0-8
+    return info;
+}
+
+/**
+ * @brief 丢弃写入的字符。decode去重后打印一行日志，格式化照常计时，只是不写终端，免得冲掉结果表格
+ */
+class NullBuffer : public std::streambuf {
+   protected:
+    int overflow(int c) override { return c; }
+};
+
+class MuteCout {
+   public:
+    MuteCout() : m_saved(std::cout.rdbuf(&m_null)) {}
+    ~MuteCout() { std::cout.rdbuf(m_saved); }
+
+   private:
+    NullBuffer m_null;
+    std::streambuf *m_saved;
+};
+
+// 与ArmorDetectorNN::decode的类别对应关系一致
+const hitcrt::Pattern PATTERNS[9] = {hitcrt::Pattern::SENTRY,     hitcrt::Pattern::HERO,       hitcrt::Pattern::ENGINEER,
+                                     hitcrt::Pattern::INFANTRY_3, hitcrt::Pattern::INFANTRY_4, hitcrt::Pattern::UNKNOWN,
+                                     hitcrt::Pattern::OUTPOST,    hitcrt::Pattern::UNKNOWN,    hitcrt::Pattern::BASE};
+
+/**
+ * @brief 原图坐标的装甲板，由后处理得到，与真实流水线里交给下游的数据一致
+ */
+std::vector<hitcrt::ArmorObservation> makeObservations(const int num) {
+    hitcrt::ArmorDetectorNN detector(makeModel(num), 0.4f);
+    const hitcrt::Frame frame(bgrImage(), hitcrt::TimePoint());
+    deploy::PoseResView result;
+    detector.infer(frame, result);
+    // 不经颜色筛选和去重，保留全部num个
+    std::vector<hitcrt::ArmorObservation> armors;
+    for (const auto det : result) {
+        hitcrt::ArmorObservation armor;
+        armor.m_topLeft = cv::Point2f(det.x(0), det.y(0));
+        armor.m_bottomLeft = cv::Point2f(det.x(1), det.y(1));
+        armor.m_bottomRight = cv::Point2f(det.x(2), det.y(2));
+        armor.m_topRight = cv::Point2f(det.x(3), det.y(3));
+        armor.m_centerLeft = (armor.m_topLeft + armor.m_bottomLeft) * 0.5f;
+        armor.m_centerRight = (armor.m_topRight + armor.m_bottomRight) * 0.5f;
+        armor.m_centerUV = (armor.m_centerLeft + armor.m_centerRight) * 0.5f;
+        armor.m_confidence = det.score;
+        armor.m_classID = det.cls;
+        armor.m_pattern = PATTERNS[det.cls % 9];
+        armors.push_back(armor);
+    }
+    return armors;
+}
+
+// 推理输出张量 -> PoseResView：逐个检测结果把框和关键点映射回原图坐标
+void BM_PosePostprocess(benchmark::State &state) {
+    const auto model = makeModel(static_cast<int>(state.range(0)));
+    const deploy::Image image(bgrImage().data, IMAGE_WIDTH, IMAGE_HEIGHT);
+    deploy::PoseResView result;
+    model->predict(image, result);
+    for (auto _ : state) {
+        model->predict(image, result);
+        benchmark::DoNotOptimize(result.num);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PosePostprocess)->Arg(6)->Arg(30)->Arg(100);
+
+// PoseResView -> 装甲板：关键点转角点、颜色筛选、同类别去重
+void BM_Decode(benchmark::State &state) {
+    hitcrt::ArmorDetectorNN detector(makeModel(static_cast<int>(state.range(0))), 0.4f);
+    const hitcrt::Frame frame(bgrImage(), hitcrt::TimePoint());
+    deploy::PoseResView result;
+    detector.infer(frame, result);
+    std::vector<hitcrt::ArmorObservation> armors;
+    const MuteCout mute;
+    for (auto _ : state) {
+        detector.decode(result, frame, recvInfo(), armors);
+        benchmark::DoNotOptimize(armors.data());
+    }
+    state.counters["kept"] = static_cast<double>(armors.size());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Decode)->Arg(6)->Arg(30)->Arg(100);
+
+// 同上，输出为带解算字段的Armor，多一次逐个构造
+void BM_DecodeArmor(benchmark::State &state) {
+    hitcrt::ArmorDetectorNN detector(makeModel(static_cast<int>(state.range(0))), 0.4f);
+    const hitcrt::Frame frame(bgrImage(), hitcrt::TimePoint());
+    deploy::PoseResView result;
+    detector.infer(frame, result);
+    std::vector<hitcrt::Armor> armors;
+    const MuteCout mute;
+    for (auto _ : state) {
+        detector.decode(result, frame, recvInfo(), armors);
+        benchmark::DoNotOptimize(armors.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DecodeArmor)->Arg(6)->Arg(30)->Arg(100);
+
+// 同类别去重（替代原filterDuplicateByClassIOU），第二个参数0为外接矩形IOU，1为四边形IOU
+void BM_ArmorNMS(benchmark::State &state) {
+    const std::vector<hitcrt::ArmorObservation> candidates = makeObservations(static_cast<int>(state.range(0)));
+    hitcrt::ArmorNMS nms(state.range(1) == 0 ? hitcrt::NMSMode::AABB : hitcrt::NMSMode::POLYGON, 0.5f);
+    std::vector<hitcrt::ArmorObservation> armors;
+    armors.reserve(candidates.size());
+    for (auto _ : state) {
+        armors.assign(candidates.begin(), candidates.end());
+        nms.apply(armors);
+        benchmark::DoNotOptimize(armors.data());
+    }
+    state.counters["kept"] = static_cast<double>(armors.size());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ArmorNMS)->ArgsProduct({{10, 50, 200}, {0, 1}});
+
+// 对照组：原filterDuplicateByClassIOU，实现取自LegacyDedup.h，不在这里另存一份
+void BM_LegacyDedup(benchmark::State &state) {
+    const std::vector<hitcrt::ArmorObservation> candidates = makeObservations(static_cast<int>(state.range(0)));
+    std::vector<hitcrt::ArmorObservation> armors;
+    for (auto _ : state) {
+        armors.assign(candidates.begin(), candidates.end());
+        hitcrt::bench::legacyFilterDuplicateByClassIOU(armors, 0.5f);
+        benchmark::DoNotOptimize(armors.data());
+    }
+    state.counters["kept"] = static_cast<double>(armors.size());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LegacyDedup)->Arg(10)->Arg(50)->Arg(200);
+
+// 网络输入坐标 -> 原图坐标，按关键点数组逐点映射
+void BM_ApplyTransform(benchmark::State &state) {
+    const int points = static_cast<int>(state.range(0));
+    deploy::AffineTransform transform;
+    transform.updateMatrix(IMAGE_WIDTH, IMAGE_HEIGHT, NET_SIZE, NET_SIZE);
+    std::mt19937 rng(SEED);
+    std::uniform_real_distribution<float> coordinate(0.0f, NET_SIZE);
+    std::vector<float> input(points * 2), output(points * 2);
+    for (auto &value : input) {
+        value = coordinate(rng);
+    }
+    for (auto _ : state) {
+        for (int i = 0; i < points; ++i) {
+            transform.applyTransform(input[2 * i], input[2 * i + 1], &output[2 * i], &output[2 * i + 1]);
+        }
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * points);
+}
+BENCHMARK(BM_ApplyTransform)->Arg(NUM_KEYPOINTS * 30)->Arg(NUM_KEYPOINTS * MAX_DETECTIONS);
+
+// 一帧的检测结果在各级之间按值传递：只含观测量的ArmorObservation与带解算字段的Armor
+template <typename ArmorT>
+void BM_ArmorCopy(benchmark::State &state) {
+    const std::vector<hitcrt::ArmorObservation> observations = makeObservations(static_cast<int>(state.range(0)));
+    const std::vector<ArmorT> source(observations.begin(), observations.end());
+    std::vector<ArmorT> copy;
+    copy.reserve(source.size());
+    for (auto _ : state) {
+        copy = source;
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(ArmorT));
+}
+BENCHMARK_TEMPLATE(BM_ArmorCopy, hitcrt::ArmorObservation)->Arg(30);
+BENCHMARK_TEMPLATE(BM_ArmorCopy, hitcrt::Armor)->Arg(30);
+
+// 取图 -> 检测的交接：借帧槽位、提交、经最新帧信箱交给消费者、归还槽位，单线程测一次往返的固定开销
+void BM_MailboxHandoff(benchmark::State &state) {
+    hitcrt::FrameRing ring(4, IMAGE_WIDTH, IMAGE_HEIGHT, CV_8UC3);
+    hitcrt::LatestFrameMailbox<hitcrt::FrameHandle> mailbox;
+    hitcrt::FrameHandle received;
+    for (auto _ : state) {
+        hitcrt::FrameHandle handle = ring.acquire();
+        handle.commit(hitcrt::TimePoint());
+        mailbox.publish(std::move(handle));
+        mailbox.try_consume(received);
+        received.reset();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MailboxHandoff);
+
+// 流水线两级之间的交接：有界通道放入、取出一个帧句柄
+void BM_StageChannelHandoff(benchmark::State &state) {
+    hitcrt::FrameRing ring(4, IMAGE_WIDTH, IMAGE_HEIGHT, CV_8UC3);
+    hitcrt::StageChannel<hitcrt::FrameHandle> channel(1, hitcrt::DropPolicy::DROP_OLDEST);
+    hitcrt::FrameHandle received;
+    for (auto _ : state) {
+        hitcrt::FrameHandle handle = ring.acquire();
+        handle.commit(hitcrt::TimePoint());
+        channel.push(handle);
+        channel.pop(received);
+        received.reset();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StageChannelHandoff);
+
+cv::Mat bayerImage() {
+    cv::Mat raw(IMAGE_HEIGHT, IMAGE_WIDTH, CV_8UC1, cv::Scalar::all(0));
+    std::mt19937 rng(SEED);
+    for (int i = 0; i < IMAGE_HEIGHT * IMAGE_WIDTH; ++i) {
+        raw.data[i] = static_cast<uint8_t>(rng());
+    }
+    return raw;
+}
+
+// Bayer原图 -> 全分辨率BGR，改造前相机线程每帧做一次
+void BM_BayerCvtColor(benchmark::State &state) {
+    const cv::Mat raw = bayerImage();
+    cv::Mat bgr;
+    for (auto _ : state) {
+        cv::cvtColor(raw, bgr, cv::COLOR_BayerBG2BGR);
+        benchmark::DoNotOptimize(bgr.data);
+    }
+    state.SetBytesProcessed(state.iterations() * IMAGE_WIDTH * IMAGE_HEIGHT);
+}
+BENCHMARK(BM_BayerCvtColor)->Unit(benchmark::kMicrosecond);
+
+// Bayer原图直接进letterbox：2x2合并去马赛克与插值、归一化融合，输出网络输入
+void BM_BayerFusedLetterbox(benchmark::State &state) {
+    const cv::Mat raw = bayerImage();
+    deploy::AffineTransform transform;
+    transform.updateMatrix(IMAGE_WIDTH, IMAGE_HEIGHT, NET_SIZE, NET_SIZE);
+    deploy::ProcessConfig config;
+    config.enableSwapRB();
+    std::vector<float> blob(static_cast<size_t>(3) * NET_SIZE * NET_SIZE);
+    for (auto _ : state) {
+        deploy::cpuBayerWarpAffine(raw.data, IMAGE_WIDTH, IMAGE_HEIGHT, blob.data(), NET_SIZE, NET_SIZE,
+                                   transform.matrix, config);
+        benchmark::DoNotOptimize(blob.data());
+    }
+    state.SetBytesProcessed(state.iterations() * IMAGE_WIDTH * IMAGE_HEIGHT);
+}
+BENCHMARK(BM_BayerFusedLetterbox)->Unit(benchmark::kMicrosecond);
+
+// 显示线程在原图上绘制检测结果；每次在同一张图上重画，只测绘制本身
+void BM_DrawArmors(benchmark::State &state) {
+    const std::vector<hitcrt::ArmorObservation> armors = makeObservations(static_cast<int>(state.range(0)));
+    cv::Mat image = bgrImage().clone();
+    for (auto _ : state) {
+        hitcrt::drawArmors(image, armors);
+        benchmark::DoNotOptimize(image.data);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DrawArmors)->Arg(6)->Arg(30)->Unit(benchmark::kMicrosecond);
+}  // namespace
+
+// OpenCV线程数在运行任何基准之前设置一次：融合letterbox是单线程的，cvtColor也按单线程比较，且结果不随过滤和注册顺序变化
+int main(int argc, char **argv) {
+    cv::setNumThreads(1);
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
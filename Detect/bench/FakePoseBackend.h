@@ -0,0 +1,188 @@
+/**
+ * @file FakePoseBackend.h
+ * @brief 不做推理的模拟后端，输出张量按TensorRT引擎的布局排列，性能测试和单元测试共用
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "infer/base_backend.hpp"
+
+namespace hitcrt::bench {
+
+/**
+ * @brief 输出张量为 num、boxes、scores、classes、kpts，坐标在网络输入空间，每个检测4个角点
+ *
+ * 默认的infer只更新仿射矩阵，输出保持setDetection写入的内容；需要按输入生成结果的派生类重写infer，
+ * 先调用updateTransforms再写检测结果。maxBatch大于1时为动态batch。
+ */
+class FakePoseBackend : public deploy::BaseBackend {
+   public:
+    static constexpr int NUM_KEYPOINTS = 4;
+    static constexpr int KEYPOINT_DIM = 2;
+
+    FakePoseBackend(const int maxBatch, const int maxDetections, const int netSize = 640)
+        : m_maxBatch(maxBatch), m_maxDetections(maxDetections), m_netSize(netSize) {
+        dynamic = maxBatch > 1;
+        min_shape = deploy::make_int4(1, 3, netSize, netSize);
+        max_shape = deploy::make_int4(maxBatch, 3, netSize, netSize);
+        affine_transforms.resize(maxBatch, deploy::AffineTransform());
+        m_num.assign(maxBatch, 0);
+        m_boxes.assign(static_cast<size_t>(maxBatch) * maxDetections * 4, 0.0f);
+        m_scores.assign(static_cast<size_t>(maxBatch) * maxDetections, 0.0f);
+        m_classes.assign(static_cast<size_t>(maxBatch) * maxDetections, 0);
+        m_kpts.assign(static_cast<size_t>(maxBatch) * maxDetections * NUM_KEYPOINTS * KEYPOINT_DIM, 0.0f);
+        bindTensors();
+    }
+
+    // 复制输出内容，张量视图指向自己的缓冲区
+    FakePoseBackend(const FakePoseBackend &other)
+        : deploy::BaseBackend(other),
+          m_maxBatch(other.m_maxBatch),
+          m_maxDetections(other.m_maxDetections),
+          m_netSize(other.m_netSize),
+          m_num(other.m_num),
+          m_boxes(other.m_boxes),
+          m_scores(other.m_scores),
+          m_classes(other.m_classes),
+          m_kpts(other.m_kpts) {
+        bindTensors();
+    }
+
+    std::unique_ptr<deploy::BaseBackend> clone() override { return std::make_unique<FakePoseBackend>(*this); }
+
+    void infer(const std::vector<deploy::Image> &inputs) override { updateTransforms(inputs); }
+
+    int numTensors() const override { return static_cast<int>(m_tensors.size()); }
+
+    deploy::HostTensor tensor(int index) const override { return m_tensors[index]; }
+
+    deploy::BackendType type() const override { return deploy::BackendType::OpenCV; }
+
+    /**
+     * @brief 写第batch张图的第index个检测，超出maxDetections的忽略
+     * @param[in] box   左、上、右、下
+     * @param[in] kpts  左上、左下、右下、右上四个角点的x、y，与ArmorDetectorNN::decode的顺序一致
+     */
+    void setDetection(const int batch, const int index, const int cls, const float score, const float *box,
+                      const float *kpts) {
+        if (index >= m_maxDetections) {
+            return;
+        }
+        const size_t slot = static_cast<size_t>(batch) * m_maxDetections + index;
+        std::copy(box, box + 4, m_boxes.begin() + slot * 4);
+        std::copy(kpts, kpts + NUM_KEYPOINTS * KEYPOINT_DIM, m_kpts.begin() + slot * NUM_KEYPOINTS * KEYPOINT_DIM);
+        m_scores[slot] = score;
+        m_classes[slot] = cls;
+    }
+
+    // 轴对齐的装甲板，角点取框的四个角
+    void setDetection(const int batch, const int index, const int cls, const float score, const float left,
+                      const float top, const float right, const float bottom) {
+        const float box[] = {left, top, right, bottom};
+        const float kpts[] = {left, top, left, bottom, right, bottom, right, top};
+        setDetection(batch, index, cls, score, box, kpts);
+    }
+
+    void setNum(const int batch, const int num) { m_num[batch] = std::min(num, m_maxDetections); }
+
+    int maxDetections() const { return m_maxDetections; }
+    int netSize() const { return m_netSize; }
+
+   protected:
+    void updateTransforms(const std::vector<deploy::Image> &inputs) {
+        for (size_t idx = 0; idx < inputs.size() && idx < affine_transforms.size(); ++idx) {
+            affine_transforms[idx].updateMatrix(inputs[idx].width, inputs[idx].height, m_netSize, m_netSize);
+        }
+    }
+
+   private:
+    void bindTensors() {
+        auto make_tensor = [](void *host, std::initializer_list<int64_t> dims) {
+            deploy::HostTensor view;
+            view.host = host;
+            view.shape.nbDims = static_cast<int>(dims.size());
+            std::copy(dims.begin(), dims.end(), view.shape.d);
+            return view;
+        };
+        m_tensors = {make_tensor(nullptr, {m_maxBatch, 3, m_netSize, m_netSize}),
+                     make_tensor(m_num.data(), {m_maxBatch, 1}),
+                     make_tensor(m_boxes.data(), {m_maxBatch, m_maxDetections, 4}),
+                     make_tensor(m_scores.data(), {m_maxBatch, m_maxDetections}),
+                     make_tensor(m_classes.data(), {m_maxBatch, m_maxDetections}),
+                     make_tensor(m_kpts.data(), {m_maxBatch, m_maxDetections, NUM_KEYPOINTS, KEYPOINT_DIM})};
+    }
+
+    int m_maxBatch;
+    int m_maxDetections;
+    int m_netSize;
+    std::vector<int> m_num;
+    std::vector<float> m_boxes;
+    std::vector<float> m_scores;
+    std::vector<int> m_classes;
+    std::vector<float> m_kpts;
+    std::vector<deploy::HostTensor> m_tensors;
+};
+
+/**
+ * @brief 按输入像素给出结果的后端，用于检查批量收集/分发和推理池的结果是否对应到自己的帧
+ *
+ * 每张图输出一个目标：类别取第一个像素，左上角x取第二个像素，y为100，网络输入坐标。
+ * 用sleep模拟GPU耗时（不占CPU，多个副本可以重叠）：固定开销 + 每张图的开销，批量推理摊薄固定开销。
+ * 克隆出的副本使用setCloneLatency设置的固定开销，用来让第一个实例比其他副本慢。
+ */
+class PixelCodedBackend : public FakePoseBackend {
+   public:
+    PixelCodedBackend(const int maxBatch, const std::chrono::microseconds fixedLatency,
+                      const std::chrono::microseconds perImageLatency = std::chrono::microseconds(0))
+        : FakePoseBackend(maxBatch, 10),
+          m_fixedLatency(fixedLatency),
+          m_perImageLatency(perImageLatency),
+          m_cloneLatency(fixedLatency) {}
+
+    std::unique_ptr<deploy::BaseBackend> clone() override {
+        auto copy = std::make_unique<PixelCodedBackend>(*this);
+        copy->m_fixedLatency = m_cloneLatency;
+        return copy;
+    }
+
+    void infer(const std::vector<deploy::Image> &inputs) override {
+        if (inputs.empty() || inputs.size() > affine_transforms.size()) {
+            throw std::invalid_argument("Number of inputs out of range");
+        }
+        updateTransforms(inputs);
+        for (size_t idx = 0; idx < inputs.size(); ++idx) {
+            const auto *pixel = static_cast<const uint8_t *>(inputs[idx].ptr);
+            const float x = pixel[1], y = 100.0f;
+            setDetection(static_cast<int>(idx), 0, pixel[0], 0.9f, x, y, x + 30.0f, y + 12.0f);
+            setNum(static_cast<int>(idx), 1);
+        }
+        std::this_thread::sleep_for(m_fixedLatency + m_perImageLatency * inputs.size());
+    }
+
+    void setCloneLatency(const std::chrono::microseconds latency) { m_cloneLatency = latency; }
+
+   private:
+    std::chrono::microseconds m_fixedLatency;
+    std::chrono::microseconds m_perImageLatency;
+    std::chrono::microseconds m_cloneLatency;
+};
+
+}  // namespace hitcrt::bench
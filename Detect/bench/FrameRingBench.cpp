@@ -0,0 +1,69 @@
+/**
+ * @file FrameRingBench.cpp
+ * @brief 回调->检测取图路径对比：逐跳clone vs 帧环形缓冲区
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "FrameRing.h"
+
+namespace {
+constexpr int WIDTH = 1280;
+constexpr int HEIGHT = 1024;
+constexpr int ITERATIONS = 2000;
+}  // namespace
+
+int main() {
+    // 模拟 sensor_msgs::msg::Image 的数据区
+    std::vector<uint8_t> msgData(WIDTH * HEIGHT * 3);
+    for (size_t i = 0; i < msgData.size(); ++i) {
+        msgData[i] = static_cast<uint8_t>(i * 31);
+    }
+    const cv::Mat msgImage(HEIGHT, WIDTH, CV_8UC3, msgData.data());
+
+    // 原路径：toCvCopy拷贝 -> push时clone -> apply里再clone
+    std::queue<cv::Mat> cloneQueue;
+    auto clonePath = [&]() {
+        cv::Mat bridged = msgImage.clone();
+        cloneQueue.push(bridged.clone());
+        cv::Mat popped = cloneQueue.front();
+        cloneQueue.pop();
+        cv::Mat image = popped.clone();
+        volatile uint8_t sink = image.data[0];
+        (void)sink;
+    };
+
+    // 环形缓冲区路径：写一次进槽位，之后只传句柄
+    hitcrt::FrameRing ring(4, WIDTH, HEIGHT, CV_8UC3);
+    std::queue<hitcrt::FrameHandle> ringQueue;
+    auto ringPath = [&]() {
+        hitcrt::FrameHandle handle = ring.acquire();
+        msgImage.copyTo(handle.image());
+        handle.commit(std::chrono::steady_clock::now());
+        ringQueue.push(handle);
+        handle.reset();
+        hitcrt::FrameHandle popped = std::move(ringQueue.front());
+        ringQueue.pop();
+        const cv::Mat &image = popped.image();
+        volatile uint8_t sink = image.data[0];
+        (void)sink;
+    };
+
+    std::printf("Frame %dx%d BGR8, %d iterations\n", WIDTH, HEIGHT, ITERATIONS);
+    hitcrt::bench::print(hitcrt::bench::run("clone per hop (3 copies)", ITERATIONS, clonePath));
+    hitcrt::bench::print(hitcrt::bench::run("frame ring (1 copy)", ITERATIONS, ringPath));
+    std::printf("ring dropped: %lu\n", static_cast<unsigned long>(ring.dropped()));
+    return 0;
+}
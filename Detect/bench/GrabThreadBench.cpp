@@ -0,0 +1,220 @@
+/**
+ * @file GrabThreadBench.cpp
+ * @brief STREAM_MULTITHREAD取图线程：SDK替身上模拟推理偶尔卡顿，对比手写取图循环的SDK丢帧和取图延迟
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <sched.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "HuarayCam.h"
+#include "IMVShim.h"
+
+namespace {
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+constexpr int WIDTH = 1280;
+constexpr int HEIGHT = 1024;
+constexpr int NUM_FRAMES = 400;
+constexpr int NUM_RAWS = 16;  // 多于SDK缓存帧数，排队中的原图不会被生产者改写
+constexpr auto FRAME_PERIOD = 5ms;  // 相机200fps
+constexpr auto INFER_TIME = 3ms;    // 平时推理耗时
+constexpr auto STALL_TIME = 60ms;   // 偶尔卡顿一次
+constexpr int STALL_EVERY = 100;
+
+/**
+ * @brief 一次运行的结果
+ */
+struct RunResult {
+    int m_consumed = 0;                   // 下游处理的帧数
+    uint64_t m_sdkDropped = 0;            // SDK缓存满丢掉的帧数
+    std::vector<int> m_indices;           // 下游依次拿到的帧号
+    std::vector<double> m_latencies;      // 相机出帧到下游拿到的时间，ms
+};
+
+/**
+ * @brief 模拟相机：按固定帧率把帧号写进原图前4个字节后放进SDK缓存
+ */
+class FakeSensor {
+   public:
+    FakeSensor() : m_raws(NUM_RAWS, std::vector<uint8_t>(static_cast<size_t>(WIDTH) * HEIGHT, 0)), m_times(NUM_FRAMES) {}
+
+    void start() {
+        m_done = false;
+        m_thread = std::thread([this] {
+            const auto begin = Clock::now();
+            for (int i = 0; i < NUM_FRAMES; ++i) {
+                std::this_thread::sleep_until(begin + FRAME_PERIOD * i);
+                uint8_t *raw = m_raws[i % NUM_RAWS].data();
+                const uint32_t index = static_cast<uint32_t>(i);
+                std::memcpy(raw, &index, sizeof(index));
+                m_times[i] = Clock::now();
+                hitcrt::camera::imvshim::queue(raw, i);
+            }
+            m_done = true;
+        });
+    }
+
+    void join() { m_thread.join(); }
+    bool done() const { return m_done; }
+    Clock::time_point time(const int index) const { return m_times[index]; }
+
+   private:
+    std::vector<std::vector<uint8_t>> m_raws;
+    std::vector<Clock::time_point> m_times;
+    std::atomic<bool> m_done{false};
+    std::thread m_thread;
+};
+
+int readIndex(const uint8_t *data) {
+    uint32_t index = 0;
+    std::memcpy(&index, data, sizeof(index));
+    return static_cast<int>(index);
+}
+
+// 下游处理一帧，第STALL_EVERY帧卡顿一次
+void infer(const int consumed) { std::this_thread::sleep_for(consumed % STALL_EVERY == STALL_EVERY - 1 ? STALL_TIME : INFER_TIME); }
+
+void record(RunResult &result, const FakeSensor &sensor, const int index) {
+    result.m_indices.push_back(index);
+    result.m_latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - sensor.time(index)).count());
+}
+
+/**
+ * @brief 改造前：下游线程自己循环IMV_GetFrame，处理完一帧才取下一帧（即在getFrameImage外面手写线程）
+ */
+RunResult runHandRolled() {
+    hitcrt::camera::imvshim::reset(WIDTH, HEIGHT);
+    IMV_HANDLE handle = nullptr;
+    IMV_CreateHandle(&handle, modeByIndex, nullptr);
+    IMV_Open(handle);
+    IMV_StartGrabbing(handle);
+    cv::Mat image(HEIGHT, WIDTH, CV_8UC1, cv::Scalar::all(0));
+
+    FakeSensor sensor;
+    RunResult result;
+    sensor.start();
+    while (true) {
+        IMV_Frame frame;
+        if (IMV_GetFrame(handle, &frame, 5) != IMV_OK) {
+            if (sensor.done()) {
+                break;
+            }
+            continue;
+        }
+        const cv::Mat raw(frame.frameInfo.height, frame.frameInfo.width, CV_8UC1, frame.pData);
+        raw.copyTo(image);
+        IMV_ReleaseFrame(handle, &frame);
+        record(result, sensor, readIndex(image.data));
+        infer(result.m_consumed++);
+    }
+    sensor.join();
+    IMV_StopGrabbing(handle);
+    result.m_sdkDropped = hitcrt::camera::imvshim::sdkDropped();
+    return result;
+}
+
+/**
+ * @brief 改造后：驱动的取图线程取图，下游用next()拿最新帧
+ * @param[in] cpu   取图线程绑定的CPU核
+ * @param[in] grabCpu   取图线程实际运行的CPU核
+ */
+RunResult runGrabThread(const int cpu, std::atomic<int> &grabCpu, hitcrt::camera::Huaray::GrabStat &stat,
+                        int &lastIndex) {
+    hitcrt::camera::imvshim::reset(WIDTH, HEIGHT);
+    hitcrt::camera::HuarayParams params(hitcrt::camera::CameraParams::noUse, 1, hitcrt::camera::STREAM_MULTITHREAD,
+                                        WIDTH, HEIGHT, 0, 50, 0, 0, 5000.0, 1.0, 1.0, {1.0, 1.0, 1.0});
+    params.setRawBayer(true);
+    params.setGrabCpu(cpu);
+    // onGet在取图线程里执行，用来确认绑核生效
+    params.setOnGet([&grabCpu] { grabCpu = sched_getcpu(); });
+    hitcrt::camera::Huaray cam;
+    RunResult result;
+    if (!cam.initiate(params)) {
+        std::printf("initiate on shim failed\n");
+        return result;
+    }
+
+    FakeSensor sensor;
+    sensor.start();
+    while (true) {
+        auto frame = cam.next(20);
+        if (!std::get<0>(frame)) {
+            if (sensor.done()) {
+                break;
+            }
+            continue;
+        }
+        record(result, sensor, readIndex(std::get<2>(frame).image().data));
+        infer(result.m_consumed++);
+    }
+    sensor.join();
+    stat = cam.grabStat();
+    auto last = cam.latest();
+    lastIndex = std::get<0>(last) ? readIndex(std::get<2>(last).image().data) : -1;
+    std::get<2>(last).reset();
+    cam.terminate();
+    result.m_sdkDropped = hitcrt::camera::imvshim::sdkDropped();
+    return result;
+}
+
+void printResult(const char *name, const RunResult &result) {
+    std::vector<double> latencies = result.m_latencies;
+    std::sort(latencies.begin(), latencies.end());
+    double mean = 0.0;
+    for (const double latency : latencies) {
+        mean += latency;
+    }
+    mean = latencies.empty() ? 0.0 : mean / latencies.size();
+    std::printf("%-18s consumed %3d, sdk dropped %3llu, latency mean %6.2f ms, p99 %6.2f ms, max %6.2f ms\n", name,
+                result.m_consumed, static_cast<unsigned long long>(result.m_sdkDropped), mean,
+                latencies.empty() ? 0.0 : latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)],
+                latencies.empty() ? 0.0 : latencies.back());
+}
+}  // namespace
+
+// 用法：grabThreadBench
+// 相机200fps，下游平时3ms一帧，每100帧卡顿60ms（超过SDK缓存8帧的40ms）
+int main() {
+    const RunResult handRolled = runHandRolled();
+
+    std::atomic<int> grabCpu{-1};
+    hitcrt::camera::Huaray::GrabStat stat;
+    int lastIndex = -1;
+    const RunResult grabThread = runGrabThread(0, grabCpu, stat, lastIndex);
+
+    printResult("hand-rolled loop", handRolled);
+    printResult("grab thread", grabThread);
+    std::printf("grab thread: grabbed %llu, overwritten before taken %llu, pool dropped %llu, get frame failed %llu, "
+                "ran on cpu %d\n",
+                static_cast<unsigned long long>(std::get<0>(stat)), static_cast<unsigned long long>(std::get<1>(stat)),
+                static_cast<unsigned long long>(std::get<2>(stat)), static_cast<unsigned long long>(std::get<3>(stat)),
+                grabCpu.load());
+
+    // 取图线程下SDK不丢帧，每帧都被转换；下游拿到的帧号严格递增，latest()是最后一帧
+    bool ok = grabThread.m_sdkDropped == 0 && std::get<0>(stat) == NUM_FRAMES && std::get<2>(stat) == 0 &&
+              grabCpu == 0 && lastIndex == NUM_FRAMES - 1 && !grabThread.m_indices.empty() &&
+              std::get<0>(stat) == static_cast<uint64_t>(grabThread.m_consumed) + std::get<1>(stat);
+    for (size_t i = 1; i < grabThread.m_indices.size(); ++i) {
+        ok = ok && grabThread.m_indices[i] > grabThread.m_indices[i - 1];
+    }
+    std::printf("grab thread check: %s\n", ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file HistogramBench.cpp
+ * @brief 耗时直方图：记录一次的代价，以及与排序整个样本序列的统计代价对比
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>分桶、分位数、合并和窗口检查移到test/HistogramTest.cpp
+ * </table>
+ */
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "utils/histogram.hpp"
+#include "utils/utils.hpp"
+
+namespace {
+using deploy::LatencyHistogram;
+}  // namespace
+
+// 用法：histogramBench
+// 对比记录一次的代价，以及样本数增长时出一次报告的代价
+int main() {
+    std::mt19937 rng(7);
+    std::lognormal_distribution<float> latency(std::log(5.0f), 0.4f);
+    std::vector<float> values(1 << 16);
+    for (auto &v : values) {
+        v = latency(rng);
+    }
+    LatencyHistogram histogram;
+    size_t next = 0;
+    hitcrt::bench::print(hitcrt::bench::run("record x1000", 1000, [&] {
+        for (int i = 0; i < 1000; ++i) {
+            histogram.record(values[next++ & (values.size() - 1)]);
+        }
+    }));
+    const std::vector<float> percentiles = {50, 90, 99, 99.9f};
+    // 原来的计时器每次报告复制并排序全部样本
+    for (const int count : {10000, 100000, 1000000}) {
+        std::vector<float> timings(count);
+        LatencyHistogram filled;
+        for (int i = 0; i < count; ++i) {
+            timings[i] = values[i & (values.size() - 1)];
+            filled.record(timings[i]);
+        }
+        hitcrt::bench::print(hitcrt::bench::run("sort report n=" + std::to_string(count), 20,
+                                                [&] { deploy::getPerformanceResult(timings, percentiles); }));
+        hitcrt::bench::print(hitcrt::bench::run("histogram report n=" + std::to_string(count), 20,
+                                                [&] { deploy::getPerformanceResult(filled, percentiles); }));
+    }
+    return 0;
+}
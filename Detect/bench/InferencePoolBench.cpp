@@ -0,0 +1,91 @@
+/**
+ * @file InferencePoolBench.cpp
+ * @brief 推理池：模拟后端上测量吞吐随副本数K的变化，以及慢副本被窃取时的吞吐
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>分发、窃取和背压检查移到test/InferencePoolTest.cpp，后端改用FakePoseBackend.h
+ * </table>
+ */
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "FakePoseBackend.h"
+#include "InferencePool.h"
+
+namespace {
+using namespace std::chrono_literals;
+
+constexpr int NET_SIZE = 640;
+constexpr int NUM_FRAMES = 240;
+
+// 第一个实例的单帧耗时为firstLatency，克隆出的副本为latency；sleep模拟GPU耗时，不占CPU，多个副本可以重叠
+std::unique_ptr<deploy::PoseModel> makeModel(const std::chrono::microseconds latency,
+                                             const std::chrono::microseconds firstLatency) {
+    auto backend = std::make_unique<hitcrt::bench::PixelCodedBackend>(1, firstLatency);
+    backend->setCloneLatency(latency);
+    return std::make_unique<deploy::PoseModel>(std::move(backend));
+}
+
+// 第一个像素为帧号对5取余，模拟后端据此给出类别（敌方蓝色，类别0-4都保留）
+cv::Mat makeImage(const int index) {
+    cv::Mat image(NET_SIZE, NET_SIZE, CV_8UC3, cv::Scalar::all(0));
+    image.data[0] = static_cast<uint8_t>(index % 5);
+    return image;
+}
+
+const hitcrt::RecvInfoBase RECV_INFO(0.0, 0.0, 0.0, 25.0, hitcrt::BLUE, true);
+
+/**
+ * @brief 连续提交NUM_FRAMES帧并等全部完成
+ * @return 吞吐，帧/秒
+ */
+double runThroughput(hitcrt::InferencePool &pool) {
+    const hitcrt::TimePoint epoch = hitcrt::Clock::now();
+    std::vector<cv::Mat> images;
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        images.push_back(makeImage(i));
+    }
+    std::vector<std::future<hitcrt::InferenceResult>> futures;
+    const auto start = hitcrt::Clock::now();
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        futures.push_back(pool.submit(hitcrt::Frame(images[i], epoch + std::chrono::microseconds(i)), RECV_INFO));
+    }
+    for (auto &future : futures) {
+        future.get();
+    }
+    return NUM_FRAMES / std::chrono::duration<double>(hitcrt::Clock::now() - start).count();
+}
+}  // namespace
+
+// 用法：inferencePoolBench
+int main() {
+    // 吞吐随副本数K的变化，模拟单帧推理5ms
+    std::printf("---- throughput vs K, mock latency 5 ms/frame, %d frames ----\n", NUM_FRAMES);
+    for (const int workers : {1, 2, 4, 8}) {
+        hitcrt::InferencePool pool(makeModel(5ms, 5ms), 0.5f, workers, NUM_FRAMES, hitcrt::DropPolicy::BLOCK);
+        const double fps = runThroughput(pool);
+        std::printf("K = %d: %7.1f fps\n", workers, fps);
+    }
+
+    // 第一个副本比其他副本慢4倍，其余副本从它的队列窃取
+    std::printf("---- work stealing, replica 0 at 20 ms, others at 5 ms ----\n");
+    hitcrt::InferencePool pool(makeModel(5ms, 20ms), 0.5f, 4, NUM_FRAMES, hitcrt::DropPolicy::BLOCK);
+    const double fps = runThroughput(pool);
+    const auto stats = pool.stats();
+    std::printf("K = 4: %7.1f fps, stolen = %llu, per worker:", fps, static_cast<unsigned long long>(stats.m_stolen));
+    for (const auto completed : stats.m_perWorker) {
+        std::printf(" %llu", static_cast<unsigned long long>(completed));
+    }
+    std::printf("\n");
+    return 0;
+}
@@ -0,0 +1,254 @@
+/**
+ * @file IngestBench.cpp
+ * @brief 图像接入：进程内发布1280x1024帧，对比cv_bridge订阅回调与TypeAdapter接入节点的回调耗时和端到端延迟
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cv_bridge/cv_bridge.h>
+#include <mutex>
+#include <sensor_msgs/image_encodings.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ImageIngest.h"
+
+namespace {
+using hitcrt::Clock;
+using hitcrt::FrameHandle;
+using hitcrt::FrameRing;
+
+constexpr int WIDTH = 1280;
+constexpr int HEIGHT = 1024;
+constexpr int FRAMES = 300;
+constexpr int WARMUP = 20;
+const std::string TOPIC = "/bench/image_raw";
+
+/**
+ * @brief 发布线程等一帧送到下游再发下一帧，只测单帧延迟
+ */
+class Delivery {
+   public:
+    void published() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done = false;
+        m_start = Clock::now();
+    }
+    // 在回调里调用，callbackUs为回调自身的耗时
+    void delivered(const FrameHandle &handle, const double callbackUs) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_latencyUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - m_start).count());
+        m_callbackUs.push_back(callbackUs);
+        // 左上角像素写的是B=1 G=2 R=3，转换后应该仍是BGR顺序
+        const uint8_t *pixel = handle.image().data;
+        m_correct = m_correct && pixel[0] == 1 && pixel[1] == 2 && pixel[2] == 3;
+        m_done = true;
+        m_cond.notify_one();
+    }
+    bool wait() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_cond.wait_for(lock, std::chrono::milliseconds(200), [this] { return m_done; });
+    }
+    void reset() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_latencyUs.clear();
+        m_callbackUs.clear();
+    }
+
+    std::vector<double> m_latencyUs;
+    std::vector<double> m_callbackUs;
+    bool m_correct = true;
+
+   private:
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_done = false;
+    Clock::time_point m_start;
+};
+
+double percentile(std::vector<double> values, const double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, static_cast<size_t>(values.size() * p))];
+}
+
+double mean(const std::vector<double> &values) {
+    double sum = 0.0;
+    for (const double value : values) {
+        sum += value;
+    }
+    return values.empty() ? 0.0 : sum / values.size();
+}
+
+// 接入节点的转换在TypeAdapter里完成，不在用户回调内，只看端到端延迟
+void report(const char *label, const Delivery &delivery, const int lost, const bool callback) {
+    if (callback) {
+        std::printf("%-34s callback mean %7.1f us, p99 %7.1f us | ", label, mean(delivery.m_callbackUs),
+                    percentile(delivery.m_callbackUs, 0.99));
+    } else {
+        std::printf("%-34s %38s | ", label, "");
+    }
+    std::printf("publish->frame slot mean %7.1f us, p99 %7.1f us | lost %d\n", mean(delivery.m_latencyUs),
+                percentile(delivery.m_latencyUs, 0.99), lost);
+}
+
+// 左上角写入BGR=1,2,3，按编码排列
+std::unique_ptr<sensor_msgs::msg::Image> makeMessage(const std::string &encoding) {
+    auto msg = std::make_unique<sensor_msgs::msg::Image>();
+    msg->width = WIDTH;
+    msg->height = HEIGHT;
+    msg->encoding = encoding;
+    msg->step = WIDTH * 3;
+    msg->data.assign(static_cast<size_t>(msg->step) * HEIGHT, 128);
+    const bool rgb = encoding == sensor_msgs::image_encodings::RGB8;
+    msg->data[0] = rgb ? 3 : 1;
+    msg->data[1] = 2;
+    msg->data[2] = rgb ? 1 : 3;
+    return msg;
+}
+
+/**
+ * @brief 原路径：订阅sensor_msgs/Image，cv_bridge::toCvCopy后再拷进槽位
+ */
+int runBridge(const bool intraProcess, const std::string &encoding, Delivery &delivery) {
+    FrameRing ring(4, WIDTH, HEIGHT, CV_8UC3);
+    const auto options = rclcpp::NodeOptions().use_intra_process_comms(intraProcess);
+    auto subNode = std::make_shared<rclcpp::Node>("ingestBenchBridgeSub", options);
+    auto pubNode = std::make_shared<rclcpp::Node>("ingestBenchBridgePub", options);
+    auto qos = rclcpp::QoS(rclcpp::KeepLast(10));
+    qos.best_effort();
+    auto subscription = subNode->create_subscription<sensor_msgs::msg::Image>(
+        TOPIC, qos, [&](const sensor_msgs::msg::Image::ConstSharedPtr &msg) {
+            const auto start = Clock::now();
+            FrameHandle handle = ring.acquire();
+            cv_bridge::toCvCopy(msg, "bgr8")->image.copyTo(handle.image());
+            handle.commit(Clock::now());
+            delivery.delivered(handle, std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        });
+    auto publisher = pubNode->create_publisher<sensor_msgs::msg::Image>(TOPIC, qos);
+
+    rclcpp::executors::SingleThreadedExecutor executor;
+    executor.add_node(subNode);
+    std::thread spinner([&executor] { executor.spin(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    int lost = 0;
+    for (int i = 0; i < WARMUP + FRAMES; ++i) {
+        if (i == WARMUP) {
+            delivery.reset();
+        }
+        auto msg = makeMessage(encoding);
+        delivery.published();
+        publisher->publish(std::move(msg));
+        lost += delivery.wait() ? 0 : 1;
+    }
+    executor.cancel();
+    spinner.join();
+    return lost;
+}
+
+/**
+ * @brief 接入节点：发布sensor_msgs/Image（经TypeAdapter转换）或借槽位发布IngestImage
+ */
+int runIngest(const bool intraProcess, const bool loan, const std::string &encoding, Delivery &delivery) {
+    FrameRing ring(4, WIDTH, HEIGHT, CV_8UC3);
+    const auto options = rclcpp::NodeOptions().use_intra_process_comms(intraProcess);
+    const std::string topic = loan ? TOPIC + "_loan" : TOPIC;
+    auto ingest = std::make_shared<hitcrt::ImageIngestNode>(
+        ring, [&](FrameHandle &&handle) { delivery.delivered(handle, 0.0); }, topic, options);
+    auto pubNode = std::make_shared<rclcpp::Node>("ingestBenchPub", options);
+    const auto qos = rclcpp::SensorDataQoS().keep_last(1);
+    auto imagePublisher = pubNode->create_publisher<sensor_msgs::msg::Image>(topic, qos);
+    auto loanPublisher = pubNode->create_publisher<hitcrt::AdaptedImage>(topic, qos);
+
+    rclcpp::executors::SingleThreadedExecutor executor;
+    executor.add_node(ingest);
+    std::thread spinner([&executor] { executor.spin(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    int lost = 0;
+    for (int i = 0; i < WARMUP + FRAMES; ++i) {
+        if (i == WARMUP) {
+            delivery.reset();
+        }
+        if (loan) {
+            // 进程内生产者直接写进借来的槽位，相当于仿真桥或回放在同一进程里
+            auto image = std::make_unique<hitcrt::IngestImage>();
+            image->m_handle = ingest->loan();
+            if (image->m_handle.empty()) {
+                ++lost;
+                continue;
+            }
+            std::memset(image->m_handle.image().data, 128, static_cast<size_t>(WIDTH) * HEIGHT * 3);
+            image->m_handle.image().data[0] = 1;
+            image->m_handle.image().data[1] = 2;
+            image->m_handle.image().data[2] = 3;
+            delivery.published();
+            loanPublisher->publish(std::move(image));
+        } else {
+            auto msg = makeMessage(encoding);
+            delivery.published();
+            imagePublisher->publish(std::move(msg));
+        }
+        lost += delivery.wait() ? 0 : 1;
+    }
+    executor.cancel();
+    spinner.join();
+    const auto stat = ingest->stat();
+    std::printf("    ingest stat: received %llu, loaned %llu, converted %llu, dropped %llu\n",
+                static_cast<unsigned long long>(std::get<0>(stat)), static_cast<unsigned long long>(std::get<1>(stat)),
+                static_cast<unsigned long long>(std::get<2>(stat)), static_cast<unsigned long long>(std::get<3>(stat)));
+    return lost;
+}
+}  // namespace
+
+// 用法：ingestBench
+// 每种路径发布300帧1280x1024，发布后等下游拿到槽位里的帧再发下一帧
+int main(int argc, char **argv) {
+    rclcpp::init(argc, argv);
+    namespace enc = sensor_msgs::image_encodings;
+    bool ok = true;
+    struct Case {
+        const char *m_label;
+        bool m_bridge;
+        bool m_intraProcess;
+        bool m_loan;
+        std::string m_encoding;
+    };
+    const std::vector<Case> cases = {
+        {"cv_bridge, DDS loopback, bgr8", true, false, false, enc::BGR8},
+        {"cv_bridge, intra-process, bgr8", true, true, false, enc::BGR8},
+        {"cv_bridge, intra-process, rgb8", true, true, false, enc::RGB8},
+        {"ingest, DDS loopback, bgr8", false, false, false, enc::BGR8},
+        {"ingest, intra-process, bgr8", false, true, false, enc::BGR8},
+        {"ingest, intra-process, rgb8", false, true, false, enc::RGB8},
+        {"ingest, intra-process, loaned slot", false, true, true, enc::BGR8},
+    };
+    for (const Case &c : cases) {
+        Delivery delivery;
+        const int lost = c.m_bridge ? runBridge(c.m_intraProcess, c.m_encoding, delivery)
+                                    : runIngest(c.m_intraProcess, c.m_loan, c.m_encoding, delivery);
+        report(c.m_label, delivery, lost, c.m_bridge);
+        // DDS回环上best effort的大消息可能丢分片，不计入检查
+        ok = ok && delivery.m_correct && (!c.m_intraProcess || lost == 0);
+    }
+    rclcpp::shutdown();
+    std::printf("ingest check: %s\n", ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file LegacyDedup.h
+ * @brief 已删除的ArmorDetectorNN::filterDuplicateByClassIOU，性能测试中作为去重的对照组，只有这一份
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#pragma once
+
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace hitcrt::bench {
+
+inline float legacyIOU(const cv::Rect &a, const cv::Rect &b) {
+    const int x1 = std::max(a.x, b.x), y1 = std::max(a.y, b.y);
+    const int x2 = std::min(a.x + a.width, b.x + b.width), y2 = std::min(a.y + a.height, b.y + b.height);
+    const int interArea = std::max(0, x2 - x1) * std::max(0, y2 - y1);
+    const int unionArea = a.area() + b.area() - interArea;
+    return unionArea <= 0 ? 0.0f : static_cast<float>(interArea) / static_cast<float>(unionArea);
+}
+
+/**
+ * @brief 按类别分组、组内按置信度排序后按外接矩形IOU抑制，每次调用都分配分组和结果
+ * @tparam ArmorT   带四个角点、m_classID和m_confidence的装甲板类型
+ */
+template <typename ArmorT>
+void legacyFilterDuplicateByClassIOU(std::vector<ArmorT> &armors, const float iouThresh) {
+    std::unordered_map<int, std::vector<ArmorT>> classToArmors;
+    for (const auto &armor : armors) {
+        classToArmors[armor.m_classID].emplace_back(armor);
+    }
+    std::vector<ArmorT> finalResult;
+    for (auto &[cls, group] : classToArmors) {
+        std::sort(group.begin(), group.end(),
+                  [](const ArmorT &a, const ArmorT &b) { return a.m_confidence > b.m_confidence; });
+        std::vector<bool> suppressed(group.size(), false);
+        for (size_t i = 0; i < group.size(); ++i) {
+            if (suppressed[i]) continue;
+            finalResult.push_back(group[i]);
+            const cv::Rect rect1 = cv::boundingRect(std::vector<cv::Point2f>{
+                group[i].m_topLeft, group[i].m_topRight, group[i].m_bottomRight, group[i].m_bottomLeft});
+            for (size_t j = i + 1; j < group.size(); ++j) {
+                if (suppressed[j]) continue;
+                const cv::Rect rect2 = cv::boundingRect(std::vector<cv::Point2f>{
+                    group[j].m_topLeft, group[j].m_topRight, group[j].m_bottomRight, group[j].m_bottomLeft});
+                if (legacyIOU(rect1, rect2) > iouThresh) {
+                    suppressed[j] = true;
+                }
+            }
+        }
+    }
+    armors.swap(finalResult);
+}
+
+}  // namespace hitcrt::bench
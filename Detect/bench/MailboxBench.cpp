@@ -0,0 +1,160 @@
+/**
+ * @file MailboxBench.cpp
+ * @brief 最新帧信箱延迟对比：ThreadSafeQueue vs LatestFrameMailbox
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>压力检查移到test/MailboxTest.cpp
+ * </table>
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "LatestFrameMailbox.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+constexpr int MAX_PRODUCERS = 4;
+
+// 原demo.cpp里的实现，作为对照组
+template <typename T>
+class ThreadSafeQueue {
+   public:
+    void push(const T &value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (queue_.size() >= max_size_) {
+            queue_.pop();
+        }
+        queue_.push(value);
+        not_empty_condition_.notify_all();
+    }
+
+    bool pop(T &value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_condition_.wait(lock, [this] { return !queue_.empty() || stopProcessing.load(); });
+        if (stopProcessing.load()) {
+            return false;
+        }
+        value = queue_.front();
+        queue_.pop();
+        return true;
+    }
+
+    void stop() {
+        stopProcessing = true;
+        not_empty_condition_.notify_all();
+    }
+
+   private:
+    std::queue<T> queue_;
+    size_t max_size_ = 1;
+    std::mutex mutex_;
+    std::condition_variable not_empty_condition_;
+    std::atomic<bool> stopProcessing{false};
+};
+
+struct Stamp {
+    uint32_t producer = 0;
+    uint64_t seq = 0;
+    Clock::time_point time;
+};
+
+double percentile(std::vector<double> &values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, static_cast<size_t>(values.size() * p))];
+}
+
+/**
+ * @brief 延迟测试：生产者按固定周期发布，消费者阻塞取帧，统计发布到取到的延迟
+ */
+template <typename Publish, typename Consume, typename Stop>
+std::vector<double> latency(const int producers, const std::chrono::microseconds period,
+                            const std::chrono::milliseconds duration, Publish publish, Consume consume, Stop stop) {
+    std::atomic<bool> running{true};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            uint64_t seq = 0;
+            auto next = Clock::now();
+            while (running.load(std::memory_order_relaxed)) {
+                next += period;
+                std::this_thread::sleep_until(next);
+                publish(p, Stamp{static_cast<uint32_t>(p), ++seq, Clock::now()});
+            }
+        });
+    }
+
+    std::vector<double> us;
+    std::thread consumer([&]() {
+        Stamp stamp;
+        while (consume(stamp)) {
+            us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - stamp.time).count());
+        }
+    });
+
+    std::this_thread::sleep_for(duration);
+    running = false;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    stop();
+    consumer.join();
+    return us;
+}
+
+void report(const char *name, const int producers, std::vector<double> us) {
+    const double p50 = percentile(us, 0.50);
+    const double p99 = percentile(us, 0.99);
+    const double max = us.empty() ? 0.0 : us.back();
+    std::printf("%-22s producers=%d received=%7zu p50 = %8.2f us, p99 = %8.2f us, max = %8.2f us\n", name,
+                producers, us.size(), p50, p99, max);
+}
+}  // namespace
+
+int main() {
+    const auto period = std::chrono::microseconds(250);
+    const auto duration = std::chrono::milliseconds(2000);
+    for (int producers = 1; producers <= MAX_PRODUCERS; ++producers) {
+        ThreadSafeQueue<Stamp> queue;
+        report("ThreadSafeQueue", producers,
+               latency(
+                   producers, period, duration, [&](int, const Stamp &stamp) { queue.push(stamp); },
+                   [&](Stamp &stamp) { return queue.pop(stamp); }, [&]() { queue.stop(); }));
+
+        hitcrt::LatestFrameMailbox<Stamp, MAX_PRODUCERS> mailbox;
+        std::vector<decltype(mailbox.producer())> handles;
+        for (int p = 1; p < producers; ++p) {
+            handles.emplace_back(mailbox.producer());
+        }
+        report("LatestFrameMailbox", producers,
+               latency(
+                   producers, period, duration,
+                   [&](int p, const Stamp &stamp) {
+                       if (p == 0) {
+                           mailbox.publish(stamp);
+                       } else {
+                           handles[p - 1].publish(stamp);
+                       }
+                   },
+                   [&](Stamp &stamp) { return mailbox.consume(stamp); }, [&]() { mailbox.stop(); }));
+        std::printf("%-22s overwritten=%lu\n", "", (unsigned long)mailbox.overwritten());
+    }
+    return 0;
+}
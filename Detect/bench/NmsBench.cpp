@@ -0,0 +1,107 @@
+/**
+ * @file NmsBench.cpp
+ * @brief 装甲板去重：原filterDuplicateByClassIOU与ArmorNMS（外接矩形/四边形）在10/50/200个候选下的耗时与堆分配
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>原去重算法改用LegacyDedup.h
+ * </table>
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ArmorNMS.h"
+#include "BenchUtil.h"
+#include "LegacyDedup.h"
+
+namespace {
+constexpr int ITERATIONS = 2000;
+constexpr float IOU_THRESH = 0.5f;
+
+std::atomic<long> g_allocations{0};  // 全局operator new调用次数
+
+/**
+ * @brief 生成候选：若干个真实目标，每个周围有抖动和轻微旋转的重复框，类别集中在少数几类
+ */
+std::vector<hitcrt::ArmorObservation> makeCandidates(const int num, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> position(0.0f, 1200.0f), jitter(-3.0f, 3.0f), angle(-0.3f, 0.3f),
+        score(0.3f, 1.0f);
+    std::vector<hitcrt::ArmorObservation> armors(num);
+    const int targets = std::max(1, num / 4);
+    std::vector<cv::Point2f> centers(targets);
+    for (auto &center : centers) {
+        center = cv::Point2f(position(rng), position(rng) * 0.8f);
+    }
+    for (int i = 0; i < num; ++i) {
+        const int target = i % targets;
+        const cv::Point2f c = centers[target] + cv::Point2f(jitter(rng), jitter(rng));
+        const float theta = angle(rng), w = 30.0f, h = 12.0f;
+        const cv::Point2f u(std::cos(theta) * w * 0.5f, std::sin(theta) * w * 0.5f);
+        const cv::Point2f v(-std::sin(theta) * h * 0.5f, std::cos(theta) * h * 0.5f);
+        armors[i].m_topLeft = c - u - v;
+        armors[i].m_topRight = c + u - v;
+        armors[i].m_bottomRight = c + u + v;
+        armors[i].m_bottomLeft = c - u + v;
+        armors[i].m_classID = target % 6;
+        armors[i].m_confidence = score(rng);
+    }
+    return armors;
+}
+
+void runCase(const std::string &name, const std::vector<hitcrt::ArmorObservation> &candidates,
+             const std::function<void(std::vector<hitcrt::ArmorObservation> &)> &filter) {
+    std::vector<hitcrt::ArmorObservation> armors;
+    armors.reserve(candidates.size());
+    auto once = [&] {
+        armors.assign(candidates.begin(), candidates.end());
+        filter(armors);
+    };
+    once();
+    const long before = g_allocations.load();
+    once();
+    const long allocations = g_allocations.load() - before;
+    std::printf("%-28s kept = %3zu, allocations/call = %ld\n", name.c_str(), armors.size(), allocations);
+    hitcrt::bench::print(hitcrt::bench::run(name, ITERATIONS, once));
+}
+}  // namespace
+
+void *operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+// 用法：nmsBench
+int main() {
+    std::mt19937 rng(2026);
+    hitcrt::ArmorNMS aabb(hitcrt::NMSMode::AABB, IOU_THRESH);
+    hitcrt::ArmorNMS polygon(hitcrt::NMSMode::POLYGON, IOU_THRESH);
+
+    for (const int num : {10, 50, 200}) {
+        const auto candidates = makeCandidates(num, rng);
+        std::printf("---- %d candidates ----\n", num);
+        runCase("legacy unordered_map " + std::to_string(num), candidates,
+                [](auto &armors) { hitcrt::bench::legacyFilterDuplicateByClassIOU(armors, IOU_THRESH); });
+        runCase("ArmorNMS AABB " + std::to_string(num), candidates, [&](auto &armors) { aabb.apply(armors); });
+        runCase("ArmorNMS POLYGON " + std::to_string(num), candidates, [&](auto &armors) { polygon.apply(armors); });
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file PipelineBench.cpp
+ * @brief 串行执行 vs 多级流水线的持续帧率对比，各级耗时用sleep模拟
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "StagePipeline.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// 模拟各级耗时（ms）：推理、后处理、画图、显示
+constexpr double STAGE_MS[] = {6.0, 1.5, 1.0, 3.0};
+constexpr int NUM_STAGES = sizeof(STAGE_MS) / sizeof(STAGE_MS[0]);
+// 模拟相机帧间隔（ms），比最慢的一级快，保证流水线始终有输入
+constexpr double FRAME_MS = 4.0;
+
+struct Task {
+    uint64_t seq = 0;
+    Clock::time_point ingest;
+};
+
+void work(const double ms) { std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(ms)); }
+
+double serial(const std::chrono::milliseconds duration) {
+    uint64_t frames = 0;
+    const auto start = Clock::now();
+    while (Clock::now() - start < duration) {
+        for (const double ms : STAGE_MS) {
+            work(ms);
+        }
+        ++frames;
+    }
+    return frames / std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double pipelined(const std::chrono::milliseconds duration, double &latencyMs) {
+    std::atomic<uint64_t> frames{0};
+    double totalMs = 0.0;
+    hitcrt::StagePipeline<Task> pipeline;
+    for (int i = 0; i < NUM_STAGES; ++i) {
+        const bool last = i + 1 == NUM_STAGES;
+        pipeline.addStage("stage" + std::to_string(i), [&, i, last](Task &task) {
+            work(STAGE_MS[i]);
+            if (last) {
+                totalMs += std::chrono::duration<double, std::milli>(Clock::now() - task.ingest).count();
+                frames.fetch_add(1, std::memory_order_relaxed);
+            }
+            return true;
+        });
+    }
+    pipeline.start();
+
+    uint64_t seq = 0;
+    const auto start = Clock::now();
+    auto next = start;
+    while (Clock::now() - start < duration) {
+        next += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(FRAME_MS));
+        std::this_thread::sleep_until(next);
+        pipeline.submit(Task{++seq, Clock::now()});
+    }
+    const double fps = frames.load() / std::chrono::duration<double>(Clock::now() - start).count();
+    pipeline.stop();
+
+    latencyMs = frames.load() > 0 ? totalMs / frames.load() : 0.0;
+    for (const auto &stats : pipeline.stats()) {
+        std::printf("  %-8s processed = %6lu, dropped = %6lu, forward dropped = %6lu, mean = %6.2f ms, p99 = %6.2f ms, "
+                    "max = %6.2f ms\n",
+                    stats.name.c_str(), (unsigned long)stats.processed, (unsigned long)stats.dropped,
+                    (unsigned long)stats.forwardDropped,
+                    stats.meanMs, stats.p99Ms, stats.maxMs);
+    }
+    return fps;
+}
+}  // namespace
+
+int main() {
+    double sum = 0.0, slowest = 0.0;
+    for (const double ms : STAGE_MS) {
+        sum += ms;
+        slowest = std::max(slowest, ms);
+    }
+    const auto duration = std::chrono::milliseconds(3000);
+
+    std::printf("stage sum = %.2f ms (%.1f fps), slowest stage = %.2f ms (%.1f fps)\n", sum, 1000.0 / sum,
+                slowest, 1000.0 / slowest);
+    std::printf("serial     fps = %6.1f\n", serial(duration));
+    double latencyMs = 0.0;
+    const double fps = pipelined(duration, latencyMs);
+    std::printf("pipelined  fps = %6.1f, ingest->display latency = %.2f ms\n", fps, latencyMs);
+    return 0;
+}
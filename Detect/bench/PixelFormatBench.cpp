@@ -0,0 +1,83 @@
+/**
+ * @file PixelFormatBench.cpp
+ * @brief 输入布局描述：RGBA倒序行直接进letterbox核与先翻转再转换的耗时对比
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>各布局的一致性检查移到test/PixelFormatTest.cpp
+ * </table>
+ */
+#include <algorithm>
+#include <cstdint>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <random>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "PixelLayout.h"
+#include "infer/affine.hpp"
+#include "infer/cpu_warpaffine.hpp"
+
+namespace {
+using deploy::PixelFormat;
+
+constexpr int SRC_WIDTH = 1280;
+constexpr int SRC_HEIGHT = 1024;
+constexpr int DST_SIZE = 640;
+constexpr int ITERATIONS = 200;
+}  // namespace
+
+// 用法：pixelFormatBench
+// 在1280x1024 RGBA倒序图像->640x640上对比单线程耗时
+int main() {
+    cv::setNumThreads(1);
+    std::mt19937 rng(3);
+    std::vector<uint8_t> bgr(static_cast<size_t>(SRC_WIDTH) * SRC_HEIGHT * 3);
+    std::generate(bgr.begin(), bgr.end(), [&rng] { return static_cast<uint8_t>(rng()); });
+    // Unity读回的ARGB32 RenderTexture：RGBA，自下而上
+    std::vector<uint8_t> rgba =
+        hitcrt::bench::layout(bgr, SRC_WIDTH, SRC_HEIGHT, PixelFormat::RGBA, SRC_WIDTH * 4, true, rng);
+    const deploy::Image image(rgba.data(), SRC_WIDTH, SRC_HEIGHT, PixelFormat::RGBA, 0, true);
+
+    deploy::AffineTransform transform;
+    transform.updateMatrix(SRC_WIDTH, SRC_HEIGHT, DST_SIZE, DST_SIZE);
+    deploy::ProcessConfig config;
+    config.enableSwapRB();
+    std::vector<float> blob(static_cast<size_t>(3) * DST_SIZE * DST_SIZE);
+
+    // 改造前：翻转、cv_bridge转bgr8，再letterbox时交换回RGB
+    cv::Mat source(SRC_HEIGHT, SRC_WIDTH, CV_8UC4, rgba.data());
+    cv::Mat flipped, converted;
+    hitcrt::bench::print(hitcrt::bench::run("flip + cvtColor + fused letterbox", ITERATIONS, [&] {
+        cv::flip(source, flipped, 0);
+        cv::cvtColor(flipped, converted, cv::COLOR_RGBA2BGR);
+        deploy::cpuWarpAffine(converted.data, SRC_WIDTH, SRC_HEIGHT, blob.data(), DST_SIZE, DST_SIZE,
+                              transform.matrix, config);
+    }));
+    // TensorRT后端：拷进暂存缓冲区时整理成BGR，GPU核函数再读一次
+    std::vector<uint8_t> packed(bgr.size());
+    hitcrt::bench::print(hitcrt::bench::run("cpuPackBgr + fused letterbox", ITERATIONS, [&] {
+        deploy::cpuPackBgr(image, packed.data());
+        deploy::cpuWarpAffine(packed.data(), SRC_WIDTH, SRC_HEIGHT, blob.data(), DST_SIZE, DST_SIZE,
+                              transform.matrix, config);
+    }));
+    hitcrt::bench::print(hitcrt::bench::run("cpuPackBgr only", ITERATIONS, [&] {
+        deploy::cpuPackBgr(image, packed.data());
+    }));
+    // CPU后端：直接读RGBA倒序缓冲区
+    hitcrt::bench::print(hitcrt::bench::run("fused letterbox on RGBA flipped", ITERATIONS, [&] {
+        deploy::cpuWarpAffine(image, blob.data(), DST_SIZE, DST_SIZE, transform.matrix, config);
+    }));
+    hitcrt::bench::print(hitcrt::bench::run("fused letterbox on packed BGR", ITERATIONS, [&] {
+        deploy::cpuWarpAffine(bgr.data(), SRC_WIDTH, SRC_HEIGHT, blob.data(), DST_SIZE, DST_SIZE, transform.matrix,
+                              config);
+    }));
+    return 0;
+}
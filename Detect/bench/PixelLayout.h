@@ -0,0 +1,48 @@
+/**
+ * @file PixelLayout.h
+ * @brief 按像素格式、行步长和行序重排测试图像，性能测试和单元测试共用
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "result.hpp"
+
+namespace hitcrt::bench {
+
+/**
+ * @brief 把行间无填充的BGR图像按格式、行步长和行序写成另一块缓冲区，A通道和行间填充填随机值
+ */
+inline std::vector<uint8_t> layout(const std::vector<uint8_t> &bgr, const int cols, const int rows,
+                                   const deploy::PixelFormat format, const int stride, const bool flip,
+                                   std::mt19937 &rng) {
+    const int channels = deploy::pixelBytes(format);
+    const bool rgb = deploy::isRgbOrder(format);
+    std::vector<uint8_t> buffer(static_cast<size_t>(stride) * rows);
+    std::generate(buffer.begin(), buffer.end(), [&rng] { return static_cast<uint8_t>(rng()); });
+    for (int y = 0; y < rows; ++y) {
+        uint8_t *row = &buffer[static_cast<size_t>(flip ? rows - 1 - y : y) * stride];
+        for (int x = 0; x < cols; ++x) {
+            const uint8_t *pixel = &bgr[(static_cast<size_t>(y) * cols + x) * 3];
+            row[x * channels] = pixel[rgb ? 2 : 0];
+            row[x * channels + 1] = pixel[1];
+            row[x * channels + 2] = pixel[rgb ? 0 : 2];
+        }
+    }
+    return buffer;
+}
+
+}  // namespace hitcrt::bench
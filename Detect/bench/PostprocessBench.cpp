@@ -0,0 +1,47 @@
+/**
+ * @file PostprocessBench.cpp
+ * @brief PoseModel后处理：嵌套vector的PoseRes与原地写入的PoseResView的耗时对比
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>零分配和结果一致性检查移到test/PostprocessTest.cpp，后端改用FakePoseBackend.h
+ * </table>
+ */
+#include <cstdio>
+#include <memory>
+
+#include "BenchUtil.h"
+#include "FakePoseBackend.h"
+#include "model.hpp"
+
+namespace {
+constexpr int ITERATIONS = 10000;
+constexpr int NUM_DETECTIONS = 12;
+constexpr int MAX_DETECTIONS = 100;
+}  // namespace
+
+// 用法：postprocessBench
+int main() {
+    auto backend = std::make_unique<hitcrt::bench::FakePoseBackend>(1, MAX_DETECTIONS);
+    for (int i = 0; i < NUM_DETECTIONS; ++i) {
+        const float x = 40.0f * i, y = 20.0f * i;
+        backend->setDetection(0, i, i % 18, 0.9f - 0.01f * i, x, y, x + 30.0f, y + 15.0f);
+    }
+    backend->setNum(0, NUM_DETECTIONS);
+    deploy::PoseModel model(std::move(backend));
+    static unsigned char pixels[1024 * 1280 * 3];
+    const deploy::Image image(pixels, 1280, 1024);
+
+    std::printf("%d detections, %d keypoints each\n", NUM_DETECTIONS, hitcrt::bench::FakePoseBackend::NUM_KEYPOINTS);
+    deploy::PoseResView view;
+    deploy::PoseRes legacy;
+    hitcrt::bench::print(hitcrt::bench::run("predict -> PoseRes", ITERATIONS, [&] { legacy = model.predict(image); }));
+    hitcrt::bench::print(hitcrt::bench::run("predict -> PoseResView", ITERATIONS, [&] { model.predict(image, view); }));
+    return 0;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file RecordBench.cpp
+ * @brief 帧录制格式：持续写入的帧率、丢帧和record()调用耗时
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>回读和恢复检查移到test/RecordTest.cpp
+ * </table>
+ */
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "FrameRecord.h"
+
+namespace {
+using hitcrt::Clock;
+using hitcrt::FrameHandle;
+using hitcrt::FrameRecorder;
+using hitcrt::FrameRing;
+
+constexpr int WIDTH = 1280;
+constexpr int HEIGHT = 1024;
+
+// 每帧像素开头和结尾写入序号，让每帧都有实际写入的像素
+void stamp(cv::Mat &image, const uint64_t seq) {
+    const size_t bytes = image.total() * image.elemSize();
+    std::memcpy(image.data, &seq, sizeof(seq));
+    std::memcpy(image.data + bytes - sizeof(seq), &seq, sizeof(seq));
+}
+
+float pitchOf(const uint64_t seq) { return static_cast<float>(seq % 1000) * 0.01f; }
+
+/**
+ * @brief 持续写入结果
+ */
+struct SustainStat {
+    uint64_t m_offered = 0;
+    uint64_t m_recorded = 0;
+    uint64_t m_dropped = 0;
+    double m_seconds = 0.0;
+    double m_maxCallUs = 0.0;
+    size_t m_maxQueued = 0;
+    size_t m_stride = 0;
+};
+
+/**
+ * @brief 模拟相机按fps出帧，handle为true时走句柄零拷贝，否则走Frame拷贝
+ * @param[in] fps   出帧率，0为不等待
+ */
+SustainStat sustain(const std::string &path, const int type, const double fps, const double seconds,
+                    const bool handle) {
+    SustainStat stat;
+    FrameRing source(32, WIDTH, HEIGHT, type);
+    FrameRecorder recorder(path, WIDTH, HEIGHT, type);
+    const auto period =
+        std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(fps > 0 ? 1.0 / fps : 0.0));
+    const auto start = Clock::now();
+    auto next = start;
+    while (Clock::now() - start < std::chrono::duration<double>(seconds)) {
+        if (fps > 0) {
+            next += period;
+            std::this_thread::sleep_until(next);
+        } else {
+            // 不限帧率时按写线程的速度喂，测的是磁盘能持续写入的上限
+            while (stat.m_offered - recorder.recorded() >= 8) {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+        FrameHandle frame = source.acquire();
+        if (frame.empty()) {
+            // 句柄还被写线程持有，等同于相机侧丢帧
+            ++stat.m_offered;
+            continue;
+        }
+        const auto now = Clock::now();
+        frame.commit(now, 0, now);
+        // 句柄路径的序号由帧环形缓冲区在commit时分配
+        const uint64_t seq = handle ? frame.seq() : stat.m_offered;
+        stamp(frame.image(), seq);
+        const hitcrt::RecvInfoBase recvInfo(pitchOf(seq), -pitchOf(seq), 0.0f, 15.0f, hitcrt::RED, true);
+        const auto call = Clock::now();
+        if (handle) {
+            recorder.record(frame, &recvInfo, 3000.0f);
+        } else {
+            recorder.record(hitcrt::Frame(frame.image(), frame.timeStamp()), seq, &recvInfo, 3000.0f);
+        }
+        stat.m_maxCallUs =
+            std::max(stat.m_maxCallUs, std::chrono::duration<double, std::micro>(Clock::now() - call).count());
+        ++stat.m_offered;
+    }
+    recorder.close();
+    stat.m_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    stat.m_recorded = recorder.recorded();
+    stat.m_dropped = stat.m_offered - stat.m_recorded;
+    stat.m_maxQueued = recorder.maxQueued();
+    stat.m_stride = recorder.stride();
+    return stat;
+}
+
+void print(const char *label, const SustainStat &stat) {
+    std::printf("%-36s offered %6llu, recorded %6llu, dropped %5llu | %7.1f fps, %7.1f MB/s | record() max %7.1f us, "
+                "max queued %zu\n",
+                label, static_cast<unsigned long long>(stat.m_offered),
+                static_cast<unsigned long long>(stat.m_recorded), static_cast<unsigned long long>(stat.m_dropped),
+                stat.m_recorded / stat.m_seconds, stat.m_recorded * stat.m_stride / stat.m_seconds / 1e6,
+                stat.m_maxCallUs, stat.m_maxQueued);
+}
+
+}  // namespace
+
+// 用法：recordBench [目录] [每项秒数]
+// 目录默认/tmp，应放在实际录制用的盘上；结果取决于磁盘
+int main(int argc, char **argv) {
+    const std::string dir = argc > 1 ? argv[1] : "/tmp";
+    const double seconds = argc > 2 ? std::atof(argv[2]) : 3.0;
+    const std::string path = dir + "/recordBench.hrec";
+
+    print("BGR 1280x1024 @120fps, handle", sustain(path, CV_8UC3, 120.0, seconds, true));
+    print("Bayer 1280x1024 @200fps, copy", sustain(path, CV_8UC1, 200.0, seconds, false));
+    print("BGR 1280x1024 unpaced, handle", sustain(path, CV_8UC3, 0.0, seconds, true));
+
+    ::unlink(path.c_str());
+    return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file ReplayBench.cpp
+ * @brief 回放相机：合成图片目录，统计各回放节奏的实际帧率、滞后和预加载占用
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>出帧顺序、时间戳节奏、取图模式和预加载检查移到test/ReplayTest.cpp
+ * </table>
+ */
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <opencv2/imgcodecs.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ReplayCam.h"
+
+namespace {
+using hitcrt::camera::Clock;
+using hitcrt::camera::Mode;
+using hitcrt::camera::ReplayCamera;
+using hitcrt::camera::ReplayPace;
+using hitcrt::camera::ReplayParams;
+using hitcrt::camera::TimePoint;
+
+constexpr int NUM_FRAMES = 60;
+constexpr int WIDTH = 64;
+constexpr int HEIGHT = 48;
+// 录制间隔交替4ms/8ms，一遍约360ms
+constexpr int64_t SHORT_NS = 4000000;
+constexpr int64_t LONG_NS = 8000000;
+
+double msOf(const Clock::duration& duration) { return std::chrono::duration<double, std::milli>(duration).count(); }
+
+/**
+ * @brief 写NUM_FRAMES张图和timestamps.txt，每张图第一个字节为序号
+ * @return std::string 目录，失败为空
+ */
+std::string makeDirectory() {
+    char dir[] = "/tmp/replayBenchXXXXXX";
+    if (mkdtemp(dir) == nullptr) {
+        return "";
+    }
+    std::ofstream stamps(std::string(dir) + "/timestamps.txt");
+    int64_t stamp = 1700000000000000000LL;
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        cv::Mat image(HEIGHT, WIDTH, CV_8UC3, cv::Scalar::all(0));
+        image.data[0] = static_cast<uint8_t>(i);
+        char name[32];
+        std::snprintf(name, sizeof(name), "/%04d.png", i);
+        cv::imwrite(std::string(dir) + name, image);
+        stamps << stamp << "\n";
+        stamp += i % 2 == 0 ? SHORT_NS : LONG_NS;
+    }
+    return dir;
+}
+
+void removeDirectory(const std::string& dir) {
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "/%04d.png", i);
+        unlink((dir + name).c_str());
+    }
+    unlink((dir + "/timestamps.txt").c_str());
+    rmdir(dir.c_str());
+}
+
+/**
+ * @brief 回调收到的帧
+ */
+struct Record {
+    int m_index;
+    TimePoint m_stamp;
+    TimePoint m_arrive;
+};
+
+/**
+ * @brief STREAM模式回放，返回回调记录
+ */
+std::vector<Record> stream(const std::string& dir, const ReplayPace pace, const int loops, ReplayCamera::ReplayStat& stat,
+                           const double fps = 100.0) {
+    std::vector<Record> records;
+    records.reserve(NUM_FRAMES * loops);
+    auto onCall = [&records](const TimePoint& stamp, const cv::Mat& image) {
+        records.push_back(Record{image.data[0], stamp, Clock::now()});
+    };
+    ReplayCamera camera(ReplayParams(onCall, dir, Mode::STREAM, pace, fps, loops));
+    camera.waitFinished(10000);
+    stat = camera.stat();
+    return records;
+}
+
+void benchRecorded(const std::string& dir) {
+    ReplayCamera::ReplayStat stat;
+    const std::vector<Record> records = stream(dir, ReplayPace::RECORDED, 2, stat);
+    double maxLagMs = 0.0;
+    for (const Record& record : records) {
+        maxLagMs = std::max(maxLagMs, msOf(record.m_arrive - record.m_stamp));
+    }
+    std::printf("recorded pace: %zu frames in %.1f ms, late %llu, max lag behind schedule %.2f ms\n", records.size(),
+                records.empty() ? 0.0 : msOf(records.back().m_arrive - records.front().m_arrive),
+                static_cast<unsigned long long>(std::get<1>(stat)), maxLagMs);
+}
+
+void benchFixedFps(const std::string& dir) {
+    ReplayCamera::ReplayStat stat;
+    const std::vector<Record> records = stream(dir, ReplayPace::FIXED_FPS, 1, stat, 200.0);
+    std::printf("fixed 200 fps: %zu frames, measured %.1f fps\n", records.size(), std::get<2>(stat));
+}
+
+void benchAsFast(const std::string& dir) {
+    ReplayCamera::ReplayStat stat;
+    const std::vector<Record> records = stream(dir, ReplayPace::AS_FAST, 200, stat);
+    std::printf("as fast: %zu frames at %.0f fps\n", records.size(), std::get<2>(stat));
+}
+
+void benchLatest(const std::string& dir) {
+    // 下游每帧耗时12ms，比录制间隔慢，统计实际取到的帧数
+    ReplayCamera camera(
+        ReplayParams(ReplayParams::noUse, dir, Mode::STREAM_MULTITHREAD, ReplayPace::RECORDED, 100.0, 1));
+    int taken = 0;
+    while (true) {
+        auto frame = camera.getFrameImage(50);
+        if (!std::get<0>(frame)) {
+            if (camera.finished()) {
+                break;
+            }
+            continue;
+        }
+        ++taken;
+        std::this_thread::sleep_for(std::chrono::milliseconds(12));
+    }
+    std::printf("multithread recorded pace, slow consumer: took %d of %d frames\n", taken, NUM_FRAMES);
+}
+
+void benchPreload(const std::string& dir) {
+    ReplayCamera camera(ReplayParams(ReplayParams::noUse, dir, Mode::SOFT, ReplayPace::AS_FAST, 100.0, 1));
+    std::printf("preload: %zu frames, %zu bytes in memory\n", camera.frameCount(), camera.loadedBytes());
+}
+}  // namespace
+
+// 用法：replayBench
+// 合成60张带序号的图和交替4ms/8ms的录制时刻，统计各回放节奏的实际帧率和滞后，正确性检查在test/ReplayTest.cpp
+int main() {
+    const std::string dir = makeDirectory();
+    if (dir.empty()) {
+        std::printf("replay bench: cannot create directory\n");
+        return 1;
+    }
+    benchRecorded(dir);
+    benchFixedFps(dir);
+    benchAsFast(dir);
+    benchLatest(dir);
+    benchPreload(dir);
+    removeDirectory(dir);
+    return 0;
+}
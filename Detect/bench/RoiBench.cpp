@@ -0,0 +1,249 @@
+/**
+ * @file RoiBench.cpp
+ * @brief ROI推理：合成序列或录制文件上对比全图推理与窗口推理的单帧耗时、上传字节数和小目标召回率
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>支持用真实模型回放FrameRecorder的录制文件，模拟后端改用FakePoseBackend.h
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>合成场景移到RoiScene.h，窗口和坐标映射检查移到test/RoiTest.cpp
+ * </table>
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ArmorDetectorNN.h"
+#include "FrameRecord.h"
+#include "RoiScene.h"
+#include "RoiScheduler.h"
+#include "utils/histogram.hpp"
+
+namespace {
+using hitcrt::bench::Scene;
+using hitcrt::bench::SceneBackend;
+using hitcrt::bench::Target;
+using hitcrt::bench::Truth;
+
+constexpr int IMAGE_WIDTH = hitcrt::bench::SCENE_WIDTH;
+constexpr int IMAGE_HEIGHT = hitcrt::bench::SCENE_HEIGHT;
+constexpr int FRAMES = 1200;
+constexpr float SMALL_HEIGHT = 12.0f;  // 原图中高度低于此值的目标算小目标：全图缩小一半后低于MIN_NET_HEIGHT
+constexpr double PI = 3.14159265358979323846;
+
+/**
+ * @brief 合成的回放序列，100fps，固定参数生成，每次运行相同
+ * @param[in] name  "receding"：一个目标远离再靠近，高度30到7像素；
+ *                  "pair"：再加一个高度20像素的目标在旁边；
+ *                  "gap"：目标在中途离开视野60帧后从另一处出现
+ */
+std::vector<Truth> makeSequence(const std::string &name) {
+    std::vector<Truth> sequence(FRAMES);
+    for (int i = 0; i < FRAMES; ++i) {
+        const double t = static_cast<double>(i) / FRAMES;
+        const float height = static_cast<float>(7.0 + 23.0 * (0.5 + 0.5 * std::cos(4.0 * PI * t)));
+        const float x = static_cast<float>(640.0 + 320.0 * std::sin(2.0 * PI * t));
+        const float y = static_cast<float>(512.0 + 200.0 * std::sin(6.0 * PI * t));
+        if (name == "gap") {
+            if (i < 500) {
+                sequence[i].push_back({x, y, 18.0f});
+            } else if (i >= 560) {
+                sequence[i].push_back({1280.0f - x, 1024.0f - y, 18.0f});
+            }
+            continue;
+        }
+        sequence[i].push_back({x, y, height});
+        if (name == "pair") {
+            sequence[i].push_back({x + 160.0f, y + 50.0f, 20.0f});
+        }
+    }
+    return sequence;
+}
+
+struct ReplayResult {
+    int m_truths = 0;
+    int m_found = 0;
+    int m_smallTruths = 0;
+    int m_smallFound = 0;
+    double m_maxError = 0.0;  // 检测到的角点与真值的最大偏差，像素
+    int m_recovery = -1;      // "gap"序列目标重新出现后第几帧重新检测到
+    deploy::LatencyHistogram m_latency;
+    uint64_t m_inputBytes = 0;
+    hitcrt::RoiStats m_roi;
+};
+
+ReplayResult replay(const std::vector<Truth> &sequence, const hitcrt::RoiConfig &config) {
+    Scene scene;
+    const cv::Mat image(IMAGE_HEIGHT, IMAGE_WIDTH, CV_8UC3, cv::Scalar(40, 40, 40));
+    scene.m_base = image.data;
+    scene.m_stride = static_cast<int>(image.step[0]);
+    hitcrt::ArmorDetectorNN detector(std::make_unique<deploy::PoseModel>(std::make_unique<SceneBackend>(&scene)), 0.5f);
+    detector.setRoiConfig(config);
+    const hitcrt::RecvInfoBase recvInfo(0.0, 0.0, 0.0, 25.0, hitcrt::BLUE, true);  // 敌方蓝色，类别0-8
+
+    ReplayResult result;
+    std::vector<hitcrt::Armor> armors;
+    for (int i = 0; i < static_cast<int>(sequence.size()); ++i) {
+        scene.m_truth = &sequence[i];
+        const auto start = std::chrono::steady_clock::now();
+        detector.apply(hitcrt::Frame(image, start), recvInfo, hitcrt::ROI(), armors);
+        result.m_latency.record(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+        for (const Target &target : sequence[i]) {
+            const bool small = target.m_height < SMALL_HEIGHT;
+            ++result.m_truths;
+            result.m_smallTruths += small;
+            for (const auto &armor : armors) {
+                const double error = std::max(std::fabs(armor.m_topLeft.x - (target.m_x - target.width() * 0.5f)),
+                                              std::fabs(armor.m_bottomRight.y - (target.m_y + target.m_height * 0.5f)));
+                if (error < 2.0) {
+                    ++result.m_found;
+                    result.m_smallFound += small;
+                    result.m_maxError = std::max(result.m_maxError, error);
+                    if (i >= 560 && result.m_recovery < 0) {
+                        result.m_recovery = i - 560;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+    result.m_inputBytes = scene.m_inputBytes;
+    result.m_roi = detector.roiScheduler().stats();
+    return result;
+}
+
+void print(const std::string &label, const ReplayResult &result) {
+    const uint64_t frames = result.m_latency.count();
+    std::printf("  %-16s recall %5.1f%%, small-target recall %5.1f%%, latency mean %.3f ms p99 %.3f ms, "
+                "upload %.2f MB/frame, roi frames %5.1f%%, lost %llu, max corner error %.3f px\n",
+                label.c_str(), 100.0 * result.m_found / std::max(result.m_truths, 1),
+                100.0 * result.m_smallFound / std::max(result.m_smallTruths, 1), result.m_latency.mean(),
+                result.m_latency.percentile(99), result.m_inputBytes / 1e6 / std::max<uint64_t>(frames, 1),
+                100.0 * result.m_roi.m_roiFrames / std::max<uint64_t>(frames, 1),
+                static_cast<unsigned long long>(result.m_roi.m_lost), result.m_maxError);
+}
+/**
+ * @brief 录制回放一遍的结果，没有真值，以全图推理的检测为参照
+ */
+struct RecordResult {
+    std::vector<std::vector<hitcrt::Armor>> m_armors;  // 每帧的检测结果
+    deploy::LatencyHistogram m_latency;
+    uint64_t m_inputBytes = 0;
+    uint64_t m_roiFrames = 0;
+};
+
+/**
+ * @brief 用真实模型逐帧回放录制文件，帧直接指向映射内存，云台角度取自录制的元数据
+ */
+RecordResult replayRecording(const hitcrt::FrameRecordReader &reader, hitcrt::ArmorDetectorNN &detector,
+                             const hitcrt::Color enemy, const hitcrt::RoiConfig &config) {
+    detector.setRoiConfig(config);
+    RecordResult result;
+    result.m_armors.resize(reader.count());
+    for (size_t i = 0; i < reader.count(); ++i) {
+        const hitcrt::RecordMeta &meta = reader.meta(i);
+        const hitcrt::RecvInfoBase recvInfo(meta.m_pitch, meta.m_yaw, meta.m_roll, 25.0f, enemy, true);
+        const hitcrt::Frame frame = reader.frame(i);
+        reader.prefetch(i + 1);
+        const auto start = std::chrono::steady_clock::now();
+        detector.apply(frame, recvInfo, hitcrt::ROI(), result.m_armors[i]);
+        result.m_latency.record(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
+        const hitcrt::RoiScheduler &scheduler = detector.roiScheduler();
+        result.m_inputBytes += static_cast<uint64_t>(scheduler.lastWindow().area()) * frame.image().elemSize();
+        result.m_roiFrames += !scheduler.fullFrame();
+    }
+    return result;
+}
+
+// 两个检测的四个角点最大偏差，像素
+double cornerError(const hitcrt::Armor &lhs, const hitcrt::Armor &rhs) {
+    const auto distance = [](const cv::Point2f &p, const cv::Point2f &q) { return cv::norm(p - q); };
+    return std::max({distance(lhs.m_topLeft, rhs.m_topLeft), distance(lhs.m_topRight, rhs.m_topRight),
+                     distance(lhs.m_bottomRight, rhs.m_bottomRight), distance(lhs.m_bottomLeft, rhs.m_bottomLeft)});
+}
+
+/**
+ * @brief 与全图推理逐帧对照：角点偏差在装甲板高度的1/4以内算同一目标，
+ *        窗口推理多出来的多为全图缩小后检测不到的小目标
+ */
+void printRecording(const std::string &label, const RecordResult &result, const RecordResult &baseline) {
+    uint64_t reference = 0, matched = 0, extra = 0;
+    double errorSum = 0.0;
+    for (size_t i = 0; i < result.m_armors.size(); ++i) {
+        const auto &armors = result.m_armors[i];
+        std::vector<bool> used(armors.size(), false);
+        for (const auto &truth : baseline.m_armors[i]) {
+            ++reference;
+            const double tolerance = std::max(2.0, 0.25 * cv::norm(truth.m_topLeft - truth.m_bottomLeft));
+            for (size_t j = 0; j < armors.size(); ++j) {
+                const double error = cornerError(truth, armors[j]);
+                if (!used[j] && error < tolerance) {
+                    used[j] = true;
+                    ++matched;
+                    errorSum += error;
+                    break;
+                }
+            }
+        }
+        extra += std::count(used.begin(), used.end(), false);
+    }
+    const uint64_t frames = std::max<uint64_t>(result.m_armors.size(), 1);
+    std::printf("  %-16s latency mean %.3f ms p99 %.3f ms, upload %.2f MB/frame, roi frames %5.1f%% | "
+                "found %5.1f%% of full-frame armors, corner error mean %.2f px, extra %llu\n",
+                label.c_str(), result.m_latency.mean(), result.m_latency.percentile(99),
+                result.m_inputBytes / 1e6 / frames, 100.0 * result.m_roiFrames / frames,
+                100.0 * matched / std::max<uint64_t>(reference, 1), errorSum / std::max<uint64_t>(matched, 1),
+                static_cast<unsigned long long>(extra));
+}
+}  // namespace
+
+// 用法：roiBench [录制文件 模型文件 [敌方颜色red|blue]]
+// 不带参数时在合成序列上回放，每个序列分别全图推理、窗口推理（每10帧、每30帧全图一次）回放一遍；
+// 给出FrameRecorder录制的文件和模型时用真实模型回放录制画面，没有真值，窗口推理以全图推理的结果为参照
+int main(int argc, char **argv) {
+    hitcrt::RoiConfig full;
+    hitcrt::RoiConfig roi10;
+    roi10.m_enable = true;
+    roi10.m_sweepInterval = 10;
+    hitcrt::RoiConfig roi30 = roi10;
+    roi30.m_sweepInterval = 30;
+
+    if (argc > 2) {
+        const hitcrt::FrameRecordReader reader(argv[1]);
+        const hitcrt::Color enemy = argc > 3 && std::string(argv[3]) == "red" ? hitcrt::RED : hitcrt::BLUE;
+        hitcrt::ArmorDetectorNN detector(argv[2], 0.5f);
+        std::printf("recording %s, %zu frames %dx%d%s\n", argv[1], reader.count(), reader.header().m_width,
+                    reader.header().m_height, reader.recovered() ? " (recovered)" : "");
+        const RecordResult baseline = replayRecording(reader, detector, enemy, full);
+        printRecording("full frame", baseline, baseline);
+        printRecording("roi sweep 10", replayRecording(reader, detector, enemy, roi10), baseline);
+        printRecording("roi sweep 30", replayRecording(reader, detector, enemy, roi30), baseline);
+        return 0;
+    }
+
+    for (const std::string name : {"receding", "pair", "gap"}) {
+        const std::vector<Truth> sequence = makeSequence(name);
+        std::printf("sequence %s, %d frames\n", name.c_str(), FRAMES);
+        const ReplayResult baseline = replay(sequence, full);
+        print("full frame", baseline);
+        for (const auto &[label, config] : {std::make_pair("roi sweep 10", roi10), std::make_pair("roi sweep 30", roi30)}) {
+            const ReplayResult result = replay(sequence, config);
+            print(label, result);
+            if (name == "gap") {
+                std::printf("  %-16s re-acquired %d frames after reappearing\n", label, result.m_recovery);
+            }
+        }
+    }
+    return 0;
+}
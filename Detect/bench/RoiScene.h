@@ -0,0 +1,122 @@
+/**
+ * @file RoiScene.h
+ * @brief ROI推理的合成场景：按真值“检测”窗口内目标的模拟后端，性能测试和单元测试共用
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "FakePoseBackend.h"
+#include "infer/cpu_warpaffine.hpp"
+
+namespace hitcrt::bench {
+
+constexpr int SCENE_WIDTH = 1280;
+constexpr int SCENE_HEIGHT = 1024;
+constexpr int SCENE_NET_SIZE = 640;
+constexpr int SCENE_MAX_DETECTIONS = 16;
+constexpr float MIN_NET_HEIGHT = 6.0f;  // 装甲板缩放到网络输入后低于这个高度就检测不到
+
+// 一个真实目标：中心和装甲板高度，宽度按比例
+struct Target {
+    float m_x;
+    float m_y;
+    float m_height;
+    float width() const { return m_height * 2.3f; }
+};
+
+// 一帧的真值
+using Truth = std::vector<Target>;
+
+/**
+ * @brief 回放时共享的场景：当前帧的原图地址和真值，模拟后端据此“检测”
+ */
+struct Scene {
+    const uint8_t *m_base = nullptr;
+    int m_stride = 0;
+    const Truth *m_truth = nullptr;
+    uint64_t m_inputBytes = 0;  // 累计上传到推理后端的字节数
+};
+
+/**
+ * @brief 模拟的检测网络
+ *
+ * 按TensorRT后端的主机路径做预处理：把输入（可能是原图中的窗口）打包成连续BGR再letterbox到网络输入，耗时与真实后端一致。
+ * 检测结果取真值：从窗口地址推出窗口在原图中的位置，完整落在窗口内、缩放后高度不低于MIN_NET_HEIGHT的目标被检测到，
+ * 四个角点经AffineTransform的逆映射写成网络输入坐标，由PoseModel映射回窗口坐标。
+ */
+class SceneBackend : public FakePoseBackend {
+   public:
+    explicit SceneBackend(Scene *scene) : FakePoseBackend(1, SCENE_MAX_DETECTIONS, SCENE_NET_SIZE), m_scene(scene) {
+        m_packed.resize(static_cast<size_t>(SCENE_WIDTH) * SCENE_HEIGHT * 3);
+        m_blob.resize(static_cast<size_t>(3) * SCENE_NET_SIZE * SCENE_NET_SIZE);
+    }
+
+    std::unique_ptr<deploy::BaseBackend> clone() override { return std::make_unique<SceneBackend>(m_scene); }
+
+    void infer(const std::vector<deploy::Image> &inputs) override {
+        updateTransforms(inputs);
+        const deploy::Image &image = inputs.front();
+        const auto &transform = affine_transforms.front();
+
+        deploy::cpuPackBgr(image, m_packed.data());
+        const deploy::Image packed(m_packed.data(), image.width, image.height);
+        deploy::cpuWarpAffine(packed, m_blob.data(), SCENE_NET_SIZE, SCENE_NET_SIZE, transform.matrix, m_config);
+        m_scene->m_inputBytes += static_cast<uint64_t>(image.width) * image.height * 3;
+
+        const auto offset = static_cast<const uint8_t *>(image.ptr) - m_scene->m_base;
+        const float originX = static_cast<float>(offset % m_scene->m_stride / 3);
+        const float originY = static_cast<float>(offset / m_scene->m_stride);
+        const float scale = std::min(static_cast<float>(SCENE_NET_SIZE) / image.width,
+                                     static_cast<float>(SCENE_NET_SIZE) / image.height);
+        // 网络输入坐标 = (窗口坐标 - z) / a，与AffineTransform::applyTransform互逆
+        const float a = transform.matrix[0].x;
+        auto toNet = [&](const float x, const float y, float *netX, float *netY) {
+            *netX = (x - originX - transform.matrix[0].z) / a;
+            *netY = (y - originY - transform.matrix[1].z) / a;
+        };
+
+        int num = 0;
+        for (const Target &target : *m_scene->m_truth) {
+            const float halfW = target.width() * 0.5f, halfH = target.m_height * 0.5f;
+            const bool inside = target.m_x - halfW >= originX && target.m_x + halfW <= originX + image.width &&
+                                target.m_y - halfH >= originY && target.m_y + halfH <= originY + image.height;
+            if (!inside || target.m_height * scale < MIN_NET_HEIGHT || num == SCENE_MAX_DETECTIONS) {
+                continue;
+            }
+            // 左上、左下、右下、右上
+            const float corners[8] = {target.m_x - halfW, target.m_y - halfH, target.m_x - halfW, target.m_y + halfH,
+                                      target.m_x + halfW, target.m_y + halfH, target.m_x + halfW, target.m_y - halfH};
+            float kpts[NUM_KEYPOINTS * KEYPOINT_DIM];
+            for (int j = 0; j < NUM_KEYPOINTS; ++j) {
+                toNet(corners[2 * j], corners[2 * j + 1], &kpts[2 * j], &kpts[2 * j + 1]);
+            }
+            float box[4];
+            toNet(corners[0], corners[1], &box[0], &box[1]);
+            toNet(corners[4], corners[5], &box[2], &box[3]);
+            setDetection(0, num++, 3, 0.9f, box, kpts);  // 蓝方3号步兵
+        }
+        setNum(0, num);
+    }
+
+   private:
+    Scene *m_scene;
+    deploy::ProcessConfig m_config;
+    std::vector<uint8_t> m_packed;
+    std::vector<float> m_blob;
+};
+
+}  // namespace hitcrt::bench
@@ -0,0 +1,274 @@
+/**
+ * @file ShmRingBench.cpp
+ * @brief 共享内存帧环：全速写时读者被覆盖的比例，跨进程端到端延迟，可选与ROS2订阅路径对比
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>取帧顺序、覆盖检测和像素一致性检查移到test/ShmRingTest.cpp
+ * </table>
+ */
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ShmFrameRing.h"
+
+#ifdef SHM_BENCH_ROS2
+#include "ImageIngest.h"
+#endif
+
+namespace {
+using hitcrt::Clock;
+using hitcrt::ShmFrameMeta;
+using hitcrt::ShmFrameReader;
+using hitcrt::ShmFrameView;
+using hitcrt::ShmFrameWriter;
+
+constexpr int WIDTH = 1280;
+constexpr int HEIGHT = 1024;
+constexpr double FPS = 100.0;
+const std::string NAME = "hitcrt_shm_bench";
+volatile uint64_t touchSink = 0;
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// 每帧像素开头和结尾写入序号
+void stamp(cv::Mat &image, const uint64_t seq) {
+    const size_t bytes = image.total() * image.elemSize();
+    std::memcpy(image.data, &seq, sizeof(seq));
+    std::memcpy(image.data + bytes - sizeof(seq), &seq, sizeof(seq));
+}
+
+// 读一遍整帧，相当于检测预处理原地读像素
+uint64_t touch(const cv::Mat &image) {
+    const uint64_t *words = reinterpret_cast<const uint64_t *>(image.data);
+    const size_t count = image.total() * image.elemSize() / sizeof(uint64_t);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; i += 8) {
+        sum += words[i];
+    }
+    return sum;
+}
+
+double percentile(std::vector<double> values, const double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, static_cast<size_t>(values.size() * p))];
+}
+
+void report(const char *label, const std::vector<double> &us) {
+    std::printf("%-40s p50 %7.1f us, p99 %7.1f us, max %7.1f us (%zu frames)\n", label, percentile(us, 0.5),
+                percentile(us, 0.99), percentile(us, 1.0), us.size());
+}
+
+/**
+ * @brief 同进程写者不等待全速写，统计读者读完整帧期间被覆盖的比例
+ */
+void benchContention() {
+    constexpr int FRAMES = 3000;
+    ShmFrameWriter writer(NAME + "_torn", WIDTH, HEIGHT, CV_8UC3, 3);
+    ShmFrameReader reader(NAME + "_torn");
+    std::thread producer([&writer] {
+        for (uint64_t seq = 1; seq <= FRAMES; ++seq) {
+            writer.begin();
+            ShmFrameMeta meta;
+            meta.m_seq = seq;
+            writer.commit(meta);
+        }
+    });
+    uint64_t intact = 0;
+    uint64_t overwritten = 0;
+    uint64_t lastSeq = 0;
+    while (lastSeq < FRAMES && reader.wait(1000)) {
+        ShmFrameView view;
+        if (!reader.latest(view)) {
+            continue;
+        }
+        touchSink = touch(view.m_image);
+        if (reader.intact(view)) {
+            ++intact;
+        } else {
+            ++overwritten;
+        }
+        lastSeq = view.m_meta.m_seq;
+    }
+    producer.join();
+    std::printf("unpaced writer, 3 slots: %llu intact, %llu overwritten while reading\n",
+                static_cast<unsigned long long>(intact), static_cast<unsigned long long>(overwritten));
+}
+
+/**
+ * @brief 子进程作为桥按FPS写帧：拿到源图像的时刻记为m_receiveNs，再原地写满槽位
+ */
+void bridgeProcess(const int frames) {
+    ShmFrameWriter writer(NAME, WIDTH, HEIGHT, CV_8UC3, 8);
+    cv::Mat source(HEIGHT, WIDTH, CV_8UC3, cv::Scalar(128, 128, 128));
+    // 等读者打开
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / FPS));
+    auto next = Clock::now();
+    for (int seq = 1; seq <= frames; ++seq) {
+        next += period;
+        std::this_thread::sleep_until(next);
+        ShmFrameMeta meta;
+        meta.m_seq = seq;
+        meta.m_receiveNs = nowNs();
+        cv::Mat &image = writer.begin();
+        source.copyTo(image);
+        stamp(image, seq);
+        writer.commit(meta);
+    }
+    // 等读者取完最后一帧再删除共享内存
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+}
+
+/**
+ * @brief 跨进程：桥进程写，本进程在futex上等待后原地读
+ */
+void runShm(const int frames, std::vector<double> &endToEndUs) {
+    const pid_t child = ::fork();
+    if (child == 0) {
+        bridgeProcess(frames);
+        std::_Exit(0);
+    }
+    std::unique_ptr<ShmFrameReader> reader;
+    for (int retry = 0; retry < 100 && !reader; ++retry) {
+        try {
+            reader = std::make_unique<ShmFrameReader>(NAME);
+        } catch (const std::runtime_error &) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    std::vector<double> wakeUs;
+    std::vector<double> readUs;
+    uint64_t lastSeq = 0;
+    while (reader && lastSeq < static_cast<uint64_t>(frames) && reader->wait(1000)) {
+        ShmFrameView view;
+        if (!reader->latest(view)) {
+            continue;
+        }
+        const int64_t woke = nowNs();
+        touchSink = touch(view.m_image);
+        const int64_t read = nowNs();
+        wakeUs.push_back((woke - view.m_meta.m_publishNs) / 1e3);
+        endToEndUs.push_back((woke - view.m_meta.m_receiveNs) / 1e3);
+        readUs.push_back((read - view.m_meta.m_receiveNs) / 1e3);
+        lastSeq = view.m_meta.m_seq;
+    }
+    const uint64_t skipped = reader ? reader->skipped() : 0;
+    reader.reset();
+    int status = 0;
+    ::waitpid(child, &status, 0);
+    report("shm: publish -> reader awake", wakeUs);
+    report("shm: bridge has image -> pixels in place", endToEndUs);
+    report("shm: bridge has image -> frame read once", readUs);
+    std::printf("shm: received %llu of %d, skipped %llu\n", static_cast<unsigned long long>(lastSeq), frames,
+                static_cast<unsigned long long>(skipped));
+}
+
+#ifdef SHM_BENCH_ROS2
+/**
+ * @brief 子进程按FPS发布sensor_msgs/Image，header.stamp为拿到图像时的steady_clock
+ */
+void publisherProcess(const int frames) {
+    rclcpp::init(0, nullptr);
+    auto node = std::make_shared<rclcpp::Node>("shmBenchPub");
+    auto publisher = node->create_publisher<sensor_msgs::msg::Image>("/shm_bench/image_raw",
+                                                                     rclcpp::SensorDataQoS().keep_last(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / FPS));
+    auto next = Clock::now();
+    for (int seq = 1; seq <= frames; ++seq) {
+        next += period;
+        std::this_thread::sleep_until(next);
+        auto msg = std::make_unique<sensor_msgs::msg::Image>();
+        const int64_t receive = nowNs();
+        msg->header.stamp.sec = static_cast<int32_t>(receive / 1000000000LL);
+        msg->header.stamp.nanosec = static_cast<uint32_t>(receive % 1000000000LL);
+        msg->width = WIDTH;
+        msg->height = HEIGHT;
+        msg->encoding = "bgr8";
+        msg->step = WIDTH * 3;
+        msg->data.assign(static_cast<size_t>(msg->step) * HEIGHT, 128);
+        publisher->publish(std::move(msg));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    rclcpp::shutdown();
+}
+
+/**
+ * @brief 现有路径：另一个进程发布，本进程的接入节点经DDS收到后转换进槽位
+ */
+void runRos2(const int frames, std::vector<double> &endToEndUs) {
+    const pid_t child = ::fork();
+    if (child == 0) {
+        publisherProcess(frames);
+        std::_Exit(0);
+    }
+    rclcpp::init(0, nullptr);
+    hitcrt::FrameRing ring(4, WIDTH, HEIGHT, CV_8UC3);
+    std::mutex mutex;
+    auto ingest = std::make_shared<hitcrt::ImageIngestNode>(
+        ring,
+        [&](hitcrt::FrameHandle &&handle) {
+            const int64_t now = nowNs();
+            std::lock_guard<std::mutex> lock(mutex);
+            endToEndUs.push_back((now - handle.rawStamp()) / 1e3);
+        },
+        "/shm_bench/image_raw");
+    rclcpp::executors::SingleThreadedExecutor executor;
+    executor.add_node(ingest);
+    std::thread spinner([&executor] { executor.spin(); });
+    int status = 0;
+    ::waitpid(child, &status, 0);
+    executor.cancel();
+    spinner.join();
+    const auto stat = ingest->stat();
+    ingest.reset();
+    rclcpp::shutdown();
+    report("ros2: publisher has image -> pixels in slot", endToEndUs);
+    const uint64_t lost = frames - std::get<0>(stat);
+    std::printf("ros2: received %llu, lost %llu\n", static_cast<unsigned long long>(std::get<0>(stat)),
+                static_cast<unsigned long long>(lost));
+}
+#endif
+}  // namespace
+
+// 用法：shmRingBench [帧数]
+// 桥进程以100fps写1280x1024 BGR帧，延迟都按同一台机器上的steady_clock计算
+int main(int argc, char **argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 500;
+    benchContention();
+
+    std::vector<double> shmUs;
+    runShm(frames, shmUs);
+#ifdef SHM_BENCH_ROS2
+    std::vector<double> rosUs;
+    runRos2(frames, rosUs);
+    std::printf("source has image -> detector has pixels, p50: shm %.1f us vs ros2 %.1f us\n",
+                percentile(shmUs, 0.5), percentile(rosUs, 0.5));
+#endif
+    return 0;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file SoftTriggerBench.cpp
+ * @brief 软触发调度：模拟时钟上对比拉流、检测器空闲才触发、按就绪时刻预测触发三种取帧方式的帧龄和检测器空等
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>仿真移到SoftTriggerSim.h，收敛和吞吐检查移到test/SoftTriggerTest.cpp
+ * </table>
+ */
+#include <algorithm>
+#include <cstdio>
+
+#include "SoftTriggerSim.h"
+
+namespace {
+using hitcrt::bench::SimResult;
+
+void printResult(const char* name, SimResult result) {
+    std::sort(result.m_ages.begin(), result.m_ages.end());
+    double age = 0.0;
+    double idle = 0.0;
+    for (size_t i = 0; i < result.m_ages.size(); ++i) {
+        age += result.m_ages[i];
+        idle += result.m_idles[i];
+    }
+    const double n = static_cast<double>(result.m_ages.size());
+    std::printf("%-18s %6.1f fps, frame age mean %6.3f ms, p99 %6.3f ms, detector idle mean %6.3f ms\n", name,
+                result.m_fps, age / n, result.m_ages[static_cast<size_t>(n * 0.99)], idle / n);
+}
+}  // namespace
+
+// 用法：softTriggerBench
+int main() {
+    using hitcrt::bench::Us;
+    const SimResult stream = hitcrt::bench::runStream();
+
+    hitcrt::camera::TriggerScheduler naiveScheduler{Us(hitcrt::bench::EXPOSURE_US)};
+    const SimResult naive = hitcrt::bench::runSoft(false, naiveScheduler);
+
+    // 传输初值故意给错，看能否收敛到实测
+    hitcrt::camera::TriggerScheduler scheduler(Us(hitcrt::bench::EXPOSURE_US), Us(1000));
+    const SimResult predictive = hitcrt::bench::runSoft(true, scheduler);
+
+    printResult("stream 200fps", stream);
+    printResult("trigger when idle", naive);
+    printResult("predictive trigger", predictive);
+    std::printf("%s", scheduler.reportStr().c_str());
+    return 0;
+}
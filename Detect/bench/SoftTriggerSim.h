@@ -0,0 +1,151 @@
+/**
+ * @file SoftTriggerSim.h
+ * @brief 软触发调度的模拟时钟仿真：拉流与软触发两种取帧方式，性能测试和单元测试共用
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "TriggerScheduler.h"
+
+namespace hitcrt::bench {
+using camera::TimePoint;
+using camera::TriggerScheduler;
+using Us = std::chrono::microseconds;
+
+// 曝光4ms，传输3ms±0.3ms，预处理1ms，推理8ms±0.8ms；全部在模拟时钟上计算，结果可复现
+constexpr int NUM_FRAMES = 5000;
+constexpr int64_t EXPOSURE_US = 4000;
+constexpr int64_t TRANSFER_US = 3000;        // 读出 + USB传输 + SDK转换的均值
+constexpr int64_t TRANSFER_JITTER_US = 300;
+constexpr int64_t PREPROCESS_US = 1000;
+constexpr int64_t INFER_US = 8000;
+constexpr int64_t INFER_JITTER_US = 800;
+constexpr int64_t STREAM_PERIOD_US = 5000;   // 拉流200fps
+
+// 模拟时钟：整数微秒，从0开始
+inline TimePoint at(const int64_t us) { return TimePoint(Us(us)); }
+inline int64_t usOf(const TimePoint& time) { return std::chrono::duration_cast<Us>(time.time_since_epoch()).count(); }
+
+/**
+ * @brief 模拟的相机和检测器，耗时服从固定种子的正态分布
+ */
+class SimCamera {
+   public:
+    explicit SimCamera(const unsigned seed) : m_random(seed) {}
+
+    // 触发（曝光开始）到回调的时间
+    int64_t latency() { return EXPOSURE_US + std::max<int64_t>(0, gauss(TRANSFER_US, TRANSFER_JITTER_US)); }
+    // 一帧推理耗时
+    int64_t infer() { return std::max<int64_t>(1000, gauss(INFER_US, INFER_JITTER_US)); }
+
+   private:
+    int64_t gauss(const int64_t mean, const int64_t stddev) {
+        std::normal_distribution<double> dist(static_cast<double>(mean), static_cast<double>(stddev));
+        return static_cast<int64_t>(std::llround(dist(m_random)));
+    }
+    std::mt19937 m_random;
+};
+
+/**
+ * @brief 一种取帧方式的结果
+ */
+struct SimResult {
+    std::vector<double> m_ages;   // 推理开始时刻减曝光开始时刻，ms
+    std::vector<double> m_idles;  // 检测器空闲到开始推理的空等时间，ms
+    double m_fps = 0.0;
+};
+
+inline double meanOf(const std::vector<double>& values) {
+    double sum = 0.0;
+    for (const double value : values) {
+        sum += value;
+    }
+    return values.empty() ? 0.0 : sum / static_cast<double>(values.size());
+}
+
+/**
+ * @brief 改造前：相机按固定帧率拉流，检测器空闲时取最新一帧
+ */
+inline SimResult runStream() {
+    SimCamera camera(1);
+    SimResult result;
+    // 预先生成所有帧的曝光开始和回调时刻，回调按顺序到达
+    const int numStream = NUM_FRAMES * 3;
+    std::vector<int64_t> exposeTimes(numStream);
+    std::vector<int64_t> arriveTimes(numStream);
+    for (int i = 0; i < numStream; ++i) {
+        exposeTimes[i] = i * STREAM_PERIOD_US;
+        arriveTimes[i] = std::max(exposeTimes[i] + camera.latency(), i > 0 ? arriveTimes[i - 1] : 0);
+    }
+
+    int64_t ready = 0;
+    int taken = -1;
+    for (int k = 0; k < NUM_FRAMES; ++k) {
+        // 最新一帧，没有新帧就等下一帧
+        int latest = taken + 1;
+        while (latest + 1 < numStream && arriveTimes[latest + 1] <= ready) {
+            ++latest;
+        }
+        const int64_t start = std::max(ready, arriveTimes[latest]) + PREPROCESS_US;
+        result.m_ages.push_back((start - exposeTimes[latest]) / 1000.0);
+        result.m_idles.push_back((start - ready) / 1000.0);
+        taken = latest;
+        ready = start + camera.infer();
+    }
+    result.m_fps = NUM_FRAMES / (ready / 1e6);
+    return result;
+}
+
+/**
+ * @brief 软触发：检测器报告就绪时刻，predictive为false时提前量为0，即检测器空闲了才触发
+ * @param[in] predictive    是否按提前量预测触发
+ * @param[out] scheduler    调度器，用于检查估计和延迟分布
+ */
+inline SimResult runSoft(const bool predictive, TriggerScheduler& scheduler) {
+    SimCamera camera(1);
+    SimResult result;
+    double inferEstimate = INFER_US;  // 检测器对自身推理耗时的滑动估计
+
+    int64_t ready = 0;          // 检测器实际空闲的时刻
+    int64_t reportTime = 0;     // 检测器报告就绪时刻的时刻，即上一帧推理开始
+    int64_t reportedReady = 0;  // 检测器报告的预计空闲时刻
+    for (int k = 0; k < NUM_FRAMES; ++k) {
+        // 不预测时等检测器真正空闲才触发
+        const int64_t trigger =
+            predictive ? usOf(scheduler.plan(at(reportedReady), at(reportTime))) : ready;
+        scheduler.onTrigger(at(trigger), at(predictive ? reportedReady : ready));
+        const int64_t arrive = trigger + camera.latency();
+        scheduler.onFrame(at(arrive));
+        scheduler.onPreprocess(Us(PREPROCESS_US));
+
+        const int64_t start = std::max(ready, arrive + PREPROCESS_US);
+        result.m_ages.push_back((start - trigger) / 1000.0);
+        result.m_idles.push_back((start - ready) / 1000.0);
+
+        // 推理开始时报告预计空闲的时刻，下一帧据此触发
+        const int64_t infer = camera.infer();
+        reportTime = start;
+        reportedReady = start + static_cast<int64_t>(inferEstimate);
+        ready = start + infer;
+        inferEstimate += (infer - inferEstimate) / 8.0;
+    }
+    result.m_fps = NUM_FRAMES / (ready / 1e6);
+    return result;
+}
+}  // namespace hitcrt::bench
@@ -0,0 +1,137 @@
+/**
+ * @file TraceBench.cpp
+ * @brief 逐帧trace：多线程写出的JSON完整性检查，以及每个区间在热路径上的开销
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Trace.h"
+
+namespace {
+using hitcrt::Tracer;
+
+constexpr int THREADS = 4;
+constexpr int FRAMES_PER_THREAD = 5000;
+constexpr int SPANS_PER_ROUND = 1000;
+constexpr int ROUNDS = 200;
+constexpr double MAX_SPAN_NS = 1000.0;
+
+size_t countOf(const std::string &text, const std::string &pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * @brief 几个线程模拟流水线各级，每帧一个外层区间套一个内层区间，检查写出的事件数、帧序号和线程名
+ */
+bool checkOutput(const std::string &path) {
+    Tracer &tracer = Tracer::instance();
+    tracer.start(path, 5);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([t]() {
+            HITCRT_TRACE_THREAD("stage " + std::to_string(t));
+            for (int i = 0; i < FRAMES_PER_THREAD; ++i) {
+                HITCRT_TRACE_FRAME(static_cast<uint64_t>(i));
+                HITCRT_TRACE_SCOPE("outer");
+                {
+                    HITCRT_TRACE_SCOPE("inner");
+                }
+                // 每线程每ms约50个区间，仍是流水线实际速率的几十倍
+                if (i % 25 == 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    // 外面的区间不属于任何帧
+    HITCRT_TRACE_SPAN("unframed", Tracer::NO_FRAME, Tracer::nowNs() - 1000, Tracer::nowNs());
+    tracer.stop();
+
+    std::ifstream file(path);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+    const uint64_t expect = static_cast<uint64_t>(THREADS) * FRAMES_PER_THREAD * 2 + 1;
+    const size_t events = countOf(text, "\"ph\":\"X\"");
+    const size_t framed = countOf(text, "\"args\":{\"frame\":");
+    const size_t lastFrame = countOf(text, "\"args\":{\"frame\":" + std::to_string(FRAMES_PER_THREAD - 1) + "}");
+    const size_t names = countOf(text, "\"name\":\"thread_name\"");
+    const bool wellFormed = text.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0 &&
+                            text.size() > 4 && text.compare(text.size() - 4, 4, "\n]}\n") == 0 &&
+                            text.find(",\n\n") == std::string::npos;
+    const bool passed = tracer.dropped() == 0 && tracer.written() == expect && events == expect &&
+                        framed == expect - 1 && lastFrame == THREADS * 2 && names >= THREADS && wellFormed;
+    std::printf("%d threads x %d frames: written %llu / %llu, dropped %llu, framed %zu, thread names %zu, %s %s\n",
+                THREADS, FRAMES_PER_THREAD, static_cast<unsigned long long>(tracer.written()),
+                static_cast<unsigned long long>(expect), static_cast<unsigned long long>(tracer.dropped()), framed,
+                names, wellFormed ? "well formed" : "malformed", passed ? "ok" : "FAIL");
+    return passed;
+}
+
+/**
+ * @brief 每轮连续记录SPANS_PER_ROUND个区间计时，轮间留时间给写文件线程取走，返回每个区间的中位耗时ns
+ */
+double spanCost(const char *label) {
+    std::vector<double> ns(ROUNDS);
+    for (int round = 0; round < ROUNDS; ++round) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < SPANS_PER_ROUND; ++i) {
+            HITCRT_TRACE_FRAME(static_cast<uint64_t>(i));
+            HITCRT_TRACE_SCOPE("span");
+        }
+        const auto stop = std::chrono::steady_clock::now();
+        ns[round] = std::chrono::duration<double, std::nano>(stop - start).count() / SPANS_PER_ROUND;
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+    }
+    std::sort(ns.begin(), ns.end());
+    std::printf("%-36s median = %7.1f ns/span, p99 = %7.1f ns/span, max = %7.1f ns/span\n", label, ns[ROUNDS / 2],
+                ns[ROUNDS * 99 / 100], ns.back());
+    return ns[ROUNDS / 2];
+}
+}  // namespace
+
+// 用法：traceBench [输出目录，默认/tmp]
+// 开销的检查只看记录中的区间；没有开始时的开销只是读一次原子变量，编译时关掉HITCRT_TRACE则为0
+int main(int argc, char **argv) {
+    const std::string dir = argc > 1 ? argv[1] : "/tmp";
+    const std::string path = dir + "/trace_bench.json";
+    const bool output = checkOutput(path);
+
+    const double idle = spanCost("tracer stopped");
+    Tracer::instance().start(path, 1);
+    const double recording = spanCost("tracer recording");
+    Tracer::instance().stop();
+    const bool cheap = recording < MAX_SPAN_NS && Tracer::instance().dropped() == 0;
+    std::printf("recording span cost %.1f ns (limit %.0f ns), idle %.1f ns, dropped %llu %s\n", recording,
+                MAX_SPAN_NS, idle, static_cast<unsigned long long>(Tracer::instance().dropped()),
+                cheap ? "ok" : "FAIL");
+    std::remove(path.c_str());
+
+    const bool passed = output && cheap;
+    std::printf("trace check: %s\n", passed ? "ok" : "FAIL");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file TrackerBench.cpp
+ * @brief 跳帧检测：合成序列或录制画面上对比每帧推理与跳帧跟踪的角点误差、有效检测帧率、漏检和误检
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>支持用真实模型回放录制画面并开启光流，模拟后端改用FakePoseBackend.h
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>合成场景移到TrackerScene.h，外推误差和推理时机检查移到test/TrackerTest.cpp
+ * </table>
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ArmorDetectorNN.h"
+#include "FrameRecord.h"
+#include "ReplayCam.h"
+#include "TrackerScene.h"
+#include "TrackingDetector.h"
+
+namespace {
+using hitcrt::bench::CornerTruth;
+using hitcrt::bench::TRACK_FRAME_SECONDS;
+using hitcrt::bench::TRACK_FRAMES;
+using hitcrt::bench::TrackResult;
+
+void print(const std::string &label, const TrackResult &result) {
+    std::printf("  %-18s rate %.2fx, corner error mean %.3f px p95 %.3f px max %.3f px, missed %5.2f%%, false %5.2f%%, "
+                "residual-forced %llu, flow-forced %llu, latency mean %.3f ms p99 %.3f ms\n",
+                label.c_str(), result.m_stats.effectiveRate(), result.mean(), result.percentile(95),
+                result.percentile(100), 100.0 * result.m_missed / std::max(result.m_reference, 1),
+                100.0 * result.m_false / std::max(result.m_reference, 1),
+                static_cast<unsigned long long>(result.m_stats.m_residualForced),
+                static_cast<unsigned long long>(result.m_stats.m_flowForced), result.m_latency.mean(),
+                result.m_latency.percentile(99));
+}
+
+/**
+ * @brief 录制画面上并排回放：每帧推理的结果作为参照，各配置的跳帧检测与参照共用同一个检测器，逐帧依次处理
+ */
+class FootageReplay {
+   public:
+    FootageReplay(const std::shared_ptr<hitcrt::ArmorDetectorNN> &detector,
+                  const std::vector<std::pair<std::string, hitcrt::TrackerConfig>> &modes)
+        : m_detector(detector), m_results(modes.size()) {
+        for (const auto &[label, config] : modes) {
+            m_labels.push_back(label);
+            m_trackers.push_back(std::make_unique<hitcrt::TrackingDetector>(detector, config));
+        }
+    }
+
+    void apply(const hitcrt::Frame &frame, const hitcrt::RecvInfoBase &recvInfo) {
+        m_detector->apply(frame, recvInfo, hitcrt::ROI(), m_expected);
+        for (size_t m = 0; m < m_trackers.size(); ++m) {
+            const auto start = std::chrono::steady_clock::now();
+            m_trackers[m]->apply(frame, recvInfo, hitcrt::ROI(), m_armors);
+            m_results[m].m_latency.record(
+                std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
+            hitcrt::bench::matchArmors(m_expected, m_armors, m_results[m]);
+        }
+        ++m_frames;
+    }
+
+    void report() {
+        std::printf("%llu frames, every-frame inference as reference\n", static_cast<unsigned long long>(m_frames));
+        for (size_t m = 0; m < m_trackers.size(); ++m) {
+            m_results[m].m_stats = m_trackers[m]->stats();
+            print(m_labels[m], m_results[m]);
+        }
+    }
+
+   private:
+    std::shared_ptr<hitcrt::ArmorDetectorNN> m_detector;
+    std::vector<std::string> m_labels;
+    std::vector<std::unique_ptr<hitcrt::TrackingDetector>> m_trackers;
+    std::vector<TrackResult> m_results;
+    std::vector<hitcrt::Armor> m_expected, m_armors;
+    uint64_t m_frames = 0;
+};
+
+/**
+ * @brief 用真实模型回放录制的画面，跳帧时开启光流
+ * @param[in] path  FrameRecorder的.hrec文件按录制的时间戳和云台角度回放；
+ *                  其他路径（图片目录、视频）由ReplayCamera预加载，SOFT模式逐帧回调，时间戳取录制时刻
+ */
+bool replayFootage(const std::string &path, const std::string &model, const hitcrt::Color enemy) {
+    const auto detector = std::make_shared<hitcrt::ArmorDetectorNN>(model, 0.5f);
+    hitcrt::TrackerConfig skip2;
+    hitcrt::TrackerConfig skip2Flow = skip2;
+    skip2Flow.m_opticalFlow = true;
+    hitcrt::TrackerConfig skip3Flow = skip2Flow;
+    skip3Flow.m_maxSkip = 3;
+    FootageReplay replay(detector, {{"skip 2", skip2}, {"skip 2 flow", skip2Flow}, {"skip 3 flow", skip3Flow}});
+
+    const std::string suffix = ".hrec";
+    if (path.size() > suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0) {
+        const hitcrt::FrameRecordReader reader(path);
+        for (size_t i = 0; i < reader.count(); ++i) {
+            const hitcrt::RecordMeta &meta = reader.meta(i);
+            const hitcrt::RecvInfoBase recvInfo(meta.m_pitch, meta.m_yaw, meta.m_roll, 25.0f, enemy, true);
+            reader.prefetch(i + 1);
+            replay.apply(reader.frame(i), recvInfo);
+        }
+    } else {
+        const hitcrt::RecvInfoBase recvInfo(0.0, 0.0, 0.0, 25.0, enemy, true);
+        const hitcrt::TimePoint origin = std::chrono::steady_clock::now();
+        hitcrt::camera::ReplayCamera camera;
+        size_t index = 0;
+        const hitcrt::camera::ReplayParams params(
+            [&](const hitcrt::camera::TimePoint &, const cv::Mat &image) {
+                replay.apply(hitcrt::Frame(image, origin + camera.offset(index++)), recvInfo);
+            },
+            path, hitcrt::camera::SOFT, hitcrt::camera::AS_FAST);
+        if (!camera.initiate(params)) {
+            std::printf("cannot replay %s\n", path.c_str());
+            return false;
+        }
+        while (camera.softTrigger()) {
+        }
+        camera.terminate();
+    }
+    std::printf("footage %s: ", path.c_str());
+    replay.report();
+    return true;
+}
+}  // namespace
+
+// 用法：trackerBench [录制 模型文件 [敌方颜色red|blue]]
+// 不带参数时在合成序列上对比：每个序列分别按每帧推理（最多跳0帧）、最多跳1/2/3帧、匀速模型跳2帧回放一遍，
+// 误差以每帧推理的结果为准；合成画面没有纹理，不跑光流。
+// 给出录制和模型时在真实画面上对比跳2帧、跳2帧加光流、跳3帧加光流与每帧推理的角点误差
+int main(int argc, char **argv) {
+    if (argc > 2) {
+        const hitcrt::Color enemy = argc > 3 && std::string(argv[3]) == "red" ? hitcrt::RED : hitcrt::BLUE;
+        return replayFootage(argv[1], argv[2], enemy) ? 0 : 1;
+    }
+
+    hitcrt::TrackerConfig every;
+    every.m_maxSkip = 0;
+    hitcrt::TrackerConfig skip1;
+    skip1.m_maxSkip = 1;
+    hitcrt::TrackerConfig skip2;
+    hitcrt::TrackerConfig skip3;
+    skip3.m_maxSkip = 3;
+    hitcrt::TrackerConfig velocity = skip2;
+    velocity.m_acceleration = false;
+
+    for (const std::string name : {"translate", "spin", "jitter"}) {
+        const std::vector<CornerTruth> sequence = hitcrt::bench::makeTrackSequence(name);
+        std::printf("sequence %s, %d frames at %.0f fps\n", name.c_str(), TRACK_FRAMES, 1.0 / TRACK_FRAME_SECONDS);
+        for (const auto &[label, config] : {std::make_pair("every frame", every), std::make_pair("skip 1", skip1),
+                                            std::make_pair("skip 2", skip2), std::make_pair("skip 3", skip3),
+                                            std::make_pair("skip 2 const-vel", velocity)}) {
+            print(label, hitcrt::bench::replayTrack(sequence, config));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,285 @@
+/**
+ * @file TrackerScene.h
+ * @brief 跳帧检测的合成场景：按真值角点“检测”的模拟后端、合成序列和与每帧推理并排回放，性能测试和单元测试共用
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ArmorDetectorNN.h"
+#include "CornerTracker.h"
+#include "FakePoseBackend.h"
+#include "TrackingDetector.h"
+#include "infer/cpu_warpaffine.hpp"
+#include "utils/histogram.hpp"
+
+namespace hitcrt::bench {
+
+constexpr int TRACK_WIDTH = 1280;
+constexpr int TRACK_HEIGHT = 1024;
+constexpr int TRACK_NET_SIZE = 640;
+constexpr int TRACK_MAX_DETECTIONS = 16;
+constexpr int TRACK_FRAMES = 900;
+constexpr double TRACK_FRAME_SECONDS = 0.01;  // 100fps
+constexpr float TRACK_NOISE = 0.25f;          // 检测角点的抖动幅度，像素
+constexpr float TRACK_MATCH_DISTANCE = 12.0f; // 中心距离在此之内算同一个装甲板
+
+// 一个真实装甲板的四个角点：左上、左下、右下、右上
+using Corners = std::array<cv::Point2f, 4>;
+// 一帧的真值
+using CornerTruth = std::vector<Corners>;
+
+inline Corners makeArmor(const float x, const float y, const float halfWidth, const float leftHalf,
+                         const float rightHalf) {
+    return {cv::Point2f(x - halfWidth, y - leftHalf), cv::Point2f(x - halfWidth, y + leftHalf),
+            cv::Point2f(x + halfWidth, y + rightHalf), cv::Point2f(x + halfWidth, y - rightHalf)};
+}
+
+// 固定种子的整数哈希，同一帧同一角点的噪声在两个检测器里相同，取值在±amplitude之内
+inline float cornerNoise(const uint32_t frame, const uint32_t index, const float amplitude) {
+    uint32_t h = frame * 0x9E3779B1u ^ (index + 0x7F4A7C15u) * 0x85EBCA77u;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    h *= 0x297A2D39u;
+    h ^= h >> 15;
+    return amplitude * (static_cast<float>(h & 0xFFFF) / 32767.5f - 1.0f);
+}
+
+/**
+ * @brief 回放时共享的场景：当前帧的序号和真值，模拟后端据此“检测”
+ */
+struct TrackScene {
+    uint32_t m_frame = 0;
+    const CornerTruth *m_truth = nullptr;
+    float m_noise = TRACK_NOISE;  // 0时检测结果与真值一致
+};
+
+/**
+ * @brief 模拟的检测网络
+ *
+ * 按TensorRT后端的主机路径做整图letterbox，推理帧的耗时与真实后端的预处理一致。检测结果为真值加上每帧固定的角点抖动，
+ * 经AffineTransform的逆映射写成网络输入坐标，由PoseModel映射回原图坐标。
+ */
+class TrackSceneBackend : public FakePoseBackend {
+   public:
+    explicit TrackSceneBackend(const TrackScene *scene)
+        : FakePoseBackend(1, TRACK_MAX_DETECTIONS, TRACK_NET_SIZE), m_scene(scene) {
+        m_packed.resize(static_cast<size_t>(TRACK_WIDTH) * TRACK_HEIGHT * 3);
+        m_blob.resize(static_cast<size_t>(3) * TRACK_NET_SIZE * TRACK_NET_SIZE);
+    }
+
+    std::unique_ptr<deploy::BaseBackend> clone() override { return std::make_unique<TrackSceneBackend>(m_scene); }
+
+    void infer(const std::vector<deploy::Image> &inputs) override {
+        updateTransforms(inputs);
+        const deploy::Image &image = inputs.front();
+        const auto &transform = affine_transforms.front();
+
+        deploy::cpuPackBgr(image, m_packed.data());
+        const deploy::Image packed(m_packed.data(), image.width, image.height);
+        deploy::cpuWarpAffine(packed, m_blob.data(), TRACK_NET_SIZE, TRACK_NET_SIZE, transform.matrix, m_config);
+
+        // 网络输入坐标 = (原图坐标 - z) / a，与AffineTransform::applyTransform互逆
+        const float a = transform.matrix[0].x;
+        auto toNet = [&](const cv::Point2f &point, float *netX, float *netY) {
+            *netX = (point.x - transform.matrix[0].z) / a;
+            *netY = (point.y - transform.matrix[1].z) / a;
+        };
+
+        int num = 0;
+        for (const Corners &truth : *m_scene->m_truth) {
+            if (num == TRACK_MAX_DETECTIONS) {
+                break;
+            }
+            Corners corners = truth;
+            for (int j = 0; j < NUM_KEYPOINTS; ++j) {
+                const uint32_t index = static_cast<uint32_t>(num * NUM_KEYPOINTS + j) * 2;
+                corners[j] += cv::Point2f(cornerNoise(m_scene->m_frame, index, m_scene->m_noise),
+                                          cornerNoise(m_scene->m_frame, index + 1, m_scene->m_noise));
+            }
+            float kpts[NUM_KEYPOINTS * KEYPOINT_DIM];
+            for (int j = 0; j < NUM_KEYPOINTS; ++j) {
+                toNet(corners[j], &kpts[2 * j], &kpts[2 * j + 1]);
+            }
+            float box[4];
+            toNet(cv::Point2f(std::min(corners[0].x, corners[1].x), std::min(corners[0].y, corners[3].y)), &box[0], &box[1]);
+            toNet(cv::Point2f(std::max(corners[2].x, corners[3].x), std::max(corners[1].y, corners[2].y)), &box[2], &box[3]);
+            setDetection(0, num++, 3, 0.9f, box, kpts);  // 蓝方3号步兵
+        }
+        setNum(0, num);
+    }
+
+   private:
+    const TrackScene *m_scene;
+    deploy::ProcessConfig m_config;
+    std::vector<uint8_t> m_packed;
+    std::vector<float> m_blob;
+};
+
+/**
+ * @brief 合成的回放序列，100fps，固定参数生成，每次运行相同
+ * @param[in] name  "translate"：两个装甲板沿正弦轨迹平移，速度和加速度连续变化，最快约13像素/帧；
+ *                  "spin"：小陀螺，四块装甲板绕中心每秒转1.5圈，转过正对±60°后消失、下一块出现，整车同时平移；
+ *                  "jitter"：一个装甲板匀速运动，每隔20到50帧突然改变方向
+ */
+inline std::vector<CornerTruth> makeTrackSequence(const std::string &name) {
+    std::vector<CornerTruth> sequence(TRACK_FRAMES);
+    float x = 640.0f, y = 512.0f, vx = 8.0f, vy = 5.0f;
+    int nextTurn = 30;
+    for (int i = 0; i < TRACK_FRAMES; ++i) {
+        const double t = i * TRACK_FRAME_SECONDS;
+        if (name == "translate") {
+            sequence[i].push_back(makeArmor(static_cast<float>(640.0 + 400.0 * std::sin(2.0 * CV_PI * 0.5 * t)),
+                                            static_cast<float>(400.0 + 150.0 * std::sin(2.0 * CV_PI * 0.35 * t + 1.0)),
+                                            28.0f, 12.0f, 12.0f));
+            sequence[i].push_back(makeArmor(static_cast<float>(640.0 - 350.0 * std::sin(2.0 * CV_PI * 0.4 * t)), 760.0f,
+                                            24.0f, 10.0f, 10.0f));
+        } else if (name == "spin") {
+            const double centerX = 640.0 + 200.0 * std::sin(2.0 * CV_PI * 0.2 * t), radius = 150.0;
+            for (int k = 0; k < 4; ++k) {
+                const double theta = std::remainder(2.0 * CV_PI * 1.5 * t + k * CV_PI / 2.0, 2.0 * CV_PI);
+                if (std::fabs(theta) >= CV_PI / 3.0) {
+                    continue;
+                }
+                // 正对时宽56像素，转过去时变窄，远离相机的一侧灯条变短
+                const float side = static_cast<float>(std::sin(theta));
+                sequence[i].push_back(makeArmor(static_cast<float>(centerX + radius * side), 520.0f,
+                                                static_cast<float>(28.0 * std::cos(theta)), 12.0f * (1.0f - 0.15f * side),
+                                                12.0f * (1.0f + 0.15f * side)));
+            }
+        } else {
+            if (i == nextTurn) {
+                // 速度大小不变，方向在四个象限间跳变
+                vx = (i / 7) % 2 == 0 ? -vx : vx;
+                vy = (i / 11) % 2 == 0 ? vy : -vy;
+                nextTurn += 20 + (i * 7) % 31;
+            }
+            if (x + vx < 100.0f || x + vx > TRACK_WIDTH - 100.0f) {
+                vx = -vx;
+            }
+            if (y + vy < 100.0f || y + vy > TRACK_HEIGHT - 100.0f) {
+                vy = -vy;
+            }
+            x += vx;
+            y += vy;
+            sequence[i].push_back(makeArmor(x, y, 28.0f, 12.0f, 12.0f));
+        }
+    }
+    return sequence;
+}
+
+/**
+ * @brief 跳帧检测与每帧推理并排回放的结果
+ */
+struct TrackResult {
+    std::vector<float> m_errors;  // 与每帧推理结果匹配上的装甲板的平均角点误差，像素
+    int m_reference = 0;          // 每帧推理输出的装甲板总数
+    int m_missed = 0;             // 每帧推理有、跟踪没有输出
+    int m_false = 0;              // 跟踪输出、每帧推理没有
+    deploy::LatencyHistogram m_latency;
+    TrackerStats m_stats;
+
+    float percentile(const double p) const {
+        if (m_errors.empty()) {
+            return 0.0f;
+        }
+        std::vector<float> sorted = m_errors;
+        std::sort(sorted.begin(), sorted.end());
+        return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p / 100.0 * sorted.size()))];
+    }
+    float mean() const {
+        double sum = 0.0;
+        for (const float error : m_errors) {
+            sum += error;
+        }
+        return m_errors.empty() ? 0.0f : static_cast<float>(sum / m_errors.size());
+    }
+    // 漏检和误检占每帧推理输出的比例
+    double mismatched() const { return static_cast<double>(m_missed + m_false) / std::max(m_reference, 1); }
+};
+
+/**
+ * @brief 按中心距离一一匹配跳帧检测与每帧推理的输出，累计角点误差、漏检和误检
+ */
+inline void matchArmors(const std::vector<Armor> &expected, const std::vector<Armor> &armors, TrackResult &result) {
+    std::vector<bool> used(armors.size(), false);
+    int matched = 0;
+    for (const auto &armor : expected) {
+        int best = -1;
+        float bestDistance = TRACK_MATCH_DISTANCE;
+        for (size_t k = 0; k < armors.size(); ++k) {
+            const float distance = static_cast<float>(cv::norm(armors[k].m_centerUV - armor.m_centerUV));
+            if (!used[k] && distance < bestDistance) {
+                best = static_cast<int>(k);
+                bestDistance = distance;
+            }
+        }
+        if (best < 0) {
+            ++result.m_missed;
+            continue;
+        }
+        used[best] = true;
+        ++matched;
+        const Corners a = CornerTracker::corners(armor), b = CornerTracker::corners(armors[best]);
+        float error = 0.0f;
+        for (int j = 0; j < 4; ++j) {
+            error += static_cast<float>(cv::norm(a[j] - b[j]));
+        }
+        result.m_errors.push_back(error / 4);
+    }
+    result.m_reference += static_cast<int>(expected.size());
+    result.m_false += static_cast<int>(armors.size()) - matched;
+}
+
+inline std::unique_ptr<ArmorDetectorNN> makeTrackDetector(const TrackScene *scene) {
+    return std::make_unique<ArmorDetectorNN>(
+        std::make_unique<deploy::PoseModel>(std::make_unique<TrackSceneBackend>(scene)), 0.5f);
+}
+
+/**
+ * @brief 每帧推理的检测器与跳帧检测并排回放同一序列，误差以每帧推理的结果为准
+ */
+inline TrackResult replayTrack(const std::vector<CornerTruth> &sequence, const TrackerConfig &config) {
+    TrackScene scene;
+    const cv::Mat image(TRACK_HEIGHT, TRACK_WIDTH, CV_8UC3, cv::Scalar(40, 40, 40));
+    const std::unique_ptr<ArmorDetectorNN> reference = makeTrackDetector(&scene);
+    TrackingDetector tracking(makeTrackDetector(&scene), config);
+    const RecvInfoBase recvInfo(0.0, 0.0, 0.0, 25.0, BLUE, true);  // 敌方蓝色，类别0-8
+    const TimePoint origin = std::chrono::steady_clock::now();
+
+    TrackResult result;
+    std::vector<Armor> expected, armors;
+    for (int i = 0; i < static_cast<int>(sequence.size()); ++i) {
+        scene.m_frame = static_cast<uint32_t>(i);
+        scene.m_truth = &sequence[i];
+        const Frame frame(image, origin + std::chrono::microseconds(static_cast<int64_t>(i * TRACK_FRAME_SECONDS * 1e6)));
+        reference->apply(frame, recvInfo, ROI(), expected);
+        const auto start = std::chrono::steady_clock::now();
+        tracking.apply(frame, recvInfo, ROI(), armors);
+        result.m_latency.record(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+        matchArmors(expected, armors, result);
+    }
+    result.m_stats = tracking.stats();
+    return result;
+}
+
+}  // namespace hitcrt::bench
@@ -0,0 +1,82 @@
+/**
+ * @file WarpAffineBench.cpp
+ * @brief CPU预处理：融合SIMD核、标量参考实现与OpenCV多步预处理的吞吐对比
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>与参考实现的一致性检查移到test/WarpAffineTest.cpp
+ * </table>
+ */
+#include <cmath>
+#include <cstdint>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "infer/affine.hpp"
+#include "infer/cpu_warpaffine.hpp"
+
+namespace {
+constexpr int SRC_WIDTH = 1280;
+constexpr int SRC_HEIGHT = 1024;
+constexpr int DST_SIZE = 640;
+constexpr int ITERATIONS = 200;
+}  // namespace
+
+// 用法：warpAffineBench
+// 在1280x1024->640x640上对比三种预处理的单线程耗时
+int main() {
+    cv::setNumThreads(1);
+    cv::Mat image(SRC_HEIGHT, SRC_WIDTH, CV_8UC3);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+
+    deploy::AffineTransform transform;
+    transform.updateMatrix(SRC_WIDTH, SRC_HEIGHT, DST_SIZE, DST_SIZE);
+    const deploy::float3 matrix[2] = {transform.matrix[0], transform.matrix[1]};
+    deploy::ProcessConfig config;
+    config.enableSwapRB();
+
+    const size_t plane = static_cast<size_t>(DST_SIZE) * DST_SIZE;
+    std::vector<float> blob(3 * plane);
+    std::vector<uint16_t> blob_half(3 * plane);
+
+    // 改造前的做法：resize + copyMakeBorder + cvtColor + convertTo + split
+    cv::Mat resized, padded, rgb, normalized;
+    std::vector<cv::Mat> planes;
+    for (int c = 0; c < 3; ++c) {
+        planes.emplace_back(DST_SIZE, DST_SIZE, CV_32F, blob.data() + c * plane);
+    }
+    // matrix是目标到源的映射，缩放系数取倒数
+    const float scale = 1.0f / matrix[0].x;
+    const int new_width = static_cast<int>(std::round(SRC_WIDTH * scale));
+    const int new_height = static_cast<int>(std::round(SRC_HEIGHT * scale));
+    const int top = (DST_SIZE - new_height) / 2, left = (DST_SIZE - new_width) / 2;
+    hitcrt::bench::print(hitcrt::bench::run("opencv resize+border+cvt+convert", ITERATIONS, [&] {
+        cv::resize(image, resized, cv::Size(new_width, new_height));
+        cv::copyMakeBorder(resized, padded, top, DST_SIZE - new_height - top, left, DST_SIZE - new_width - left,
+                           cv::BORDER_CONSTANT, cv::Scalar::all(config.border_value));
+        cv::cvtColor(padded, rgb, cv::COLOR_BGR2RGB);
+        rgb.convertTo(normalized, CV_32F, config.alpha.x, config.beta.x);
+        cv::split(normalized, planes);
+    }));
+
+    hitcrt::bench::print(hitcrt::bench::run("scalar reference fp32", ITERATIONS, [&] {
+        deploy::cpuWarpAffineReference(image.data, SRC_WIDTH, SRC_HEIGHT, blob.data(), DST_SIZE, DST_SIZE, matrix,
+                                       config);
+    }));
+    hitcrt::bench::print(hitcrt::bench::run("fused simd fp32", ITERATIONS, [&] {
+        deploy::cpuWarpAffine(image.data, SRC_WIDTH, SRC_HEIGHT, blob.data(), DST_SIZE, DST_SIZE, matrix, config);
+    }));
+    hitcrt::bench::print(hitcrt::bench::run("fused simd fp16", ITERATIONS, [&] {
+        deploy::cpuWarpAffine(image.data, SRC_WIDTH, SRC_HEIGHT, blob_half.data(), DST_SIZE, DST_SIZE, matrix, config,
+                              deploy::PlanarType::Float16);
+    }));
+    return 0;
+}
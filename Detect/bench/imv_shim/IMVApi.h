@@ -0,0 +1,149 @@
+/**
+ * @file IMVApi.h
+ * @brief Huaray SDK替身：只声明HuarayCam用到的类型和接口，供没有相机和SDK的机器上测试驱动
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ * @note 结构体只保留驱动访问到的字段，布局与真实SDK不同，不能与libMVSDK混用
+ */
+#pragma once
+#include <cstdint>
+
+#define IMV_OK 0
+#define IMV_ERROR -101
+#define IMV_INVALID_HANDLE -102
+#define IMV_INVALID_PARAM -103
+#define IMV_NO_DATA -119
+
+#define IMV_MAX_STRING_LENTH 256
+
+typedef void* IMV_HANDLE;
+
+enum IMV_EInterfaceType { interfaceTypeGige = 0x1, interfaceTypeUsb3 = 0x2, interfaceTypeAll = 0xFFFFFFFF };
+enum IMV_ECameraType { typeGigeCamera = 0, typeU3vCamera = 1, typeCLCamera = 2, typePCIeCamera = 3 };
+enum IMV_ECreateHandleMode { modeByIndex = 0, modeByCameraKey, modeByDeviceUserID, modeByIPAddress };
+enum IMV_EPixelType { gvspPixelMono8 = 0x01080001, gvspPixelBayRG8 = 0x01080009, gvspPixelBGR8 = 0x02180015 };
+enum IMV_EBayerDemosaic { demosaicNearestNeighbor = 0, demosaicBilinear, demosaicEdgeSensing };
+enum IMV_EVType { offLine = 0, onLine };
+
+typedef struct {
+    char str[IMV_MAX_STRING_LENTH];
+} IMV_String;
+
+typedef struct {
+    char ipAddress[IMV_MAX_STRING_LENTH];
+} IMV_GigEDeviceInfo;
+
+typedef struct {
+    IMV_ECameraType nCameraType;
+    char cameraKey[IMV_MAX_STRING_LENTH];
+    char cameraName[IMV_MAX_STRING_LENTH];
+    char serialNumber[IMV_MAX_STRING_LENTH];
+    char vendorName[IMV_MAX_STRING_LENTH];
+    char modelName[IMV_MAX_STRING_LENTH];
+    struct {
+        IMV_GigEDeviceInfo gigeDeviceInfo;
+    } DeviceSpecificInfo;
+} IMV_DeviceInfo;
+
+typedef struct {
+    unsigned int nDevNum;
+    IMV_DeviceInfo* pDevInfo;
+} IMV_DeviceList;
+
+typedef struct {
+    unsigned int nParamCnt;
+    IMV_String paramNameList[1];
+} IMV_ErrorList;
+
+typedef struct {
+    uint64_t blockId;
+    unsigned int status;
+    unsigned int width;
+    unsigned int height;
+    unsigned int size;
+    IMV_EPixelType pixelFormat;
+    uint64_t timeStamp;
+    unsigned int paddingX;
+    unsigned int paddingY;
+} IMV_FrameInfo;
+
+typedef struct {
+    void* frameHandle;
+    unsigned char* pData;
+    IMV_FrameInfo frameInfo;
+} IMV_Frame;
+
+typedef struct {
+    unsigned int nWidth;
+    unsigned int nHeight;
+    IMV_EPixelType ePixelFormat;
+    unsigned char* pSrcData;
+    unsigned int nSrcDataLen;
+    unsigned int nPaddingX;
+    unsigned int nPaddingY;
+    IMV_EBayerDemosaic eBayerDemosaic;
+    IMV_EPixelType eDstPixelFormat;
+    unsigned char* pDstBuf;
+    unsigned int nDstBufSize;
+    unsigned int nDstDataLen;
+} IMV_PixelConvertParam;
+
+typedef struct {
+    unsigned int imageError;
+    unsigned int lostPacketBlock;
+    unsigned int imageReceived;
+    double fps;
+    double bandwidth;
+} IMV_U3VStreamStatsInfo;
+
+typedef struct {
+    IMV_ECameraType nCameraType;
+    IMV_U3VStreamStatsInfo u3vStatisticsInfo;
+} IMV_StreamStatisticsInfo;
+
+typedef struct {
+    IMV_EVType event;
+} IMV_SConnectArg;
+
+typedef void (*IMV_FrameCallBack)(IMV_Frame* pFrame, void* pUser);
+typedef void (*IMV_ConnectCallBack)(const IMV_SConnectArg* pConnectArg, void* pUser);
+
+int IMV_EnumDevices(IMV_DeviceList* pDeviceList, unsigned int interfaceType);
+int IMV_CreateHandle(IMV_HANDLE* handle, IMV_ECreateHandleMode mode, void* pIdentifier);
+int IMV_DestroyHandle(IMV_HANDLE handle);
+int IMV_GetDeviceInfo(IMV_HANDLE handle, IMV_DeviceInfo* pDevInfo);
+int IMV_Open(IMV_HANDLE handle);
+int IMV_Close(IMV_HANDLE handle);
+bool IMV_IsOpen(IMV_HANDLE handle);
+bool IMV_IsGrabbing(IMV_HANDLE handle);
+int IMV_StartGrabbing(IMV_HANDLE handle);
+int IMV_StopGrabbing(IMV_HANDLE handle);
+int IMV_AttachGrabbing(IMV_HANDLE handle, IMV_FrameCallBack proc, void* pUser);
+int IMV_GetFrame(IMV_HANDLE handle, IMV_Frame* pFrame, unsigned int timeoutMS);
+int IMV_ReleaseFrame(IMV_HANDLE handle, IMV_Frame* pFrame);
+int IMV_ClearFrameBuffer(IMV_HANDLE handle);
+int IMV_SetBufferCount(IMV_HANDLE handle, unsigned int nSize);
+int IMV_GetStatisticsInfo(IMV_HANDLE handle, IMV_StreamStatisticsInfo* pStreamStatsInfo);
+int IMV_ResetStatisticsInfo(IMV_HANDLE handle);
+int IMV_SubscribeConnectArg(IMV_HANDLE handle, IMV_ConnectCallBack proc, void* pUser);
+int IMV_GetIntFeatureValue(IMV_HANDLE handle, const char* pFeatureName, int64_t* pIntValue);
+int IMV_SetIntFeatureValue(IMV_HANDLE handle, const char* pFeatureName, int64_t intValue);
+int IMV_GetDoubleFeatureValue(IMV_HANDLE handle, const char* pFeatureName, double* pDoubleValue);
+int IMV_SetDoubleFeatureValue(IMV_HANDLE handle, const char* pFeatureName, double doubleValue);
+int IMV_GetBoolFeatureValue(IMV_HANDLE handle, const char* pFeatureName, bool* pBoolValue);
+int IMV_SetBoolFeatureValue(IMV_HANDLE handle, const char* pFeatureName, bool boolValue);
+int IMV_SetEnumFeatureValue(IMV_HANDLE handle, const char* pFeatureName, uint64_t enumValue);
+int IMV_GetEnumFeatureSymbol(IMV_HANDLE handle, const char* pFeatureName, IMV_String* pEnumSymbol);
+int IMV_SetEnumFeatureSymbol(IMV_HANDLE handle, const char* pFeatureName, const char* pEnumSymbol);
+int IMV_ExecuteCommandFeature(IMV_HANDLE handle, const char* pFeatureName);
+int IMV_SaveDeviceCfg(IMV_HANDLE handle, const char* pFullPath);
+int IMV_LoadDeviceCfg(IMV_HANDLE handle, const char* pFullPath, IMV_ErrorList* pErrorList);
+int IMV_PixelConvert(IMV_HANDLE handle, IMV_PixelConvertParam* pstPixelConvertParam);
@@ -0,0 +1,325 @@
+/**
+ * @file IMVShim.cpp
+ * @brief Huaray SDK替身：特征读写存在表里，取图和回调由测试程序驱动
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include "IMVShim.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace {
+
+struct Device {
+    std::mutex m_mutex;
+    std::map<std::string, int64_t> m_intFeatures;
+    std::map<std::string, double> m_doubleFeatures;
+    bool m_open = false;
+    bool m_grabbing = false;
+    IMV_FrameCallBack m_frameCallBack = nullptr;
+    void* m_frameUser = nullptr;
+    // SDK缓存中等IMV_GetFrame取走的帧，没有释放的帧也占缓存
+    std::condition_variable m_frameCond;
+    // 定长环形队列，出入队不申请内存（SDK缓存最多32帧）
+    std::array<std::pair<const uint8_t*, uint64_t>, 32> m_pending;
+    unsigned int m_head = 0;
+    unsigned int m_count = 0;
+    unsigned int m_bufferCount = 8;
+    unsigned int m_outstanding = 0;  // 已取走未释放
+    std::atomic<uint64_t> m_converts{0};
+    std::atomic<uint64_t> m_released{0};
+    std::atomic<uint64_t> m_dropped{0};
+};
+
+Device g_device;
+IMV_DeviceInfo g_deviceInfo;
+int g_handle = 0;  // 句柄只需要非空
+
+IMV_Frame makeFrame(const uint8_t* raw, const uint64_t blockId) {
+    IMV_Frame frame;
+    std::memset(&frame, 0, sizeof(frame));
+    const unsigned int width = static_cast<unsigned int>(g_device.m_intFeatures["Width"]);
+    const unsigned int height = static_cast<unsigned int>(g_device.m_intFeatures["Height"]);
+    frame.pData = const_cast<uint8_t*>(raw);
+    frame.frameInfo.blockId = blockId;
+    frame.frameInfo.width = width;
+    frame.frameInfo.height = height;
+    frame.frameInfo.size = width * height;
+    frame.frameInfo.pixelFormat = gvspPixelBayRG8;
+    // 硬件时间戳取出帧时刻，单位ns，与真实相机一样和本机时钟不同源
+    frame.frameInfo.timeStamp = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+            .count());
+    return frame;
+}
+}  // namespace
+
+namespace hitcrt::camera::imvshim {
+
+void reset(const int width, const int height) {
+    std::lock_guard<std::mutex> lock(g_device.m_mutex);
+    g_device.m_intFeatures.clear();
+    g_device.m_doubleFeatures.clear();
+    g_device.m_intFeatures["Width"] = width;
+    g_device.m_intFeatures["Height"] = height;
+    g_device.m_open = false;
+    g_device.m_grabbing = false;
+    g_device.m_frameCallBack = nullptr;
+    g_device.m_frameUser = nullptr;
+    g_device.m_head = 0;
+    g_device.m_count = 0;
+    g_device.m_bufferCount = 8;
+    g_device.m_outstanding = 0;
+    g_device.m_converts = 0;
+    g_device.m_released = 0;
+    g_device.m_dropped = 0;
+
+    std::memset(&g_deviceInfo, 0, sizeof(g_deviceInfo));
+    g_deviceInfo.nCameraType = typeU3vCamera;
+    std::strcpy(g_deviceInfo.vendorName, "Huaray Technology");
+    std::strcpy(g_deviceInfo.modelName, "IMV-SHIM");
+    std::strcpy(g_deviceInfo.serialNumber, "SHIM0001");
+    std::strcpy(g_deviceInfo.cameraKey, "Huaray:SHIM0001");
+}
+
+bool deliver(const uint8_t* raw, const uint64_t blockId) {
+    IMV_FrameCallBack callBack = nullptr;
+    void* user = nullptr;
+    IMV_Frame frame;
+    {
+        std::lock_guard<std::mutex> lock(g_device.m_mutex);
+        if (!g_device.m_grabbing || g_device.m_frameCallBack == nullptr) {
+            return false;
+        }
+        callBack = g_device.m_frameCallBack;
+        user = g_device.m_frameUser;
+        frame = makeFrame(raw, blockId);
+    }
+    callBack(&frame, user);
+    return true;
+}
+
+bool queue(const uint8_t* raw, const uint64_t blockId) {
+    {
+        std::lock_guard<std::mutex> lock(g_device.m_mutex);
+        if (g_device.m_count + g_device.m_outstanding >= g_device.m_bufferCount) {
+            g_device.m_dropped.fetch_add(1);
+            return false;
+        }
+        const unsigned int tail = (g_device.m_head + g_device.m_count) % g_device.m_pending.size();
+        g_device.m_pending[tail] = std::make_pair(raw, blockId);
+        ++g_device.m_count;
+    }
+    g_device.m_frameCond.notify_one();
+    return true;
+}
+
+uint64_t pixelConvertCalls() { return g_device.m_converts.load(); }
+
+uint64_t releasedFrames() { return g_device.m_released.load(); }
+
+uint64_t sdkDropped() { return g_device.m_dropped.load(); }
+
+}  // namespace hitcrt::camera::imvshim
+
+// ============================== SDK接口 ==============================
+int IMV_EnumDevices(IMV_DeviceList* pDeviceList, unsigned int interfaceType) {
+    pDeviceList->nDevNum = 1;
+    pDeviceList->pDevInfo = &g_deviceInfo;
+    return IMV_OK;
+}
+
+int IMV_CreateHandle(IMV_HANDLE* handle, IMV_ECreateHandleMode mode, void* pIdentifier) {
+    *handle = &g_handle;
+    return IMV_OK;
+}
+
+int IMV_DestroyHandle(IMV_HANDLE handle) { return IMV_OK; }
+
+int IMV_GetDeviceInfo(IMV_HANDLE handle, IMV_DeviceInfo* pDevInfo) {
+    *pDevInfo = g_deviceInfo;
+    return IMV_OK;
+}
+
+int IMV_Open(IMV_HANDLE handle) {
+    std::lock_guard<std::mutex> lock(g_device.m_mutex);
+    g_device.m_open = true;
+    return IMV_OK;
+}
+
+int IMV_Close(IMV_HANDLE handle) {
+    std::lock_guard<std::mutex> lock(g_device.m_mutex);
+    g_device.m_open = false;
+    return IMV_OK;
+}
+
+bool IMV_IsOpen(IMV_HANDLE handle) {
+    std::lock_guard<std::mutex> lock(g_device.m_mutex);
+    return g_device.m_open;
+}
+
+bool IMV_IsGrabbing(IMV_HANDLE handle) {
+    std::lock_guard<std::mutex> lock(g_device.m_mutex);
+    return g_device.m_grabbing;
+}
+
+int IMV_StartGrabbing(IMV_HANDLE handle) {
+    std::lock_guard<std::mutex> lock(g_device.m_mutex);
+    g_device.m_grabbing = g_device.m_open;
+    return g_device.m_open ? IMV_OK : IMV_ERROR;
+}
+
+int IMV_StopGrabbing(IMV_HANDLE handle) {
+    {
+        std::lock_guard<std::mutex> lock(g_device.m_mutex);
+        g_device.m_grabbing = false;
+        g_device.m_count = 0;
+    }
+    g_device.m_frameCond.notify_all();
+    return IMV_OK;
+}
+
+int IMV_AttachGrabbing(IMV_HANDLE handle, IMV_FrameCallBack proc, void* pUser) {
+    std::lock_guard<std::mutex> lock(g_device.m_mutex);
+    g_device.m_frameCallBack = proc;
+    g_device.m_frameUser = pUser;
+    return IMV_OK;
+}
+
+int IMV_GetFrame(IMV_HANDLE handle, IMV_Frame* pFrame, unsigned int timeoutMS) {
+    std::unique_lock<std::mutex> lock(g_device.m_mutex);
+    if (!g_device.m_frameCond.wait_for(lock, std::chrono::milliseconds(timeoutMS),
+                                       [] { return g_device.m_count > 0 || !g_device.m_grabbing; }) ||
+        g_device.m_count == 0) {
+        return IMV_NO_DATA;
+    }
+    const auto& pending = g_device.m_pending[g_device.m_head];
+    *pFrame = makeFrame(pending.first, pending.second);
+    g_device.m_head = (g_device.m_head + 1) % g_device.m_pending.size();
+    --g_device.m_count;
+    ++g_device.m_outstanding;
+    return IMV_OK;
+}
+
+int IMV_ReleaseFrame(IMV_HANDLE handle, IMV_Frame* pFrame) {
+    {
+        std::lock_guard<std::mutex> lock(g_device.m_mutex);
+        if (g_device.m_outstanding > 0) {
+            --g_device.m_outstanding;
+        }
+    }
+    g_device.m_released.fetch_add(1);
+    return IMV_OK;
+}
+
+int IMV_ClearFrameBuffer(IMV_HANDLE handle) {
+    std::lock_guard<std::mutex> lock(g_device.m_mutex);
+    g_device.m_count = 0;
+    return IMV_OK;
+}
+
+int IMV_SetBufferCount(IMV_HANDLE handle, unsigned int nSize) {
+    std::lock_guard<std::mutex> lock(g_device.m_mutex);
+    g_device.m_bufferCount = std::min<unsigned int>(nSize, g_device.m_pending.size());
+    return IMV_OK;
+}
+
+int IMV_GetStatisticsInfo(IMV_HANDLE handle, IMV_StreamStatisticsInfo* pStreamStatsInfo) {
+    std::memset(pStreamStatsInfo, 0, sizeof(*pStreamStatsInfo));
+    pStreamStatsInfo->nCameraType = typeU3vCamera;
+    return IMV_OK;
+}
+
+int IMV_ResetStatisticsInfo(IMV_HANDLE handle) { return IMV_OK; }
+
+int IMV_SubscribeConnectArg(IMV_HANDLE handle, IMV_ConnectCallBack proc, void* pUser) { return IMV_OK; }
+
+int IMV_GetIntFeatureValue(IMV_HANDLE handle, const char* pFeatureName, int64_t* pIntValue) {
+    std::lock_guard<std::mutex> lock(g_device.m_mutex);
+    *pIntValue = g_device.m_intFeatures[pFeatureName];
+    return IMV_OK;
+}
+
+int IMV_SetIntFeatureValue(IMV_HANDLE handle, const char* pFeatureName, int64_t intValue) {
+    std::lock_guard<std::mutex> lock(g_device.m_mutex);
+    g_device.m_intFeatures[pFeatureName] = intValue;
+    return IMV_OK;
+}
+
+int IMV_GetDoubleFeatureValue(IMV_HANDLE handle, const char* pFeatureName, double* pDoubleValue) {
+    std::lock_guard<std::mutex> lock(g_device.m_mutex);
+    *pDoubleValue = g_device.m_doubleFeatures[pFeatureName];
+    return IMV_OK;
+}
+
+int IMV_SetDoubleFeatureValue(IMV_HANDLE handle, const char* pFeatureName, double doubleValue) {
+    std::lock_guard<std::mutex> lock(g_device.m_mutex);
+    g_device.m_doubleFeatures[pFeatureName] = doubleValue;
+    return IMV_OK;
+}
+
+int IMV_GetBoolFeatureValue(IMV_HANDLE handle, const char* pFeatureName, bool* pBoolValue) {
+    *pBoolValue = false;
+    return IMV_OK;
+}
+
+int IMV_SetBoolFeatureValue(IMV_HANDLE handle, const char* pFeatureName, bool boolValue) { return IMV_OK; }
+
+int IMV_SetEnumFeatureValue(IMV_HANDLE handle, const char* pFeatureName, uint64_t enumValue) { return IMV_OK; }
+
+int IMV_GetEnumFeatureSymbol(IMV_HANDLE handle, const char* pFeatureName, IMV_String* pEnumSymbol) {
+    std::strcpy(pEnumSymbol->str, "Off");
+    return IMV_OK;
+}
+
+int IMV_SetEnumFeatureSymbol(IMV_HANDLE handle, const char* pFeatureName, const char* pEnumSymbol) {
+    return IMV_OK;
+}
+
+int IMV_ExecuteCommandFeature(IMV_HANDLE handle, const char* pFeatureName) { return IMV_OK; }
+
+int IMV_SaveDeviceCfg(IMV_HANDLE handle, const char* pFullPath) { return IMV_OK; }
+
+int IMV_LoadDeviceCfg(IMV_HANDLE handle, const char* pFullPath, IMV_ErrorList* pErrorList) { return IMV_OK; }
+
+/**
+ * @brief 最近邻去马赛克到BGR8，只检查输出缓冲区大小，不申请内存
+ */
+int IMV_PixelConvert(IMV_HANDLE handle, IMV_PixelConvertParam* pstPixelConvertParam) {
+    IMV_PixelConvertParam& param = *pstPixelConvertParam;
+    const unsigned int width = param.nWidth, height = param.nHeight;
+    if (param.pDstBuf == nullptr || param.nDstBufSize < width * height * 3) {
+        return IMV_INVALID_PARAM;
+    }
+    for (unsigned int y = 0; y < height; ++y) {
+        const uint8_t* top = param.pSrcData + (y & ~1u) * width;
+        const uint8_t* bottom = top + width;
+        uint8_t* out = param.pDstBuf + static_cast<size_t>(y) * width * 3;
+        for (unsigned int x = 0; x < width; ++x) {
+            const unsigned int cell = x & ~1u;
+            out[3 * x + 0] = bottom[cell + 1];
+            out[3 * x + 1] = top[cell + 1];
+            out[3 * x + 2] = top[cell];
+        }
+    }
+    param.nDstDataLen = width * height * 3;
+    g_device.m_converts.fetch_add(1);
+    return IMV_OK;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file IMVShim.h
+ * @brief Huaray SDK替身的控制接口：设定传感器尺寸，模拟相机出帧
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#pragma once
+#include <cstdint>
+
+#include "IMVApi.h"
+
+namespace hitcrt::camera::imvshim {
+
+// 替身里只有一台相机，宽高即"Width"/"Height"特征的初值
+void reset(const int width, const int height);
+
+// 拉流且注册了回调时，在调用线程里同步回调一帧BayerRG8原图，返回是否回调
+bool deliver(const uint8_t* raw, const uint64_t blockId);
+
+// 相机出一帧放进SDK缓存供IMV_GetFrame取走，原图内存由调用方保持有效
+// 缓存帧数由IMV_SetBufferCount设置（默认8），缓存满时丢掉这一帧并返回false，与SDK一样
+bool queue(const uint8_t* raw, const uint64_t blockId);
+
+// 调用计数
+uint64_t pixelConvertCalls();
+uint64_t releasedFrames();
+// SDK缓存满丢掉的帧数
+uint64_t sdkDropped();
+
+}  // namespace hitcrt::camera::imvshim
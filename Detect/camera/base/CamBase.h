@@ -86,7 +86,7 @@ class CameraParams {
                 return "Unknown";
         }
     }
-    const CallBack onCall() const { return m_onCall; }
+    const CallBack& onCall() const { return m_onCall; }
     const std::string path() const { return m_path; }
     static void noUse(const TimePoint&, const cv::Mat&) {}
 
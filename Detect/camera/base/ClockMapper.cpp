@@ -0,0 +1,145 @@
+/**
+ * @file ClockMapper.cpp
+ * @brief 时钟域映射
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>帧时间戳改用相机硬件时钟映射到本机时钟
+ * </table>
+ */
+#include "ClockMapper.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace hitcrt::camera {
+
+ClockMapper::ClockMapper(const Duration segment, const size_t segments, const Duration resetGap)
+    : m_segment(segment), m_segments(std::max<size_t>(segments, 2)), m_resetGap(resetGap) {
+    m_points.reserve(m_segments);
+}
+
+/**
+ * @brief 清空样本和模型，固定延迟保留
+ */
+void ClockMapper::reset() {
+    m_started = false;
+    m_points.clear();
+    m_pointNext = 0;
+    m_segmentIndex = 0;
+    m_fitted = false;
+    m_offset = 0.0;
+    m_drift = 0.0;
+    m_samples = 0;
+}
+
+/**
+ * @brief 输入一对样本，更新模型
+ * @param[in] sourceNs      源时钟读数，ns
+ * @param[in] receiveTime   本机收到这一帧的时刻
+ * @return TimePoint 映射到本机时钟的时刻，不晚于receiveTime
+ */
+TimePoint ClockMapper::update(const int64_t sourceNs, const TimePoint& receiveTime) {
+    const int64_t hostNs = std::chrono::duration_cast<Duration>(receiveTime.time_since_epoch()).count();
+    if (m_started) {
+        // 源时钟倒退或跳变，之前的模型作废
+        const int64_t sourceStep = sourceNs - m_lastSource;
+        const int64_t hostStep = hostNs - m_lastHost;
+        if (sourceStep < 0 || std::llabs(sourceStep - hostStep) > m_resetGap.count()) {
+            reset();
+            ++m_resets;
+        }
+    }
+    m_lastSource = sourceNs;
+    m_lastHost = hostNs;
+    ++m_samples;
+
+    if (!m_started) {
+        m_started = true;
+        m_originSource = sourceNs;
+        m_originHost = hostNs;
+        m_segmentIndex = 0;
+        m_current = Point();
+        m_offset = 0.0;
+        return receiveTime - m_latency;
+    }
+
+    Point point;
+    point.m_x = sourceNs - m_originSource;
+    point.m_y = hostNs - m_originHost - point.m_x;
+    const int64_t segmentIndex = point.m_x / m_segment.count();
+    if (segmentIndex != m_segmentIndex) {
+        // 上一段结束，它的下包络点参与拟合
+        if (m_points.size() < m_segments) {
+            m_points.push_back(m_current);
+        } else {
+            m_points[m_pointNext] = m_current;
+        }
+        m_pointNext = (m_pointNext + 1) % m_segments;
+        m_segmentIndex = segmentIndex;
+        m_current = point;
+        fit();
+    } else if (point.m_y < m_current.m_y) {
+        m_current = point;
+    }
+    // 拟合出漂移之前只估计偏移
+    if (!m_fitted) {
+        m_offset = static_cast<double>(m_current.m_y);
+        for (const Point& ended : m_points) {
+            m_offset = std::min(m_offset, static_cast<double>(ended.m_y));
+        }
+    }
+    return std::min(map(sourceNs), receiveTime - m_latency);
+}
+
+/**
+ * @brief 按当前模型把源时钟读数映射到本机时钟
+ * @param[in] sourceNs  源时钟读数，ns
+ * @return TimePoint
+ */
+TimePoint ClockMapper::map(const int64_t sourceNs) const {
+    if (!m_started) {
+        return TimePoint();
+    }
+    const int64_t x = sourceNs - m_originSource;
+    const int64_t y = static_cast<int64_t>(std::llround(m_offset + m_drift * static_cast<double>(x)));
+    return TimePoint(std::chrono::duration_cast<Clock::duration>(Duration(m_originHost + x + y))) - m_latency;
+}
+
+/**
+ * @brief 对已结束各段的下包络点做最小二乘，至少两段才拟合
+ */
+void ClockMapper::fit() {
+    if (m_points.size() < 2) {
+        return;
+    }
+    // 先求均值再求中心化的协方差，避免大数平方相减
+    double meanX = 0.0;
+    double meanY = 0.0;
+    for (const Point& point : m_points) {
+        meanX += static_cast<double>(point.m_x);
+        meanY += static_cast<double>(point.m_y);
+    }
+    meanX /= static_cast<double>(m_points.size());
+    meanY /= static_cast<double>(m_points.size());
+    double sxx = 0.0;
+    double sxy = 0.0;
+    for (const Point& point : m_points) {
+        const double dx = static_cast<double>(point.m_x) - meanX;
+        sxx += dx * dx;
+        sxy += dx * (static_cast<double>(point.m_y) - meanY);
+    }
+    if (sxx <= 0.0) {
+        return;
+    }
+    m_drift = sxy / sxx;
+    m_offset = meanY - m_drift * meanX;
+    m_fitted = true;
+}
+
+}  // namespace hitcrt::camera
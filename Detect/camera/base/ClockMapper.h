@@ -0,0 +1,101 @@
+/**
+ * @file ClockMapper.h
+ * @brief 时钟域映射：在线拟合源时钟（相机硬件时钟、仿真消息时间戳）相对本机steady_clock的偏移和漂移
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>帧时间戳改用相机硬件时钟映射到本机时钟
+ * </table>
+ */
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "CamBase.h"
+
+namespace hitcrt::camera {
+
+/**
+ * @brief 源时钟到本机steady_clock的线性映射 host = source + offset + drift * source
+ *
+ * 每帧输入一对样本：源时钟读数和本机收到这一帧的时刻。收到时刻 = 真实时刻 + 最小传输延迟 + 排队抖动，
+ * 抖动只会让收到时刻变晚，所以按源时钟把样本分成等长的段，每段只留 收到时刻 - 源时钟 最小的样本（下包络），
+ * 再对最近若干段的下包络做最小二乘，得到偏移和漂移。映射结果是按最小传输延迟到达的时刻，
+ * 再减去setLatency设定的固定延迟即为曝光时刻。
+ * 源时钟倒退或与本机时钟的走时差超过重置阈值（相机重启、仿真时间跳变）时清空重新拟合。
+ * 不是线程安全的，一个源时钟一个对象。
+ */
+class ClockMapper {
+   public:
+    using Duration = std::chrono::nanoseconds;
+
+    /**
+     * @param[in] segment   分段长度（源时钟），每段取一个下包络点
+     * @param[in] segments  参与拟合的段数，segment * segments 即拟合的时间跨度
+     * @param[in] resetGap  源时钟与本机时钟走时差超过此值时重置
+     */
+    ClockMapper(const Duration segment = std::chrono::milliseconds(500), const size_t segments = 32,
+                const Duration resetGap = std::chrono::seconds(1));
+
+    // 输入一对样本并返回这一帧映射到本机时钟的时刻，源时钟单位ns
+    TimePoint update(const int64_t sourceNs, const TimePoint& receiveTime);
+    // 按当前模型映射，还没有样本时返回纪元时刻
+    TimePoint map(const int64_t sourceNs) const;
+    void reset();
+
+    // setters
+    // 最小传输延迟中不可观测的固定部分（读出、USB/网络的最短耗时），映射结果减去此值
+    void setLatency(const Duration& latency) { m_latency = latency; }
+
+    // getters
+    // 已经拟合出漂移
+    const bool fitted() const { return m_fitted; }
+    // 源时钟相对本机时钟的漂移，ppm，源时钟走得慢为正
+    const double driftPpm() const { return m_drift * 1e6; }
+    const uint64_t samples() const { return m_samples; }
+    const uint64_t resets() const { return m_resets; }
+
+   private:
+    // 一段的下包络点，x为源时钟相对原点，y为收到时刻 - 源时钟的相对值，单位ns
+    struct Point {
+        int64_t m_x = 0;
+        int64_t m_y = 0;
+    };
+
+    void fit();
+
+    Duration m_segment;
+    size_t m_segments;
+    Duration m_resetGap;
+    Duration m_latency{0};
+
+    // 原点在第一个样本，之后的样本都相对它，避免大数相减丢精度
+    bool m_started = false;
+    int64_t m_originSource = 0;
+    int64_t m_originHost = 0;
+    int64_t m_lastSource = 0;
+    int64_t m_lastHost = 0;
+
+    // 已结束的段，环形覆盖最早的一段
+    std::vector<Point> m_points;
+    size_t m_pointNext = 0;
+    // 当前段
+    int64_t m_segmentIndex = 0;
+    Point m_current;
+
+    // 模型 y = m_offset + m_drift * x
+    bool m_fitted = false;
+    double m_offset = 0.0;
+    double m_drift = 0.0;
+
+    uint64_t m_samples = 0;
+    uint64_t m_resets = 0;
+};
+
+}  // namespace hitcrt::camera
@@ -0,0 +1,166 @@
+/**
+ * @file FramePool.cpp
+ * @brief 相机取图缓冲池
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>替换格式转换中逐帧申请的输出内存
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>槽位记录相机硬件时间戳和回调时刻
+ * </table>
+ */
+#include "FramePool.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace hitcrt::camera {
+
+/**
+ * @brief 槽位，包装池内存的Mat和引用计数，0表示空闲
+ */
+struct FrameBuffer::Slot {
+    cv::Mat m_image;
+    std::atomic<int> m_refs{0};
+    uint64_t m_deviceTimeStamp = 0;
+    TimePoint m_receiveTime;
+};
+
+// ============================== FrameBuffer ==============================
+FrameBuffer::FrameBuffer(const FrameBuffer& other) : m_slot(other.m_slot), m_pool(other.m_pool) {
+    if (m_slot != nullptr) {
+        m_slot->m_refs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+FrameBuffer::FrameBuffer(FrameBuffer&& other) noexcept : m_slot(other.m_slot), m_pool(other.m_pool) {
+    other.m_slot = nullptr;
+    other.m_pool = nullptr;
+}
+
+FrameBuffer& FrameBuffer::operator=(const FrameBuffer& other) {
+    if (this != &other) {
+        // 先加后减，自赋值同一槽位时也不会提前归还
+        if (other.m_slot != nullptr) {
+            other.m_slot->m_refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        reset();
+        m_slot = other.m_slot;
+        m_pool = other.m_pool;
+    }
+    return *this;
+}
+
+FrameBuffer& FrameBuffer::operator=(FrameBuffer&& other) noexcept {
+    if (this != &other) {
+        reset();
+        m_slot = other.m_slot;
+        m_pool = other.m_pool;
+        other.m_slot = nullptr;
+        other.m_pool = nullptr;
+    }
+    return *this;
+}
+
+FrameBuffer::~FrameBuffer() { reset(); }
+
+/**
+ * @brief 释放对槽位的引用，最后一个引用归还槽位
+ */
+void FrameBuffer::reset() {
+    if (m_slot != nullptr) {
+        m_pool->release(m_slot);
+        m_slot = nullptr;
+        m_pool = nullptr;
+    }
+}
+
+cv::Mat& FrameBuffer::image() { return m_slot->m_image; }
+
+const cv::Mat& FrameBuffer::image() const { return m_slot->m_image; }
+
+const int FrameBuffer::useCount() const {
+    return m_slot ? m_slot->m_refs.load(std::memory_order_relaxed) : 0;
+}
+
+void FrameBuffer::setStamp(const uint64_t deviceTimeStamp, const TimePoint& receiveTime) {
+    m_slot->m_deviceTimeStamp = deviceTimeStamp;
+    m_slot->m_receiveTime = receiveTime;
+}
+
+const uint64_t FrameBuffer::deviceTimeStamp() const { return m_slot->m_deviceTimeStamp; }
+
+const TimePoint FrameBuffer::receiveTime() const { return m_slot->m_receiveTime; }
+
+// ============================== FramePool ==============================
+/**
+ * @brief 一次性分配全部槽位，每个槽位按页对齐
+ * @param[in] capacity      槽位数，至少要覆盖 转换中的1帧 + 下游同时持有 的数量
+ * @param[in] width         图像宽度
+ * @param[in] height        图像高度
+ * @param[in] type          图像类型，BGR8或Bayer原图的CV_8UC1
+ */
+FramePool::FramePool(const int capacity, const int width, const int height, const int type)
+    : m_width(width), m_height(height), m_type(type) {
+    if (capacity <= 0 || width <= 0 || height <= 0) {
+        throw std::invalid_argument("FramePool: capacity, width and height must be positive");
+    }
+    const size_t imageBytes = static_cast<size_t>(width) * height * CV_ELEM_SIZE(type);
+    m_slotBytes = (imageBytes + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+
+    void* memory = nullptr;
+    if (posix_memalign(&memory, PAGE_SIZE, m_slotBytes * capacity) != 0) {
+        throw std::bad_alloc();
+    }
+    m_memory = static_cast<uint8_t*>(memory);
+    // 提前触页，避免第一轮写入时产生缺页中断
+    std::memset(m_memory, 0, m_slotBytes * capacity);
+
+    m_slots.reserve(capacity);
+    for (int i = 0; i < capacity; ++i) {
+        std::unique_ptr<FrameBuffer::Slot> slot(new FrameBuffer::Slot);
+        slot->m_image = cv::Mat(height, width, type, m_memory + i * m_slotBytes);
+        m_slots.emplace_back(std::move(slot));
+    }
+}
+
+FramePool::~FramePool() {
+    m_slots.clear();
+    std::free(m_memory);
+}
+
+/**
+ * @brief 从游标位置开始找一个空闲槽位
+ * @return FrameBuffer 空闲槽位的句柄，全部占用时为空
+ */
+FrameBuffer FramePool::acquire() {
+    const uint64_t start = m_cursor.fetch_add(1, std::memory_order_relaxed);
+    const size_t num = m_slots.size();
+    for (size_t i = 0; i < num; ++i) {
+        FrameBuffer::Slot* slot = m_slots[(start + i) % num].get();
+        int expected = 0;
+        if (slot->m_refs.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+            return FrameBuffer(slot, this);
+        }
+    }
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return FrameBuffer();
+}
+
+const int FramePool::inUse() const {
+    int count = 0;
+    for (const auto& slot : m_slots) {
+        count += slot->m_refs.load(std::memory_order_relaxed) > 0 ? 1 : 0;
+    }
+    return count;
+}
+
+void FramePool::release(FrameBuffer::Slot* slot) { slot->m_refs.fetch_sub(1, std::memory_order_acq_rel); }
+
+}  // namespace hitcrt::camera
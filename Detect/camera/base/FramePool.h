@@ -0,0 +1,116 @@
+/**
+ * @file FramePool.h
+ * @brief 相机取图缓冲池：预分配定长图像槽位，带引用计数的缓冲区句柄
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>替换格式转换中逐帧申请的输出内存
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>槽位记录相机硬件时间戳和回调时刻
+ * </table>
+ */
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <opencv2/core.hpp>
+#include <vector>
+
+#include "CamBase.h"
+
+namespace hitcrt::camera {
+
+class FramePool;
+
+/**
+ * @brief 缓冲区句柄，拷贝只增加引用计数，不拷贝像素
+ * @note 最后一个句柄析构时槽位归还给FramePool，FramePool必须比所有句柄活得久
+ */
+class FrameBuffer {
+   public:
+    FrameBuffer() = default;
+    FrameBuffer(const FrameBuffer& other);
+    FrameBuffer(FrameBuffer&& other) noexcept;
+    FrameBuffer& operator=(const FrameBuffer& other);
+    FrameBuffer& operator=(FrameBuffer&& other) noexcept;
+    ~FrameBuffer();
+
+    bool empty() const { return m_slot == nullptr; }
+    void reset();
+
+    // 相机驱动写完像素后记录相机硬件时间戳和本机收到这一帧的时刻
+    void setStamp(const uint64_t deviceTimeStamp, const TimePoint& receiveTime);
+
+    // getters
+    cv::Mat& image();
+    const cv::Mat& image() const;
+    const int useCount() const;
+    // 相机硬件时间戳，单位由相机决定，Huaray为ns
+    const uint64_t deviceTimeStamp() const;
+    const TimePoint receiveTime() const;
+
+   private:
+    friend class FramePool;
+    struct Slot;
+    FrameBuffer(Slot* slot, FramePool* pool) : m_slot(slot), m_pool(pool) {}
+
+    Slot* m_slot = nullptr;
+    FramePool* m_pool = nullptr;
+};
+
+// 取到缓冲区句柄的帧回调，句柄可以留到回调返回之后，不用拷贝图像
+using FrameCallBack = std::function<void(const TimePoint&, const FrameBuffer&)>;
+
+/**
+ * @brief 相机取图缓冲池
+ *
+ * 构造时按图像尺寸一次性分配 capacity 个页对齐的槽位，格式转换直接写进空闲槽位，运行期间不再申请内存。
+ * 槽位全部被占用时acquire()返回空句柄，由相机驱动丢掉这一帧并计数。
+ * 相机驱动单独编译，不依赖检测工程的FrameRing，两者的槽位管理方式相同。
+ */
+class FramePool {
+   public:
+    static constexpr size_t PAGE_SIZE = 4096;
+
+    FramePool(const int capacity, const int width, const int height, const int type = CV_8UC3);
+    ~FramePool();
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    // 取一个空闲槽位，全部被占用时返回空句柄
+    FrameBuffer acquire();
+
+    // getters
+    const int capacity() const { return static_cast<int>(m_slots.size()); }
+    const int width() const { return m_width; }
+    const int height() const { return m_height; }
+    const int type() const { return m_type; }
+    const size_t slotBytes() const { return m_slotBytes; }
+    const uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    // 正被句柄引用的槽位数
+    const int inUse() const;
+    // 尺寸和类型与槽位一致才能写入
+    bool fits(const int width, const int height, const int type) const {
+        return width == m_width && height == m_height && type == m_type;
+    }
+
+   private:
+    friend class FrameBuffer;
+    void release(FrameBuffer::Slot* slot);
+
+    const int m_width;
+    const int m_height;
+    const int m_type;
+    size_t m_slotBytes = 0;
+    uint8_t* m_memory = nullptr;
+    std::vector<std::unique_ptr<FrameBuffer::Slot>> m_slots;
+    std::atomic<uint64_t> m_cursor{0};
+    std::atomic<uint64_t> m_dropped{0};
+};
+
+}  // namespace hitcrt::camera
@@ -0,0 +1,245 @@
+/**
+ * @file TriggerScheduler.cpp
+ * @brief 软触发调度
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>SOFT模式按检测器就绪时刻预测触发
+ * </table>
+ */
+#include "TriggerScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace hitcrt::camera {
+
+namespace {
+double toMs(const Clock::duration& duration) { return std::chrono::duration<double, std::milli>(duration).count(); }
+
+// 已排序样本的分位数
+double quantile(const std::vector<double>& sorted, const double q) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const size_t index = static_cast<size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+}  // namespace
+
+TriggerScheduler::TriggerScheduler(const Duration exposure, const Duration transfer, const Duration margin,
+                                   const double deviations)
+    : m_exposure(exposure),
+      m_margin(margin),
+      m_deviations(deviations),
+      m_transferInit(static_cast<double>(transfer.count())) {
+    m_latencies.reserve(HISTORY_SIZE);
+    m_lateness.reserve(HISTORY_SIZE);
+    reset();
+}
+
+/**
+ * @brief 清空估计、在途触发和统计，曝光时间、余量和最小间隔保留
+ */
+void TriggerScheduler::reset() {
+    m_transferMean = m_transferInit;
+    m_transferDev = 0.0;
+    m_preprocessMean = 0.0;
+    m_transferMeasured = false;
+    m_preprocessMeasured = false;
+    m_pendingHead = 0;
+    m_pendingCount = 0;
+    m_triggeredOnce = false;
+    m_latencies.clear();
+    m_lateness.clear();
+    m_latencyNext = 0;
+    m_latenessNext = 0;
+    m_triggered = 0;
+    m_received = 0;
+    m_lost = 0;
+    m_unmatched = 0;
+}
+
+/**
+ * @brief 当前提前量
+ * @return TriggerScheduler::Duration 曝光 + 传输均值 + K倍平均偏差 + 预处理均值 + 余量
+ */
+const TriggerScheduler::Duration TriggerScheduler::lead() const {
+    const double transfer = m_transferMean + m_deviations * m_transferDev;
+    return m_exposure + m_margin + Duration(static_cast<int64_t>(transfer + m_preprocessMean));
+}
+
+/**
+ * @brief 倒推触发时刻
+ * @param[in] readyTime     检测器预计空闲的时刻
+ * @param[in] now           当前时刻
+ * @return TimePoint 触发时刻，赶不上时就是now，检测器会空等一会
+ */
+TimePoint TriggerScheduler::plan(const TimePoint& readyTime, const TimePoint& now) const {
+    TimePoint fireTime = readyTime - lead();
+    if (m_triggeredOnce) {
+        fireTime = std::max(fireTime, m_lastTrigger + m_minInterval);
+    }
+    return std::max(fireTime, now);
+}
+
+/**
+ * @brief 记录一次触发
+ * @param[in] triggerTime   触发时刻
+ * @param[in] readyTime     这次触发要赶上的检测器就绪时刻
+ */
+void TriggerScheduler::onTrigger(const TimePoint& triggerTime, const TimePoint& readyTime) {
+    // 在途触发已满，最早的那帧不会再来了
+    if (m_pendingCount == MAX_IN_FLIGHT) {
+        popPending();
+        ++m_lost;
+    }
+    m_pending[(m_pendingHead + m_pendingCount) % MAX_IN_FLIGHT] = {triggerTime, readyTime};
+    ++m_pendingCount;
+    m_lastTrigger = triggerTime;
+    m_triggeredOnce = true;
+    ++m_triggered;
+}
+
+/**
+ * @brief 记录一次回调，更新传输估计和延迟统计
+ * @param[in] arriveTime    回调时刻
+ * @return true 与在途触发配对
+ * @return false 没有在途触发，比如触发模式下相机自己出了帧
+ */
+bool TriggerScheduler::onFrame(const TimePoint& arriveTime) {
+    if (m_pendingCount == 0) {
+        ++m_unmatched;
+        return false;
+    }
+    const Pending pending = m_pending[m_pendingHead];
+    popPending();
+    ++m_received;
+
+    const auto latency = arriveTime - pending.m_trigger;
+    const double transfer = static_cast<double>(std::chrono::duration_cast<Duration>(latency - m_exposure).count());
+    if (!m_transferMeasured) {
+        m_transferMean = transfer;
+        m_transferDev = transfer / 2.0;
+        m_transferMeasured = true;
+    } else {
+        // 先用旧均值算偏差，再更新均值
+        m_transferDev += DEV_GAIN * (std::abs(transfer - m_transferMean) - m_transferDev);
+        m_transferMean += MEAN_GAIN * (transfer - m_transferMean);
+    }
+
+    pushSample(m_latencies, m_latencyNext, toMs(latency));
+    const auto preprocessed = arriveTime + Duration(static_cast<int64_t>(m_preprocessMean));
+    pushSample(m_lateness, m_latenessNext, toMs(preprocessed - pending.m_ready));
+    return true;
+}
+
+/**
+ * @brief 记录一帧预处理耗时
+ * @param[in] preprocess    预处理耗时
+ */
+void TriggerScheduler::onPreprocess(const Duration& preprocess) {
+    const double value = static_cast<double>(preprocess.count());
+    if (!m_preprocessMeasured) {
+        m_preprocessMean = value;
+        m_preprocessMeasured = true;
+    } else {
+        m_preprocessMean += MEAN_GAIN * (value - m_preprocessMean);
+    }
+}
+
+/**
+ * @brief 丢掉超时的在途触发，防止之后的回调配错触发
+ * @param[in] now       当前时刻
+ * @param[in] timeout   触发后等回调的最长时间
+ * @return size_t 丢掉的帧数
+ */
+size_t TriggerScheduler::expire(const TimePoint& now, const Duration& timeout) {
+    size_t expired = 0;
+    while (m_pendingCount > 0 && now - m_pending[m_pendingHead].m_trigger > timeout) {
+        popPending();
+        ++m_lost;
+        ++expired;
+    }
+    return expired;
+}
+
+/**
+ * @brief 统计触发到回调的延迟分布
+ * @return TriggerReport
+ */
+TriggerReport TriggerScheduler::report() const {
+    TriggerReport report;
+    report.m_triggered = m_triggered;
+    report.m_received = m_received;
+    report.m_lost = m_lost;
+    report.m_unmatched = m_unmatched;
+    report.m_lead = toMs(lead());
+
+    std::vector<double> sorted = m_latencies;
+    std::sort(sorted.begin(), sorted.end());
+    if (!sorted.empty()) {
+        double sum = 0.0;
+        for (const double latency : sorted) {
+            sum += latency;
+        }
+        report.m_min = sorted.front();
+        report.m_mean = sum / static_cast<double>(sorted.size());
+        report.m_p50 = quantile(sorted, 0.5);
+        report.m_p90 = quantile(sorted, 0.9);
+        report.m_p99 = quantile(sorted, 0.99);
+        report.m_max = sorted.back();
+    }
+
+    sorted = m_lateness;
+    std::sort(sorted.begin(), sorted.end());
+    if (!sorted.empty()) {
+        double sum = 0.0;
+        for (const double lateness : sorted) {
+            sum += lateness;
+        }
+        report.m_lateMean = sum / static_cast<double>(sorted.size());
+        report.m_lateP90 = quantile(sorted, 0.9);
+    }
+    return report;
+}
+
+/**
+ * @brief 格式化输出延迟分布
+ * @return std::string
+ */
+std::string TriggerScheduler::reportStr() const {
+    const TriggerReport r = report();
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer),
+             "Soft trigger: triggered %llu, received %llu, lost %llu, unmatched %llu\n"
+             "Trigger to callback (ms): min %.3f, mean %.3f, p50 %.3f, p90 %.3f, p99 %.3f, max %.3f\n"
+             "Ready lateness (ms): mean %.3f, p90 %.3f, lead %.3f\n",
+             static_cast<unsigned long long>(r.m_triggered), static_cast<unsigned long long>(r.m_received),
+             static_cast<unsigned long long>(r.m_lost), static_cast<unsigned long long>(r.m_unmatched), r.m_min,
+             r.m_mean, r.m_p50, r.m_p90, r.m_p99, r.m_max, r.m_lateMean, r.m_lateP90, r.m_lead);
+    return buffer;
+}
+
+void TriggerScheduler::popPending() {
+    m_pendingHead = (m_pendingHead + 1) % MAX_IN_FLIGHT;
+    --m_pendingCount;
+}
+
+// 样本满了以后覆盖最早的
+void TriggerScheduler::pushSample(std::vector<double>& samples, size_t& next, const double value) {
+    if (samples.size() < HISTORY_SIZE) {
+        samples.push_back(value);
+    } else {
+        samples[next] = value;
+    }
+    next = (next + 1) % HISTORY_SIZE;
+}
+
+}  // namespace hitcrt::camera
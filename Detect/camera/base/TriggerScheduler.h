@@ -0,0 +1,145 @@
+/**
+ * @file TriggerScheduler.h
+ * @brief 软触发调度：按检测器预计空闲的时刻倒推软触发时刻，统计触发到回调的延迟
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>SOFT模式按检测器就绪时刻预测触发
+ * </table>
+ */
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CamBase.h"
+
+namespace hitcrt::camera {
+
+/**
+ * @brief 触发到回调的延迟分布，单位ms
+ */
+struct TriggerReport {
+    uint64_t m_triggered = 0;  // 发出的触发数
+    uint64_t m_received = 0;   // 对上触发的回调数
+    uint64_t m_lost = 0;       // 触发后一直没等到回调的帧数
+    uint64_t m_unmatched = 0;  // 没有对应触发的回调数
+    // 触发到回调的延迟
+    double m_min = 0.0;
+    double m_mean = 0.0;
+    double m_p50 = 0.0;
+    double m_p90 = 0.0;
+    double m_p99 = 0.0;
+    double m_max = 0.0;
+    // 帧预处理完的时刻减检测器就绪时刻，正数是检测器在等帧，负数是帧在等检测器
+    double m_lateMean = 0.0;
+    double m_lateP90 = 0.0;
+    // 当前提前量：曝光 + 传输估计 + 预处理估计 + 余量
+    double m_lead = 0.0;
+};
+
+/**
+ * @brief 软触发调度器
+ *
+ * 检测器报告预计空闲的时刻readyTime，调度器在 readyTime - 提前量 时触发，使新帧预处理完时检测器正好空闲。
+ * 提前量 = 曝光时间 + 传输估计 + 预处理估计 + 余量，其中曝光时间由驱动设置，
+ * 传输（读出、传输、SDK转换，即触发到回调的延迟减去曝光）和预处理耗时按实测滑动估计，
+ * 传输估计取均值加K倍平均偏差，宁可帧早到一点，也不让检测器空等。
+ * 所有接口都显式传入时刻，不读系统时钟，可以用模拟时钟测试；不是线程安全的，由调用方加锁。
+ */
+class TriggerScheduler {
+   public:
+    using Duration = std::chrono::microseconds;
+
+    // 最多同时在途的触发数，再多就认为最早的那帧丢了
+    static constexpr size_t MAX_IN_FLIGHT = 8;
+    // 保留最近多少个延迟样本用于统计分布
+    static constexpr size_t HISTORY_SIZE = 4096;
+
+    /**
+     * @param[in] exposure      曝光时间
+     * @param[in] transfer      传输耗时的初值，测到第一帧前使用
+     * @param[in] margin        额外余量
+     * @param[in] deviations    传输估计取均值加几倍平均偏差
+     */
+    TriggerScheduler(const Duration exposure = Duration(5000), const Duration transfer = Duration(3000),
+                     const Duration margin = Duration(200), const double deviations = 2.0);
+
+    // 检测器预计在readyTime空闲，返回应该发出触发的时刻，不早于now和上次触发 + 最小间隔
+    TimePoint plan(const TimePoint& readyTime, const TimePoint& now) const;
+    // 在triggerTime发出了触发，readyTime是这次触发要赶上的就绪时刻
+    void onTrigger(const TimePoint& triggerTime, const TimePoint& readyTime);
+    // 在arriveTime收到回调，与最早的在途触发配对，返回是否配对成功
+    bool onFrame(const TimePoint& arriveTime);
+    // 下游实测的一帧预处理耗时
+    void onPreprocess(const Duration& preprocess);
+    // 在途触发超过timeout还没回调的都算丢帧，返回丢掉的帧数
+    size_t expire(const TimePoint& now, const Duration& timeout);
+
+    // setters
+    void setExposure(const Duration& exposure) { m_exposure = exposure; }
+    // 相机两次触发之间的最小间隔，由最大帧率决定
+    void setMinInterval(const Duration& minInterval) { m_minInterval = minInterval; }
+    void reset();
+
+    // getters
+    const Duration lead() const;
+    const Duration transferEstimate() const { return Duration(static_cast<int64_t>(m_transferMean)); }
+    const Duration preprocessEstimate() const { return Duration(static_cast<int64_t>(m_preprocessMean)); }
+    const size_t inFlight() const { return m_pendingCount; }
+    TriggerReport report() const;
+    std::string reportStr() const;
+
+   private:
+    // 在途的一次触发
+    struct Pending {
+        TimePoint m_trigger;
+        TimePoint m_ready;
+    };
+
+    void popPending();
+    static void pushSample(std::vector<double>& samples, size_t& next, const double value);
+
+    Duration m_exposure;
+    Duration m_margin;
+    Duration m_minInterval{0};
+    double m_deviations;
+    double m_transferInit;
+
+    // 滑动估计，单位us
+    double m_transferMean = 0.0;
+    double m_transferDev = 0.0;
+    double m_preprocessMean = 0.0;
+    bool m_transferMeasured = false;
+    bool m_preprocessMeasured = false;
+
+    // 在途触发的环形队列，回调按触发顺序到达
+    std::array<Pending, MAX_IN_FLIGHT> m_pending;
+    size_t m_pendingHead = 0;
+    size_t m_pendingCount = 0;
+    TimePoint m_lastTrigger;
+    bool m_triggeredOnce = false;
+
+    // 统计，单位ms
+    std::vector<double> m_latencies;
+    std::vector<double> m_lateness;
+    size_t m_latencyNext = 0;
+    size_t m_latenessNext = 0;
+    uint64_t m_triggered = 0;
+    uint64_t m_received = 0;
+    uint64_t m_lost = 0;
+    uint64_t m_unmatched = 0;
+
+    // 滑动估计的权重，与TCP往返时间估计相同
+    const double MEAN_GAIN = 1.0 / 8.0;
+    const double DEV_GAIN = 1.0 / 4.0;
+};
+
+}  // namespace hitcrt::camera
@@ -15,6 +15,11 @@
  * <tr><td>2022-06-06 <td>BG2EDG  <td>加入快速版reset，不用断流重置参数
  * <tr><td>2022-06-21 <td>BG2EDG  <td>加入自动搜索Dahua/Huaray设备Idx功能
  * <tr><td>2023-01-08 <td>GL      <td>加入指定SN码功能
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>格式转换写入预分配的缓冲池，修复sdkCvtMatBGR8逐帧泄漏
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>STREAM_MULTITHREAD模式由驱动内部的取图线程实现
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>实现SOFT模式，按检测器就绪时刻预测软触发
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>帧时间戳改用相机硬件时钟映射到本机时钟
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>SOFT模式长时间没有请求时自行触发并报警
  * </table>
  */
 #include "HuarayCam.h"
@@ -66,7 +71,12 @@ HuarayParams::HuarayParams(const HuarayParams& cameraParams)
       m_balanceRatio(cameraParams.balanceRatio()),
       m_offLineFunc(cameraParams.offLineFunc()),
       m_onLineFunc(cameraParams.onLineFunc()),
-      m_onGet(cameraParams.onGet()) {}
+      m_onGet(cameraParams.onGet()),
+      m_rawBayer(cameraParams.rawBayer()),
+      m_onFrame(cameraParams.onFrame()),
+      m_grabCpu(cameraParams.grabCpu()),
+      m_deviceClock(cameraParams.deviceClock()),
+      m_stampLatency(cameraParams.stampLatency()) {}
 
 /**
  * @brief 相机参数信息格式化输出
@@ -139,6 +149,11 @@ void HuarayParams::setBalanceRatio(const std::vector<double>& values) { m_balanc
 void HuarayParams::setOffLineFunc(const std::function<void()>& offLineFunc) { m_offLineFunc = offLineFunc; }
 void HuarayParams::setOnLineFunc(const std::function<void()>& onLineFunc) { m_onLineFunc = onLineFunc; }
 void HuarayParams::setOnGet(const std::function<void()>& onGet) { m_onGet = onGet; }
+void HuarayParams::setRawBayer(const bool rawBayer) { m_rawBayer = rawBayer; }
+void HuarayParams::setOnFrame(const FrameCallBack& onFrame) { m_onFrame = onFrame; }
+void HuarayParams::setGrabCpu(const int cpu) { m_grabCpu = cpu; }
+void HuarayParams::setDeviceClock(const bool deviceClock) { m_deviceClock = deviceClock; }
+void HuarayParams::setStampLatency(const int latencyUs) { m_stampLatency = latencyUs; }
 
 // getters
 const std::string HuarayParams::SN() const { return m_cameraSN; };
@@ -154,7 +169,12 @@ const double HuarayParams::gainRaw() const { return m_gainRaw; };
 const std::vector<double>& HuarayParams::balanceRatio() const { return m_balanceRatio; };
 const std::function<void()> HuarayParams::offLineFunc() const { return m_offLineFunc; };
 const std::function<void()> HuarayParams::onLineFunc() const { return m_onLineFunc; }
-const std::function<void()> HuarayParams::onGet() const { return m_onGet; }
+const std::function<void()>& HuarayParams::onGet() const { return m_onGet; }
+const bool HuarayParams::rawBayer() const { return m_rawBayer; }
+const FrameCallBack& HuarayParams::onFrame() const { return m_onFrame; }
+const int HuarayParams::grabCpu() const { return m_grabCpu; }
+const bool HuarayParams::deviceClock() const { return m_deviceClock; }
+const int HuarayParams::stampLatency() const { return m_stampLatency; }
 
 // ============================== Huaray Drivers ==============================
 // APIs
@@ -392,32 +412,120 @@ bool Huaray::resetStat() {
 
 /**
  * @brief 用于多线程取图
- * @return std::tuple<bool, TimePoint, std::unique_ptr<cv::Mat>>
+ * @return std::tuple<bool, TimePoint, FrameBuffer>
  * @author BG2EDG (928330305@qq.com)
  */
-std::tuple<bool, TimePoint, std::unique_ptr<cv::Mat>> Huaray::getFrameImage() {
+std::tuple<bool, TimePoint, FrameBuffer> Huaray::getFrameImage() {
+    // 取图线程在运行时由它调用IMV_GetFrame，这里只取它转换好的帧
+    if (m_grabThread.joinable()) {
+        return next(TIMEOUT_MS);
+    }
     auto timeStamp = std::chrono::steady_clock::now();
 
     // 获取一帧图像
-    if (!isGrabbing()) {
-        return std::make_tuple(false, timeStamp, nullptr);
+    if (!isGrabbing() || m_userDataPtr == nullptr || m_framePool == nullptr) {
+        return std::make_tuple(false, timeStamp, FrameBuffer());
     }
     m_ret = IMV_GetFrame(m_devHandle, &m_frame, TIMEOUT_MS);
 
     if (IMV_OK != m_ret) {
         printf("Get frame failed! ErrorCode[%d]\n", m_ret);
-        return std::make_tuple(false, timeStamp, nullptr);
+        return std::make_tuple(false, timeStamp, FrameBuffer());
     }
     // if (m_devHandle == NULL) {
     //     printf("devHandle is NULL\n");
     //     return std::make_tuple(false, timeStamp, nullptr);
     // }
 
-    auto framePair = cvtMatBGR8(m_frame, nullptr);
+    const auto receiveTime = std::chrono::steady_clock::now();
+    auto framePair = cvtFrame(m_frame, std::get<1>(*m_userDataPtr), *m_framePool);
+    if (framePair.first) {
+        timeStamp = stampFrame(m_frame, receiveTime, std::get<5>(*m_userDataPtr), framePair.second);
+    }
 
     releaseFrame();
 
-    return std::make_tuple(framePair.first, timeStamp, move(framePair.second));
+    return std::make_tuple(framePair.first, timeStamp, std::move(framePair.second));
+}
+
+/**
+ * @brief 取图线程转换好的最新一帧，不阻塞
+ * @return std::tuple<bool, TimePoint, FrameBuffer> 还没有帧时为false
+ */
+std::tuple<bool, TimePoint, FrameBuffer> Huaray::latest() {
+    std::lock_guard<std::mutex> lock(m_latestMutex);
+    if (m_latest.empty()) {
+        return std::make_tuple(false, m_latestTime, FrameBuffer());
+    }
+    m_takenSeq = m_latestSeq;
+    return std::make_tuple(true, m_latestTime, m_latest);
+}
+
+/**
+ * @brief 等待取图线程转换出一帧没取过的新帧
+ * @param[in] timeoutMs     最长等待时间
+ * @return std::tuple<bool, TimePoint, FrameBuffer> 超时或取图线程停止时为false
+ */
+std::tuple<bool, TimePoint, FrameBuffer> Huaray::next(const uint timeoutMs) {
+    std::unique_lock<std::mutex> lock(m_latestMutex);
+    m_latestCond.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                          [this] { return m_latestSeq > m_takenSeq || !m_grabRunning; });
+    if (m_latestSeq <= m_takenSeq || m_latest.empty()) {
+        return std::make_tuple(false, m_latestTime, FrameBuffer());
+    }
+    m_takenSeq = m_latestSeq;
+    return std::make_tuple(true, m_latestTime, m_latest);
+}
+
+/**
+ * @brief 取图线程统计
+ * @return Huaray::GrabStat 取到的帧数，没被取走就被覆盖的帧数，缓冲池满丢掉的帧数，IMV_GetFrame失败次数
+ */
+Huaray::GrabStat Huaray::grabStat() {
+    const uint64_t poolDropped = m_framePool != nullptr ? m_framePool->dropped() : 0;
+    return std::make_tuple(m_grabbed.load(), m_overwritten.load(), poolDropped, m_grabFailed.load());
+}
+
+/**
+ * @brief SOFT模式下请求一帧
+ * @param[in] readyTime     检测器预计空闲的时刻
+ * @return true
+ * @return false 不是SOFT模式或软触发线程没有运行
+ */
+bool Huaray::requestFrame(const TimePoint& readyTime) {
+    if (!m_triggerRunning) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_triggerMutex);
+        m_readyTime = readyTime;
+        ++m_readySeq;
+    }
+    m_triggerCond.notify_one();
+    return true;
+}
+
+/**
+ * @brief 记录下游一帧的预处理耗时
+ * @param[in] preprocess    预处理耗时
+ */
+void Huaray::reportPreprocess(const std::chrono::microseconds& preprocess) {
+    std::lock_guard<std::mutex> lock(m_triggerMutex);
+    m_triggerScheduler.onPreprocess(preprocess);
+}
+
+/**
+ * @brief 软触发到回调的延迟分布
+ * @return TriggerReport
+ */
+TriggerReport Huaray::triggerReport() {
+    std::lock_guard<std::mutex> lock(m_triggerMutex);
+    return m_triggerScheduler.report();
+}
+
+std::string Huaray::triggerReportStr() {
+    std::lock_guard<std::mutex> lock(m_triggerMutex);
+    return m_triggerScheduler.reportStr() + " idleTriggers " + std::to_string(m_idleTriggers);
 }
 
 /**
@@ -562,8 +670,18 @@ bool Huaray::close() {
  * @author BG2EDG (928330305@qq.com)
  */
 bool Huaray::start(const CameraParams& cameraParams) {
-    // 不同模式可能开启抓图的操作不同，但暂时是一致的
-    return startGrabbing();
+    if (!startGrabbing()) {
+        return false;
+    }
+    // 多线程模式再开取图线程
+    if (cameraParams.mode() == Mode::STREAM_MULTITHREAD && m_userDataPtr != nullptr) {
+        return startGrabThread(std::get<1>(*m_userDataPtr));
+    }
+    // 软触发模式再开软触发线程
+    if (cameraParams.mode() == Mode::SOFT) {
+        return startTriggerThread();
+    }
+    return true;
 }
 
 /**
@@ -574,7 +692,9 @@ bool Huaray::start(const CameraParams& cameraParams) {
  * @author BG2EDG (928330305@qq.com)
  */
 bool Huaray::stop(const CameraParams& cameraParams) {
-    // 不同模式可能停止抓图的操作不同，但暂时是一致的
+    // 先停取图线程和软触发线程，它们不再调用SDK后再停止拉流
+    stopGrabThread();
+    stopTriggerThread();
     return stopGrabbing();
 }
 
@@ -650,6 +770,188 @@ void Huaray::destroy() {
     }
 }
 
+/**
+ * @brief 开启取图线程
+ * @param[in] cameraParams  相机参数，用到rawBayer和grabCpu
+ * @return true
+ * @return false
+ */
+bool Huaray::startGrabThread(const HuarayParams& cameraParams) {
+    if (m_grabThread.joinable() || m_framePool == nullptr) {
+        return m_grabThread.joinable();
+    }
+    m_grabRunning = true;
+    m_grabThread = std::thread(&Huaray::grabLoop, this, cameraParams.grabCpu());
+    return true;
+}
+
+/**
+ * @brief 停止取图线程，释放它持有的最新帧
+ */
+void Huaray::stopGrabThread() {
+    if (!m_grabThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_latestMutex);
+        m_grabRunning = false;
+    }
+    m_latestCond.notify_all();
+    m_grabThread.join();
+
+    std::lock_guard<std::mutex> lock(m_latestMutex);
+    m_latest.reset();
+    m_takenSeq = m_latestSeq;
+}
+
+/**
+ * @brief 取图线程：取到一帧立即转换进缓冲池并归还SDK缓存，再替换最新帧
+ * @param[in] cpu   绑定的CPU核，-1不绑定
+ * @note SDK缓存的周转只取决于转换耗时，与下游处理速度无关
+ */
+void Huaray::grabLoop(const int cpu) {
+    if (cpu >= 0) {
+        pinThread(cpu);
+    }
+    const HuarayParams& cameraParams = std::get<1>(*m_userDataPtr);
+    IMV_Frame frame;
+    while (m_grabRunning) {
+        int ret = IMV_GetFrame(m_devHandle, &frame, GRAB_TIMEOUT_MS);
+        auto timeStamp = std::chrono::steady_clock::now();
+        if (IMV_OK != ret) {
+            // 超时或断线，断线时IMV_GetFrame会立即返回，等一会再试
+            m_grabFailed.fetch_add(1, std::memory_order_relaxed);
+            if (!isGrabbing()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(GRAB_TIMEOUT_MS));
+            }
+            continue;
+        }
+        cameraParams.onGet()();
+        auto framePair = cvtFrame(frame, cameraParams, *m_framePool);
+        if (framePair.first) {
+            timeStamp = stampFrame(frame, timeStamp, std::get<5>(*m_userDataPtr), framePair.second);
+        }
+        ret = IMV_ReleaseFrame(m_devHandle, &frame);
+        if (IMV_OK != ret) {
+            printf("Release frame failed! ErrorCode[%d]\n", ret);
+        }
+        if (!framePair.first) {
+            continue;
+        }
+        m_grabbed.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(m_latestMutex);
+            if (m_latestSeq > m_takenSeq) {
+                m_overwritten.fetch_add(1, std::memory_order_relaxed);
+            }
+            m_latest = std::move(framePair.second);
+            m_latestTime = timeStamp;
+            ++m_latestSeq;
+        }
+        m_latestCond.notify_all();
+    }
+}
+
+/**
+ * @brief 把调用线程绑定到一个CPU核
+ * @param[in] cpu   CPU核序号
+ * @return true
+ * @return false
+ */
+bool Huaray::pinThread(const int cpu) {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    const int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+    if (ret != 0) {
+        printf("Pin grab thread to CPU %d failed! ErrorCode[%d]\n", cpu, ret);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 开启软触发线程
+ * @return true
+ */
+bool Huaray::startTriggerThread() {
+    if (m_triggerThread.joinable()) {
+        return true;
+    }
+    // 在requestFrame生效前取序号，线程启动前到达的请求也会触发
+    const uint64_t readySeq = m_readySeq;
+    m_triggerRunning = true;
+    m_triggerThread = std::thread(&Huaray::triggerLoop, this, readySeq);
+    return true;
+}
+
+/**
+ * @brief 停止软触发线程，还没发出的请求直接丢弃
+ */
+void Huaray::stopTriggerThread() {
+    if (!m_triggerThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_triggerMutex);
+        m_triggerRunning = false;
+    }
+    m_triggerCond.notify_all();
+    m_triggerThread.join();
+}
+
+/**
+ * @brief 软触发线程：等到检测器的请求后按提前量算出触发时刻，到点发出软触发
+ * @param[in] firedSeq  已经处理过的请求序号
+ * @note 等待期间来了新请求就按新的就绪时刻重新计算，每个请求最多触发一次；
+ *       超过REQUEST_IDLE_MS没有请求时按当前时刻自行触发
+ */
+void Huaray::triggerLoop(uint64_t firedSeq) {
+    std::unique_lock<std::mutex> lock(m_triggerMutex);
+    while (m_triggerRunning) {
+        if (!m_triggerCond.wait_for(lock, std::chrono::milliseconds(REQUEST_IDLE_MS),
+                                    [this, &firedSeq] { return m_readySeq != firedSeq || !m_triggerRunning; })) {
+            // 长时间没有请求：没人调用requestFrame，或者丢了一次触发后检测器等不到帧。
+            // 按当前时刻自己请求一帧，相机不会停住，第一次时报警
+            if (!m_requestIdleWarned) {
+                std::cerr << "Huaray: SOFT mode got no requestFrame() for " << REQUEST_IDLE_MS
+                          << " ms, triggering on timeout" << std::endl;
+                m_requestIdleWarned = true;
+            }
+            ++m_idleTriggers;
+            m_readyTime = Clock::now();
+            ++m_readySeq;
+        }
+        if (!m_triggerRunning) {
+            break;
+        }
+        const uint64_t readySeq = m_readySeq;
+        const TimePoint fireTime = m_triggerScheduler.plan(m_readyTime, Clock::now());
+        // 到点前来了新请求或要停止，重新计算
+        if (m_triggerCond.wait_until(lock, fireTime,
+                                     [this, readySeq] { return m_readySeq != readySeq || !m_triggerRunning; })) {
+            continue;
+        }
+        firedSeq = readySeq;
+        const TimePoint triggerTime = Clock::now();
+        m_triggerScheduler.expire(triggerTime, std::chrono::milliseconds(TRIGGER_LOST_MS));
+        // 先登记再触发，保证回调到达时能配上这次触发；触发失败的这一帧会超时算作丢帧
+        m_triggerScheduler.onTrigger(triggerTime, m_readyTime);
+        lock.unlock();
+        softTrigger();
+        lock.lock();
+    }
+}
+
+/**
+ * @brief SOFT模式下记录回调时刻
+ * @param[in] arriveTime    回调时刻
+ */
+void Huaray::onTriggeredFrame(const TimePoint& arriveTime) {
+    std::lock_guard<std::mutex> lock(m_triggerMutex);
+    m_triggerScheduler.onFrame(arriveTime);
+}
+
 /**
  * @brief 数据帧回调函数
  * @param[in] pFrame        数据帧的指针
@@ -665,6 +967,9 @@ void Huaray::onGetFrame(IMV_Frame* pFrame, void* pUser) {
         return;
     }
     UserData* pOnCalllData = (UserData*)pUser;
+    if (std::get<4>(*pOnCalllData)) {
+        std::get<4>(*pOnCalllData)(timeStamp);
+    }
     std::get<1>(*pOnCalllData).onGet()();
 
     // auto devHandle = std::get<0>(*pOnCalllData);
@@ -673,10 +978,21 @@ void Huaray::onGetFrame(IMV_Frame* pFrame, void* pUser) {
     //     return;
     // }
 
-    // 转成BGR8格式的cv::Mat
-    auto framePair = cvtMatBGR8(*pFrame, nullptr);
+    FramePool* pool = std::get<3>(*pOnCalllData);
+    if (pool == nullptr) {
+        return;
+    }
+
+    // 转成BGR8格式写进缓冲池，原图模式下只拷贝Bayer数据；池满时丢掉这一帧
+    const HuarayParams& cameraParams = std::get<1>(*pOnCalllData);
+    auto framePair = cvtFrame(*pFrame, cameraParams, *pool);
     if (framePair.first) {
-        std::get<1>(*pOnCalllData).onCall()(timeStamp, *framePair.second);
+        timeStamp = stampFrame(*pFrame, timeStamp, std::get<5>(*pOnCalllData), framePair.second);
+        if (cameraParams.onFrame()) {
+            cameraParams.onFrame()(timeStamp, framePair.second);
+        } else {
+            cameraParams.onCall()(timeStamp, framePair.second.image());
+        }
     }
 
     return;
@@ -805,47 +1121,114 @@ void Huaray::deviceOnLine(const UserData& onConnectData) {
 }
 
 /**
- * @brief OpenCV实现：图像格式转换为BGR8，以cv::Mat存储
+ * @brief 按参数选择原图拷贝或OpenCV实现的BGR8转换
+ * @param[in] frame         图像帧
+ * @param[in] cameraParams  相机参数，只用到rawBayer
+ * @param[in] pool          输出缓冲池
+ * @return std::pair<bool, FrameBuffer>
+ */
+std::pair<bool, FrameBuffer> Huaray::cvtFrame(const IMV_Frame& frame, const HuarayParams& cameraParams,
+                                              FramePool& pool) {
+    return cameraParams.rawBayer() ? cvtMatRaw(frame, nullptr, pool) : cvtMatBGR8(frame, nullptr, pool);
+}
+
+/**
+ * @brief 在缓冲区上记录硬件时间戳和回调时刻，并得到帧时间戳
+ * @param[in] frame         图像帧，frameInfo.timeStamp为相机硬件时间戳，ns
+ * @param[in] receiveTime   本机收到这一帧的时刻
+ * @param[in] clockMapper   硬件时钟映射，为空或相机不给时间戳时用回调时刻
+ * @param[out] buffer       输出缓冲区
+ * @return TimePoint 帧时间戳
+ */
+TimePoint Huaray::stampFrame(const IMV_Frame& frame, const TimePoint& receiveTime, ClockMapper* clockMapper,
+                             FrameBuffer& buffer) {
+    const uint64_t deviceTimeStamp = frame.frameInfo.timeStamp;
+    buffer.setStamp(deviceTimeStamp, receiveTime);
+    if (clockMapper == nullptr || deviceTimeStamp == 0) {
+        return receiveTime;
+    }
+    return clockMapper->update(static_cast<int64_t>(deviceTimeStamp), receiveTime);
+}
+
+/**
+ * @brief 从缓冲池取一个与帧尺寸一致的槽位
+ * @param[in] frame         图像帧
+ * @param[in] type          输出图像类型
+ * @param[in] pool          输出缓冲池
+ * @return FrameBuffer 尺寸不符或池满时为空
+ */
+static FrameBuffer acquireFor(const IMV_Frame& frame, const int type, FramePool& pool) {
+    if (!pool.fits(frame.frameInfo.width, frame.frameInfo.height, type)) {
+        printf("Frame size %ux%u does not match frame pool %dx%d!\n", frame.frameInfo.width,
+               frame.frameInfo.height, pool.width(), pool.height());
+        return FrameBuffer();
+    }
+    return pool.acquire();
+}
+
+/**
+ * @brief OpenCV实现：图像格式转换为BGR8，写入缓冲池的槽位
  * @param[in] frame         图像帧
  * @param[in] devHandle     设备句柄，实际没用，为了和sdk版的接口统一
- * @return std::pair<bool, std::unique_ptr<cv::Mat>>
+ * @param[in] pool          输出缓冲池
+ * @return std::pair<bool, FrameBuffer>
  * @author BG2EDG (928330305@qq.com)
  */
-std::pair<bool, std::unique_ptr<cv::Mat>> Huaray::cvtMatBGR8(const IMV_Frame& frame,
-                                                             const IMV_HANDLE devHandle) {
-    // 用数据指针建Mat，不发生数据拷贝
+std::pair<bool, FrameBuffer> Huaray::cvtMatBGR8(const IMV_Frame& frame, const IMV_HANDLE devHandle,
+                                                FramePool& pool) {
+    FrameBuffer buffer = acquireFor(frame, CV_8UC3, pool);
+    if (buffer.empty()) {
+        return std::make_pair(false, FrameBuffer());
+    }
+    // 用数据指针建Mat，不发生数据拷贝；槽位尺寸和类型一致，cvtColor直接写入不重新分配
     cv::Mat temp = cv::Mat(frame.frameInfo.height, frame.frameInfo.width, CV_8UC1, (uint8_t*)frame.pData);
-    cv::Mat frame_temp(temp.rows, temp.cols, CV_8UC3);
-    cv::cvtColor(temp, frame_temp, cv::COLOR_BayerBG2BGR_EA);
-    return std::make_pair(true, std::make_unique<cv::Mat>(frame_temp));
+    cv::cvtColor(temp, buffer.image(), cv::COLOR_BayerBG2BGR_EA);
+    return std::make_pair(true, std::move(buffer));
 }
 
 /**
- * @brief sdk实现：图像格式转换为BGR8，以cv::Mat存储
+ * @brief 不做格式转换：拷贝BayerBG8原图到缓冲池的单通道槽位
+ * @param[in] frame         图像帧
+ * @param[in] devHandle     设备句柄，实际没用，为了和sdk版的接口统一
+ * @param[in] pool          输出缓冲池
+ * @return std::pair<bool, FrameBuffer>
+ * @note 检测器把单通道图像当作BayerBG8，预处理时2x2合并去马赛克，省去全分辨率BGR图像的写入和读回
+ */
+std::pair<bool, FrameBuffer> Huaray::cvtMatRaw(const IMV_Frame& frame, const IMV_HANDLE devHandle,
+                                               FramePool& pool) {
+    FrameBuffer buffer = acquireFor(frame, CV_8UC1, pool);
+    if (buffer.empty()) {
+        return std::make_pair(false, FrameBuffer());
+    }
+    // SDK的缓冲区在releaseFrame后会被复用，必须拷贝
+    const cv::Mat temp(frame.frameInfo.height, frame.frameInfo.width, CV_8UC1, (uint8_t*)frame.pData);
+    temp.copyTo(buffer.image());
+    return std::make_pair(true, std::move(buffer));
+}
+
+/**
+ * @brief sdk实现：图像格式转换为BGR8，写入缓冲池的槽位
  * @param[in] frame         图像帧
  * @param[in] devHandle     设备句柄
- * @return std::pair<bool, std::unique_ptr<cv::Mat>>
+ * @param[in] pool          输出缓冲池
+ * @return std::pair<bool, FrameBuffer>
  * @author BG2EDG (928330305@qq.com)
  * @attention 当前版本的效果4～8ms且不稳定，后续如有更新要进行对比
  */
-std::pair<bool, std::unique_ptr<cv::Mat>> Huaray::sdkCvtMatBGR8(const IMV_Frame& frame,
-                                                                const IMV_HANDLE devHandle) {
+std::pair<bool, FrameBuffer> Huaray::sdkCvtMatBGR8(const IMV_Frame& frame, const IMV_HANDLE devHandle,
+                                                   FramePool& pool) {
     int ret = IMV_OK;
     const IMV_EPixelType convertFormat = gvspPixelBGR8;
     IMV_PixelConvertParam stPixelConvertParam;
-    unsigned char* pDstBuf = NULL;
-    unsigned int nDstBufSize = 0;
-    const char* pConvertFormatStr = NULL;
+    const char* pConvertFormatStr = (const char*)"BGR8";
 
-    nDstBufSize = sizeof(unsigned char) * frame.frameInfo.width * frame.frameInfo.height * 3;
-    pConvertFormatStr = (const char*)"BGR8";
-    pDstBuf = (unsigned char*)malloc(nDstBufSize);
-    cv::Mat frameImage(frame.frameInfo.height, frame.frameInfo.width, CV_8UC3, (uint8_t*)pDstBuf);
-
-    if (NULL == pDstBuf) {
-        printf("malloc pDstBuf failed!\n");
-        return std::make_pair(false, nullptr);
+    // 直接转换到槽位内存，不再逐帧malloc
+    FrameBuffer buffer = acquireFor(frame, CV_8UC3, pool);
+    if (buffer.empty()) {
+        return std::make_pair(false, FrameBuffer());
     }
+    unsigned char* pDstBuf = buffer.image().data;
+    const unsigned int nDstBufSize = sizeof(unsigned char) * frame.frameInfo.width * frame.frameInfo.height * 3;
 
     // 图像转换成BGR8
     // convert image to BGR8
@@ -867,10 +1250,10 @@ std::pair<bool, std::unique_ptr<cv::Mat>> Huaray::sdkCvtMatBGR8(const IMV_Frame&
     if (IMV_OK == ret) {
         // printf("image convert to %s successfully! nDstDataLen (%u)\n",
         //        pConvertFormatStr, stPixelConvertParam.nDstBufSize);
-        return std::make_pair(true, std::make_unique<cv::Mat>(frameImage));
+        return std::make_pair(true, std::move(buffer));
     } else {
         printf("image convert to %s failed! ErrorCode[%d]\n", pConvertFormatStr, ret);
-        return std::make_pair(false, nullptr);
+        return std::make_pair(false, FrameBuffer());
     }
 }
 
@@ -976,8 +1359,22 @@ bool Huaray::setParamsLite(const HuarayParams& cameraParams) {
  * @author BG2EDG (928330305@qq.com)
  */
 bool Huaray::setOperation(const HuarayParams& cameraParams) {
+    // 成像参数已设置，按相机当前的宽高分配缓冲池
+    if (!allocateFramePool(cameraParams)) {
+        return false;
+    }
     // 重连回调接收数据
-    m_userDataPtr = std::make_unique<UserData>(m_devHandle, cameraParams, boost::bind(&Huaray::retry, this));
+    // SOFT模式下回调时刻用于统计触发延迟
+    std::function<void(const TimePoint&)> onArrive = nullptr;
+    if (cameraParams.mode() == Mode::SOFT) {
+        onArrive = [this](const TimePoint& arriveTime) { onTriggeredFrame(arriveTime); };
+    }
+    // 每次重新设置都重新拟合，相机重连后硬件时钟可能已经归零
+    m_clockMapper.setLatency(std::chrono::microseconds(cameraParams.stampLatency()));
+    m_clockMapper.reset();
+    m_userDataPtr = std::make_unique<UserData>(m_devHandle, cameraParams, boost::bind(&Huaray::retry, this),
+                                               m_framePool.get(), onArrive,
+                                               cameraParams.deviceClock() ? &m_clockMapper : nullptr);
 
     // 测试Buffer Size，改成1会出问题，没有对此值修改
     // if (setBufferSize(BUFFER_COUNT)) {
@@ -1002,7 +1399,14 @@ bool Huaray::setOperation(const HuarayParams& cameraParams) {
             }
             break;
         case Mode::STREAM_MULTITHREAD:
-            // 外部创建线程取图，这里啥也不干
+            // 取图线程在start中开启
+            if (!setContinuous()) {
+                return false;
+            }
+            // 注册重连
+            if (!attachConnection(m_userDataPtr.get())) {
+                return false;
+            }
             break;
         case Mode::LINE:
             // 设置外部触发
@@ -1019,16 +1423,69 @@ bool Huaray::setOperation(const HuarayParams& cameraParams) {
             }
             break;
         case Mode::SOFT:
-            // TODO 增加软触发
+            // 设置软触发
+            if (!setSoftTrigger()) {
+                return false;
+            }
             // 注册回调
             if (!attachGrabbing(m_userDataPtr.get())) {
                 return false;
             }
+            // 注册重连
+            if (!attachConnection(m_userDataPtr.get())) {
+                return false;
+            }
+            {
+                // 曝光时间以相机为准
+                const auto exposure = std::chrono::microseconds(static_cast<int64_t>(getDoubleValue("ExposureTime")));
+                // 触发间隔由相机在当前曝光、分辨率和带宽下能达到的最大帧率决定，传输受限时比曝光时间长，
+                // 读不到帧率时退回曝光时间
+                double maxFrameRate = getDoubleValue("ResultingFrameRate");
+                if (maxFrameRate <= 0.0) {
+                    maxFrameRate = getDoubleValue("AcquisitionFrameRate");
+                }
+                auto minInterval = exposure;
+                if (maxFrameRate > 0.0) {
+                    minInterval = std::max(minInterval, std::chrono::duration_cast<std::chrono::microseconds>(
+                                                            std::chrono::duration<double>(1.0 / maxFrameRate)));
+                }
+                std::lock_guard<std::mutex> lock(m_triggerMutex);
+                m_triggerScheduler.setExposure(exposure);
+                m_triggerScheduler.setMinInterval(minInterval);
+                m_triggerScheduler.reset();
+            }
             break;
     }
     return true;
 }
 
+/**
+ * @brief 按相机当前的宽高和输出格式分配缓冲池，与已有的池一致时复用
+ * @param[in] cameraParams  相机参数，只用到rawBayer
+ * @return true
+ * @return false
+ * @attention 重建缓冲池前，之前取得的FrameBuffer必须已经全部释放
+ */
+bool Huaray::allocateFramePool(const HuarayParams& cameraParams) {
+    // 从文件加载参数时cameraParams里没有宽高，以相机为准
+    const int width = getIntValue("Width");
+    const int height = getIntValue("Height");
+    const int type = cameraParams.rawBayer() ? CV_8UC1 : CV_8UC3;
+    if (width <= 0 || height <= 0) {
+        printf("Allocate frame pool failed! Invalid size %dx%d\n", width, height);
+        return false;
+    }
+    if (m_framePool != nullptr && m_framePool->fits(width, height, type)) {
+        return true;
+    }
+    if (m_framePool != nullptr && m_framePool->inUse() > 0) {
+        printf("Frame pool is still in use, resize it after releasing all frames!\n");
+        return false;
+    }
+    m_framePool = std::make_unique<FramePool>(FRAME_POOL_SIZE, width, height, type);
+    return true;
+}
+
 /**
  * @brief 设置连续抓图
  * @return true
@@ -1103,6 +1560,53 @@ bool Huaray::setLineTrigger() {
     return true;
 }
 
+/**
+ * @brief 设置软触发模式
+ * @return true
+ * @return false
+ */
+bool Huaray::setSoftTrigger() {
+    // 设置触发源为软触发
+    // Set trigger source to Software
+    m_ret = IMV_SetEnumFeatureSymbol(m_devHandle, "TriggerSource", "Software");
+    if (IMV_OK != m_ret) {
+        printf("Set triggerSource value failed! ErrorCode[%d]\n", m_ret);
+        return false;
+    }
+
+    // 设置触发器
+    // Set trigger selector to FrameStart
+    m_ret = IMV_SetEnumFeatureSymbol(m_devHandle, "TriggerSelector", "FrameStart");
+    if (IMV_OK != m_ret) {
+        printf("Set triggerSelector value failed! ErrorCode[%d]\n", m_ret);
+        return false;
+    }
+
+    // 设置触发模式
+    // Set trigger mode to On
+    m_ret = IMV_SetEnumFeatureSymbol(m_devHandle, "TriggerMode", "On");
+    if (IMV_OK != m_ret) {
+        printf("Set triggerMode value failed! ErrorCode[%d]\n", m_ret);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 执行一次软触发
+ * @return true
+ * @return false
+ */
+bool Huaray::softTrigger() {
+    // 由软触发线程调用，不写m_ret
+    const int ret = IMV_ExecuteCommandFeature(m_devHandle, "TriggerSoftware");
+    if (IMV_OK != ret) {
+        printf("Execute TriggerSoftware failed! ErrorCode[%d]\n", ret);
+        return false;
+    }
+    return true;
+}
+
 /**
  * @brief 清除帧数据缓存
  * @return true
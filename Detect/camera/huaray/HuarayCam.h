@@ -14,6 +14,12 @@
  * <tr><td>2022-06-06 <td>BG2EDG  <td>加入快速版reset，不用断流重置参数
  * <tr><td>2022-06-21 <td>BG2EDG  <td>加入自动搜索Dahua/Huaray设备Idx功能
  * <tr><td>2023-01-08 <td>GL      <td>加入指定SN码功能
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>加入Bayer原图输出，去马赛克合并到检测器预处理
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>格式转换写入预分配的缓冲池，修复sdkCvtMatBGR8逐帧泄漏
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>STREAM_MULTITHREAD模式由驱动内部的取图线程实现
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>实现SOFT模式，按检测器就绪时刻预测软触发
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>帧时间戳改用相机硬件时钟映射到本机时钟
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>SOFT模式长时间没有请求时自行触发并报警
  * </table>
  */
 #pragma once
@@ -23,16 +29,22 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <atomic>
 #include <boost/bind.hpp>
+#include <condition_variable>
 #include <functional>
 #include <iostream>
 #include <list>
+#include <mutex>
 #include <opencv2/core.hpp>
 #include <opencv2/highgui.hpp>
 #include <opencv2/opencv.hpp>
 #include <thread>
 
 #include "CamBase.h"
+#include "ClockMapper.h"
+#include "FramePool.h"
+#include "TriggerScheduler.h"
 #include "IMVApi.h"
 
 namespace hitcrt::camera {
@@ -93,6 +105,16 @@ class HuarayParams : public CameraParams {
     void setOffLineFunc(const std::function<void()>& offLineFunc);
     void setOnLineFunc(const std::function<void()>& onLineFunc);
     void setOnGet(const std::function<void()>& onGet);
+    // true时回调输出BayerBG8原图（单通道），由检测器预处理一次完成去马赛克和letterbox
+    void setRawBayer(const bool rawBayer);
+    // 设置后回调改为传出缓冲区句柄，代替onCall
+    void setOnFrame(const FrameCallBack& onFrame);
+    // STREAM_MULTITHREAD模式下取图线程绑定的CPU核，-1不绑定
+    void setGrabCpu(const int cpu);
+    // true时帧时间戳由相机硬件时间戳映射到本机steady_clock，false时为回调时刻
+    void setDeviceClock(const bool deviceClock);
+    // 映射时减去的固定延迟（曝光结束到最快回调的耗时），us
+    void setStampLatency(const int latencyUs);
     // getters
 	const std::string SN() const;
     const int width() const;
@@ -107,7 +129,12 @@ class HuarayParams : public CameraParams {
     const std::vector<double>& balanceRatio() const;
     const std::function<void()> offLineFunc() const;
     const std::function<void()> onLineFunc() const;
-    const std::function<void()> onGet() const;
+    const std::function<void()>& onGet() const;
+    const bool rawBayer() const;
+    const FrameCallBack& onFrame() const;
+    const int grabCpu() const;
+    const bool deviceClock() const;
+    const int stampLatency() const;
 
     // 用于占位
     static void noUse(){};
@@ -131,6 +158,15 @@ class HuarayParams : public CameraParams {
     // onGet在进入回调后立即执行，onCall在图像转成BGR8后执行
     // 从抓图到onGet函数调用时间在微妙数量级，可以忽略不计
     std::function<void()> m_onGet = noUse;
+    // 输出Bayer原图，不在相机线程里转BGR
+    bool m_rawBayer = false;
+    // 为空时回调onCall，图像只在回调期间有效；设置后回调句柄，下游持有句柄即持有图像
+    FrameCallBack m_onFrame = nullptr;
+    // 取图线程绑定的CPU核
+    int m_grabCpu = -1;
+    // 回调时刻包含传输和SDK排队的抖动，硬件时间戳没有
+    bool m_deviceClock = true;
+    int m_stampLatency = 0;
 };
 
 /**
@@ -141,6 +177,8 @@ class Huaray : public Camera {
    public:
     // 流统计信息：图像错误的帧数，丢包的帧数，正常获取的帧数，帧率，带宽(Mbps)
     using StreamStat = std::tuple<uint, uint, uint, double, double>;
+    // 取图线程统计：取到的帧数，没被取走就被新帧覆盖的帧数，缓冲池满丢掉的帧数，IMV_GetFrame失败次数
+    using GrabStat = std::tuple<uint64_t, uint64_t, uint64_t, uint64_t>;
 
     Huaray() = default;
     Huaray(const HuarayParams& cameraParams);
@@ -165,8 +203,26 @@ class Huaray : public Camera {
     bool isOpen();
     // 判断相机是否正常抓图
     bool isGrabbing();
-    // 多线程取图，使用时另开线程,该部分未经过运行测试，使用前请测试功能是否正常
-    std::tuple<bool, TimePoint, std::unique_ptr<cv::Mat>> getFrameImage();
+    // 主动取一帧，返回缓冲池中的句柄，句柄全部释放后槽位才能复用
+    // STREAM_MULTITHREAD模式下等同于next(TIMEOUT_MS)
+    std::tuple<bool, TimePoint, FrameBuffer> getFrameImage();
+    // STREAM_MULTITHREAD模式：驱动内部的取图线程循环IMV_GetFrame，转换后立即归还SDK缓存，
+    // 只保留最新一帧，下游处理慢时丢的是没取走的旧帧而不是SDK缓存里的帧
+    // 非阻塞取最新一帧，还没有帧时返回false
+    std::tuple<bool, TimePoint, FrameBuffer> latest();
+    // 阻塞等待一帧没取过的新帧，超时或停止时返回false
+    std::tuple<bool, TimePoint, FrameBuffer> next(const uint timeoutMs = 100);
+    GrabStat grabStat();
+    // SOFT模式：检测器报告预计空闲的时刻，驱动减去曝光、传输、预处理的提前量后发出软触发，
+    // 新帧预处理完时检测器正好空闲；上一次请求还没触发时以新的就绪时刻为准
+    bool requestFrame(const TimePoint& readyTime);
+    // SOFT模式：下游实测的一帧预处理耗时，计入提前量
+    void reportPreprocess(const std::chrono::microseconds& preprocess);
+    // SOFT模式：触发到回调的延迟分布
+    TriggerReport triggerReport();
+    std::string triggerReportStr();
+    // 取图缓冲池，initiate后有效
+    const FramePool* framePool() const { return m_framePool.get(); }
     // 硬件触发计数
     int64_t getTriggerCnt();
     int64_t getTriggerLost();
@@ -180,9 +236,10 @@ class Huaray : public Camera {
     bool resetStat();
 
    protected:
-    // 用于断线重连回调传参
-    using UserData =
-        std::tuple<IMV_HANDLE, HuarayParams, std::function<bool()>>;
+    // 用于断线重连回调传参，第四项是格式转换的输出缓冲池，第五项是SOFT模式下记录回调时刻的函数，
+    // 最后一项是硬件时钟映射，不用硬件时间戳时为空
+    using UserData = std::tuple<IMV_HANDLE, HuarayParams, std::function<bool()>, FramePool*,
+                                std::function<void(const TimePoint&)>, ClockMapper*>;
     using UserDataPtr = std::unique_ptr<UserData>;
     // 具体功能接口，临时修改或增加功能请继承此类再使用
     // 根据SDK例程修改，使用前一定看清前提
@@ -206,6 +263,7 @@ class Huaray : public Camera {
     bool setParams(const HuarayParams& cameraParams);      //设置成像参数
     bool setParamsLite(const HuarayParams& cameraParams);  //设置部分参数
     bool setOperation(const HuarayParams& cameraParams);   //设置相机回调
+    bool allocateFramePool(const HuarayParams& cameraParams);  //按当前宽高分配缓冲池
     //设置成像参数
     bool setWidth(const int value);
     bool setHeight(const int value);
@@ -223,17 +281,41 @@ class Huaray : public Camera {
     bool stopGrabbing();                      //停止拉流
     bool setContinuous();           //设置连续抓图，关闭触发
     bool setLineTrigger();          //设置外部触发，待测试
+    bool setSoftTrigger();          //设置软触发
+    bool softTrigger();             //发出一次软触发
     bool setBufferSize(uint size);  // 设置缓存帧数,1~32，暂未使用
 
     // 清空数据缓存
     bool clearFrameBuffer();
     // 数据相关
+    // 输出写进pool中的空闲槽位，pool满或尺寸不符时返回false
     // 驱动函数实现，速度慢且不稳，4～8ms
-    static std::pair<bool, std::unique_ptr<cv::Mat>> sdkCvtMatBGR8(
-        const IMV_Frame& frame, const IMV_HANDLE devHandle);
+    static std::pair<bool, FrameBuffer> sdkCvtMatBGR8(
+        const IMV_Frame& frame, const IMV_HANDLE devHandle, FramePool& pool);
     // OpenCV实现，速度较快1ms
-    static std::pair<bool, std::unique_ptr<cv::Mat>> cvtMatBGR8(
-        const IMV_Frame& frame, const IMV_HANDLE devHandle);
+    static std::pair<bool, FrameBuffer> cvtMatBGR8(
+        const IMV_Frame& frame, const IMV_HANDLE devHandle, FramePool& pool);
+    // 不转换，拷贝一份BayerBG8原图（单通道，数据量是BGR8的1/3）
+    static std::pair<bool, FrameBuffer> cvtMatRaw(
+        const IMV_Frame& frame, const IMV_HANDLE devHandle, FramePool& pool);
+    // 按参数选择cvtMatRaw或cvtMatBGR8
+    static std::pair<bool, FrameBuffer> cvtFrame(
+        const IMV_Frame& frame, const HuarayParams& cameraParams, FramePool& pool);
+    // 在缓冲区上记录硬件时间戳和回调时刻，返回帧时间戳
+    static TimePoint stampFrame(const IMV_Frame& frame, const TimePoint& receiveTime, ClockMapper* clockMapper,
+                                FrameBuffer& buffer);
+
+    // 取图线程相关
+    bool startGrabThread(const HuarayParams& cameraParams);
+    void stopGrabThread();
+    void grabLoop(const int cpu);
+    static bool pinThread(const int cpu);
+
+    // 软触发线程相关
+    bool startTriggerThread();
+    void stopTriggerThread();
+    void triggerLoop(uint64_t firedSeq);
+    void onTriggeredFrame(const TimePoint& arriveTime);
 
     // 帧回调相关
     std::unique_ptr<UserData> m_userDataPtr;
@@ -273,6 +355,34 @@ class Huaray : public Camera {
     IMV_HANDLE m_devHandle;
     IMV_Frame m_frame;
     IMV_DeviceList m_devList;
+    // 格式转换的输出缓冲池，尺寸或格式变化时重建
+    std::unique_ptr<FramePool> m_framePool;
+    // 相机硬件时钟到本机时钟的映射，只在取图的那个线程里更新
+    ClockMapper m_clockMapper;
+
+    // 取图线程及其输出的最新帧
+    std::thread m_grabThread;
+    std::atomic<bool> m_grabRunning{false};
+    std::mutex m_latestMutex;  // 保护以下四项
+    std::condition_variable m_latestCond;
+    FrameBuffer m_latest;
+    TimePoint m_latestTime;
+    uint64_t m_latestSeq = 0;  // 最新帧的序号，从1开始
+    uint64_t m_takenSeq = 0;   // 下游取走的最后一帧的序号
+    std::atomic<uint64_t> m_grabbed{0};
+    std::atomic<uint64_t> m_overwritten{0};
+    std::atomic<uint64_t> m_grabFailed{0};
+
+    // 软触发线程及其调度状态
+    std::thread m_triggerThread;
+    std::atomic<bool> m_triggerRunning{false};
+    std::mutex m_triggerMutex;  // 保护以下各项，回调线程记录回调时刻也要加锁
+    std::condition_variable m_triggerCond;
+    TriggerScheduler m_triggerScheduler;
+    TimePoint m_readyTime;
+    uint64_t m_readySeq = 0;  // 每次requestFrame加1，等待触发期间变化则重新计算触发时刻
+    uint64_t m_idleTriggers = 0;     // 没有请求而自行触发的次数
+    bool m_requestIdleWarned = false;
 
     //外部触发：上升沿:RisingEdge,下降沿:FallingEdge
     const std::string TRIGGER_EDGE = "RisingEdge";
@@ -280,7 +390,15 @@ class Huaray : public Camera {
     const uint MAX_RETRY_TIMES = 10;
     //获取一张图片的最长等待时间
     const uint TIMEOUT_MS = 5;
+    //取图线程单次等待时间，也是停止取图线程的最长等待时间
+    const uint GRAB_TIMEOUT_MS = 100;
     //缓冲区大小（1～32，默认是8）
     const uint BUFFER_COUNT = 8;  //暂未使用
+    //取图缓冲池槽位数：转换中的1帧 + 下游同时持有的帧
+    const int FRAME_POOL_SIZE = 4;
+    //软触发后超过这个时间还没回调就算丢帧
+    const uint TRIGGER_LOST_MS = 100;
+    //SOFT模式超过这个时间没有requestFrame就自行触发一帧
+    const uint REQUEST_IDLE_MS = 200;
 };
 }  // namespace hitcrt::camera
\ No newline at end of file
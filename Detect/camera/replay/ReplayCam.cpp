@@ -0,0 +1,494 @@
+/**
+ * @file ReplayCam.cpp
+ * @brief 离线回放相机
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>不依赖相机和仿真的回放驱动
+ * </table>
+ */
+#include "ReplayCam.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/videoio.hpp>
+
+namespace hitcrt::camera {
+
+// ============================== Replay Parameters ==============================
+ReplayParams::ReplayParams(const CallBack& onCall, const std::string& path, const Mode mode, const ReplayPace pace,
+                           const double fps, const int loops, const int maxFrames)
+    : CameraParams(onCall, 0, mode, ParamSource::FILE, path),
+      m_pace(pace),
+      m_fps(fps),
+      m_loops(loops),
+      m_maxFrames(maxFrames) {}
+
+ReplayParams::ReplayParams(const ReplayParams& cameraParams)
+    : CameraParams(cameraParams),
+      m_pace(cameraParams.pace()),
+      m_fps(cameraParams.fps()),
+      m_loops(cameraParams.loops()),
+      m_maxFrames(cameraParams.maxFrames()) {}
+
+/**
+ * @brief 回放参数格式化输出
+ */
+void ReplayParams::show() {
+    std::cout << "============ Replay Params ============" << std::endl;
+    std::cout << "Source:     " << path() << std::endl;
+    std::cout << "Mode:       " << modeStr() << std::endl;
+    std::cout << "Pace:       " << paceStr() << std::endl;
+    std::cout << "FPS:        " << m_fps << std::endl;
+    std::cout << "Loops:      " << m_loops << std::endl;
+    std::cout << "Max Frames: " << m_maxFrames << std::endl;
+}
+
+// setters
+void ReplayParams::setPace(const ReplayPace pace) { m_pace = pace; }
+void ReplayParams::setFps(const double fps) { m_fps = fps; }
+void ReplayParams::setLoops(const int loops) { m_loops = loops; }
+void ReplayParams::setMaxFrames(const int maxFrames) { m_maxFrames = maxFrames; }
+
+// getters
+const ReplayPace ReplayParams::pace() const { return m_pace; }
+const double ReplayParams::fps() const { return m_fps; }
+const int ReplayParams::loops() const { return m_loops; }
+const int ReplayParams::maxFrames() const { return m_maxFrames; }
+const std::string ReplayParams::paceStr() const {
+    switch (m_pace) {
+        case ReplayPace::RECORDED:
+            return "Recorded";
+        case ReplayPace::FIXED_FPS:
+            return "Fixed FPS";
+        case ReplayPace::AS_FAST:
+            return "As Fast As Possible";
+    }
+    return "Unknown";
+}
+
+// ============================== Replay Camera ==============================
+// APIs
+ReplayCamera::ReplayCamera(const ReplayParams& cameraParams) { initiate(cameraParams); }
+
+ReplayCamera::~ReplayCamera() { terminate(); }
+
+/**
+ * @brief 预加载全部帧并开始回放
+ * @param[in] cameraParams  回放参数
+ * @return true
+ * @return false
+ */
+bool ReplayCamera::initiate(const ReplayParams& cameraParams) {
+    m_params = cameraParams;
+    if (!findDevices()) {
+        return false;
+    }
+    if (!open()) {
+        return false;
+    }
+    if (!start(m_params)) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 停止回放并释放预加载的帧
+ * @return true
+ */
+bool ReplayCamera::terminate() {
+    stop(m_params);
+    return close();
+}
+
+/**
+ * @brief STREAM_MULTITHREAD模式取一帧
+ * @param[in] timeoutMs     按节奏回放时等新帧的最长时间
+ * @return std::tuple<bool, TimePoint, cv::Mat> 超时或回放完时为false，图像只读
+ */
+std::tuple<bool, TimePoint, cv::Mat> ReplayCamera::getFrameImage(const uint timeoutMs) {
+    if (m_params.mode() != Mode::STREAM_MULTITHREAD || m_frames.empty()) {
+        return std::make_tuple(false, TimePoint(), cv::Mat());
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // 尽快回放时下游来取才出下一帧
+    if (m_params.pace() == ReplayPace::AS_FAST) {
+        const uint64_t total = totalFrames();
+        if (total != 0 && m_next >= total) {
+            return std::make_tuple(false, TimePoint(), cv::Mat());
+        }
+        const size_t index = m_next % m_frames.size();
+        ++m_next;
+        const TimePoint now = Clock::now();
+        m_lastTime = now;
+        ++m_delivered;
+        if (total != 0 && m_next == total) {
+            m_finished = true;
+            m_cond.notify_all();
+        }
+        return std::make_tuple(true, now, m_frames[index]);
+    }
+
+    m_cond.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                    [this] { return m_latestSeq > m_takenSeq || m_finished || !m_running; });
+    if (m_latestSeq <= m_takenSeq) {
+        return std::make_tuple(false, m_latestTime, cv::Mat());
+    }
+    m_takenSeq = m_latestSeq;
+    return std::make_tuple(true, m_latestTime, m_frames[(m_latestSeq - 1) % m_frames.size()]);
+}
+
+/**
+ * @brief SOFT模式在调用线程里回调下一帧
+ * @return true
+ * @return false 不是SOFT模式或已经回放完
+ */
+bool ReplayCamera::softTrigger() {
+    if (m_params.mode() != Mode::SOFT || m_frames.empty()) {
+        return false;
+    }
+    size_t index = 0;
+    TimePoint now;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const uint64_t total = totalFrames();
+        if (total != 0 && m_next >= total) {
+            return false;
+        }
+        index = m_next % m_frames.size();
+        ++m_next;
+        now = Clock::now();
+        m_lastTime = now;
+        if (total != 0 && m_next == total) {
+            m_finished = true;
+        }
+    }
+    ++m_delivered;
+    m_params.onCall()(now, m_frames[index]);
+    m_cond.notify_all();
+    return true;
+}
+
+/**
+ * @brief 等待回放完
+ * @param[in] timeoutMs     最长等待时间
+ * @return true
+ * @return false 超时
+ */
+bool ReplayCamera::waitFinished(const uint timeoutMs) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_cond.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return m_finished.load(); });
+}
+
+/**
+ * @brief 回放统计
+ * @return ReplayCamera::ReplayStat 已回调的帧数，晚于计划一帧以上的帧数，实际帧率
+ */
+ReplayCamera::ReplayStat ReplayCamera::stat() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const double seconds = std::chrono::duration<double>(m_lastTime - m_startTime).count();
+    const uint64_t delivered = m_delivered.load();
+    return std::make_tuple(delivered, m_late.load(), seconds > 0.0 ? delivered / seconds : 0.0);
+}
+
+/**
+ * @brief 预加载占用的内存
+ * @return size_t 字节数
+ */
+const size_t ReplayCamera::loadedBytes() const {
+    size_t bytes = 0;
+    for (const cv::Mat& frame : m_frames) {
+        bytes += frame.total() * frame.elemSize();
+    }
+    return bytes;
+}
+
+// ============================== Replay Drivers ==============================
+// Implementations
+
+/**
+ * @brief 检查回放源
+ * @return true
+ * @return false
+ */
+bool ReplayCamera::findDevices() {
+    struct stat info;
+    if (m_params.path().empty() || ::stat(m_params.path().c_str(), &info) != 0) {
+        printf("Replay source %s not found!\n", m_params.path().c_str());
+        return false;
+    }
+    m_isDirectory = S_ISDIR(info.st_mode);
+    return true;
+}
+
+/**
+ * @brief 把全部帧解码进内存
+ * @param[in] id    未使用
+ * @return true
+ * @return false 没有读到任何一帧
+ */
+bool ReplayCamera::open(const uint id) {
+    m_frames.clear();
+    m_offsets.clear();
+    const bool loaded = m_isDirectory ? loadImages(m_params.path()) : loadVideo(m_params.path());
+    if (!loaded || m_frames.empty()) {
+        printf("Replay source %s has no frames!\n", m_params.path().c_str());
+        return false;
+    }
+    if (m_params.pace() == ReplayPace::FIXED_FPS || m_offsets.size() != m_frames.size()) {
+        fillOffsets(m_params.fps());
+    }
+    // 一遍的时长按平均帧间隔补上最后一帧
+    const size_t num = m_offsets.size();
+    const std::chrono::nanoseconds interval =
+        num > 1 ? (m_offsets.back() - m_offsets.front()) / static_cast<int64_t>(num - 1)
+                : std::chrono::nanoseconds(static_cast<int64_t>(1e9 / m_params.fps()));
+    m_loopLength = m_offsets.back() + interval;
+    return true;
+}
+
+/**
+ * @brief 释放预加载的帧
+ * @return true
+ */
+bool ReplayCamera::close() {
+    m_frames.clear();
+    m_frames.shrink_to_fit();
+    m_offsets.clear();
+    return true;
+}
+
+/**
+ * @brief 开始回放
+ * @param[in] cameraParams  回放参数
+ * @return true
+ * @return false 模式不支持，或回放线程还在，需先stop
+ */
+bool ReplayCamera::start(const CameraParams& cameraParams) {
+    if (cameraParams.mode() == Mode::LINE || cameraParams.mode() == Mode::UNKNOWN) {
+        printf("Replay camera does not support mode %s!\n", cameraParams.modeStr().c_str());
+        return false;
+    }
+    // 回放线程还在读写计数，不能重置；放完自己退出的线程也要stop回收
+    if (m_playThread.joinable()) {
+        printf("Replay camera already started, stop it first!\n");
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_latestSeq = 0;
+        m_takenSeq = 0;
+        m_next = 0;
+        m_startTime = Clock::now();
+        m_lastTime = m_startTime;
+        m_delivered = 0;
+        m_late = 0;
+        m_finished = false;
+    }
+    // 只有回放线程推帧的模式才开线程，其余由下游拉取
+    const bool push = cameraParams.mode() == Mode::STREAM ||
+                      (cameraParams.mode() == Mode::STREAM_MULTITHREAD && m_params.pace() != ReplayPace::AS_FAST);
+    if (push) {
+        m_running = true;
+        m_playThread = std::thread(&ReplayCamera::playLoop, this);
+    }
+    return true;
+}
+
+/**
+ * @brief 停止回放线程
+ * @param[in] cameraParams  未使用
+ * @return true
+ */
+bool ReplayCamera::stop(const CameraParams& cameraParams) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_cond.notify_all();
+    if (m_playThread.joinable()) {
+        m_playThread.join();
+    }
+    return true;
+}
+
+/**
+ * @brief 按文件名顺序解码目录下的图片，有timestamps.txt时读入录制时刻
+ * @param[in] dir   图片目录
+ * @return true
+ * @return false
+ */
+bool ReplayCamera::loadImages(const std::string& dir) {
+    std::vector<cv::String> files;
+    cv::glob(dir + "/*", files, false);
+    std::sort(files.begin(), files.end());
+    const std::vector<std::string> extensions = {".png", ".jpg", ".jpeg", ".bmp", ".tif", ".tiff", ".pgm", ".ppm"};
+    for (const cv::String& file : files) {
+        const size_t dot = file.rfind('.');
+        if (dot == cv::String::npos) {
+            continue;
+        }
+        std::string extension = file.substr(dot);
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if (std::find(extensions.begin(), extensions.end(), extension) == extensions.end()) {
+            continue;
+        }
+        if (m_params.maxFrames() > 0 && static_cast<int>(m_frames.size()) >= m_params.maxFrames()) {
+            break;
+        }
+        cv::Mat image = cv::imread(file, cv::IMREAD_UNCHANGED);
+        if (image.empty()) {
+            printf("Decode %s failed!\n", file.c_str());
+            continue;
+        }
+        if (image.channels() == 4) {
+            cv::cvtColor(image, image, cv::COLOR_BGRA2BGR);
+        }
+        if (!m_frames.empty() && (image.size() != m_frames.front().size() || image.type() != m_frames.front().type())) {
+            printf("Skip %s: size or type differs from the first frame!\n", file.c_str());
+            continue;
+        }
+        m_frames.push_back(image);
+    }
+
+    // 录制时刻，单位ns
+    std::ifstream stamps(dir + "/" + TIMESTAMP_FILE);
+    int64_t stamp = 0;
+    int64_t first = 0;
+    while (stamps >> stamp && m_offsets.size() < m_frames.size()) {
+        if (m_offsets.empty()) {
+            first = stamp;
+        }
+        m_offsets.emplace_back(stamp - first);
+    }
+    if (stamps.is_open() && m_offsets.size() != m_frames.size()) {
+        printf("%s has %zu timestamps for %zu frames, replay at %.1f fps instead!\n", TIMESTAMP_FILE.c_str(),
+               m_offsets.size(), m_frames.size(), m_params.fps());
+    }
+    return true;
+}
+
+/**
+ * @brief 解码整个视频，录制时刻取每帧的播放时刻
+ * @param[in] path  视频文件
+ * @return true
+ * @return false
+ */
+bool ReplayCamera::loadVideo(const std::string& path) {
+    cv::VideoCapture capture(path);
+    if (!capture.isOpened()) {
+        printf("Open video %s failed!\n", path.c_str());
+        return false;
+    }
+    bool stamped = true;
+    while (m_params.maxFrames() <= 0 || static_cast<int>(m_frames.size()) < m_params.maxFrames()) {
+        // 每帧一个新的Mat，解码结果不共享内存
+        cv::Mat image;
+        if (!capture.read(image) || image.empty()) {
+            break;
+        }
+        const double ms = capture.get(cv::CAP_PROP_POS_MSEC);
+        // 部分后端不给播放时刻，之后按fps回放
+        if (!m_offsets.empty() && ms * 1e6 <= static_cast<double>(m_offsets.back().count())) {
+            stamped = false;
+        }
+        m_offsets.emplace_back(static_cast<int64_t>(ms * 1e6));
+        m_frames.push_back(image);
+    }
+    if (!stamped) {
+        m_offsets.clear();
+    } else if (!m_offsets.empty()) {
+        const std::chrono::nanoseconds first = m_offsets.front();
+        for (auto& offset : m_offsets) {
+            offset -= first;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 按固定帧率生成录制时刻
+ * @param[in] fps   帧率
+ */
+void ReplayCamera::fillOffsets(const double fps) {
+    const double period = 1e9 / (fps > 0.0 ? fps : 100.0);
+    m_offsets.resize(m_frames.size());
+    for (size_t i = 0; i < m_offsets.size(); ++i) {
+        m_offsets[i] = std::chrono::nanoseconds(static_cast<int64_t>(period * static_cast<double>(i)));
+    }
+}
+
+/**
+ * @brief 回放线程：按计划时刻依次回调或更新最新帧
+ */
+void ReplayCamera::playLoop() {
+    const uint64_t total = totalFrames();
+    const bool paced = m_params.pace() != ReplayPace::AS_FAST;
+    uint64_t n = 0;
+    for (; m_running && (total == 0 || n < total); ++n) {
+        TimePoint timeStamp;
+        if (paced) {
+            timeStamp = m_startTime + std::chrono::duration_cast<Clock::duration>(due(n));
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_cond.wait_until(lock, timeStamp, [this] { return !m_running; })) {
+                break;
+            }
+            // 比下一帧的计划时刻还晚，说明下游回调拖慢了回放
+            const auto nextDue = m_startTime + std::chrono::duration_cast<Clock::duration>(due(n + 1));
+            if (Clock::now() > nextDue) {
+                ++m_late;
+            }
+        } else {
+            timeStamp = Clock::now();
+        }
+
+        const cv::Mat& image = m_frames[n % m_frames.size()];
+        if (m_params.mode() == Mode::STREAM) {
+            m_params.onCall()(timeStamp, image);
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_latestSeq = n + 1;
+            m_latestTime = timeStamp;
+            m_lastTime = Clock::now();
+        }
+        ++m_delivered;
+        m_cond.notify_all();
+    }
+    // 被stop打断时没有放完，取图方由!m_running唤醒
+    if (total != 0 && n == total) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_finished = true;
+        }
+        m_cond.notify_all();
+    }
+}
+
+/**
+ * @brief 第n个回放帧的计划时刻
+ * @param[in] n     回放序号，跨遍累计
+ * @return std::chrono::nanoseconds 相对开始回放的偏移
+ */
+std::chrono::nanoseconds ReplayCamera::due(const uint64_t n) const {
+    const uint64_t loop = n / m_frames.size();
+    return m_loopLength * static_cast<int64_t>(loop) + m_offsets[n % m_frames.size()];
+}
+
+uint64_t ReplayCamera::totalFrames() const {
+    return m_params.loops() > 0 ? static_cast<uint64_t>(m_params.loops()) * m_frames.size() : 0;
+}
+
+}  // namespace hitcrt::camera
@@ -0,0 +1,162 @@
+/**
+ * @file ReplayCam.h
+ * @brief 离线回放相机：把图片目录或视频预先解码进内存，按录制节奏、固定帧率或尽快回放
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>不依赖相机和仿真的回放驱动
+ * </table>
+ */
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <opencv2/core.hpp>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "CamBase.h"
+
+namespace hitcrt::camera {
+
+// 回放节奏：按录制时的时间间隔，按固定帧率，不等待尽快回放
+enum ReplayPace { RECORDED = 0, FIXED_FPS, AS_FAST };
+
+/**
+ * @brief 回放参数，CameraParams的path为图片目录或视频文件
+ *
+ * 图片目录按文件名排序回放，目录下有timestamps.txt（每行一个ns时间戳，与排序后的图片一一对应）时
+ * RECORDED按它回放，没有时按fps；视频按帧的播放时刻回放。
+ */
+class ReplayParams : public CameraParams {
+   public:
+    ReplayParams(const CallBack& onCall = noUse, const std::string& path = "", const Mode mode = STREAM,
+                 const ReplayPace pace = RECORDED, const double fps = 100.0, const int loops = 1,
+                 const int maxFrames = 0);
+    ReplayParams(const ReplayParams& cameraParams);
+
+    // 格式化输出
+    void show();
+    // setters
+    void setPace(const ReplayPace pace);
+    void setFps(const double fps);
+    // 回放几遍，0为一直循环到stop
+    void setLoops(const int loops);
+    // 最多预加载的帧数，0为全部
+    void setMaxFrames(const int maxFrames);
+    // getters
+    const ReplayPace pace() const;
+    const double fps() const;
+    const int loops() const;
+    const int maxFrames() const;
+    const std::string paceStr() const;
+
+   private:
+    ReplayPace m_pace = RECORDED;
+    double m_fps = 100.0;
+    int m_loops = 1;
+    int m_maxFrames = 0;
+};
+
+/**
+ * @brief 回放相机
+ *
+ * open时把全部帧解码进内存，回放期间没有磁盘读取和解码，回调拿到的图像直接指向预加载的内存，只读。
+ * 模式与Huaray一致：
+ * STREAM               回放线程按节奏调用onCall；
+ * STREAM_MULTITHREAD   按节奏回放时由回放线程更新最新帧，getFrameImage取没取过的新帧；
+ *                      AS_FAST时getFrameImage每次直接返回下一帧，回放速度由下游决定，不丢帧；
+ * SOFT                 每次softTrigger在调用线程里回调下一帧；
+ * LINE                 回放没有外部触发，不支持。
+ * 按节奏回放时回调的时间戳为这一帧计划的出帧时刻，AS_FAST时为回调时刻。
+ */
+class ReplayCamera : public Camera {
+   public:
+    // 回放统计：已回调的帧数，比计划时刻晚一帧以上才回调的帧数，实际帧率
+    using ReplayStat = std::tuple<uint64_t, uint64_t, double>;
+
+    ReplayCamera() = default;
+    ReplayCamera(const ReplayParams& cameraParams);
+    ~ReplayCamera();
+
+    // 调用接口
+    // 预加载并开始回放
+    bool initiate(const ReplayParams& cameraParams);
+    // 停止回放并释放预加载的帧
+    bool terminate();
+    // STREAM_MULTITHREAD模式取一帧
+    std::tuple<bool, TimePoint, cv::Mat> getFrameImage(const uint timeoutMs = 100);
+    // SOFT模式回放一帧
+    bool softTrigger();
+    // 全部回放完，被stop打断的回放不算
+    bool finished() const { return m_finished; }
+    // 等待回放完，超时返回false
+    bool waitFinished(const uint timeoutMs);
+    ReplayStat stat();
+
+    // getters
+    const size_t frameCount() const { return m_frames.size(); }
+    const cv::Mat& frame(const size_t index) const { return m_frames[index]; }
+    // 相对第一帧的录制时刻
+    const std::chrono::nanoseconds offset(const size_t index) const { return m_offsets[index]; }
+    // 预加载占用的内存
+    const size_t loadedBytes() const;
+
+   protected:
+    // 检查path是目录还是文件
+    virtual bool findDevices() override;
+    // 预加载，id未使用
+    virtual bool open(const uint id = 0) override;
+    virtual bool close() override;
+    virtual bool start(const CameraParams& cameraParams) override;
+    virtual bool stop(const CameraParams& cameraParams) override;
+
+    bool loadImages(const std::string& dir);
+    bool loadVideo(const std::string& path);
+    // 没有录制时刻或按固定帧率时，按fps生成
+    void fillOffsets(const double fps);
+
+    void playLoop();
+    // 第n个回放帧（跨遍累计）的计划时刻相对开始的偏移
+    std::chrono::nanoseconds due(const uint64_t n) const;
+    // 回放帧总数，0为无限
+    uint64_t totalFrames() const;
+
+    ReplayParams m_params;
+    bool m_isDirectory = false;
+    std::vector<cv::Mat> m_frames;
+    std::vector<std::chrono::nanoseconds> m_offsets;
+    std::chrono::nanoseconds m_loopLength{0};  // 一遍的时长，下一遍从这里接着排
+
+    // 回放线程
+    std::thread m_playThread;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_finished{false};
+    std::mutex m_mutex;  // 保护以下四项
+    std::condition_variable m_cond;
+    uint64_t m_latestSeq = 0;  // 最新帧的回放序号，从1开始
+    uint64_t m_takenSeq = 0;
+    TimePoint m_latestTime;
+
+    // 拉取模式（AS_FAST的STREAM_MULTITHREAD和SOFT）的下一帧
+    uint64_t m_next = 0;
+
+    // 统计
+    TimePoint m_startTime;
+    TimePoint m_lastTime;
+    std::atomic<uint64_t> m_delivered{0};
+    std::atomic<uint64_t> m_late{0};
+
+    //图片目录下的录制时刻文件
+    const std::string TIMESTAMP_FILE = "timestamps.txt";
+};
+
+}  // namespace hitcrt::camera
@@ -1,19 +1,23 @@
 #include "HuarayCam.h"
 #include "ArmorDetectorNN.h"
 #include "ArmorBase.h"
+#include "ArmorOverlay.h"
+#include "FrameRecord.h"
+#include "FrameRing.h"
+#include "ImageIngest.h"
+#include "LatestFrameMailbox.h"
+#include "ShmFrameRing.h"
+#include "StagePipeline.h"
+#include "Trace.h"
 #include <memory>
 #include <opencv2/highgui.hpp>
 #include <opencv2/opencv.hpp>
 #include <opencv2/stitching/warpers.hpp>
 #include <atomic>
-#include <condition_variable>
 #include <iostream>
-#include <mutex>
-#include <queue>
 #include <thread>
 
 // Ros2 仿真
-#include <cv_bridge/cv_bridge.h>
 #include <opencv2/core/types.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <sensor_msgs/msg/image.hpp>
@@ -22,11 +26,43 @@
 // 配置为你电脑上生成引擎的路径
 #define modelpath "/home/fx/Detect/7.29.engine"
 #define conf_thres 0.4
+// 仿真图像尺寸，与Unity相机分辨率一致
+#define image_width 1280
+#define image_height 1024
+// 每处理多少帧输出一次流水线各级耗时
+#define stats_interval 600
+// 非空时把收到的仿真图像满帧率录制到这个文件，之后可离线回放
+// Ctrl+C直接退出不会写文件尾，读取时自动恢复，也可用FrameRecordReader::repair补上
+#define record_path ""
+// 非空时从shm_bridge写的共享内存帧环取图，不再订阅图像话题，名字与shm_bridge的参数一致
+#define shm_ring_name ""
+// 非空且以-DENABLE_TRACE=ON编译时把逐帧trace写到这个文件，用ui.perfetto.dev或chrome://tracing打开
+#define trace_path ""
+// 非空时直接用华睿相机按这个.mvcfg配置取图，SOFT模式，推理级开始推理时请求下一帧；优先于shm_ring_name
+#define huaray_config ""
+#define huaray_id 0
 using Clock = std::chrono::steady_clock;
 using TimePoint = std::chrono::time_point<Clock>;
-struct frameTime {
-  cv::Mat m_frame;
-  TimePoint m_time;
+using FrameMailbox = hitcrt::LatestFrameMailbox<hitcrt::FrameHandle>;
+
+// 流水线级数和每级通道容量，与initPipeline中的addStage一致
+constexpr size_t pipeline_stages = 4;
+constexpr size_t stage_capacity = 1;
+// 每个生产者正在写、发布时换进信箱的一帧 + 信箱里还没取走的一帧；被顶掉的旧帧在发布时立即释放
+constexpr size_t mailbox_slots = FrameMailbox::MAX_PRODUCERS + 1;
+// 主线程从信箱取出、还没送进流水线的一帧
+constexpr size_t consumer_slots = 1;
+// 帧槽位数按同时可能持有句柄的位置累加：信箱两端、主线程、流水线每级通道里排队的和正在处理的。
+// 被挤出、跳过的任务回收时立即归还槽位；录制拷贝进录制器自己的缓冲区，画图原地画在槽位上，都不另占槽位。
+// 槽位用完时取图方丢掉这一帧，不会阻塞
+constexpr size_t frame_ring_capacity = mailbox_slots + consumer_slots + pipeline_stages * (stage_capacity + 1);
+
+// 流水线中逐级传递的一帧数据，处理完由流水线回收复用，推理输出和后处理结果的容量跨帧保留
+struct DetectionTask {
+  hitcrt::FrameHandle m_handle;          // 帧槽位，各级读写同一块内存
+  deploy::PoseResView m_result;          // 推理输出
+  std::vector<hitcrt::ArmorObservation> m_armors;  // 后处理结果
+  bool m_detected = false;
 };
 void SIGINTHandler(int sigNum) {
   std::cout << "\nInterrupt signal SIGINT received.\n";
@@ -38,65 +74,45 @@ void SIGINTHandler(int sigNum) {
   exit(sigNum);
 }
 
-template <typename T> class ThreadSafeQueue {
-public:
-  ThreadSafeQueue()
-      : stopProcessing(false) {}
-
-  void push(const T &value) {
-    std::unique_lock<std::mutex> lock(mutex_);
-
-    // 如果队列满了，丢弃最旧的元素，或者根据需求进行处理
-    if (queue_.size() >= max_size_) {
-      queue_.pop(); // 这里使用丢弃最旧数据的策略
-    }
-
-    queue_.push(value);
-    not_empty_condition_.notify_all(); // 通知消费者线程数据已更新
-  }
-
-  void pop(T &value) {
-    std::unique_lock<std::mutex> lock(mutex_);
-
-    // 如果队列为空，消费者线程会阻塞等待
-    not_empty_condition_.wait(
-        lock, [this] { return !queue_.empty() || stopProcessing.load(); });
-    if (stopProcessing.load()) {
-      return;
-    }
-    value = queue_.front();
-    queue_.pop();
-  }
-
-  bool empty() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    return queue_.empty();
-  }
-
-  void stop() {
-    stopProcessing = true;
-    not_empty_condition_.notify_all();
-  }
-
-private:
-  std::queue<T> queue_;
-  size_t max_size_ =1;
-  mutable std::mutex mutex_;
-  std::condition_variable not_empty_condition_;
-  std::atomic<bool> stopProcessing;
-};
-
 // 自定义的类
 class RobotDemo {
    public:
-    RobotDemo() {
+    RobotDemo() : m_frameRing(static_cast<int>(frame_ring_capacity), image_width, image_height, CV_8UC3) {
+#ifdef HITCRT_TRACE
+        if (std::string(trace_path).size() > 0) {
+            hitcrt::Tracer::instance().start(trace_path);
+        }
+#endif
+        if (std::string(record_path).size() > 0) {
+            m_recorder = std::make_unique<hitcrt::FrameRecorder>(record_path, image_width, image_height, CV_8UC3);
+        }
         // 初始化装甲板检测器
         m_detector =
             std::make_shared<hitcrt::ArmorDetectorNN>(modelpath, conf_thres);
-        initROS2();
+        initPipeline();
+        if (std::string(huaray_config).size() > 0) {
+            initCamera();
+        } else if (std::string(shm_ring_name).size() > 0) {
+            initShm();
+        } else {
+            initROS2();
+        }
     }
     ~RobotDemo() {
-      m_queue.stop(); // 停止队列阻塞
+      m_mailbox.stop(); // 唤醒阻塞在信箱上的主线程
+      // 推理级会调用m_camera->requestFrame，先停流水线并等各级线程退出，再释放相机
+      m_pipeline.stop();
+      if (m_camera) {
+        // 相机回调里还会读m_camera，先停回调和软触发线程，m_camera不再被其他线程访问后再释放
+        m_camera->terminate();
+        m_camera.reset();
+      }
+      m_shmRunning = false;
+      if (m_shmThread.joinable()) {
+        m_shmThread.join();
+      }
+      hitcrt::Tracer::instance().stop(); // 各级线程已退出，写完剩余区间和文件尾
+      m_executor.cancel();
       if (rclcpp::ok()) {
         rclcpp::shutdown();
       }
@@ -105,43 +121,109 @@ class RobotDemo {
       }
       cv::destroyAllWindows();
     }
-    // 用于帧回调的成员函数
-    void apply(const hitcrt::camera::TimePoint& timeStamp,
-               const cv::Mat& frameImage) {
-      cv::Mat image = frameImage.clone();
-      // 创建帧对象用于检测
-      hitcrt::Frame frame(image, timeStamp);
-      // 创建接收信息（设置敌方颜色）
-      hitcrt::RecvInfoBase recvInfo(0.0, 0.0, 0.0, 25.0, hitcrt::RED, true);
-
-      // 创建ROI（使用全图）
-      hitcrt::ROI roi;
+    // 检测流水线：推理 -> 后处理 -> 画图 -> 显示，每级一个线程
+    // 预处理（letterbox、归一化）在TensorRT的CUDA Graph里和推理一起完成，归在推理级
+    void initPipeline() {
+      m_pipeline
+          .addStage(
+              "infer",
+              [this](DetectionTask &task) {
+                HITCRT_TRACE_FRAME(task.m_handle.seq());
+                hitcrt::Frame frame(task.m_handle.image(), task.m_handle.timeStamp(), task.m_handle.rawStamp(),
+                                    task.m_handle.receiveTime());
+                const TimePoint inferStart = Clock::now();
+                // 推理级预计在本次推理结束时空闲，驱动按这个时刻减去提前量发出软触发
+                if (m_camera) {
+                  m_camera->requestFrame(inferStart + m_inferEstimate);
+                }
+                m_detector->infer(frame, task.m_result);
+                // 推理耗时的滑动平均，只在推理线程读写
+                const Clock::duration inferTime = Clock::now() - inferStart;
+                m_inferEstimate = m_inferEstimate == Clock::duration::zero()
+                                      ? inferTime
+                                      : m_inferEstimate + (inferTime - m_inferEstimate) / 8;
+                return true;
+              },
+              stage_capacity, hitcrt::DropPolicy::DROP_OLDEST) // 推理跟不上时只保留最新帧
+          .addStage(
+              "postprocess",
+              [this](DetectionTask &task) {
+                HITCRT_TRACE_FRAME(task.m_handle.seq());
+                hitcrt::Frame frame(task.m_handle.image(), task.m_handle.timeStamp(), task.m_handle.rawStamp(),
+                                    task.m_handle.receiveTime());
+                hitcrt::RecvInfoBase recvInfo(0.0, 0.0, 0.0, 25.0, hitcrt::RED, true);
+                task.m_detected = m_detector->decode(task.m_result, frame, recvInfo, task.m_armors);
+                return true;
+              },
+              stage_capacity, hitcrt::DropPolicy::BLOCK) // 推理结果不丢
+          .addStage(
+              "draw",
+              [this](DetectionTask &task) {
+                HITCRT_TRACE_FRAME(task.m_handle.seq());
+                // 前两级已经读完，这里原地画在帧槽位上
+                drawOverlay(task.m_handle.image(), task.m_handle.timeStamp(), task.m_armors,
+                            task.m_detected);
+                return true;
+              },
+              stage_capacity, hitcrt::DropPolicy::DROP_OLDEST)
+          .addStage(
+              "display",
+              [this](DetectionTask &task) {
+                HITCRT_TRACE_FRAME(task.m_handle.seq());
+                cv::imshow("Armor Detection", task.m_handle.image());
+                cv::waitKey(1);
+                // 抓图到显示完的整段延迟，与各级区间对照找出慢在哪里
+                HITCRT_TRACE_SPAN("frame latency", task.m_handle.seq(), task.m_handle.timeStamp(), Clock::now());
+                if (++m_displayed % stats_interval == 0) {
+                  printStats();
+                }
+                return true;
+              },
+              stage_capacity, hitcrt::DropPolicy::SKIP) // 显示跟不上就跳过，不拖累前级
+          .setReset([](DetectionTask &task) {
+            task.m_handle.reset(); // 立即归还帧槽位，不让回收池里的任务占着
+            task.m_result.num = 0;
+            task.m_armors.clear();
+            task.m_detected = false;
+          });
+      // 帧槽位数按pipeline_stages计算，增删级时要一起改
+      if (m_pipeline.stats().size() != pipeline_stages) {
+        throw std::logic_error("RobotDemo: pipeline_stages does not match the stages in initPipeline");
+      }
+      m_pipeline.start();
+    }
 
-      // 执行装甲板检测
-      std::vector<hitcrt::Armor> armors;
-      bool detected = m_detector->apply(frame, recvInfo, roi, armors);
+    void printStats() {
+      for (const auto &stats : m_pipeline.stats()) {
+        std::cout << "[" << stats.name << "] processed: " << stats.processed
+                  << ", dropped: " << stats.dropped << ", forward dropped: " << stats.forwardDropped
+                  << ", mean: " << stats.meanMs
+                  << " ms, p50: " << stats.p50Ms << " ms, p99: " << stats.p99Ms
+                  << " ms, max: " << stats.maxMs << " ms" << std::endl;
+      }
+    }
 
-      // 在图像上绘制检测结果
+    // 画检测结果和时间、数量信息，ArmorT为Armor或ArmorObservation
+    template <typename ArmorT>
+    void drawOverlay(cv::Mat &image, const hitcrt::camera::TimePoint &timeStamp,
+                     const std::vector<ArmorT> &armors, const bool detected) {
       if (detected) {
-        drawArmors(image, armors);
+        hitcrt::drawArmors(image, armors);
       }
-        
-        // 显示时间信息
-        std::stringstream ss;
-        auto duration = timeStamp - startTime;
-        ss << "TimeStamp: " << (double)duration.count() / std::nano::den;
-        cv::putText(image, ss.str(), cv::Point2i(20, 40),
-                    cv::FONT_HERSHEY_PLAIN, 1.5, cv::Scalar(0, 255, 0));
-        
-        // 显示检测结果统计
-        std::stringstream ss2;
-        ss2 << "Armors detected: " << armors.size();
-        cv::putText(image, ss2.str(), cv::Point2i(20, 120),
-                    cv::FONT_HERSHEY_PLAIN, 1.5, cv::Scalar(0, 255, 0));
-        
-        cv::imshow("Armor Detection", image);
-        cv::waitKey(1);
-    };
+
+      // 显示时间信息
+      std::stringstream ss;
+      auto duration = timeStamp - startTime;
+      ss << "TimeStamp: " << (double)duration.count() / std::nano::den;
+      cv::putText(image, ss.str(), cv::Point2i(20, 40),
+                  cv::FONT_HERSHEY_PLAIN, 1.5, cv::Scalar(0, 255, 0));
+      
+      // 显示检测结果统计
+      std::stringstream ss2;
+      ss2 << "Armors detected: " << armors.size();
+      cv::putText(image, ss2.str(), cv::Point2i(20, 120),
+                  cv::FONT_HERSHEY_PLAIN, 1.5, cv::Scalar(0, 255, 0));
+    }
     
     void onGet() {
         RobotDemo::onGetTime = std::chrono::steady_clock::now();
@@ -150,153 +232,153 @@ class RobotDemo {
     static hitcrt::camera::TimePoint startTime;
     static hitcrt::camera::TimePoint onGetTime;
 
-    // 绘制装甲板检测结果
-    void drawArmors(cv::Mat& image, const std::vector<hitcrt::Armor>& armors) {
-        for (size_t i = 0; i < armors.size(); ++i) {
-            const auto& armor = armors[i];
-            
-            // 装甲板的四个角点
-            std::vector<cv::Point2f> corners = {
-                armor.m_topLeft,     // 左上
-                armor.m_topRight,    // 右上  
-                armor.m_bottomRight, // 右下
-                armor.m_bottomLeft   // 左下
-            };
-            
-            // 绘制装甲板边界框
-            cv::Scalar color;
-            if (armor.m_pattern == hitcrt::Pattern::UNKNOWN) {
-                color = cv::Scalar(255, 255, 255);  // 白色表示未知
-            } else {
-                color = cv::Scalar(0, 255, 0);  // 绿色表示检测到的装甲板
-            }
-            
-            // 绘制四边形边界
-            for (int j = 0; j < 4; j++) {
-                cv::line(image, corners[j], corners[(j + 1) % 4], color, 2);
-            }
-            
-            // 绘制角点
-            for (int j = 0; j < 4; j++) {
-                cv::circle(image, corners[j], 4, cv::Scalar(0, 0, 255), -1);  // 红色圆点表示角点
-                // 标注角点序号
-                cv::putText(image, std::to_string(j), corners[j] + cv::Point2f(5, -5),
-                           cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(255, 255, 255), 1);
-            }
-            
-            // 绘制中心点
-            cv::circle(image, armor.m_centerUV, 4, cv::Scalar(255, 0, 0), -1);  // 蓝色中心点
-            
-            // 添加信息标签
-            std::string label = "ID:" + std::to_string(armor.m_classID) + 
-                               " C:" + std::to_string(armor.m_confidence).substr(0, 4);
-            
-            // 根据装甲板类型添加不同颜色
-            cv::Scalar textColor;
-            switch (armor.m_pattern) {
-                case hitcrt::Pattern::HERO:
-                    textColor = cv::Scalar(0, 165, 255);  // 橙色
-                    label += " HERO";
-                    break;
-                case hitcrt::Pattern::INFANTRY_3:
-                case hitcrt::Pattern::INFANTRY_4:
-                    textColor = cv::Scalar(255, 255, 0);  // 青色
-                    label += " INF";
-                    break;
-                case hitcrt::Pattern::SENTRY:
-                    textColor = cv::Scalar(255, 0, 255);  // 紫色
-                    label += " SENTRY";
-                    break;
-                case hitcrt::Pattern::ENGINEER:
-                    textColor = cv::Scalar(0, 255, 255);  // 黄色
-                    label += " ENG";
-                    break;
-                case hitcrt::Pattern::OUTPOST:
-                    textColor = cv::Scalar(128, 128, 128);  // 灰色
-                    label += " OUTPOST";
-                    break;
-                case hitcrt::Pattern::BASE:
-                    textColor = cv::Scalar(255, 0, 0);  // 蓝色
-                    label += " BASE";
-                    break;
-                default:
-                    textColor = cv::Scalar(255, 255, 255);  // 白色
-                    label += " UNKNOWN";
-                    break;
-            }
-            
-            // 在装甲板上方显示标签
-            cv::Point2f textPosition = armor.m_topLeft;
-            if (armor.m_topLeft.y < armor.m_bottomLeft.y) {
-                textPosition.y -= 10;  // 如果左上角在上方，就在上方显示
-            } else {
-                textPosition.y += 20;  // 否则在下方显示
-            }
-            
-            cv::putText(image, label, textPosition,
-                       cv::FONT_HERSHEY_SIMPLEX, 0.6, textColor, 2);
-            
-            // 绘制左右中心点连线
-            cv::line(image, armor.m_centerLeft, armor.m_centerRight, 
-                    cv::Scalar(255, 255, 0), 1);  // 青色连线
-        }
-    }
     void initROS2() {
       // 检查ROS2是否已经初始化
       if (!rclcpp::ok()) {
         rclcpp::init(0, nullptr);
       }
-      // 创建节点
-      m_simulationImageNode =
-          std::make_shared<rclcpp::Node>("hitcrtVisionNode");
-
-      // 兼容Ros2ForUnity通信规则
-      auto qos = rclcpp::QoS(rclcpp::KeepLast(10));
-      qos.best_effort();
-
-      // 创建订阅者 - 图像话题
-      m_simulationImageSub_ =
-          m_simulationImageNode->create_subscription<sensor_msgs::msg::Image>(
-              "/image_raw", qos,
-              std::bind(&RobotDemo::ros2ImageCallback, this,
-                        std::placeholders::_1));
+      // 接入节点：跨进程的消息一次转换写进帧槽位，进程内借槽位发布时不拷贝
+      m_ingestNode = std::make_shared<hitcrt::ImageIngestNode>(
+          m_frameRing, [this](hitcrt::FrameHandle &&handle) { onImage(std::move(handle)); });
+      m_executor.add_node(m_ingestNode);
 
       // 启动spin线程
       m_ros2SpinThread = std::thread([this]() {
+        HITCRT_TRACE_THREAD("ros2 executor");
         try {
-          rclcpp::spin(m_simulationImageNode);
+          m_executor.spin();
         } catch (const std::exception &e) {
           // 捕获潜在异常
         }
       });
     }
 
-    void ros2ImageCallback(const sensor_msgs::msg::Image::ConstSharedPtr &msg) {
-
-      try {
-
-        cv_bridge::CvImagePtr cv_ptr = cv_bridge::toCvCopy(msg, "bgr8");
-
-        TimePoint timePoint = std::chrono::steady_clock::now();
-
-        // 压入队列
-
-        m_queue.push(frameTime{cv_ptr->image.clone(), timePoint});
+    // 共享内存取图线程：futex上等桥进程发布，槽位只读映射，拷一次进帧槽位供各级读写
+    // 读完像素就归还共享内存槽位，后面的流水线各级异步处理，不用担心被桥进程覆盖；代价是每帧一次拷贝
+    void initShm() {
+      m_shmRunning = true;
+      m_shmThread = std::thread([this]() {
+        HITCRT_TRACE_THREAD("shm reader");
+        std::unique_ptr<hitcrt::ShmFrameReader> reader;
+        bool sizeWarned = false;
+        while (m_shmRunning) {
+          if (!reader) {
+            try {
+              reader = std::make_unique<hitcrt::ShmFrameReader>(shm_ring_name);
+            } catch (const std::runtime_error &e) {
+              // 桥进程还没启动
+              std::this_thread::sleep_for(std::chrono::milliseconds(200));
+              continue;
+            }
+          }
+          if (!reader->wait(100)) {
+            // 桥进程重启时删掉旧段重建，旧映射上永远等不到新帧，重新打开
+            if (reader->stale()) {
+              std::cout << "shm ring " << shm_ring_name << " writer restarted or exited, reopening" << std::endl;
+              reader.reset();
+            }
+            continue;
+          }
+          hitcrt::ShmFrameView view;
+          if (!reader->latest(view)) {
+            continue;
+          }
+          if (!m_frameRing.fits(view.m_image.cols, view.m_image.rows, view.m_image.type())) {
+            if (!sizeWarned) {
+              std::cerr << "shm ring frame " << view.m_image.cols << "x" << view.m_image.rows << " type "
+                        << view.m_image.type() << " does not fit frame ring slots " << m_frameRing.width() << "x"
+                        << m_frameRing.height() << " type " << m_frameRing.type() << ", dropping frames" << std::endl;
+              sizeWarned = true;
+            }
+            continue;
+          }
+          hitcrt::FrameHandle handle = m_frameRing.acquire();
+          if (handle.empty()) {
+            continue;
+          }
+          const TimePoint copyStart = Clock::now();
+          view.m_image.copyTo(handle.image());
+          // 拷贝期间被桥进程覆盖的帧丢掉，句柄未提交直接归还
+          if (!reader->intact(view)) {
+            continue;
+          }
+          const TimePoint timeStamp(std::chrono::duration_cast<Clock::duration>(
+              std::chrono::nanoseconds(view.m_meta.m_timeStampNs)));
+          const TimePoint receiveTime(std::chrono::duration_cast<Clock::duration>(
+              std::chrono::nanoseconds(view.m_meta.m_receiveNs)));
+          handle.commit(timeStamp, view.m_meta.m_rawStamp, receiveTime);
+          HITCRT_TRACE_SPAN("shm copy", handle.seq(), copyStart, Clock::now());
+          onImage(std::move(handle));
+        }
+      });
+    }
 
-      } catch (cv_bridge::Exception &e) {
+    // 华睿相机SOFT模式取图：回调里的图像只在回调期间有效，拷一次进帧槽位
+    void initCamera() {
+      hitcrt::camera::HuarayParams params(
+          [this](const hitcrt::camera::TimePoint &timeStamp, const cv::Mat &image) { onCamera(timeStamp, image); },
+          huaray_id, hitcrt::camera::Mode::SOFT, huaray_config);
+      m_camera = std::make_unique<hitcrt::camera::Huaray>();
+      if (!m_camera->initiate(params)) {
+        throw std::runtime_error("RobotDemo: huaray camera initiate failed");
+      }
+      // 第一帧还没有推理级的请求，立即请求；之后丢了触发驱动会超时自行补发
+      m_camera->requestFrame(Clock::now());
+    }
 
+    // 相机回调：回调到帧发布进信箱的耗时就是推理级之前的预处理，报告给驱动计入软触发的提前量。
+    // letterbox、归一化在推理级里，已经算在推理耗时中
+    void onCamera(const hitcrt::camera::TimePoint &timeStamp, const cv::Mat &image) {
+      const TimePoint receiveTime = Clock::now();
+      if (!m_frameRing.fits(image.cols, image.rows, image.type())) {
+        if (!m_cameraSizeWarned) {
+          std::cerr << "huaray frame " << image.cols << "x" << image.rows << " type " << image.type()
+                    << " does not fit frame ring slots " << m_frameRing.width() << "x" << m_frameRing.height()
+                    << " type " << m_frameRing.type() << ", dropping frames" << std::endl;
+          m_cameraSizeWarned = true;
+        }
+        return;
+      }
+      hitcrt::FrameHandle handle = m_frameRing.acquire();
+      if (handle.empty()) {
         return;
       }
+      image.copyTo(handle.image());
+      handle.commit(timeStamp, 0, receiveTime);
+      HITCRT_TRACE_SPAN("camera copy", handle.seq(), receiveTime, Clock::now());
+      onImage(std::move(handle));
+      m_camera->reportPreprocess(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - receiveTime));
+    }
+
+    // 接入节点回调：句柄已打好时间戳
+    void onImage(hitcrt::FrameHandle &&handle) {
+      // 录制拷贝进录制器自己的缓冲区，不占帧槽位
+      if (m_recorder) {
+        m_recorder->record(hitcrt::Frame(handle.image(), handle.timeStamp(), handle.rawStamp(), handle.receiveTime()),
+                           handle.seq());
+      }
+
+      // 发布到信箱，只传递句柄，未被取走的旧帧会被直接顶掉
+      m_mailbox.publish(std::move(handle));
     }
-    void ros2SpinThread() { rclcpp::spin(m_simulationImageNode); }
 
     std::shared_ptr<hitcrt::ArmorDetectorNN> m_detector;
-    std::shared_ptr<rclcpp::Node> m_simulationImageNode;
-    rclcpp::Subscription<sensor_msgs::msg::Image>::SharedPtr m_simulationImageSub_;
     std::thread m_ros2SpinThread;
-    std::mutex m_imageMutex;
-    cv::Mat image;
-    ThreadSafeQueue<frameTime> m_queue;
+    hitcrt::FrameRing m_frameRing; // 必须在m_mailbox之前声明，保证句柄先于槽位析构
+    FrameMailbox m_mailbox;
+    // 节点的intra-process缓冲里可能还有句柄，也要在m_frameRing之后声明
+    std::shared_ptr<hitcrt::ImageIngestNode> m_ingestNode;
+    rclcpp::executors::StaticSingleThreadedExecutor m_executor;
+    hitcrt::StagePipeline<DetectionTask> m_pipeline;
+    std::unique_ptr<hitcrt::FrameRecorder> m_recorder; // 录制，record_path为空时不创建
+    std::thread m_shmThread; // 共享内存取图，shm_ring_name为空时不启动
+    std::atomic<bool> m_shmRunning{false};
+    // 华睿相机，huaray_config为空时不创建；回调写帧环，在m_frameRing之后声明；
+    // 推理级和相机回调都会读这个指针，析构时等两边的线程都停了才释放
+    std::unique_ptr<hitcrt::camera::Huaray> m_camera;
+    bool m_cameraSizeWarned = false;       // 只在相机回调线程读写
+    Clock::duration m_inferEstimate{};     // 推理耗时的滑动平均，只在推理线程读写
+    uint64_t m_displayed = 0;
 };
 
 hitcrt::camera::TimePoint RobotDemo::startTime;
@@ -309,13 +391,19 @@ int main() {
   // 实例化对象
   
   RobotDemo robot;
-  frameTime frameT;
+  HITCRT_TRACE_THREAD("main");
+  hitcrt::FrameHandle frameHandle;
   while (rclcpp::ok()) {
-    robot.m_queue.pop(frameT);
-    if (frameT.m_frame.empty())
+    if (!robot.m_mailbox.consume(frameHandle))
+      break;
+    if (frameHandle.empty())
       continue;
+    // 收到到送进流水线，信箱里等待的时间
+    HITCRT_TRACE_SPAN("mailbox", frameHandle.seq(), frameHandle.receiveTime(), Clock::now());
 
-    robot.apply(frameT.m_time, frameT.m_frame);
+    DetectionTask task = robot.m_pipeline.acquire();
+    task.m_handle = std::move(frameHandle);
+    robot.m_pipeline.submit(std::move(task));
   }
   
 
@@ -1,9 +1,12 @@
 
 #pragma once
 
+#ifdef DEPLOY_WITH_TRT
 #include <cuda_runtime.h>
+#endif
 
 #include <iostream>
+#include <string>
 
 #ifdef _MSC_VER
 #define DEPLOYAPI __declspec(dllexport)
@@ -13,6 +16,7 @@
 
 namespace deploy {
 
+#ifdef DEPLOY_WITH_TRT
 /**
  * @brief 检查 CUDA 错误并处理，通过打印错误消息。
  *
@@ -40,6 +44,7 @@ inline void checkCudaError(cudaError_t code, const char* file, int line) {
  * @param code 要检查错误的 CUDA API 调用。
  */
 #define CHECK(code) checkCudaError((code), __FILE__, __LINE__)
+#endif
 
 /**
  * @brief 生成错误消息的宏。
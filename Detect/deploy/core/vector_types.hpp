@@ -0,0 +1,42 @@
+#pragma once
+
+#ifdef DEPLOY_WITH_TRT
+
+#include <vector_functions.hpp>
+
+#else
+
+namespace deploy {
+
+/**
+ * @brief 无 CUDA 环境下替代 CUDA 向量类型，仅保留本库用到的类型和构造函数
+ *
+ * 成员布局与 CUDA 的 vector_types.h 一致，InferOption、AffineTransform 等在两种构建下源码不变。
+ */
+struct float3 {
+    float x, y, z;
+};
+
+struct int2 {
+    int x, y;
+};
+
+struct int4 {
+    int x, y, z, w;
+};
+
+inline float3 make_float3(float x, float y, float z) {
+    return float3{x, y, z};
+}
+
+inline int2 make_int2(int x, int y) {
+    return int2{x, y};
+}
+
+inline int4 make_int4(int x, int y, int z, int w) {
+    return int4{x, y, z, w};
+}
+
+}  // namespace deploy
+
+#endif
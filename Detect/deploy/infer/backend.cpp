@@ -4,11 +4,12 @@
 
 #include "deploy/core/core.hpp"
 #include "deploy/infer/backend.hpp"
+#include "deploy/infer/cpu_warpaffine.hpp"
 #include "deploy/utils/utils.hpp"
 
 namespace deploy {
 
-TrtBackend::TrtBackend(const std::string& trt_engine_file, const InferOption& infer_option) : option(infer_option) {
+TrtBackend::TrtBackend(const std::string& trt_engine_file, const InferOption& infer_option) : BaseBackend(infer_option) {
     cudaSetDevice(option.device_id);   // < 设置设备
     CHECK(cudaStreamCreate(&stream));  // < 创建 stream
 
@@ -35,7 +36,7 @@ TrtBackend::TrtBackend(const std::string& trt_engine_file, const InferOption& in
     if (!dynamic) captureCudaGraph();
 }
 
-std::unique_ptr<TrtBackend> TrtBackend::clone() {
+std::unique_ptr<BaseBackend> TrtBackend::clone() {
     auto clone_backend    = std::make_unique<TrtBackend>();
     clone_backend->option = option;
 
@@ -66,6 +67,15 @@ TrtBackend::~TrtBackend() {
     CHECK(cudaStreamDestroy(stream));
 }
 
+HostTensor TrtBackend::tensor(int index) const {
+    auto&      tensor_info = tensor_infos[index];
+    HostTensor view;
+    view.host         = tensor_info.input ? nullptr : tensor_info.buffer->host();
+    view.shape.nbDims = tensor_info.shape.nbDims;
+    std::copy(tensor_info.shape.d, tensor_info.shape.d + tensor_info.shape.nbDims, view.shape.d);
+    return view;
+}
+
 void TrtBackend::getTensorInfo() {
     std::vector<TensorInfo>().swap(tensor_infos);
     buffer_type_     = option.enable_managed_memory ? BufferType::Unified : (zero_copy_ ? BufferType::Mapped : BufferType::Discrete);
@@ -216,6 +226,8 @@ void TrtBackend::staticInfer(const std::vector<Image>& inputs) {
         throw std::invalid_argument("Number of inputs out of range");
     }
 
+    // 只计主机侧的打包和图参数更新，仿射核在图里异步执行，不计入
+    StageTimer preprocess("preprocess");
     if (option.input_shape.has_value()) {
         if (option.cuda_mem) {
             for (int idx = 0; idx < num; ++idx) {
@@ -238,7 +250,7 @@ void TrtBackend::staticInfer(const std::vector<Image>& inputs) {
             }
         } else {
             for (auto idx = 0; idx < num; ++idx) {
-                std::memcpy(static_cast<uint8_t*>(inputs_buffer_->host()) + idx * input_size_, inputs[idx].ptr, input_size_);
+                cpuPackBgr(inputs[idx], static_cast<uint8_t*>(inputs_buffer_->host()) + idx * input_size_);
             }
         }
     } else {
@@ -257,7 +269,7 @@ void TrtBackend::staticInfer(const std::vector<Image>& inputs) {
             uint8_t* input_ptr = static_cast<uint8_t*>(inputs_buffer_->host());
 
             for (int idx = 0; idx < num; ++idx) {
-                std::memcpy(input_ptr, inputs[idx].ptr, input_sizes[idx]);
+                cpuPackBgr(inputs[idx], input_ptr);
                 input_ptr += input_sizes[idx];
             }
 
@@ -296,6 +308,8 @@ void TrtBackend::staticInfer(const std::vector<Image>& inputs) {
         }
     }
 
+    preprocess.stop();
+
     // Launch the CUDA graph
     cuda_graph_.launch(stream);
 }
@@ -318,11 +332,13 @@ void TrtBackend::dynamicInfer(const std::vector<Image>& inputs) {
         }
     }
 
+    // 只计主机侧的打包、拷贝和仿射核入队，核函数在流上异步执行，不计入
+    StageTimer preprocess("preprocess");
     if (option.input_shape.has_value()) {
         // 2. 处理静态输入形状
         if (!option.cuda_mem) {
             for (int idx = 0; idx < num; ++idx) {
-                std::memcpy(static_cast<uint8_t*>(inputs_buffer_->host()) + idx * input_size_, inputs[idx].ptr, input_size_);
+                cpuPackBgr(inputs[idx], static_cast<uint8_t*>(inputs_buffer_->host()) + idx * input_size_);
             }
             inputs_buffer_->hostToDevice(stream);
         }
@@ -358,7 +374,7 @@ void TrtBackend::dynamicInfer(const std::vector<Image>& inputs) {
 
             // 拷贝输入数据到主机内存
             for (int idx = 0; idx < num; ++idx) {
-                std::memcpy(input_host, inputs[idx].ptr, input_sizes[idx]);
+                cpuPackBgr(inputs[idx], input_host);
                 input_host += input_sizes[idx];
             }
 
@@ -397,6 +413,8 @@ void TrtBackend::dynamicInfer(const std::vector<Image>& inputs) {
         }
     }
 
+    preprocess.stop();
+
     // 推理
     if (!manager_->enqueueV3(stream)) {
         throw std::runtime_error("Infer Error.");
@@ -414,6 +432,16 @@ void TrtBackend::dynamicInfer(const std::vector<Image>& inputs) {
 }
 
 void TrtBackend::infer(const std::vector<Image>& inputs) {
+    // GPU 核函数读行间无填充的 BGR：主机输入在拷进暂存缓冲区时一次遍历完成通道顺序、去填充和翻转，
+    // 显存输入不经过主机，必须已经是整块 BGR；Bayer 原图的 2x2 合并去马赛克目前只有 CPU 实现
+    for (const auto& image : inputs) {
+        if (image.format == PixelFormat::BayerBG) {
+            throw std::invalid_argument(MAKE_ERROR_MESSAGE("TrtBackend: Bayer input is not supported"));
+        }
+        if (option.cuda_mem && !image.packedBgr()) {
+            throw std::invalid_argument(MAKE_ERROR_MESSAGE("TrtBackend: device input must be packed BGR"));
+        }
+    }
     if (dynamic) {
         dynamicInfer(inputs);
     } else {
@@ -9,6 +9,7 @@
 
 #include "../core/buffer.hpp"
 #include "../core/core.hpp"
+#include "../infer/base_backend.hpp"
 #include "../infer/warpaffine.hpp"
 #include "../option.hpp"
 #include "../result.hpp"
@@ -18,7 +19,7 @@ namespace deploy {
 /**
  * @brief TensorRT 后端类，用于执行推理操作。
  */
-class DEPLOYAPI TrtBackend {
+class DEPLOYAPI TrtBackend : public BaseBackend {
 public:
     /**
      * @brief 构造函数，用于初始化 TrtBackend 对象。
@@ -36,29 +37,34 @@ public:
     /**
      * @brief 析构函数。
      */
-    ~TrtBackend();
+    ~TrtBackend() override;
 
     /**
      * @brief 克隆 TrtBackend 对象。
      *
      * @return 克隆后的 TrtBackend 对象的智能指针。
      */
-    std::unique_ptr<TrtBackend> clone();
+    std::unique_ptr<BaseBackend> clone() override;
 
     /**
      * @brief 执行推理操作。
      *
      * @param inputs 输入图像向量。
      */
-    void infer(const std::vector<Image>& inputs);
-
-    cudaStream_t                 stream;             // < CUDA 流
-    InferOption                  option;             // < 推理选项
-    std::vector<TensorInfo>      tensor_infos;       // < 张量信息向量
-    std::vector<AffineTransform> affine_transforms;  // < 仿射变换向量
-    int4                         min_shape;          // < 最小形状
-    int4                         max_shape;          // < 最大形状
-    bool                         dynamic;            // < 是否为动态形状
+    void infer(const std::vector<Image>& inputs) override;
+
+    int numTensors() const override {
+        return static_cast<int>(tensor_infos.size());
+    }
+
+    HostTensor tensor(int index) const override;
+
+    BackendType type() const override {
+        return BackendType::TensorRT;
+    }
+
+    cudaStream_t            stream;        // < CUDA 流
+    std::vector<TensorInfo> tensor_infos;  // < 张量信息向量
 
 private:
     void getTensorInfo();
@@ -0,0 +1,36 @@
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+#include "deploy/infer/base_backend.hpp"
+#include "deploy/infer/ocv_backend.hpp"
+#ifdef DEPLOY_WITH_TRT
+#include "deploy/infer/backend.hpp"
+#endif
+
+namespace deploy {
+
+static BackendType deduceBackend(const std::string& model_file) {
+    auto dot = model_file.find_last_of('.');
+    if (dot == std::string::npos) {
+        return BackendType::TensorRT;
+    }
+    std::string ext = model_file.substr(dot + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+    return ext == "onnx" ? BackendType::OpenCV : BackendType::TensorRT;
+}
+
+std::unique_ptr<BaseBackend> createBackend(const std::string& model_file, const InferOption& infer_option) {
+    BackendType type = infer_option.backend == BackendType::Auto ? deduceBackend(model_file) : infer_option.backend;
+
+    if (type == BackendType::OpenCV) {
+        return std::make_unique<OcvBackend>(model_file, infer_option);
+    }
+#ifdef DEPLOY_WITH_TRT
+    return std::make_unique<TrtBackend>(model_file, infer_option);
+#else
+    throw std::runtime_error(MAKE_ERROR_MESSAGE("TensorRT backend is not built, use an ONNX model with the OpenCV backend: " + model_file));
+#endif
+}
+
+}  // namespace deploy
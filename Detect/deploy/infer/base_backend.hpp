@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../option.hpp"
+#include "../result.hpp"
+#include "affine.hpp"
+
+namespace deploy {
+
+/**
+ * @brief 张量形状，字段与 nvinfer1::Dims 保持一致，后处理代码对两种后端写法相同
+ */
+struct TensorShape {
+    static constexpr int MAX_DIMS = 8;  // < 最大维数
+
+    int     nbDims = 0;                 // < 维数
+    int64_t d[MAX_DIMS]{};              // < 各维大小
+};
+
+/**
+ * @brief 主机端张量视图，不持有内存
+ */
+struct HostTensor {
+    void*       host = nullptr;  // < 主机端数据指针
+    TensorShape shape;           // < 张量形状
+};
+
+/**
+ * @brief 推理后端抽象基类
+ *
+ * 约定张量顺序与 TensorRT-YOLO 导出的引擎一致：0 为输入，1 起依次为 num、boxes、scores、classes，
+ * 之后为各任务特有的输出（kpts、masks 等）。输出坐标位于网络输入坐标系，由 affine_transforms 映射回原图。
+ */
+class DEPLOYAPI BaseBackend {
+public:
+    /**
+     * @brief 构造函数
+     *
+     * @param infer_option 推理选项
+     */
+    explicit BaseBackend(const InferOption& infer_option) : option(infer_option) {}
+
+    /**
+     * @brief 默认构造函数，仅在 clone 方法中使用
+     */
+    BaseBackend() = default;
+
+    /**
+     * @brief 析构函数
+     */
+    virtual ~BaseBackend() = default;
+
+    /**
+     * @brief 克隆后端对象，克隆出的对象拥有独立的缓冲区，可在另一线程中推理
+     *
+     * @return 克隆后的后端对象的智能指针
+     */
+    virtual std::unique_ptr<BaseBackend> clone() = 0;
+
+    /**
+     * @brief 执行推理操作，返回时输出已在主机端可读
+     *
+     * @param inputs 输入图像向量
+     */
+    virtual void infer(const std::vector<Image>& inputs) = 0;
+
+    /**
+     * @brief 获取张量数量（输入 + 输出）
+     */
+    virtual int numTensors() const = 0;
+
+    /**
+     * @brief 获取指定张量的主机端视图
+     *
+     * @param index 张量索引
+     * @return 主机端张量视图
+     */
+    virtual HostTensor tensor(int index) const = 0;
+
+    /**
+     * @brief 获取后端类型
+     */
+    virtual BackendType type() const = 0;
+
+    InferOption                  option;                // < 推理选项
+    std::vector<AffineTransform> affine_transforms;     // < 仿射变换向量
+    int4                         min_shape{};           // < 最小形状
+    int4                         max_shape{};           // < 最大形状
+    bool                         dynamic = false;       // < 是否为动态形状
+};
+
+/**
+ * @brief 按推理选项创建后端
+ *
+ * option.backend 为 Auto 时按文件后缀选择：.onnx 使用 OpenCV DNN，其余按 TensorRT 引擎加载。
+ * 未编译 TensorRT 支持时请求 TensorRT 后端会抛出异常。
+ *
+ * @param model_file 模型文件路径
+ * @param infer_option 推理选项
+ * @return 后端对象的智能指针
+ */
+DEPLOYAPI std::unique_ptr<BaseBackend> createBackend(const std::string& model_file, const InferOption& infer_option);
+
+}  // namespace deploy
@@ -0,0 +1,728 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+#include "deploy/infer/cpu_warpaffine.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DEPLOY_CPU_X86
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define DEPLOY_CPU_NEON
+#endif
+
+namespace deploy {
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t exp  = (bits >> 23) & 0xFFu;
+    uint32_t       mant = bits & 0x7FFFFFu;
+
+    if (exp == 0xFFu) {  // inf / nan
+        return static_cast<uint16_t>(sign | 0x7C00u | (mant ? 0x200u | (mant >> 13) : 0u));
+    }
+    const int half_exp = static_cast<int>(exp) - 127 + 15;
+    if (half_exp >= 0x1F) {  // 上溢为 inf
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+    if (half_exp <= 0) {  // 非规格化数或下溢为 0
+        if (half_exp < -10) {
+            return static_cast<uint16_t>(sign);
+        }
+        mant |= 0x800000u;
+        const uint32_t shift     = static_cast<uint32_t>(14 - half_exp);
+        uint32_t       half_mant = mant >> shift;
+        const uint32_t remainder = mant & ((1u << shift) - 1u);
+        const uint32_t halfway   = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half_mant & 1u))) {
+            ++half_mant;
+        }
+        return static_cast<uint16_t>(sign | half_mant);
+    }
+    uint32_t       half      = sign | (static_cast<uint32_t>(half_exp) << 10) | (mant >> 13);
+    const uint32_t remainder = mant & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+        ++half;  // 进位可能溢出到指数，结果仍然正确（最大值进位为 inf）
+    }
+    return static_cast<uint16_t>(half);
+}
+
+float halfToFloat(uint16_t value) {
+    const uint32_t sign = (static_cast<uint32_t>(value) & 0x8000u) << 16;
+    uint32_t       exp  = (value >> 10) & 0x1Fu;
+    uint32_t       mant = value & 0x3FFu;
+    uint32_t       bits;
+    if (exp == 0x1Fu) {
+        bits = sign | 0x7F800000u | (mant << 13);
+    } else if (exp == 0) {
+        if (mant == 0) {
+            bits = sign;
+        } else {
+            // 非规格化数，规格化后再拼装
+            int e = -1;
+            do {
+                ++e;
+                mant <<= 1;
+            } while ((mant & 0x400u) == 0);
+            bits = sign | (static_cast<uint32_t>(127 - 15 - e) << 23) | ((mant & 0x3FFu) << 13);
+        }
+    } else {
+        bits = sign | ((exp + 127 - 15) << 23) | (mant << 13);
+    }
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+namespace {
+
+/**
+ * @brief 输出平面，按输出类型写入
+ */
+struct PlanarOutput {
+    void*      base;
+    size_t     plane;
+    PlanarType type;
+
+    void store(size_t offset, const float value[3]) const {
+        if (type == PlanarType::Float32) {
+            float* out                 = static_cast<float*>(base) + offset;
+            out[0]                     = value[0];
+            out[plane]                 = value[1];
+            out[2 * plane]             = value[2];
+        } else {
+            uint16_t* out              = static_cast<uint16_t*>(base) + offset;
+            out[0]                     = floatToHalf(value[0]);
+            out[plane]                 = floatToHalf(value[1]);
+            out[2 * plane]             = floatToHalf(value[2]);
+        }
+    }
+};
+
+/**
+ * @brief BGR / RGB / BGRA / RGBA 8 位输入
+ *
+ * data 指向第 0 行，自下而上存储时指向缓冲区的最后一行，step 为负。
+ */
+struct PackedSource {
+    const uint8_t* data;
+    int            cols;      // < 采样坐标系下的宽度
+    int            rows;      // < 采样坐标系下的高度
+    ptrdiff_t      step;      // < 相邻两行的地址差
+    int            channels;  // < 每个像素的字节数，3 或 4
+    bool           swap_rb;   // < 读出时交换第 0 和第 2 个字节
+
+    void fetch(const int x, const int y, float value[3]) const {
+        const uint8_t* pixel = data + y * step + x * channels;
+        value[0]             = pixel[swap_rb ? 2 : 0];
+        value[1]             = pixel[1];
+        value[2]             = pixel[swap_rb ? 0 : 2];
+    }
+
+    // 最后一个能整读 4 字节的偏移，相对 data
+    int lastWord() const {
+        return static_cast<int>(std::max<ptrdiff_t>(0, (rows - 1) * step) + cols * channels - 4);
+    }
+};
+
+/**
+ * @brief BayerBG8 输入按 2x2 合并后的 BGR 图像，宽高各为原图的一半
+ *
+ * 排列与 cv::COLOR_BayerBG2BGR 一致，每个 2x2 单元为 R G / G B，合并后 B、R 取对应像素，G 取两个 G 的平均。
+ * 自下而上存储时单元按行倒序（cell_step 为负），单元内的上下两行仍按缓冲区顺序，不改变排列。
+ */
+struct BayerSource {
+    const uint8_t* data;       // < 第 0 行单元的上一行
+    int            cols;       // < 合并后的宽度
+    int            rows;       // < 合并后的高度
+    int            stride;     // < 原图一行的字节数
+    ptrdiff_t      cell_step;  // < 相邻两行单元的地址差
+
+    void fetch(const int x, const int y, float value[3]) const {
+        const uint8_t* top    = data + y * cell_step + 2 * x;
+        const uint8_t* bottom = top + stride;
+        value[0]              = bottom[1];
+        value[1]              = 0.5f * (static_cast<float>(top[1]) + static_cast<float>(bottom[0]));
+        value[2]              = top[0];
+    }
+
+    int lastWord() const {
+        return static_cast<int>(std::max<ptrdiff_t>(0, (rows - 1) * cell_step) + stride + 2 * cols - 4);
+    }
+};
+
+PackedSource packedSource(const Image& image, const bool swap_rb) {
+    const uint8_t* data = static_cast<const uint8_t*>(image.ptr);
+    if (image.flip) {
+        data += static_cast<ptrdiff_t>(image.height - 1) * image.stride;
+    }
+    return {data, image.width, image.height, image.flip ? -static_cast<ptrdiff_t>(image.stride) : image.stride,
+            pixelBytes(image.format), swap_rb};
+}
+
+BayerSource bayerSource(const Image& image) {
+    const int      rows = image.height / 2;
+    const uint8_t* data = static_cast<const uint8_t*>(image.ptr);
+    if (image.flip) {
+        data += static_cast<ptrdiff_t>(rows - 1) * 2 * image.stride;
+    }
+    const ptrdiff_t cell_step = 2 * static_cast<ptrdiff_t>(image.stride);
+    return {data, image.width / 2, rows, image.stride, image.flip ? -cell_step : cell_step};
+}
+
+/**
+ * @brief 单个像素，逐条对应 CUDA 核函数 warp_affine_bilinear
+ */
+template <typename Source>
+inline void warpPixel(const Source& source, const float3& m0, const float3& m1, const ProcessConfig& config,
+                      const int element_x, const int element_y, float out[3]) {
+    const float src_x = m0.x * element_x + m0.y * element_y + m0.z;
+    const float src_y = m1.x * element_x + m1.y * element_y + m1.z;
+
+    const int src_x0 = static_cast<int>(std::floor(src_x));
+    const int src_y0 = static_cast<int>(std::floor(src_y));
+    const int src_x1 = src_x0 + 1;
+    const int src_y1 = src_y0 + 1;
+
+    const float wx0 = src_x1 - src_x;
+    const float wx1 = src_x - src_x0;
+    const float wy0 = src_y1 - src_y;
+    const float wy1 = src_y - src_y0;
+
+    auto fetch = [&](int x, int y, float value[3]) {
+        if (x >= 0 && x < source.cols && y >= 0 && y < source.rows) {
+            source.fetch(x, y, value);
+        } else {
+            value[0] = value[1] = value[2] = config.border_value;
+        }
+    };
+
+    float v00[3], v01[3], v10[3], v11[3];
+    fetch(src_x0, src_y0, v00);
+    fetch(src_x1, src_y0, v01);
+    fetch(src_x0, src_y1, v10);
+    fetch(src_x1, src_y1, v11);
+
+    const float w00 = wx0 * wy0, w01 = wx1 * wy0, w10 = wx0 * wy1, w11 = wx1 * wy1;
+    float       sum[3];
+    for (int c = 0; c < 3; ++c) {
+        sum[c]  = w00 * v00[c] + w01 * v01[c];
+        sum[c] += w10 * v10[c] + w11 * v11[c];
+    }
+    if (config.swap_rb) {
+        const float temp = sum[0];
+        sum[0]           = sum[2];
+        sum[2]           = temp;
+    }
+    out[0] = sum[0] * config.alpha.x + config.beta.x;
+    out[1] = sum[1] * config.alpha.y + config.beta.y;
+    out[2] = sum[2] * config.alpha.z + config.beta.z;
+}
+
+template <typename Source>
+void warpRowsScalar(const Source& source, const PlanarOutput& output, const int dst_cols,
+                    const float3& m0, const float3& m1, const ProcessConfig& config,
+                    const int row_begin, const int row_end, const int col_begin) {
+    float value[3];
+    for (int y = row_begin; y < row_end; ++y) {
+        for (int x = col_begin; x < dst_cols; ++x) {
+            warpPixel(source, m0, m1, config, x, y, value);
+            output.store(static_cast<size_t>(y) * dst_cols + x, value);
+        }
+    }
+}
+
+/**
+ * @brief 原图坐标到 2x2 合并后坐标的矩阵
+ *
+ * 合并后像素 (bx, by) 的中心在原图的 (2bx + 0.5, 2by + 0.5)，即 b = (s - 0.5) / 2。
+ */
+void binnedMatrix(const float3 matrix[2], float3 binned[2]) {
+    for (int i = 0; i < 2; ++i) {
+        binned[i] = make_float3(0.5f * matrix[i].x, 0.5f * matrix[i].y, 0.5f * (matrix[i].z - 0.5f));
+    }
+}
+
+#ifdef DEPLOY_CPU_X86
+
+bool supportsAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c");
+    return supported;
+}
+
+/**
+ * @brief 从 offset 处读 4 字节，offset 超过 last 时改为从 last 读取再右移，避免越过缓冲区末尾
+ */
+__attribute__((target("avx2,fma,f16c"))) inline __m256i gatherWords(const int* base, const __m256i offset,
+                                                                    const __m256i mask, const __m256i last) {
+    const __m256i clamped = _mm256_min_epi32(offset, last);
+    const __m256i shift   = _mm256_slli_epi32(_mm256_sub_epi32(offset, clamped), 3);
+    const __m256i pixel   = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), base, clamped, mask, 1);
+    return _mm256_srlv_epi32(pixel, shift);
+}
+
+/**
+ * @brief 用 gather 读取 8 个邻域像素的三个通道，mask 为 0 的通道取 border_value
+ *
+ * 每个像素读 4 字节（三通道时多读下一个像素的第一个字节），行偏移可以为负。
+ */
+__attribute__((target("avx2,fma,f16c"))) inline void gatherPixels(const PackedSource& source, const __m256i x, const __m256i y,
+                                                                const __m256i mask, const __m256 border, __m256 value[3]) {
+    const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+    const __m256i last      = _mm256_set1_epi32(source.lastWord());
+    const __m256i offset    = _mm256_add_epi32(_mm256_mullo_epi32(y, _mm256_set1_epi32(static_cast<int>(source.step))),
+                                               _mm256_mullo_epi32(x, _mm256_set1_epi32(source.channels)));
+    const __m256i pixel     = gatherWords(reinterpret_cast<const int*>(source.data), offset, mask, last);
+    const __m256  valid     = _mm256_castsi256_ps(mask);
+    const __m256  c0        = _mm256_cvtepi32_ps(_mm256_and_si256(pixel, byte_mask));
+    const __m256  c1        = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixel, 8), byte_mask));
+    const __m256  c2        = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixel, 16), byte_mask));
+    value[0] = _mm256_blendv_ps(border, source.swap_rb ? c2 : c0, valid);
+    value[1] = _mm256_blendv_ps(border, c1, valid);
+    value[2] = _mm256_blendv_ps(border, source.swap_rb ? c0 : c2, valid);
+}
+
+/**
+ * @brief 合并后的 8 个邻域像素，每个 2x2 单元的上下两行各用一次 gather 读取
+ */
+__attribute__((target("avx2,fma,f16c"))) inline void gatherPixels(const BayerSource& source, const __m256i x, const __m256i y,
+                                                                const __m256i mask, const __m256 border, __m256 value[3]) {
+    const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+    const __m256i last      = _mm256_set1_epi32(source.lastWord());
+    const __m256i top_off   = _mm256_add_epi32(_mm256_mullo_epi32(y, _mm256_set1_epi32(static_cast<int>(source.cell_step))),
+                                               _mm256_add_epi32(x, x));
+    const __m256i bot_off   = _mm256_add_epi32(top_off, _mm256_set1_epi32(source.stride));
+    const int*    base      = reinterpret_cast<const int*>(source.data);
+    const __m256i top       = gatherWords(base, top_off, mask, last);
+    const __m256i bottom    = gatherWords(base, bot_off, mask, last);
+    const __m256  valid     = _mm256_castsi256_ps(mask);
+
+    const __m256 r  = _mm256_cvtepi32_ps(_mm256_and_si256(top, byte_mask));
+    const __m256 g0 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(top, 8), byte_mask));
+    const __m256 g1 = _mm256_cvtepi32_ps(_mm256_and_si256(bottom, byte_mask));
+    const __m256 b  = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(bottom, 8), byte_mask));
+    value[0] = _mm256_blendv_ps(border, b, valid);
+    value[1] = _mm256_blendv_ps(border, _mm256_mul_ps(_mm256_add_ps(g0, g1), _mm256_set1_ps(0.5f)), valid);
+    value[2] = _mm256_blendv_ps(border, r, valid);
+}
+
+/**
+ * @brief AVX2 实现，每次处理一行中连续的 8 个输出像素
+ *
+ * 坐标、权重、边界判断、插值和归一化都在向量中完成，4 个邻域像素各用一次 gatherPixels 读取。
+ */
+template <typename Source>
+__attribute__((target("avx2,fma,f16c"))) void warpRowsAvx2(const Source& source, const PlanarOutput& output, const int dst_cols,
+                                                         const float3& m0, const float3& m1, const ProcessConfig& config,
+                                                         const int row_begin, const int row_end) {
+    const __m256i  cols        = _mm256_set1_epi32(source.cols);
+    const __m256i  cols_m1     = _mm256_set1_epi32(source.cols - 1);
+    const __m256i  rows        = _mm256_set1_epi32(source.rows);
+    const __m256i  rows_m1     = _mm256_set1_epi32(source.rows - 1);
+    const __m256i  minus1      = _mm256_set1_epi32(-1);
+    const __m256i  minus2      = _mm256_set1_epi32(-2);
+    const __m256i  one_i       = _mm256_set1_epi32(1);
+    const __m256   border      = _mm256_set1_ps(config.border_value);
+    const __m256   one         = _mm256_set1_ps(1.0f);
+    const __m256   iota        = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256   m0x         = _mm256_set1_ps(m0.x);
+    const __m256   m1x         = _mm256_set1_ps(m1.x);
+    const __m256   alpha[3]    = {_mm256_set1_ps(config.alpha.x), _mm256_set1_ps(config.alpha.y), _mm256_set1_ps(config.alpha.z)};
+    const __m256   beta[3]     = {_mm256_set1_ps(config.beta.x), _mm256_set1_ps(config.beta.y), _mm256_set1_ps(config.beta.z)};
+
+    const int vec_cols = dst_cols & ~7;
+    for (int y = row_begin; y < row_end; ++y) {
+        const __m256 row_x = _mm256_set1_ps(m0.y * y + m0.z);
+        const __m256 row_y = _mm256_set1_ps(m1.y * y + m1.z);
+        const size_t row   = static_cast<size_t>(y) * dst_cols;
+
+        for (int x = 0; x < vec_cols; x += 8) {
+            const __m256 element_x = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(x)), iota);
+            const __m256 src_x     = _mm256_add_ps(_mm256_mul_ps(m0x, element_x), row_x);
+            const __m256 src_y     = _mm256_add_ps(_mm256_mul_ps(m1x, element_x), row_y);
+            const __m256 floor_x   = _mm256_floor_ps(src_x);
+            const __m256 floor_y   = _mm256_floor_ps(src_y);
+            const __m256i x0       = _mm256_cvttps_epi32(floor_x);
+            const __m256i y0       = _mm256_cvttps_epi32(floor_y);
+            const __m256i x1       = _mm256_add_epi32(x0, one_i);
+            const __m256i y1       = _mm256_add_epi32(y0, one_i);
+
+            const __m256 wx0 = _mm256_sub_ps(_mm256_add_ps(floor_x, one), src_x);
+            const __m256 wx1 = _mm256_sub_ps(src_x, floor_x);
+            const __m256 wy0 = _mm256_sub_ps(_mm256_add_ps(floor_y, one), src_y);
+            const __m256 wy1 = _mm256_sub_ps(src_y, floor_y);
+
+            // x0 在 [0, cols)，x1 = x0 + 1 在 [0, cols) 即 x0 在 [-1, cols - 1)
+            const __m256i in_x0 = _mm256_and_si256(_mm256_cmpgt_epi32(x0, minus1), _mm256_cmpgt_epi32(cols, x0));
+            const __m256i in_x1 = _mm256_and_si256(_mm256_cmpgt_epi32(x0, minus2), _mm256_cmpgt_epi32(cols_m1, x0));
+            const __m256i in_y0 = _mm256_and_si256(_mm256_cmpgt_epi32(y0, minus1), _mm256_cmpgt_epi32(rows, y0));
+            const __m256i in_y1 = _mm256_and_si256(_mm256_cmpgt_epi32(y0, minus2), _mm256_cmpgt_epi32(rows_m1, y0));
+
+            __m256 v00[3], v01[3], v10[3], v11[3];
+            gatherPixels(source, x0, y0, _mm256_and_si256(in_x0, in_y0), border, v00);
+            gatherPixels(source, x1, y0, _mm256_and_si256(in_x1, in_y0), border, v01);
+            gatherPixels(source, x0, y1, _mm256_and_si256(in_x0, in_y1), border, v10);
+            gatherPixels(source, x1, y1, _mm256_and_si256(in_x1, in_y1), border, v11);
+
+            const __m256 w00 = _mm256_mul_ps(wx0, wy0);
+            const __m256 w01 = _mm256_mul_ps(wx1, wy0);
+            const __m256 w10 = _mm256_mul_ps(wx0, wy1);
+            const __m256 w11 = _mm256_mul_ps(wx1, wy1);
+
+            __m256 sum[3];
+            for (int c = 0; c < 3; ++c) {
+                const __m256 top    = _mm256_add_ps(_mm256_mul_ps(w00, v00[c]), _mm256_mul_ps(w01, v01[c]));
+                const __m256 bottom = _mm256_add_ps(_mm256_mul_ps(w10, v10[c]), _mm256_mul_ps(w11, v11[c]));
+                sum[c]              = _mm256_add_ps(top, bottom);
+            }
+            if (config.swap_rb) {
+                const __m256 temp = sum[0];
+                sum[0]            = sum[2];
+                sum[2]            = temp;
+            }
+
+            for (int c = 0; c < 3; ++c) {
+                const __m256 value  = _mm256_add_ps(_mm256_mul_ps(sum[c], alpha[c]), beta[c]);
+                const size_t offset = c * output.plane + row + x;
+                if (output.type == PlanarType::Float32) {
+                    _mm256_storeu_ps(static_cast<float*>(output.base) + offset, value);
+                } else {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(static_cast<uint16_t*>(output.base) + offset),
+                                     _mm256_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT));
+                }
+            }
+        }
+    }
+
+    // 每行剩余不足 8 个的像素
+    if (vec_cols < dst_cols) {
+        warpRowsScalar(source, output, dst_cols, m0, m1, config, row_begin, row_end, vec_cols);
+    }
+}
+
+#endif  // DEPLOY_CPU_X86
+
+#ifdef DEPLOY_CPU_NEON
+
+/**
+ * @brief NEON 实现，每次处理一行中连续的 4 个输出像素
+ *
+ * NEON 没有 gather，坐标、权重、插值和归一化用向量计算，邻域像素逐通道装入向量。
+ */
+template <typename Source>
+void warpRowsNeon(const Source& source, const PlanarOutput& output, const int dst_cols,
+                  const float3& m0, const float3& m1, const ProcessConfig& config,
+                  const int row_begin, const int row_end) {
+    const float32x4_t iota     = {0.0f, 1.0f, 2.0f, 3.0f};
+    const float32x4_t one      = vdupq_n_f32(1.0f);
+    const float32x4_t alpha[3] = {vdupq_n_f32(config.alpha.x), vdupq_n_f32(config.alpha.y), vdupq_n_f32(config.alpha.z)};
+    const float32x4_t beta[3]  = {vdupq_n_f32(config.beta.x), vdupq_n_f32(config.beta.y), vdupq_n_f32(config.beta.z)};
+
+    auto load = [&](const int32_t xs[4], const int32_t ys[4], float32x4_t value[3]) {
+        float lanes[3][4];
+        for (int i = 0; i < 4; ++i) {
+            if (xs[i] >= 0 && xs[i] < source.cols && ys[i] >= 0 && ys[i] < source.rows) {
+                float pixel[3];
+                source.fetch(xs[i], ys[i], pixel);
+                lanes[0][i] = pixel[0];
+                lanes[1][i] = pixel[1];
+                lanes[2][i] = pixel[2];
+            } else {
+                lanes[0][i] = lanes[1][i] = lanes[2][i] = config.border_value;
+            }
+        }
+        value[0] = vld1q_f32(lanes[0]);
+        value[1] = vld1q_f32(lanes[1]);
+        value[2] = vld1q_f32(lanes[2]);
+    };
+
+    const int vec_cols = dst_cols & ~3;
+    for (int y = row_begin; y < row_end; ++y) {
+        const float32x4_t row_x = vdupq_n_f32(m0.y * y + m0.z);
+        const float32x4_t row_y = vdupq_n_f32(m1.y * y + m1.z);
+        const size_t      row   = static_cast<size_t>(y) * dst_cols;
+
+        for (int x = 0; x < vec_cols; x += 4) {
+            const float32x4_t element_x = vaddq_f32(vdupq_n_f32(static_cast<float>(x)), iota);
+            const float32x4_t src_x     = vaddq_f32(vmulq_f32(vdupq_n_f32(m0.x), element_x), row_x);
+            const float32x4_t src_y     = vaddq_f32(vmulq_f32(vdupq_n_f32(m1.x), element_x), row_y);
+            const float32x4_t floor_x   = vrndmq_f32(src_x);
+            const float32x4_t floor_y   = vrndmq_f32(src_y);
+
+            int32_t x0[4], y0[4], x1[4], y1[4];
+            vst1q_s32(x0, vcvtq_s32_f32(floor_x));
+            vst1q_s32(y0, vcvtq_s32_f32(floor_y));
+            vst1q_s32(x1, vaddq_s32(vld1q_s32(x0), vdupq_n_s32(1)));
+            vst1q_s32(y1, vaddq_s32(vld1q_s32(y0), vdupq_n_s32(1)));
+
+            const float32x4_t wx0 = vsubq_f32(vaddq_f32(floor_x, one), src_x);
+            const float32x4_t wx1 = vsubq_f32(src_x, floor_x);
+            const float32x4_t wy0 = vsubq_f32(vaddq_f32(floor_y, one), src_y);
+            const float32x4_t wy1 = vsubq_f32(src_y, floor_y);
+
+            float32x4_t v00[3], v01[3], v10[3], v11[3];
+            load(x0, y0, v00);
+            load(x1, y0, v01);
+            load(x0, y1, v10);
+            load(x1, y1, v11);
+
+            const float32x4_t w00 = vmulq_f32(wx0, wy0);
+            const float32x4_t w01 = vmulq_f32(wx1, wy0);
+            const float32x4_t w10 = vmulq_f32(wx0, wy1);
+            const float32x4_t w11 = vmulq_f32(wx1, wy1);
+
+            float32x4_t sum[3];
+            for (int c = 0; c < 3; ++c) {
+                const float32x4_t top    = vaddq_f32(vmulq_f32(w00, v00[c]), vmulq_f32(w01, v01[c]));
+                const float32x4_t bottom = vaddq_f32(vmulq_f32(w10, v10[c]), vmulq_f32(w11, v11[c]));
+                sum[c]                   = vaddq_f32(top, bottom);
+            }
+            if (config.swap_rb) {
+                const float32x4_t temp = sum[0];
+                sum[0]                 = sum[2];
+                sum[2]                 = temp;
+            }
+
+            for (int c = 0; c < 3; ++c) {
+                const float32x4_t value  = vaddq_f32(vmulq_f32(sum[c], alpha[c]), beta[c]);
+                const size_t      offset = c * output.plane + row + x;
+                if (output.type == PlanarType::Float32) {
+                    vst1q_f32(static_cast<float*>(output.base) + offset, value);
+                } else {
+                    vst1_u16(static_cast<uint16_t*>(output.base) + offset, vreinterpret_u16_f16(vcvt_f16_f32(value)));
+                }
+            }
+        }
+    }
+
+    if (vec_cols < dst_cols) {
+        warpRowsScalar(source, output, dst_cols, m0, m1, config, row_begin, row_end, vec_cols);
+    }
+}
+
+#endif  // DEPLOY_CPU_NEON
+
+std::atomic<bool> simd_enabled{true};
+
+/**
+ * @brief 按平台选择实现
+ */
+template <typename Source>
+void warpRows(const Source& source, const PlanarOutput& output, const int dst_cols,
+              const float3 matrix[2], const ProcessConfig& config, const int row_begin, const int row_end) {
+    if (!simd_enabled.load(std::memory_order_relaxed)) {
+        warpRowsScalar(source, output, dst_cols, matrix[0], matrix[1], config, row_begin, row_end, 0);
+        return;
+    }
+#if defined(DEPLOY_CPU_X86)
+    if (supportsAvx2()) {
+        warpRowsAvx2(source, output, dst_cols, matrix[0], matrix[1], config, row_begin, row_end);
+        return;
+    }
+#elif defined(DEPLOY_CPU_NEON)
+    warpRowsNeon(source, output, dst_cols, matrix[0], matrix[1], config, row_begin, row_end);
+    return;
+#endif
+    warpRowsScalar(source, output, dst_cols, matrix[0], matrix[1], config, row_begin, row_end, 0);
+}
+
+#ifdef DEPLOY_CPU_X86
+
+/**
+ * @brief 一行整理成 BGR，每次用 pshufb 处理 4 个四通道像素或 5 个三通道像素
+ *
+ * 每次读写 16 字节，多写的字节由下一次覆盖；读写会越过行尾的部分留给标量处理。
+ *
+ * @return 已处理的像素数
+ */
+__attribute__((target("avx2"))) int packRowAvx2(const PackedSource& source, const uint8_t* row, uint8_t* out) {
+    const int pixels = source.channels == 4 ? 4 : 5;
+    alignas(16) int8_t order[16];
+    for (int j = 0; j < 16; ++j) {
+        const int c = j % 3;
+        const int from = source.swap_rb ? 2 - c : c;
+        order[j] = j < pixels * 3 ? static_cast<int8_t>(j / 3 * source.channels + from) : static_cast<int8_t>(0x80);
+    }
+    const __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i*>(order));
+    int x = 0;
+    // 写 16 字节要求 x * 3 + 16 不超过行尾，读 16 字节的要求更宽松
+    for (; x + 6 <= source.cols; x += pixels) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x * source.channels));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 3), _mm_shuffle_epi8(in, shuffle));
+    }
+    return x;
+}
+
+#endif  // DEPLOY_CPU_X86
+
+#ifdef DEPLOY_CPU_NEON
+
+/**
+ * @brief 一行整理成 BGR，每次按通道解交织读 16 个像素
+ *
+ * @return 已处理的像素数
+ */
+int packRowNeon(const PackedSource& source, const uint8_t* row, uint8_t* out) {
+    int x = 0;
+    for (; x + 16 <= source.cols; x += 16) {
+        uint8x16x3_t bgr;
+        if (source.channels == 4) {
+            const uint8x16x4_t in = vld4q_u8(row + x * 4);
+            bgr.val[0]            = in.val[source.swap_rb ? 2 : 0];
+            bgr.val[1]            = in.val[1];
+            bgr.val[2]            = in.val[source.swap_rb ? 0 : 2];
+        } else {
+            const uint8x16x3_t in = vld3q_u8(row + x * 3);
+            bgr.val[0]            = in.val[source.swap_rb ? 2 : 0];
+            bgr.val[1]            = in.val[1];
+            bgr.val[2]            = in.val[source.swap_rb ? 0 : 2];
+        }
+        vst3q_u8(out + x * 3, bgr);
+    }
+    return x;
+}
+
+#endif  // DEPLOY_CPU_NEON
+
+/**
+ * @brief 第 y 行整理成行间无填充的 BGR
+ */
+void packRow(const PackedSource& source, const int y, uint8_t* out) {
+    const uint8_t* row = source.data + y * source.step;
+    int            x   = 0;
+    if (simd_enabled.load(std::memory_order_relaxed)) {
+#if defined(DEPLOY_CPU_X86)
+        if (supportsAvx2()) {
+            x = packRowAvx2(source, row, out);
+        }
+#elif defined(DEPLOY_CPU_NEON)
+        x = packRowNeon(source, row, out);
+#endif
+    }
+    for (; x < source.cols; ++x) {
+        const uint8_t* pixel = row + x * source.channels;
+        out[3 * x]           = pixel[source.swap_rb ? 2 : 0];
+        out[3 * x + 1]       = pixel[1];
+        out[3 * x + 2]       = pixel[source.swap_rb ? 0 : 2];
+    }
+}
+
+}  // namespace
+
+void cpuWarpAffineRows(const Image& image, void* dst, const int dst_cols, const int dst_rows,
+                       const float3 matrix[2], const ProcessConfig& config, PlanarType type,
+                       const int row_begin, const int row_end) {
+    const PlanarOutput output{dst, static_cast<size_t>(dst_cols) * dst_rows, type};
+    if (image.format == PixelFormat::BayerBG) {
+        float3 binned[2];
+        binnedMatrix(matrix, binned);
+        warpRows(bayerSource(image), output, dst_cols, binned, config, row_begin, row_end);
+        return;
+    }
+    // 输入的通道顺序和 swap_rb 合并成读取时的一次选择，插值后不再交换
+    ProcessConfig folded = config;
+    folded.swap_rb       = false;
+    warpRows(packedSource(image, isRgbOrder(image.format) != config.swap_rb), output, dst_cols, matrix, folded,
+             row_begin, row_end);
+}
+
+void cpuWarpAffine(const Image& image, void* dst, const int dst_cols, const int dst_rows,
+                   const float3 matrix[2], const ProcessConfig& config, PlanarType type) {
+    cpuWarpAffineRows(image, dst, dst_cols, dst_rows, matrix, config, type, 0, dst_rows);
+}
+
+void cpuWarpAffineReference(const Image& image, void* dst, const int dst_cols, const int dst_rows,
+                            const float3 matrix[2], const ProcessConfig& config, PlanarType type) {
+    const PlanarOutput output{dst, static_cast<size_t>(dst_cols) * dst_rows, type};
+    if (image.format == PixelFormat::BayerBG) {
+        float3 binned[2];
+        binnedMatrix(matrix, binned);
+        warpRowsScalar(bayerSource(image), output, dst_cols, binned[0], binned[1], config, 0, dst_rows, 0);
+        return;
+    }
+    warpRowsScalar(packedSource(image, isRgbOrder(image.format)), output, dst_cols, matrix[0], matrix[1], config,
+                   0, dst_rows, 0);
+}
+
+void cpuWarpAffineRows(const void* src, const int src_cols, const int src_rows,
+                       void* dst, const int dst_cols, const int dst_rows,
+                       const float3 matrix[2], const ProcessConfig& config, PlanarType type,
+                       const int row_begin, const int row_end) {
+    const Image image(const_cast<void*>(src), src_cols, src_rows);
+    cpuWarpAffineRows(image, dst, dst_cols, dst_rows, matrix, config, type, row_begin, row_end);
+}
+
+void cpuWarpAffine(const void* src, const int src_cols, const int src_rows,
+                   void* dst, const int dst_cols, const int dst_rows,
+                   const float3 matrix[2], const ProcessConfig& config, PlanarType type) {
+    cpuWarpAffineRows(src, src_cols, src_rows, dst, dst_cols, dst_rows, matrix, config, type, 0, dst_rows);
+}
+
+void cpuWarpAffineReference(const void* src, const int src_cols, const int src_rows,
+                            void* dst, const int dst_cols, const int dst_rows,
+                            const float3 matrix[2], const ProcessConfig& config, PlanarType type) {
+    const Image image(const_cast<void*>(src), src_cols, src_rows);
+    cpuWarpAffineReference(image, dst, dst_cols, dst_rows, matrix, config, type);
+}
+
+void cpuBayerWarpAffineRows(const void* src, const int src_cols, const int src_rows,
+                            void* dst, const int dst_cols, const int dst_rows,
+                            const float3 matrix[2], const ProcessConfig& config, PlanarType type,
+                            const int row_begin, const int row_end) {
+    const Image image(const_cast<void*>(src), src_cols, src_rows, PixelFormat::BayerBG);
+    cpuWarpAffineRows(image, dst, dst_cols, dst_rows, matrix, config, type, row_begin, row_end);
+}
+
+void cpuBayerWarpAffine(const void* src, const int src_cols, const int src_rows,
+                        void* dst, const int dst_cols, const int dst_rows,
+                        const float3 matrix[2], const ProcessConfig& config, PlanarType type) {
+    cpuBayerWarpAffineRows(src, src_cols, src_rows, dst, dst_cols, dst_rows, matrix, config, type, 0, dst_rows);
+}
+
+void cpuBayerWarpAffineReference(const void* src, const int src_cols, const int src_rows,
+                                 void* dst, const int dst_cols, const int dst_rows,
+                                 const float3 matrix[2], const ProcessConfig& config, PlanarType type) {
+    const Image image(const_cast<void*>(src), src_cols, src_rows, PixelFormat::BayerBG);
+    cpuWarpAffineReference(image, dst, dst_cols, dst_rows, matrix, config, type);
+}
+
+void setCpuSimdEnabled(bool enabled) {
+    simd_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+const char* cpuSimdPath() {
+    if (!simd_enabled.load(std::memory_order_relaxed)) {
+        return "scalar";
+    }
+#if defined(DEPLOY_CPU_X86)
+    return supportsAvx2() ? "avx2" : "scalar";
+#elif defined(DEPLOY_CPU_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+void cpuPackBgr(const Image& image, void* dst) {
+    if (image.format == PixelFormat::BayerBG) {
+        throw std::invalid_argument(MAKE_ERROR_MESSAGE("cpuPackBgr: Bayer input is not supported"));
+    }
+    uint8_t*  out       = static_cast<uint8_t*>(dst);
+    const int row_bytes = image.width * 3;
+    if (image.packedBgr()) {
+        std::memcpy(out, image.ptr, static_cast<size_t>(row_bytes) * image.height);
+        return;
+    }
+    const PackedSource source = packedSource(image, isRgbOrder(image.format));
+    for (int y = 0; y < image.height; ++y) {
+        packRow(source, y, out + static_cast<size_t>(y) * row_bytes);
+    }
+}
+
+}  // namespace deploy
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../option.hpp"
+#include "../result.hpp"
+
+namespace deploy {
+
+/**
+ * @brief CPU 预处理输出的数据类型
+ */
+enum class PlanarType {
+    Float32,  // < 32 位浮点
+    Float16   // < 16 位浮点（IEEE 754 half），按 uint16_t 存储
+};
+
+/**
+ * @brief 使用 CPU 应用仿射变换，cudaWarpAffine 的 CPU 版本。
+ *
+ * 一次遍历完成双线性插值、BGR->RGB 交换、归一化和 HWC->CHW 平面化，计算方式与 CUDA 核函数一致：
+ * 越界的邻域像素取 border_value，输出为 sum * alpha + beta。
+ * 支持 AVX2 的 x86 机器运行时自动使用 AVX2 + FMA + F16C 实现，ARM 上使用 NEON 实现，否则退回标量实现。
+ *
+ * @param src 输入图像数据的指针，BGR 8 位三通道，行间无填充
+ * @param src_cols 输入图像的宽度
+ * @param src_rows 输入图像的高度
+ * @param dst 输出数据的指针，3 个连续的 dst_rows * dst_cols 平面
+ * @param dst_cols 输出图像的宽度
+ * @param dst_rows 输出图像的高度
+ * @param matrix 仿射变换矩阵，目标坐标到源坐标的映射
+ * @param config 处理配置参数
+ * @param type 输出数据类型
+ */
+void cpuWarpAffine(const void* src, const int src_cols, const int src_rows,
+                   void* dst, const int dst_cols, const int dst_rows,
+                   const float3 matrix[2], const ProcessConfig& config, PlanarType type = PlanarType::Float32);
+
+/**
+ * @brief 只处理输出的 [row_begin, row_end) 行，供调用方按行分块多线程执行。
+ *
+ * 参数同 cpuWarpAffine，dst 仍指向完整输出的起始地址。
+ */
+void cpuWarpAffineRows(const void* src, const int src_cols, const int src_rows,
+                       void* dst, const int dst_cols, const int dst_rows,
+                       const float3 matrix[2], const ProcessConfig& config, PlanarType type,
+                       const int row_begin, const int row_end);
+
+/**
+ * @brief 逐像素的标量实现，逐条对应 CUDA 核函数，用作正确性检查的参考
+ *
+ * 参数同 cpuWarpAffine。
+ */
+void cpuWarpAffineReference(const void* src, const int src_cols, const int src_rows,
+                            void* dst, const int dst_cols, const int dst_rows,
+                            const float3 matrix[2], const ProcessConfig& config, PlanarType type = PlanarType::Float32);
+
+/**
+ * @brief BayerBG8 原图直接 2x2 合并去马赛克并仿射变换，一次遍历写入网络输入，不生成全分辨率的 BGR 图像。
+ *
+ * 排列与 cv::COLOR_BayerBG2BGR 一致（每个 2x2 单元为 R G / G B），合并后的像素 B、R 取单元内对应像素，
+ * G 取两个 G 的平均，之后的插值、通道交换、归一化与 cpuWarpAffine 相同。
+ * matrix 仍是网络输入到原图（全分辨率）坐标的映射，检测结果经 AffineTransform 映射回原图坐标，与 BGR 输入一致。
+ * 合并后的分辨率为原图的一半，letterbox 缩放比例不超过 0.5 时不损失信息。
+ *
+ * @param src BayerBG8 原图数据的指针，单通道，行间无填充
+ * @param src_cols 原图宽度，需为偶数
+ * @param src_rows 原图高度，需为偶数
+ * 其余参数同 cpuWarpAffine
+ */
+void cpuBayerWarpAffine(const void* src, const int src_cols, const int src_rows,
+                        void* dst, const int dst_cols, const int dst_rows,
+                        const float3 matrix[2], const ProcessConfig& config, PlanarType type = PlanarType::Float32);
+
+/**
+ * @brief 只处理输出的 [row_begin, row_end) 行，参数同 cpuBayerWarpAffine 和 cpuWarpAffineRows。
+ */
+void cpuBayerWarpAffineRows(const void* src, const int src_cols, const int src_rows,
+                            void* dst, const int dst_cols, const int dst_rows,
+                            const float3 matrix[2], const ProcessConfig& config, PlanarType type,
+                            const int row_begin, const int row_end);
+
+/**
+ * @brief cpuBayerWarpAffine 的逐像素标量实现，用作正确性检查的参考
+ */
+void cpuBayerWarpAffineReference(const void* src, const int src_cols, const int src_rows,
+                                 void* dst, const int dst_cols, const int dst_rows,
+                                 const float3 matrix[2], const ProcessConfig& config, PlanarType type = PlanarType::Float32);
+
+/**
+ * @brief 按 Image 描述的像素格式和内存布局读原缓冲区，一次遍历完成 letterbox、通道顺序、归一化和平面化。
+ *
+ * BGR / RGB / BGRA / RGBA 直接按通道偏移读取，输入的通道顺序和 config.swap_rb 合并成读取时的一次选择，
+ * 插值后不再交换；stride 跳过行间填充；flip 时从缓冲区最后一行开始按负步长读取，不先翻转图像。
+ * BayerBG 同 cpuBayerWarpAffine，flip 时按 2x2 单元倒序，单元内的排列仍按缓冲区中的 R G / G B。
+ *
+ * @param image 输入图像及其布局描述
+ * 其余参数同 cpuWarpAffine
+ */
+void cpuWarpAffine(const Image& image, void* dst, const int dst_cols, const int dst_rows,
+                   const float3 matrix[2], const ProcessConfig& config, PlanarType type = PlanarType::Float32);
+
+/**
+ * @brief 只处理输出的 [row_begin, row_end) 行，参数同 cpuWarpAffine(const Image&, ...) 和 cpuWarpAffineRows。
+ */
+void cpuWarpAffineRows(const Image& image, void* dst, const int dst_cols, const int dst_rows,
+                       const float3 matrix[2], const ProcessConfig& config, PlanarType type,
+                       const int row_begin, const int row_end);
+
+/**
+ * @brief cpuWarpAffine(const Image&, ...) 的逐像素标量实现，先按格式读成 BGR 再按 config.swap_rb 交换，用作参考
+ */
+void cpuWarpAffineReference(const Image& image, void* dst, const int dst_cols, const int dst_rows,
+                            const float3 matrix[2], const ProcessConfig& config, PlanarType type = PlanarType::Float32);
+
+/**
+ * @brief 把 BGR / RGB / BGRA / RGBA 输入按布局一次遍历整理成行间无填充、自上而下的 BGR，供 GPU 后端拷贝到显存
+ *
+ * 输入已经是整块 BGR 时只做 memcpy。BayerBG 不支持。
+ *
+ * @param image 输入图像及其布局描述
+ * @param dst 输出，image.width * image.height * 3 字节
+ */
+void cpuPackBgr(const Image& image, void* dst);
+
+/**
+ * @brief 开关 SIMD 实现，关闭后各 CPU 预处理函数固定走标量实现，可在任意线程调用；默认开启
+ *
+ * 用于在支持 SIMD 的机器上也能检查和对比标量实现。
+ */
+void setCpuSimdEnabled(bool enabled);
+
+/**
+ * @brief 当前 CPU 预处理实际使用的实现："avx2"、"neon" 或 "scalar"
+ */
+const char* cpuSimdPath();
+
+/**
+ * @brief float 转 IEEE 754 half，就近舍入到偶数，与 F16C / NEON 的转换结果一致
+ *
+ * @param value 输入值
+ * @return half 的位表示
+ */
+uint16_t floatToHalf(float value);
+
+/**
+ * @brief IEEE 754 half 转 float
+ *
+ * @param value half 的位表示
+ * @return 转换后的值
+ */
+float halfToFloat(uint16_t value);
+
+}  // namespace deploy
@@ -0,0 +1,232 @@
+#include <algorithm>
+#include <opencv2/imgproc.hpp>
+#include <stdexcept>
+
+#include "deploy/infer/cpu_warpaffine.hpp"
+#include "deploy/infer/ocv_backend.hpp"
+#include "deploy/utils/utils.hpp"
+
+namespace deploy {
+
+// 类别内 NMS 时按类别平移候选框的距离，与 TensorRT EfficientNMS 插件的做法一致
+static constexpr double CLASS_OFFSET = 7680.0;
+
+OcvBackend::OcvBackend(const std::string& onnx_file, const InferOption& infer_option)
+    : BaseBackend(infer_option), onnx_file_(onnx_file) {
+    net_ = cv::dnn::readNetFromONNX(onnx_file_);
+    if (net_.empty()) {
+        throw std::runtime_error(MAKE_ERROR_MESSAGE("Failed to load ONNX model: " + onnx_file_));
+    }
+    net_.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+    net_.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+    output_names_ = net_.getUnconnectedOutLayersNames();
+
+    initialize();
+}
+
+std::unique_ptr<BaseBackend> OcvBackend::clone() {
+    return std::make_unique<OcvBackend>(onnx_file_, option);
+}
+
+void OcvBackend::initialize() {
+    const auto& cpu = option.cpu;
+    if (cpu.max_batch < 1 || cpu.input_width <= 0 || cpu.input_height <= 0 || cpu.max_detections < 1) {
+        throw std::invalid_argument(MAKE_ERROR_MESSAGE("OcvBackend: invalid CpuConfig"));
+    }
+
+    // 批量可变，按 TensorRT 动态形状的约定记录范围
+    dynamic   = true;
+    min_shape = make_int4(1, 3, cpu.input_height, cpu.input_width);
+    max_shape = make_int4(cpu.max_batch, 3, cpu.input_height, cpu.input_width);
+
+    if (option.input_shape.has_value()) {
+        affine_transforms.emplace_back(AffineTransform());
+        affine_transforms.front().updateMatrix(option.input_shape->y, option.input_shape->x, max_shape.w, max_shape.z);
+    } else {
+        affine_transforms.resize(max_shape.x, AffineTransform());
+    }
+
+    if (cpu.preprocess == CpuPreprocess::OpenCV) {
+        letterbox_.create(max_shape.z, max_shape.w, CV_8UC3);
+        channels_.resize(3);
+    }
+    const int blob_shape[] = {max_shape.x, max_shape.y, max_shape.z, max_shape.w};
+    blob_.create(4, blob_shape, CV_32F);
+    blob_.setTo(cv::Scalar::all(0));
+
+    // 先推理一次全零输入：检查输出布局、推算类别数，同时完成各层的内存分配
+    const int single_shape[] = {1, max_shape.y, max_shape.z, max_shape.w};
+    net_.setInput(cv::Mat(4, single_shape, CV_32F, blob_.data));
+    net_.forward(outputs_, output_names_);
+    if (outputs_.empty() || outputs_.front().dims != 3) {
+        throw std::runtime_error(MAKE_ERROR_MESSAGE("OcvBackend: expected a raw output of [batch, channels, anchors], export the ONNX model without the NMS plugin"));
+    }
+    const int channels = outputs_.front().size[1];
+    const int anchors  = outputs_.front().size[2];
+    num_classes_       = cpu.num_classes > 0 ? cpu.num_classes : channels - 4 - cpu.num_keypoints * cpu.keypoint_dim;
+    if (num_classes_ < 1 || 4 + num_classes_ + cpu.num_keypoints * cpu.keypoint_dim != channels) {
+        throw std::runtime_error(MAKE_ERROR_MESSAGE("OcvBackend: output channels " + std::to_string(channels) + " do not match num_classes/num_keypoints/keypoint_dim"));
+    }
+
+    anchor_scores_.resize(anchors);
+    anchor_classes_.resize(anchors);
+    candidates_.reserve(anchors);
+    nms_boxes_.reserve(anchors);
+    nms_scores_.reserve(anchors);
+    keep_.reserve(cpu.max_detections);
+
+    const int batch = max_shape.x, max_det = cpu.max_detections;
+    num_.assign(batch, 0);
+    boxes_.assign(batch * max_det * 4, 0.0f);
+    scores_.assign(batch * max_det, 0.0f);
+    classes_.assign(batch * max_det, 0);
+    kpts_.assign(batch * max_det * cpu.num_keypoints * cpu.keypoint_dim, 0.0f);
+
+    auto make_tensor = [](void* host, std::initializer_list<int64_t> dims) {
+        HostTensor view;
+        view.host         = host;
+        view.shape.nbDims = static_cast<int>(dims.size());
+        std::copy(dims.begin(), dims.end(), view.shape.d);
+        return view;
+    };
+    tensors_ = {
+        make_tensor(blob_.data, {batch, max_shape.y, max_shape.z, max_shape.w}),
+        make_tensor(num_.data(), {batch, 1}),
+        make_tensor(boxes_.data(), {batch, max_det, 4}),
+        make_tensor(scores_.data(), {batch, max_det}),
+        make_tensor(classes_.data(), {batch, max_det}),
+        make_tensor(kpts_.data(), {batch, max_det, cpu.num_keypoints, cpu.keypoint_dim})};
+}
+
+void OcvBackend::preprocess(const Image& image, int idx) {
+    StageTimer timer("preprocess");
+    auto& affine_transform = option.input_shape.has_value() ? affine_transforms.front() : affine_transforms[idx];
+    affine_transform.updateMatrix(image.width, image.height, max_shape.w, max_shape.z);
+
+    const auto&  config = option.config;
+    const size_t plane  = static_cast<size_t>(max_shape.z) * max_shape.w;
+    float*       dst    = blob_.ptr<float>() + static_cast<size_t>(idx) * max_shape.y * plane;
+
+    if (option.cpu.preprocess == CpuPreprocess::Fused) {
+        // 按行分块在 OpenCV 线程池中并行，每块一次遍历直接写入 blob 对应的平面
+        // 按 image 描述的格式和布局读原缓冲区：Bayer 原图 2x2 合并去马赛克，RGBA、行间填充、倒序行都不先转换
+        const float3 matrix[2] = {affine_transform.matrix[0], affine_transform.matrix[1]};
+        cv::parallel_for_(cv::Range(0, max_shape.z), [&](const cv::Range& rows) {
+            cpuWarpAffineRows(image, dst, max_shape.w, max_shape.z, matrix, config, PlanarType::Float32,
+                              rows.start, rows.end);
+        });
+        return;
+    }
+
+    // matrix 是目标到源的映射，与 CUDA 核函数一致，因此使用 WARP_INVERSE_MAP
+    cv::Mat src(image.height, image.width, CV_8UC3, image.ptr);
+    if (image.format == PixelFormat::BayerBG) {
+        // 按缓冲区顺序去马赛克后再翻转，不改变 Bayer 排列
+        cv::cvtColor(cv::Mat(image.height, image.width, CV_8UC1, image.ptr, image.stride), demosaic_,
+                     cv::COLOR_BayerBG2BGR);
+        if (image.flip) {
+            cv::flip(demosaic_, demosaic_, 0);
+        }
+        src = demosaic_;
+    } else if (!image.packedBgr()) {
+        demosaic_.create(image.height, image.width, CV_8UC3);
+        cpuPackBgr(image, demosaic_.data);
+        src = demosaic_;
+    }
+    const cv::Matx23f matrix(affine_transform.matrix[0].x, affine_transform.matrix[0].y, affine_transform.matrix[0].z,
+                             affine_transform.matrix[1].x, affine_transform.matrix[1].y, affine_transform.matrix[1].z);
+    cv::warpAffine(src, letterbox_, matrix, letterbox_.size(), cv::INTER_LINEAR | cv::WARP_INVERSE_MAP,
+                   cv::BORDER_CONSTANT, cv::Scalar::all(config.border_value));
+
+    // HWC -> CHW，同时完成通道交换和归一化，直接写入 blob 对应的平面
+    cv::split(letterbox_, channels_);
+    const float alpha[] = {config.alpha.x, config.alpha.y, config.alpha.z};
+    const float beta[]  = {config.beta.x, config.beta.y, config.beta.z};
+    for (int c = 0; c < 3; ++c) {
+        const int src_c = config.swap_rb ? 2 - c : c;
+        cv::Mat   out(max_shape.z, max_shape.w, CV_32F, dst + c * plane);
+        channels_[src_c].convertTo(out, CV_32F, alpha[c], beta[c]);
+    }
+}
+
+void OcvBackend::decode(const cv::Mat& output, int idx) {
+    const auto&  cpu     = option.cpu;
+    const int    anchors = output.size[2];
+    const int    kpt_len = cpu.num_keypoints * cpu.keypoint_dim;
+    const float* base    = output.ptr<float>(idx);
+
+    // 类别在外层循环，按行连续读取输出
+    std::fill(anchor_scores_.begin(), anchor_scores_.end(), 0.0f);
+    for (int c = 0; c < num_classes_; ++c) {
+        const float* row = base + static_cast<size_t>(4 + c) * anchors;
+        for (int a = 0; a < anchors; ++a) {
+            if (row[a] > anchor_scores_[a]) {
+                anchor_scores_[a]  = row[a];
+                anchor_classes_[a] = c;
+            }
+        }
+    }
+
+    candidates_.clear();
+    nms_boxes_.clear();
+    nms_scores_.clear();
+    for (int a = 0; a < anchors; ++a) {
+        if (anchor_scores_[a] <= cpu.conf_thres) continue;
+        const float cx = base[a], cy = base[anchors + a];
+        const float w = base[2 * anchors + a], h = base[3 * anchors + a];
+        const double offset = anchor_classes_[a] * CLASS_OFFSET;
+        candidates_.push_back({a, anchor_classes_[a], anchor_scores_[a]});
+        nms_boxes_.emplace_back(cx - 0.5 * w + offset, cy - 0.5 * h + offset, w, h);
+        nms_scores_.push_back(anchor_scores_[a]);
+    }
+
+    // 保留结果按置信度降序排列
+    keep_.clear();
+    cv::dnn::NMSBoxes(nms_boxes_, nms_scores_, cpu.conf_thres, cpu.iou_thres, keep_, 1.0f, cpu.max_detections);
+
+    const int max_det = cpu.max_detections;
+    const int num     = std::min(static_cast<int>(keep_.size()), max_det);
+    num_[idx]         = num;
+    float* boxes      = boxes_.data() + static_cast<size_t>(idx) * max_det * 4;
+    float* scores     = scores_.data() + static_cast<size_t>(idx) * max_det;
+    int*   classes    = classes_.data() + static_cast<size_t>(idx) * max_det;
+    float* kpts       = kpts_.data() + static_cast<size_t>(idx) * max_det * kpt_len;
+    for (int i = 0; i < num; ++i) {
+        const Candidate& cand = candidates_[keep_[i]];
+        const int        a    = cand.anchor;
+        const float cx = base[a], cy = base[anchors + a];
+        const float w = base[2 * anchors + a], h = base[3 * anchors + a];
+        boxes[i * 4]     = cx - 0.5f * w;
+        boxes[i * 4 + 1] = cy - 0.5f * h;
+        boxes[i * 4 + 2] = cx + 0.5f * w;
+        boxes[i * 4 + 3] = cy + 0.5f * h;
+        scores[i]        = cand.score;
+        classes[i]       = cand.cls;
+        const float* kpt_row = base + static_cast<size_t>(4 + num_classes_) * anchors + a;
+        for (int k = 0; k < kpt_len; ++k) {
+            kpts[i * kpt_len + k] = kpt_row[static_cast<size_t>(k) * anchors];
+        }
+    }
+}
+
+void OcvBackend::infer(const std::vector<Image>& inputs) {
+    const int num = static_cast<int>(inputs.size());
+    if (num < min_shape.x || num > max_shape.x) {
+        throw std::invalid_argument("Number of inputs out of range");
+    }
+
+    for (int idx = 0; idx < num; ++idx) {
+        preprocess(inputs[idx], idx);
+    }
+
+    // 只把前 num 张图送入网络，blob 内存不重新分配
+    const int shape[] = {num, max_shape.y, max_shape.z, max_shape.w};
+    net_.setInput(cv::Mat(4, shape, CV_32F, blob_.data));
+    net_.forward(outputs_, output_names_);
+
+    for (int idx = 0; idx < num; ++idx) {
+        decode(outputs_.front(), idx);
+    }
+}
+
+}  // namespace deploy
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <memory>
+#include <opencv2/core.hpp>
+#include <opencv2/dnn.hpp>
+#include <string>
+#include <vector>
+
+#include "../infer/base_backend.hpp"
+#include "../option.hpp"
+#include "../result.hpp"
+
+namespace deploy {
+
+/**
+ * @brief OpenCV DNN 后端类，在无 GPU 的机器上用 CPU 执行推理
+ *
+ * 加载与 TensorRT 引擎同源的原始 ONNX 导出（不含 NMS 插件）。预处理（letterbox + 归一化，
+ * 默认使用与 cudaWarpAffine 对应的 cpuWarpAffine）、解码和 NMS 都在 CPU 上完成，结果按 TensorRT 引擎的输出布局（num、boxes、scores、classes、kpts）
+ * 写入预分配的主机缓冲区，因此 BaseModel 的后处理无需区分后端。
+ * 所有中间缓冲区在构造时按最大批量分配，推理过程中复用。
+ * 卷积、warpAffine 和类型转换在 OpenCV 的进程级线程池中并行，后端（包括 clone()）不修改线程数，
+ * 由应用设置一次（cv::setNumThreads），多个副本同时推理时按副本数分配核心。
+ */
+class DEPLOYAPI OcvBackend : public BaseBackend {
+public:
+    /**
+     * @brief 构造函数，用于初始化 OcvBackend 对象。
+     *
+     * @param onnx_file ONNX 模型文件路径。
+     * @param infer_option 推理选项。
+     */
+    OcvBackend(const std::string& onnx_file, const InferOption& infer_option);
+
+    /**
+     * @brief 析构函数。
+     */
+    ~OcvBackend() override = default;
+
+    /**
+     * @brief 克隆 OcvBackend 对象，重新加载模型，缓冲区独立。
+     *
+     * @return 克隆后的 OcvBackend 对象的智能指针。
+     */
+    std::unique_ptr<BaseBackend> clone() override;
+
+    /**
+     * @brief 执行推理操作。
+     *
+     * @param inputs 输入图像向量，BGR 格式的 8 位三通道图像。
+     */
+    void infer(const std::vector<Image>& inputs) override;
+
+    int numTensors() const override {
+        return static_cast<int>(tensors_.size());
+    }
+
+    HostTensor tensor(int index) const override {
+        return tensors_[index];
+    }
+
+    BackendType type() const override {
+        return BackendType::OpenCV;
+    }
+
+private:
+    /**
+     * @brief 候选目标，指向输出张量中的一个锚点
+     */
+    struct Candidate {
+        int   anchor;  // < 锚点索引
+        int   cls;     // < 类别
+        float score;   // < 置信度
+    };
+
+    void initialize();
+    void preprocess(const Image& image, int idx);
+    void decode(const cv::Mat& output, int idx);
+
+    std::string              onnx_file_;     // < ONNX 模型文件路径
+    cv::dnn::Net             net_;           // < OpenCV DNN 网络
+    std::vector<std::string> output_names_;  // < 输出层名称
+
+    cv::Mat              letterbox_;  // < letterbox 后的 8 位图像，仅 CpuPreprocess::OpenCV 使用
+    std::vector<cv::Mat> channels_;   // < letterbox 拆分出的单通道图像，仅 CpuPreprocess::OpenCV 使用
+    cv::Mat              demosaic_;   // < 非整块 BGR 输入转换后的 BGR 图像，仅 CpuPreprocess::OpenCV 使用
+    cv::Mat              blob_;       // < 网络输入，NCHW 浮点，按最大批量分配
+    std::vector<cv::Mat> outputs_;    // < 网络原始输出
+
+    std::vector<float> anchor_scores_;   // < 每个锚点的最高类别得分
+    std::vector<int>   anchor_classes_;  // < 每个锚点得分最高的类别
+
+    std::vector<Candidate>  candidates_;  // < 超过阈值的候选目标
+    std::vector<cv::Rect2d> nms_boxes_;   // < 按类别偏移后的候选框，用于类别内 NMS
+    std::vector<float>      nms_scores_;  // < 候选框置信度
+    std::vector<int>        keep_;        // < NMS 保留的候选索引
+
+    std::vector<int>   num_;      // < [batch, 1] 每张图的目标数
+    std::vector<float> boxes_;    // < [batch, max_det, 4] 网络输入坐标系下的 ltrb
+    std::vector<float> scores_;   // < [batch, max_det]
+    std::vector<int>   classes_;  // < [batch, max_det]
+    std::vector<float> kpts_;     // < [batch, max_det, nkpt, ndim]
+
+    std::vector<HostTensor> tensors_;  // < 与 TensorRT 引擎顺序一致的张量视图
+
+    int num_classes_ = 0;  // < 类别数
+};
+
+}  // namespace deploy
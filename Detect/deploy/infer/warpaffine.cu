@@ -134,34 +134,6 @@ __global__ void gpuMutliBilinearWarpAffine(const void* src, const int src_cols,
                          element_x, element_y);
 }
 
-void AffineTransform::updateMatrix(int src_width, int src_height, int dst_width, int dst_height) {
-    if (src_width == last_src_width_ && src_height == last_src_height_) return;
-    last_src_width_  = src_width;
-    last_src_height_ = src_height;
-
-    double scale  = std::min(static_cast<double>(dst_width) / src_width, static_cast<double>(dst_height) / src_height);
-    double offset = 0.5 * scale - 0.5;
-
-    double scale_from_width  = -0.5 * scale * src_width;
-    double scale_from_height = -0.5 * scale * src_height;
-    double half_dst_width    = 0.5 * dst_width;
-    double half_dst_height   = 0.5 * dst_height;
-
-    double inv_d = (scale != 0.0) ? 1.0 / (scale * scale) : 0.0;
-    double a     = scale * inv_d;
-
-    matrix[0] = make_float3(a, 0.0, -a * (scale_from_width + half_dst_width + offset));
-    matrix[1] = make_float3(0.0, a, -a * (scale_from_height + half_dst_height + offset));
-
-    dst_offset_x = int(dst_width * 0.5 + scale_from_width);
-    dst_offset_y = int(dst_height * 0.5 + scale_from_height);
-}
-
-void AffineTransform::applyTransform(float x, float y, float* transformed_x, float* transformed_y) const {
-    *transformed_x = matrix[0].x * x + matrix[0].y * y + matrix[0].z;
-    *transformed_y = matrix[1].x * x + matrix[1].y * y + matrix[1].z;
-}
-
 void cudaWarpAffine(const void* src, const int src_cols, const int src_rows,
                     void* dst, const int dst_cols, const int dst_rows,
                     const float3 matrix[2], const ProcessConfig config, cudaStream_t stream) {
@@ -4,41 +4,10 @@
 #include <cuda_runtime_api.h>
 
 #include "../option.hpp"
+#include "affine.hpp"
 
 namespace deploy {
 
-/**
- * @brief 用于仿射变换的 2x3 变换矩阵的结构体
- *
- */
-struct AffineTransform {
-    float3 matrix[2];         // < 用于仿射变换的 2x3 变换矩阵
-    int    dst_offset_x;      // < 变换后目标图像的 X 轴偏移量。
-    int    dst_offset_y;      // < 变换后目标图像的 Y 轴偏移量。
-    int    last_src_width_;   // < 上一次处理的源图像的宽度。
-    int    last_src_height_;  // < 上一次处理的源图像的高度。
-
-    /**
-     * @brief 根据源图像和目标图像尺寸的变化更新仿射变换矩阵
-     *
-     * @param src_width 源图像的宽度
-     * @param src_height 源图像的高度
-     * @param dst_width 目标图像的宽度
-     * @param dst_height 目标图像的高度
-     */
-    void updateMatrix(int src_width, int src_height, int dst_width, int dst_height);
-
-    /**
-     * @brief 使用仿射变换矩阵变换一个点
-     *
-     * @param x 点的 X 坐标
-     * @param y 点的 Y 坐标
-     * @param[out] transformed_x 变换后的 X 坐标
-     * @param[out] transformed_y 变换后的 Y 坐标
-     */
-    void applyTransform(float x, float y, float* transformed_x, float* transformed_y) const;
-};
-
 /**
  * @brief 使用 CUDA 应用仿射变换。
  *
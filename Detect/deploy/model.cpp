@@ -1,4 +1,5 @@
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <sstream>
@@ -6,15 +7,47 @@
 
 #include "model.hpp"
 #include "result.hpp"
+#ifdef DEPLOY_WITH_TRT
+#include "infer/backend.hpp"
+#endif
 
 namespace deploy {
 
+template <typename ResultType>
+BaseModel<ResultType>::BaseModel(const std::string& model_file, const InferOption& infer_option)
+    : backend_(createBackend(model_file, infer_option)) {
+    if (backend_->option.enable_performance_report) {
+        createTimers();
+    }
+}
+
+template <typename ResultType>
+BaseModel<ResultType>::BaseModel(std::unique_ptr<BaseBackend> backend)
+    : backend_(std::move(backend)) {
+    if (backend_->option.enable_performance_report) {
+        createTimers();
+    }
+}
+
+template <typename ResultType>
+void BaseModel<ResultType>::createTimers() {
+#ifdef DEPLOY_WITH_TRT
+    if (auto trt_backend = dynamic_cast<TrtBackend*>(backend_.get())) {
+        infer_gpu_trace_ = std::make_unique<GpuTimer>(trt_backend->stream);
+    } else {
+        infer_gpu_trace_ = std::make_unique<CpuTimer>();
+    }
+#else
+    infer_gpu_trace_ = std::make_unique<CpuTimer>();
+#endif
+    infer_cpu_trace_ = std::make_unique<CpuTimer>();
+}
+
 template <typename ResultType>
 std::unique_ptr<BaseModel<ResultType>> BaseModel<ResultType>::clone() const {
-    auto clone_model              = std::make_unique<BaseModel<ResultType>>();
-    clone_model->backend_         = backend_->clone();  // < 克隆 TrtBackend
-    clone_model->infer_gpu_trace_ = std::make_unique<GpuTimer>(clone_model->backend_->stream);
-    clone_model->infer_cpu_trace_ = std::make_unique<CpuTimer>();
+    auto clone_model      = std::make_unique<BaseModel<ResultType>>();
+    clone_model->backend_ = backend_->clone();  // < 克隆推理后端
+    clone_model->createTimers();
     return clone_model;
 }
 
@@ -25,18 +58,16 @@ std::vector<ResultType> BaseModel<ResultType>::predict(const std::vector<Image>&
         infer_cpu_trace_->start();
         infer_gpu_trace_->start();
     }
-    std::cout << "222" << std::endl;
 
     backend_->infer(images);  // 调用推理方法
 
     // 预分配结果空间
     std::vector<ResultType> results(images.size());
-    std::cout << "1111" << std::endl;
 
     for (auto idx = 0u; idx < images.size(); ++idx) {
         results[idx] = postProcess(idx);
     }
-    std::cout<<"1111"<<std::endl;
+
     if (backend_->option.enable_performance_report) {
         infer_gpu_trace_->stop();
         infer_cpu_trace_->stop();
@@ -55,6 +86,11 @@ int BaseModel<ResultType>::batch_size() const {
     return backend_->max_shape.x;
 }
 
+template <typename ResultType>
+BackendType BaseModel<ResultType>::backend() const {
+    return backend_->type();
+}
+
 template <typename ResultType>
 std::tuple<std::string, std::string, std::string> BaseModel<ResultType>::performanceReport() {
     if (backend_->option.enable_performance_report) {
@@ -66,13 +102,14 @@ std::tuple<std::string, std::string, std::string> BaseModel<ResultType>::perform
         std::string throughputStr = ss.str();
         ss.str("");  // 清空 stringstream
 
-        auto percentiles = std::vector<float>{90, 95, 99};
+        // 直方图取分位数，代价与运行时长无关
+        auto percentiles = std::vector<float>{50, 90, 99, 99.9};
 
         auto getLatencyStr = [&](const auto& trace, const std::string& device) {
-            auto result = getPerformanceResult(trace->milliseconds(), {0.90, 0.95, 0.99});
-            ss << device << " Latency: min = " << result.min << " ms, max = " << result.max << " ms, mean = " << result.mean << " ms, median = " << result.median << " ms";
+            auto result = getPerformanceResult(trace->histogram(), percentiles);
+            ss << device << " Latency: min = " << result.min << " ms, max = " << result.max << " ms, mean = " << result.mean << " ms";
             for (int32_t i = 0, n = percentiles.size(); i < n; ++i) {
-                ss << ", percentile(" << percentiles[i] << "%) = " << result.percentiles[i] << " ms";
+                ss << ", p" << percentiles[i] << " = " << result.percentiles[i] << " ms";
             }
             std::string output = ss.str();
             ss.str("");  // 清空 stringstream
@@ -80,7 +117,7 @@ std::tuple<std::string, std::string, std::string> BaseModel<ResultType>::perform
         };
 
         std::string cpuLatencyStr = getLatencyStr(infer_cpu_trace_, "CPU");
-        std::string gpuLatencyStr = getLatencyStr(infer_gpu_trace_, "GPU");
+        std::string gpuLatencyStr = getLatencyStr(infer_gpu_trace_, backend_->type() == BackendType::TensorRT ? "GPU" : "Device");
 
         total_request_ = 0;
         infer_cpu_trace_->reset();
@@ -96,8 +133,8 @@ std::tuple<std::string, std::string, std::string> BaseModel<ResultType>::perform
 // ClassifyModel 的后处理方法实现
 template <>
 ClassifyRes BaseModel<ClassifyRes>::postProcess(int idx) {
-    auto&  tensor_info = backend_->tensor_infos[1];
-    float* topk        = static_cast<float*>(tensor_info.buffer->host()) + idx * tensor_info.shape.d[1] * tensor_info.shape.d[2];
+    auto   tensor_info = backend_->tensor(1);
+    float* topk        = static_cast<float*>(tensor_info.host) + idx * tensor_info.shape.d[1] * tensor_info.shape.d[2];
 
     ClassifyRes result;
     result.num = tensor_info.shape.d[1];
@@ -115,15 +152,15 @@ ClassifyRes BaseModel<ClassifyRes>::postProcess(int idx) {
 // DetectModel 的后处理方法实现
 template <>
 DetectRes BaseModel<DetectRes>::postProcess(int idx) {
-    auto& num_tensor   = backend_->tensor_infos[1];
-    auto& box_tensor   = backend_->tensor_infos[2];
-    auto& score_tensor = backend_->tensor_infos[3];
-    auto& class_tensor = backend_->tensor_infos[4];
+    auto  num_tensor   = backend_->tensor(1);
+    auto  box_tensor   = backend_->tensor(2);
+    auto  score_tensor = backend_->tensor(3);
+    auto  class_tensor = backend_->tensor(4);
 
-    int    num     = static_cast<int*>(num_tensor.buffer->host())[idx];
-    float* boxes   = static_cast<float*>(box_tensor.buffer->host()) + idx * box_tensor.shape.d[1] * box_tensor.shape.d[2];
-    float* scores  = static_cast<float*>(score_tensor.buffer->host()) + idx * score_tensor.shape.d[1];
-    int*   classes = static_cast<int*>(class_tensor.buffer->host()) + idx * class_tensor.shape.d[1];
+    int    num     = static_cast<int*>(num_tensor.host)[idx];
+    float* boxes   = static_cast<float*>(box_tensor.host) + idx * box_tensor.shape.d[1] * box_tensor.shape.d[2];
+    float* scores  = static_cast<float*>(score_tensor.host) + idx * score_tensor.shape.d[1];
+    int*   classes = static_cast<int*>(class_tensor.host) + idx * class_tensor.shape.d[1];
 
     DetectRes result;
     result.num   = num;
@@ -156,15 +193,15 @@ DetectRes BaseModel<DetectRes>::postProcess(int idx) {
 // OBBModel 的后处理方法实现
 template <>
 OBBRes BaseModel<OBBRes>::postProcess(int idx) {
-    auto& num_tensor   = backend_->tensor_infos[1];
-    auto& box_tensor   = backend_->tensor_infos[2];
-    auto& score_tensor = backend_->tensor_infos[3];
-    auto& class_tensor = backend_->tensor_infos[4];
+    auto  num_tensor   = backend_->tensor(1);
+    auto  box_tensor   = backend_->tensor(2);
+    auto  score_tensor = backend_->tensor(3);
+    auto  class_tensor = backend_->tensor(4);
 
-    int    num     = static_cast<int*>(num_tensor.buffer->host())[idx];
-    float* boxes   = static_cast<float*>(box_tensor.buffer->host()) + idx * box_tensor.shape.d[1] * box_tensor.shape.d[2];
-    float* scores  = static_cast<float*>(score_tensor.buffer->host()) + idx * score_tensor.shape.d[1];
-    int*   classes = static_cast<int*>(class_tensor.buffer->host()) + idx * class_tensor.shape.d[1];
+    int    num     = static_cast<int*>(num_tensor.host)[idx];
+    float* boxes   = static_cast<float*>(box_tensor.host) + idx * box_tensor.shape.d[1] * box_tensor.shape.d[2];
+    float* scores  = static_cast<float*>(score_tensor.host) + idx * score_tensor.shape.d[1];
+    int*   classes = static_cast<int*>(class_tensor.host) + idx * class_tensor.shape.d[1];
 
     OBBRes result;
     result.num   = num;
@@ -198,19 +235,19 @@ OBBRes BaseModel<OBBRes>::postProcess(int idx) {
 // SegmentModel 的后处理方法实现
 template <>
 SegmentRes BaseModel<SegmentRes>::postProcess(int idx) {
-    auto& num_tensor   = backend_->tensor_infos[1];
-    auto& box_tensor   = backend_->tensor_infos[2];
-    auto& score_tensor = backend_->tensor_infos[3];
-    auto& class_tensor = backend_->tensor_infos[4];
-    auto& mask_tensor  = backend_->tensor_infos[5];
+    auto  num_tensor   = backend_->tensor(1);
+    auto  box_tensor   = backend_->tensor(2);
+    auto  score_tensor = backend_->tensor(3);
+    auto  class_tensor = backend_->tensor(4);
+    auto  mask_tensor  = backend_->tensor(5);
     int   mask_height  = mask_tensor.shape.d[2];
     int   mask_width   = mask_tensor.shape.d[3];
 
-    int      num     = static_cast<int*>(num_tensor.buffer->host())[idx];
-    float*   boxes   = static_cast<float*>(box_tensor.buffer->host()) + idx * box_tensor.shape.d[1] * box_tensor.shape.d[2];
-    float*   scores  = static_cast<float*>(score_tensor.buffer->host()) + idx * score_tensor.shape.d[1];
-    int*     classes = static_cast<int*>(class_tensor.buffer->host()) + idx * class_tensor.shape.d[1];
-    uint8_t* masks   = static_cast<uint8_t*>(mask_tensor.buffer->host()) + idx * mask_tensor.shape.d[1] * mask_height * mask_width;
+    int      num     = static_cast<int*>(num_tensor.host)[idx];
+    float*   boxes   = static_cast<float*>(box_tensor.host) + idx * box_tensor.shape.d[1] * box_tensor.shape.d[2];
+    float*   scores  = static_cast<float*>(score_tensor.host) + idx * score_tensor.shape.d[1];
+    int*     classes = static_cast<int*>(class_tensor.host) + idx * class_tensor.shape.d[1];
+    uint8_t* masks   = static_cast<uint8_t*>(mask_tensor.host) + idx * mask_tensor.shape.d[1] * mask_height * mask_width;
 
     SegmentRes result;
     result.num   = num;
@@ -256,29 +293,19 @@ SegmentRes BaseModel<SegmentRes>::postProcess(int idx) {
 // PoseModel 的后处理方法实现
 template <>
 PoseRes BaseModel<PoseRes>::postProcess(int idx) {
-    std::cout << "Tensor shapes:" << std::endl;
-    for (int i = 0; i < backend_->tensor_infos.size(); ++i) {
-        auto &shape = backend_->tensor_infos[i].shape;
-        std::cout << "Tensor " << i << ": ";
-        for (int d = 0; d < shape.nbDims; ++d) {
-        std::cout << shape.d[d] << " ";
-        }
-        std::cout << std::endl;
-    }
-
-    auto& num_tensor   = backend_->tensor_infos[1];
-    auto& box_tensor   = backend_->tensor_infos[2];
-    auto& score_tensor = backend_->tensor_infos[3];
-    auto& class_tensor = backend_->tensor_infos[4];
-    auto& kpt_tensor   = backend_->tensor_infos[5];
+    auto  num_tensor   = backend_->tensor(1);
+    auto  box_tensor   = backend_->tensor(2);
+    auto  score_tensor = backend_->tensor(3);
+    auto  class_tensor = backend_->tensor(4);
+    auto  kpt_tensor   = backend_->tensor(5);
     int   nkpt         = kpt_tensor.shape.d[2];
     int   ndim         = kpt_tensor.shape.d[3];
 
-    int    num     = static_cast<int*>(num_tensor.buffer->host())[idx];
-    float* boxes   = static_cast<float*>(box_tensor.buffer->host()) + idx * box_tensor.shape.d[1] * box_tensor.shape.d[2];
-    float* scores  = static_cast<float*>(score_tensor.buffer->host()) + idx * score_tensor.shape.d[1];
-    int*   classes = static_cast<int*>(class_tensor.buffer->host()) + idx * class_tensor.shape.d[1];
-    float* kpts    = static_cast<float*>(kpt_tensor.buffer->host()) + idx * kpt_tensor.shape.d[1] * nkpt * ndim;
+    int    num     = static_cast<int*>(num_tensor.host)[idx];
+    float* boxes   = static_cast<float*>(box_tensor.host) + idx * box_tensor.shape.d[1] * box_tensor.shape.d[2];
+    float* scores  = static_cast<float*>(score_tensor.host) + idx * score_tensor.shape.d[1];
+    int*   classes = static_cast<int*>(class_tensor.host) + idx * class_tensor.shape.d[1];
+    float* kpts    = static_cast<float*>(kpt_tensor.host) + idx * kpt_tensor.shape.d[1] * nkpt * ndim;
 
     PoseRes result;
     result.num   = num;
@@ -318,4 +345,90 @@ PoseRes BaseModel<PoseRes>::postProcess(int idx) {
     return result;
 }
 
+template <>
+void BaseModel<PoseRes>::predict(const Image& image, PoseResView& result) {
+    if (backend_->option.enable_performance_report) {
+        total_request_ += (backend_->dynamic ? 1 : backend_->max_shape.x);
+        infer_cpu_trace_->start();
+        infer_gpu_trace_->start();
+    }
+
+    // 首次调用后容量不变，clear + push_back 不再分配
+    inputs_.clear();
+    inputs_.push_back(image);
+    backend_->infer(inputs_);
+    postProcess(0, result);
+
+    if (backend_->option.enable_performance_report) {
+        infer_gpu_trace_->stop();
+        infer_cpu_trace_->stop();
+    }
+}
+
+template <>
+void BaseModel<PoseRes>::predict(const std::vector<Image>& images, std::vector<PoseResView>& results) {
+    if (backend_->option.enable_performance_report) {
+        total_request_ += (backend_->dynamic ? images.size() : backend_->max_shape.x);
+        infer_cpu_trace_->start();
+        infer_gpu_trace_->start();
+    }
+
+    backend_->infer(images);
+    // 只增不减，已有的 PoseResView 保留容量
+    if (results.size() < images.size()) {
+        results.resize(images.size());
+    }
+    for (auto idx = 0u; idx < images.size(); ++idx) {
+        postProcess(idx, results[idx]);
+    }
+
+    if (backend_->option.enable_performance_report) {
+        infer_gpu_trace_->stop();
+        infer_cpu_trace_->stop();
+    }
+}
+
+// PoseModel 的原地后处理方法实现，直接从输出张量写入 SoA 存储
+template <>
+void BaseModel<PoseRes>::postProcess(int idx, PoseResView& result) {
+    const auto box_tensor = backend_->tensor(2);
+    const auto kpt_tensor = backend_->tensor(5);
+    const int  max_det    = static_cast<int>(box_tensor.shape.d[1]);
+    const int  box_size   = static_cast<int>(box_tensor.shape.d[2]);
+    const int  nkpt       = static_cast<int>(kpt_tensor.shape.d[2]);
+    const int  ndim       = static_cast<int>(kpt_tensor.shape.d[3]);
+    const int  stride     = nkpt * ndim;
+
+    const int    num     = std::min(static_cast<const int*>(backend_->tensor(1).host)[idx], max_det);
+    const float* boxes   = static_cast<const float*>(box_tensor.host) + static_cast<size_t>(idx) * max_det * box_size;
+    const float* scores  = static_cast<const float*>(backend_->tensor(3).host) + static_cast<size_t>(idx) * max_det;
+    const int*   classes = static_cast<const int*>(backend_->tensor(4).host) + static_cast<size_t>(idx) * max_det;
+    const float* kpts    = static_cast<const float*>(kpt_tensor.host) + static_cast<size_t>(idx) * max_det * stride;
+
+    const auto& affine_transform = backend_->option.input_shape.has_value()
+                                       ? backend_->affine_transforms.front()
+                                       : backend_->affine_transforms[idx];
+
+    result.reserve(max_det, nkpt, ndim);
+    result.num = num;
+    std::copy(scores, scores + num, result.scores.begin());
+    std::copy(classes, classes + num, result.classes.begin());
+
+    for (int i = 0; i < num; ++i) {
+        const float* src_box = boxes + i * box_size;
+        Box&         box     = result.boxes[i];
+        affine_transform.applyTransform(src_box[0], src_box[1], &box.left, &box.top);
+        affine_transform.applyTransform(src_box[2], src_box[3], &box.right, &box.bottom);
+
+        const float* src_kpt = kpts + i * stride;
+        float*       dst_kpt = result.kpts.data() + static_cast<size_t>(i) * stride;
+        for (int j = 0; j < nkpt; ++j) {
+            affine_transform.applyTransform(src_kpt[j * ndim], src_kpt[j * ndim + 1], &dst_kpt[j * ndim], &dst_kpt[j * ndim + 1]);
+            for (int d = 2; d < ndim; ++d) {
+                dst_kpt[j * ndim + d] = src_kpt[j * ndim + d];
+            }
+        }
+    }
+}
+
 }  // namespace deploy
@@ -5,7 +5,7 @@
 #include <string>
 #include <vector>
 
-#include "infer/backend.hpp"
+#include "infer/base_backend.hpp"
 #include "utils/utils.hpp"
 #include "option.hpp"
 #include "result.hpp"
@@ -28,18 +28,19 @@ public:
     ~BaseModel() = default;
 
     /**
-     * @brief 构造一个新的 BaseModel 对象
+     * @brief 构造一个新的 BaseModel 对象，按 infer_option.backend 选择推理后端
      *
-     * @param trt_engine_file TensorRT 引擎文件路径
+     * @param model_file 模型文件路径，TensorRT 引擎或 ONNX 模型
      * @param infer_option 推理选项
      */
-    explicit BaseModel(const std::string& trt_engine_file, const InferOption& infer_option)
-        : backend_(std::make_unique<TrtBackend>(trt_engine_file, infer_option)) {
-        if (backend_->option.enable_performance_report) {
-            infer_gpu_trace_ = std::make_unique<GpuTimer>(backend_->stream);
-            infer_cpu_trace_ = std::make_unique<CpuTimer>();
-        }
-    }
+    explicit BaseModel(const std::string& model_file, const InferOption& infer_option);
+
+    /**
+     * @brief 使用已创建的推理后端构造 BaseModel 对象，用于自定义后端
+     *
+     * @param backend 推理后端
+     */
+    explicit BaseModel(std::unique_ptr<BaseBackend> backend);
 
     /**
      * @brief 克隆 BaseModel 对象
@@ -64,6 +65,26 @@ public:
      */
     std::vector<ResultType> predict(const std::vector<Image>& images);
 
+    /**
+     * @brief 对单张图像进行推理，结果原地写入调用方跨帧复用的 result，稳态下不分配堆内存
+     *
+     * 仅 PoseModel 提供实现。
+     *
+     * @param image 输入图像
+     * @param result 推理结果
+     */
+    void predict(const Image& image, PoseResView& result);
+
+    /**
+     * @brief 对多张图像进行一次批量推理，结果原地写入 results，results 不足时扩容
+     *
+     * 仅 PoseModel 提供实现。
+     *
+     * @param images 输入图像向量，数量不超过 batch_size()
+     * @param results 推理结果，前 images.size() 项按输入顺序一一对应
+     */
+    void predict(const std::vector<Image>& images, std::vector<PoseResView>& results);
+
     /**
      * @brief 获取性能报告
      *
@@ -78,6 +99,13 @@ public:
      */
     int batch_size() const;
 
+    /**
+     * @brief 获取推理后端类型
+     *
+     * @return 后端类型
+     */
+    BackendType backend() const;
+
 protected:
     /**
      * @brief 后处理方法，由派生类实现
@@ -87,13 +115,36 @@ protected:
      */
     ResultType postProcess(int idx);
 
-    std::unique_ptr<TrtBackend> backend_;         // < TensorRT 后端
+    /**
+     * @brief 后处理方法，结果原地写入 result，仅 PoseModel 提供实现
+     *
+     * @param idx 索引
+     * @param result 推理结果
+     */
+    void postProcess(int idx, PoseResView& result);
+
+    /**
+     * @brief 创建设备端计时器，TensorRT 后端为 GPU 计时器，CPU 后端与 CPU 计时器相同
+     */
+    void createTimers();
 
-    unsigned long long        total_request_{0};  // < 总请求数
-    std::unique_ptr<GpuTimer> infer_gpu_trace_;   // < GPU推理计时器
-    std::unique_ptr<CpuTimer> infer_cpu_trace_;   // < CPU推理计时器
+    std::unique_ptr<BaseBackend> backend_;         // < 推理后端
+
+    unsigned long long         total_request_{0};  // < 总请求数
+    std::unique_ptr<TimerBase> infer_gpu_trace_;   // < 设备推理计时器
+    std::unique_ptr<CpuTimer>  infer_cpu_trace_;   // < CPU推理计时器
+
+    std::vector<Image> inputs_;  // < 单张推理时复用的输入向量
 };
 
+// PoseModel 的原地推理接口
+template <>
+void BaseModel<PoseRes>::predict(const Image& image, PoseResView& result);
+template <>
+void BaseModel<PoseRes>::predict(const std::vector<Image>& images, std::vector<PoseResView>& results);
+template <>
+void BaseModel<PoseRes>::postProcess(int idx, PoseResView& result);
+
 // 实例化模板类
 template class BaseModel<ClassifyRes>;
 template class BaseModel<DetectRes>;
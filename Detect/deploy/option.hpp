@@ -4,9 +4,9 @@
 #include <cassert>
 #include <optional>
 #include <vector>
-#include <vector_functions.hpp>
 
 #include "core/macro.hpp"
+#include "core/vector_types.hpp"
 
 namespace deploy {
 
@@ -56,6 +56,45 @@ struct ProcessConfig {
     }
 };
 
+/**
+ * @brief 推理后端类型
+ *
+ */
+enum class BackendType {
+    Auto,      // < 按模型文件后缀选择：.onnx 使用 OpenCV，其余使用 TensorRT
+    TensorRT,  // < TensorRT 引擎，需要 CUDA
+    OpenCV     // < OpenCV DNN，仅使用 CPU
+};
+
+/**
+ * @brief CPU 后端的预处理实现
+ *
+ */
+enum class CpuPreprocess {
+    OpenCV,  // < cv::warpAffine + split + convertTo，多次遍历图像
+    Fused    // < cpuWarpAffine，一次遍历完成 letterbox、通道交换、归一化和平面化（AVX2 / NEON）
+};
+
+/**
+ * @brief CPU 后端配置结构体
+ *
+ * CPU 后端加载不带 NMS 插件的原始 ONNX 导出，输出为 [batch, 4 + 类别数 + 关键点数 * 维度, 锚点数]，
+ * 解码和 NMS 在 CPU 上完成，结果按 TensorRT 引擎的输出布局写回，后处理两种后端共用。
+ */
+struct CpuConfig {
+    int   max_batch      = 1;      // < 单次推理的最大图像数
+    int   input_width    = 640;    // < 网络输入宽度
+    int   input_height   = 640;    // < 网络输入高度
+    int   num_classes    = 0;      // < 类别数，0 表示由输出通道数推算
+    int   num_keypoints  = 4;      // < 每个目标的关键点数
+    int   keypoint_dim   = 2;      // < 每个关键点的维度，2 为 (x, y)，3 为 (x, y, conf)
+    int   max_detections = 100;    // < 每张图最多保留的目标数，对应 TensorRT NMS 插件的 max_output_boxes
+    float conf_thres     = 0.25f;  // < 置信度阈值
+    float iou_thres      = 0.45f;  // < NMS 的 IoU 阈值
+
+    CpuPreprocess preprocess = CpuPreprocess::Fused;  // < 预处理实现
+};
+
 /**
  * @brief 推理选项配置结构体
  *
@@ -67,6 +106,8 @@ struct DEPLOYAPI InferOption {
     bool                enable_performance_report = false;  // < 是否启用性能报告
     std::optional<int2> input_shape;                        // < 输入数据的高、宽，未设置时表示宽度可变（用于输入数据宽高确定的任务场景：监控视频分析，AI外挂等）
     ProcessConfig       config;                             // < 图像预处理配置
+    BackendType         backend                   = BackendType::Auto;  // < 推理后端
+    CpuConfig           cpu;                                // < CPU 后端配置
 
     /**
      * @brief 设置 GPU 设备 ID
@@ -138,6 +179,35 @@ struct DEPLOYAPI InferOption {
     void setInputDimensions(int width, int height) {
         input_shape = make_int2(height, width);
     }
+
+    /**
+     * @brief 设置推理后端
+     *
+     * @param type 后端类型
+     */
+    void setBackend(BackendType type) {
+        backend = type;
+    }
+
+    /**
+     * @brief 设置 CPU 后端的网络输入尺寸，需与导出 ONNX 时的尺寸一致
+     *
+     * @param width 宽度
+     * @param height 高度
+     */
+    void setNetworkDimensions(int width, int height) {
+        cpu.input_width  = width;
+        cpu.input_height = height;
+    }
+
+    /**
+     * @brief 设置 CPU 后端的预处理实现
+     *
+     * @param type 预处理实现
+     */
+    void setCpuPreprocess(CpuPreprocess type) {
+        cpu.preprocess = type;
+    }
 };
 
 }  // namespace deploy
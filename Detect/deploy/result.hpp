@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <optional>
 #include <stdexcept>
@@ -10,13 +11,67 @@
 
 namespace deploy {
 
+/**
+ * @brief 输入图像的像素格式
+ */
+enum class PixelFormat {
+    BGR,     // < BGR 8 位三通道
+    RGB,     // < RGB 8 位三通道
+    BGRA,    // < BGRA 8 位四通道，A 不参与计算
+    RGBA,    // < RGBA 8 位四通道，A 不参与计算，Unity ARGB32 RenderTexture 读回的格式
+    BayerBG  // < BayerBG8 原图，单通道，排列同 cv::COLOR_BayerBG2BGR，预处理时 2x2 合并去马赛克
+};
+
+/**
+ * @brief 每个像素的字节数
+ */
+inline int pixelBytes(PixelFormat format) {
+    switch (format) {
+        case PixelFormat::BGRA:
+        case PixelFormat::RGBA:
+            return 4;
+        case PixelFormat::BayerBG:
+            return 1;
+        default:
+            return 3;
+    }
+}
+
+/**
+ * @brief 内存中按 R G B 顺序存放，预处理读出时交换为 BGR
+ */
+inline bool isRgbOrder(PixelFormat format) {
+    return format == PixelFormat::RGB || format == PixelFormat::RGBA;
+}
+
+inline const char* formatName(PixelFormat format) {
+    switch (format) {
+        case PixelFormat::BGR:
+            return "BGR";
+        case PixelFormat::RGB:
+            return "RGB";
+        case PixelFormat::BGRA:
+            return "BGRA";
+        case PixelFormat::RGBA:
+            return "RGBA";
+        default:
+            return "BayerBG";
+    }
+}
+
 /**
  * @brief 图像结构体，用于存储图像数据及其尺寸信息
+ *
+ * 除像素格式外还描述内存布局：行间填充（stride）和自下而上的行序（flip），
+ * 预处理按描述直接读原缓冲区，仿真读回的 RGBA 倒序图像不需要先翻转、转换成 BGR。
  */
 struct DEPLOYAPI Image {
-    void* ptr;         // < 图像数据指针
-    int   width  = 0;  // < 图像宽度
-    int   height = 0;  // < 图像高度
+    void*       ptr;                         // < 图像数据指针
+    int         width  = 0;                  // < 图像宽度
+    int         height = 0;                  // < 图像高度
+    PixelFormat format = PixelFormat::BGR;   // < 像素格式
+    int         stride = 0;                  // < 每行字节数，不小于 width * pixelBytes(format)
+    bool        flip   = false;              // < ptr 指向的第一行是图像最下面一行（OpenGL / Unity 的行序）
 
     /**
      * @brief 构造函数，初始化图像数据和尺寸
@@ -24,15 +79,42 @@ struct DEPLOYAPI Image {
      * @param data 图像数据指针
      * @param width 图像宽度
      * @param height 图像高度
+     * @param format 像素格式，BayerBG 要求宽高为偶数
+     * @param stride 每行字节数，0 表示行间无填充
+     * @param flip 是否自下而上存储
      */
-    Image(void* data, int width, int height) : ptr(data), width(width), height(height) {
+    Image(void* data, int width, int height, PixelFormat format = PixelFormat::BGR, int stride = 0, bool flip = false)
+        : ptr(data), width(width), height(height), format(format), stride(stride), flip(flip) {
         if (width <= 0 || height <= 0) {
             throw std::invalid_argument(MAKE_ERROR_MESSAGE("Image: width and height must be positive"));
         }
+        if (format == PixelFormat::BayerBG && (width % 2 != 0 || height % 2 != 0)) {
+            throw std::invalid_argument(MAKE_ERROR_MESSAGE("Image: Bayer width and height must be even"));
+        }
+        if (this->stride == 0) {
+            this->stride = width * pixelBytes(format);
+        } else if (this->stride < width * pixelBytes(format)) {
+            throw std::invalid_argument(MAKE_ERROR_MESSAGE("Image: stride is smaller than a row"));
+        }
+    }
+
+    /**
+     * @brief 缓冲区字节数
+     */
+    size_t bytes() const {
+        return static_cast<size_t>(stride) * height;
+    }
+
+    /**
+     * @brief 行间无填充、自上而下的 BGR，可以整块拷贝
+     */
+    bool packedBgr() const {
+        return format == PixelFormat::BGR && stride == width * 3 && !flip;
     }
 
     friend std::ostream& operator<<(std::ostream& os, const Image& img) {
-        os << "Image(width=" << img.width << ", height=" << img.height << ", ptr=" << img.ptr << ")";
+        os << "Image(width=" << img.width << ", height=" << img.height << ", format=" << formatName(img.format)
+           << ", stride=" << img.stride << (img.flip ? ", flip" : "") << ", ptr=" << img.ptr << ")";
         return os;
     }
 };
@@ -413,4 +495,121 @@ struct DEPLOYAPI PoseRes : public BaseRes {
     PoseRes& operator=(PoseRes&& other) noexcept = default;  // < 默认移动赋值运算符
 };
 
+/**
+ * @brief 姿态估计结果的结构体数组（SoA）存储，供每帧原地写入、跨帧复用
+ *
+ * boxes、scores、classes 和平铺的关键点各自连续存储，容量按后端的最大检测数一次分配，
+ * 之后每帧只改写前 num 项，容量和关键点布局不变时不再分配堆内存。
+ * 第 i 个目标的关键点从 kpts[i * kpt_stride] 开始，每个关键点 kpt_dim 个值：(x, y) 或 (x, y, conf)。
+ */
+struct DEPLOYAPI PoseResView {
+    /**
+     * @brief 单个目标的只读视图，指向 PoseResView 内部存储，不拷贝数据
+     */
+    struct Detection {
+        const Box*   box;      // < 矩形框
+        float        score;    // < 得分
+        int          cls;      // < 类别
+        const float* kpts;     // < 该目标第一个关键点的地址
+        int          kpt_dim;  // < 每个关键点的维度
+
+        float x(int j) const {
+            return kpts[j * kpt_dim];
+        }
+
+        float y(int j) const {
+            return kpts[j * kpt_dim + 1];
+        }
+
+        std::optional<float> conf(int j) const {
+            return kpt_dim > 2 ? std::optional<float>(kpts[j * kpt_dim + 2]) : std::nullopt;
+        }
+    };
+
+    /**
+     * @brief 按下标遍历前 num 个目标的迭代器，解引用返回 Detection
+     */
+    class Iterator {
+    public:
+        Iterator(const PoseResView* view, int index) : view_(view), index_(index) {}
+
+        Detection operator*() const {
+            return (*view_)[index_];
+        }
+
+        Iterator& operator++() {
+            ++index_;
+            return *this;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return index_ != other.index_;
+        }
+
+    private:
+        const PoseResView* view_;   // < 所属视图
+        int                index_;  // < 当前下标
+    };
+
+    int                num           = 0;  // < 本帧的目标数量
+    int                num_keypoints = 0;  // < 每个目标的关键点数
+    int                kpt_dim       = 0;  // < 每个关键点的维度
+    int                kpt_stride    = 0;  // < 相邻目标关键点的间隔，num_keypoints * kpt_dim
+    std::vector<Box>   boxes;              // < [capacity] 矩形框，前 num 项有效
+    std::vector<float> scores;             // < [capacity] 得分
+    std::vector<int>   classes;            // < [capacity] 类别
+    std::vector<float> kpts;               // < [capacity * kpt_stride] 平铺的关键点
+
+    /**
+     * @brief 当前容量，即最多可存放的目标数
+     */
+    int capacity() const {
+        return static_cast<int>(scores.size());
+    }
+
+    /**
+     * @brief 确保容量和关键点布局，容量足够且布局相同时不做任何分配
+     *
+     * @param capacity 最多存放的目标数
+     * @param keypoints 每个目标的关键点数
+     * @param dim 每个关键点的维度
+     */
+    void reserve(int capacity, int keypoints, int dim) {
+        if (capacity <= this->capacity() && keypoints == num_keypoints && dim == kpt_dim) {
+            return;
+        }
+        num_keypoints = keypoints;
+        kpt_dim       = dim;
+        kpt_stride    = keypoints * dim;
+        const int cap = std::max(capacity, this->capacity());
+        boxes.resize(cap);
+        scores.resize(cap);
+        classes.resize(cap);
+        kpts.resize(static_cast<size_t>(cap) * kpt_stride);
+    }
+
+    Detection operator[](int i) const {
+        return Detection{&boxes[i], scores[i], classes[i], kpts.data() + static_cast<size_t>(i) * kpt_stride, kpt_dim};
+    }
+
+    Iterator begin() const {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() const {
+        return Iterator(this, num);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const PoseResView& res) {
+        os << "PoseResView(\n    num=" << res.num << ",\n    detections=[\n";
+        for (const auto det : res) {
+            os << "        class=" << det.cls << ", score=" << det.score << ", " << *det.box << ", kpts=[";
+            for (int j = 0; j < res.num_keypoints; ++j) os << "(" << det.x(j) << ", " << det.y(j) << "), ";
+            os << "],\n";
+        }
+        os << "    ]\n)";
+        return os;
+    }
+};
+
 }  // namespace deploy
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace deploy {
+
+/**
+ * @brief 对数分桶的耗时直方图，内存固定，记录 O(1)，取分位数的代价与样本数无关。
+ *
+ * 按 HDR Histogram 的方式分桶：以 ns 为单位，小于 2^kSubBucketBits 的值每个 ns 一个桶，
+ * 之后每个 2 的幂区间等分为 2^kSubBucketBits 个桶，桶宽不超过下界的 1/128。
+ * 分位数取所在桶的中点，相对误差不超过 kMaxRelativeError；最小值、最大值、总和单独记录，是精确值。
+ * 超过 kMaxTrackableNs 的值计入最后一个桶，最大值仍是精确的。
+ * 同一个直方图不能在多个线程中同时写入。
+ */
+class LatencyHistogram {
+public:
+    static constexpr int     kSubBucketBits     = 7;                                             // < 每个 2 的幂区间的分桶位数
+    static constexpr int64_t kSubBucketCount    = int64_t{1} << kSubBucketBits;                  // < 每个 2 的幂区间的桶数
+    static constexpr int     kMaxMagnitude      = 36;                                            // < 可区分的最大值为 2^36 ns，约 68.7 s
+    static constexpr int64_t kMaxTrackableNs    = (int64_t{1} << kMaxMagnitude) - 1;             // < 可区分的最大值
+    static constexpr int     kBucketCount       = (kMaxMagnitude - kSubBucketBits + 1) << kSubBucketBits;  // < 桶数
+    static constexpr double  kMaxRelativeError  = 1.0 / (2 * kSubBucketCount);                   // < 分位数的最大相对误差
+
+    LatencyHistogram() : counts_(kBucketCount, 0) {}
+
+    /**
+     * @brief 记录一次耗时
+     *
+     * @param ms 耗时，单位毫秒，负数按 0 计
+     */
+    void record(float ms) {
+        recordNs(static_cast<int64_t>(static_cast<double>(ms) * 1e6 + 0.5));
+    }
+
+    /**
+     * @brief 记录一次耗时
+     *
+     * @param ns 耗时，单位纳秒，负数按 0 计
+     */
+    void recordNs(int64_t ns) {
+        ns = std::max<int64_t>(ns, 0);
+        ++counts_[bucketIndex(ns)];
+        ++count_;
+        sum_ns_ += ns;
+        min_ns_ = std::min(min_ns_, ns);
+        max_ns_ = std::max(max_ns_, ns);
+    }
+
+    /**
+     * @brief 累加另一个直方图，结果与两者的样本记录到同一个直方图中一致
+     */
+    void merge(const LatencyHistogram& other) {
+        if (other.count_ == 0) {
+            return;
+        }
+        for (int i = 0; i < kBucketCount; ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        count_ += other.count_;
+        sum_ns_ += other.sum_ns_;
+        min_ns_ = std::min(min_ns_, other.min_ns_);
+        max_ns_ = std::max(max_ns_, other.max_ns_);
+    }
+
+    /**
+     * @brief 清空全部样本，不释放内存
+     */
+    void reset() {
+        std::fill(counts_.begin(), counts_.end(), 0);
+        count_  = 0;
+        sum_ns_ = 0;
+        min_ns_ = std::numeric_limits<int64_t>::max();
+        max_ns_ = 0;
+    }
+
+    uint64_t count() const noexcept { return count_; }  // < 样本数
+
+    float min() const noexcept { return count_ == 0 ? 0.F : static_cast<float>(min_ns_ * 1e-6); }  // < 最小值，毫秒
+
+    float max() const noexcept { return static_cast<float>(max_ns_ * 1e-6); }  // < 最大值，毫秒
+
+    float total() const noexcept { return static_cast<float>(sum_ns_ * 1e-6); }  // < 总和，毫秒
+
+    float mean() const noexcept {
+        return count_ == 0 ? 0.F : static_cast<float>(static_cast<double>(sum_ns_) / count_ * 1e-6);
+    }  // < 平均值，毫秒
+
+    /**
+     * @brief 百分位数，按升序第 ceil(percentile / 100 * count) 个样本所在的桶取值
+     * @note 百分位数必须在 [0, 100] 范围内。否则，将抛出异常。没有样本时返回 0。
+     *
+     * @param percentile 百分位数
+     * @return float 百分位数值，毫秒，限制在 [min, max] 内
+     */
+    float percentile(float percentile) const {
+        if (percentile < 0.F || percentile > 100.F) {
+            throw std::invalid_argument("LatencyHistogram: percentile is not in [0, 100]");
+        }
+        if (count_ == 0) {
+            return 0.F;
+        }
+        const auto rank = std::max<uint64_t>(
+            1, static_cast<uint64_t>(std::ceil(static_cast<double>(percentile) / 100.0 * static_cast<double>(count_) - 1e-9)));
+        uint64_t seen = 0;
+        for (int i = 0; i < kBucketCount; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                const int64_t value = std::clamp(bucketMiddle(i), min_ns_, max_ns_);
+                return static_cast<float>(value * 1e-6);
+            }
+        }
+        return max();
+    }
+
+    /**
+     * @brief 值所在的桶
+     */
+    static int bucketIndex(int64_t ns) {
+        if (ns < kSubBucketCount) {
+            return static_cast<int>(ns);
+        }
+        ns              = std::min(ns, kMaxTrackableNs);
+        const int shift = magnitude(ns) - kSubBucketBits;
+        return static_cast<int>((static_cast<int64_t>(shift) << kSubBucketBits) + (ns >> shift));
+    }
+
+    /**
+     * @brief 桶的下界（包含），单位纳秒
+     */
+    static int64_t bucketLower(int index) {
+        if (index < kSubBucketCount) {
+            return index;
+        }
+        const int shift = (index >> kSubBucketBits) - 1;
+        return static_cast<int64_t>(index - (shift << kSubBucketBits)) << shift;
+    }
+
+    /**
+     * @brief 桶宽，单位纳秒
+     */
+    static int64_t bucketWidth(int index) {
+        return index < kSubBucketCount ? 1 : int64_t{1} << ((index >> kSubBucketBits) - 1);
+    }
+
+private:
+    static int magnitude(int64_t value) {
+        return 63 - __builtin_clzll(static_cast<unsigned long long>(value));
+    }
+
+    static int64_t bucketMiddle(int index) {
+        return bucketLower(index) + (bucketWidth(index) - 1) / 2;
+    }
+
+    std::vector<uint64_t> counts_;                                     // < 各桶的样本数
+    uint64_t              count_{0};                                   // < 样本数
+    int64_t               sum_ns_{0};                                  // < 总和
+    int64_t               min_ns_{std::numeric_limits<int64_t>::max()};  // < 最小值
+    int64_t               max_ns_{0};                                  // < 最大值
+};
+
+/**
+ * @brief 最近一段时间的耗时直方图
+ *
+ * 时间窗口等分为若干片，每片一个 LatencyHistogram，按记录时刻写入所在的片，过期的片在被复用时清空。
+ * 取快照时合并仍在窗口内的片，代价只与片数有关；窗口的边界精确到一片的长度。
+ * 同一个窗口直方图不能在多个线程中同时写入。
+ */
+class WindowedHistogram {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 构造函数
+     *
+     * @param window 窗口长度
+     * @param slices 窗口的分片数，越多边界越精确，内存和取快照的代价越大
+     */
+    explicit WindowedHistogram(std::chrono::milliseconds window = std::chrono::seconds(10), int slices = 5)
+        : slice_ns_(std::max<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(window).count() / std::max(slices, 1), 1)),
+          slices_(std::max(slices, 1)),
+          epochs_(std::max(slices, 1), -1) {}
+
+    /**
+     * @brief 记录一次耗时
+     *
+     * @param ms 耗时，单位毫秒
+     * @param now 记录时刻
+     */
+    void record(float ms, Clock::time_point now = Clock::now()) {
+        slice(now).record(ms);
+    }
+
+    /**
+     * @brief 记录一次耗时
+     *
+     * @param ns 耗时，单位纳秒
+     * @param now 记录时刻
+     */
+    void recordNs(int64_t ns, Clock::time_point now = Clock::now()) {
+        slice(now).recordNs(ns);
+    }
+
+    /**
+     * @brief 合并窗口内的片，写入 result（先清空），不分配内存
+     *
+     * @param result 输出
+     * @param now 窗口的结束时刻
+     */
+    void snapshot(LatencyHistogram& result, Clock::time_point now = Clock::now()) const {
+        result.reset();
+        const int64_t epoch = epochOf(now);
+        for (size_t i = 0; i < slices_.size(); ++i) {
+            if (epochs_[i] >= 0 && epochs_[i] > epoch - static_cast<int64_t>(slices_.size()) && epochs_[i] <= epoch) {
+                result.merge(slices_[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief 清空全部样本
+     */
+    void reset() {
+        for (auto& slice : slices_) {
+            slice.reset();
+        }
+        std::fill(epochs_.begin(), epochs_.end(), -1);
+    }
+
+private:
+    int64_t epochOf(Clock::time_point now) const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count() / slice_ns_;
+    }
+
+    LatencyHistogram& slice(Clock::time_point now) {
+        const int64_t epoch = epochOf(now);
+        const size_t  index = static_cast<size_t>(epoch % static_cast<int64_t>(slices_.size()));
+        if (epochs_[index] != epoch) {
+            slices_[index].reset();
+            epochs_[index] = epoch;
+        }
+        return slices_[index];
+    }
+
+    int64_t                       slice_ns_;  // < 每片的长度
+    std::vector<LatencyHistogram> slices_;    // < 各片的直方图
+    std::vector<int64_t>          epochs_;    // < 各片对应的时间片序号，-1 为未使用
+};
+
+}  // namespace deploy
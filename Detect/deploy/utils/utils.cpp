@@ -1,5 +1,6 @@
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 
 #include "deploy/core/macro.hpp"
@@ -20,6 +21,7 @@ void ReadBinaryFromFile(const std::string& file, std::string* contents) {
     fin.close();
 }
 
+#ifdef DEPLOY_WITH_TRT
 bool SupportsIntegratedZeroCopy(const int gpu_id) {
     // 查询设备属性，检查是否为集成显卡
     cudaDeviceProp cuprops;
@@ -32,6 +34,7 @@ bool SupportsIntegratedZeroCopy(const int gpu_id) {
         return false;
     }
 }
+#endif
 
 float findPercentile(float percentile, std::vector<float> const& timings) {
     int32_t const all     = static_cast<int32_t>(timings.size());
@@ -75,15 +78,50 @@ PerformanceResult getPerformanceResult(std::vector<float> const& timings, std::v
     return result;
 }
 
+PerformanceResult getPerformanceResult(LatencyHistogram const& histogram, std::vector<float> const& percentiles) {
+    PerformanceResult result;
+    result.min    = histogram.min();
+    result.max    = histogram.max();
+    result.mean   = histogram.mean();
+    result.median = histogram.percentile(50.F);
+    result.percentiles.reserve(percentiles.size());
+    for (auto percentile : percentiles) {
+        result.percentiles.emplace_back(histogram.percentile(percentile));
+    }
+    return result;
+}
+
 void CpuTimer::start() {
     mStart = std::chrono::high_resolution_clock::now();
 }
 
 void CpuTimer::stop() {
     mStop = std::chrono::high_resolution_clock::now();
-    mMs.push_back(std::chrono::duration<float, std::milli>{mStop - mStart}.count());
+    record(std::chrono::duration<float, std::milli>{mStop - mStart}.count());
+}
+
+static std::atomic<StageHook> stage_hook{nullptr};
+
+static int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void setStageHook(StageHook hook) {
+    stage_hook.store(hook, std::memory_order_release);
+}
+
+StageTimer::StageTimer(const char* stage)
+    : mStage(stage), mHook(stage_hook.load(std::memory_order_acquire)), mBeginNs(mHook ? steadyNowNs() : 0) {}
+
+void StageTimer::stop() {
+    if (mHook) {
+        mHook(mStage, mBeginNs, steadyNowNs());
+        mHook = nullptr;
+    }
 }
 
+#ifdef DEPLOY_WITH_TRT
 GpuTimer::GpuTimer(cudaStream_t stream) : mStream(stream) {
     CHECK(cudaEventCreate(&mStart));
     CHECK(cudaEventCreate(&mStop));
@@ -103,7 +141,8 @@ void GpuTimer::stop() {
     CHECK(cudaEventSynchronize(mStop));
     float ms{0.0F};
     CHECK(cudaEventElapsedTime(&ms, mStart, mStop));
-    mMs.push_back(ms);
+    record(ms);
 }
+#endif
 
 }  // namespace deploy
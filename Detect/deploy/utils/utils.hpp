@@ -1,14 +1,18 @@
 
 #pragma once
 
+#ifdef DEPLOY_WITH_TRT
 #include <cuda_runtime_api.h>
+#endif
 
 #include <chrono>
+#include <cstdint>
 #include <numeric>
 #include <string>
 #include <vector>
 
 #include "../core/macro.hpp"
+#include "histogram.hpp"
 
 namespace deploy {
 
@@ -23,6 +27,7 @@ namespace deploy {
  */
 void ReadBinaryFromFile(const std::string& file, std::string* contents);
 
+#ifdef DEPLOY_WITH_TRT
 /**
  * @brief 检查指定的 GPU 是否支持集成零拷贝内存
  *
@@ -34,6 +39,7 @@ void ReadBinaryFromFile(const std::string& file, std::string* contents);
  * @return false 如果 GPU 不支持集成零拷贝内存
  */
 bool SupportsIntegratedZeroCopy(const int gpu_id);
+#endif
 
 /**
  * @brief 在一个升序的时间序列中找到指定的百分位数
@@ -74,28 +80,48 @@ struct PerformanceResult {
  */
 PerformanceResult getPerformanceResult(std::vector<float> const& timings, std::vector<float> const& percentiles);
 
+/**
+ * @brief 按直方图统计，代价与样本数无关
+ *
+ * @param histogram 耗时直方图
+ * @param percentiles 百分位数列表，每项在 [0, 100] 内
+ * @return PerformanceResult 性能结果对象，中位数和百分位数的相对误差不超过 LatencyHistogram::kMaxRelativeError
+ */
+PerformanceResult getPerformanceResult(LatencyHistogram const& histogram, std::vector<float> const& percentiles);
+
 /**
  * @brief 定义一个计时器基类
  *
  * 该类提供了基本的计时功能，包括开始计时、停止计时、获取计时结果（毫秒）、重置计时结果以及获取总计时（毫秒）。
  * 它是一个抽象类，用于派生出具体的 CPU 计时器和 GPU 计时器类。
+ * 计时结果记录在固定大小的直方图中，长时间运行内存不增长。
  */
 class TimerBase {
 public:
-    virtual void       start() {}  // < 虚函数，用于开始计时
-    virtual void       stop() {}   // < 虚函数，用于停止计时
-    std::vector<float> milliseconds() const noexcept {
-        return mMs;
-    }  // < 获取计时结果（毫秒）
+    virtual ~TimerBase() = default;
+    virtual void            start() {}  // < 虚函数，用于开始计时
+    virtual void            stop() {}   // < 虚函数，用于停止计时
+    const LatencyHistogram& histogram() const noexcept {
+        return mHistogram;
+    }  // < 获取上次重置以来的计时结果（毫秒）
+    void recent(LatencyHistogram& result) const {
+        mRecent.snapshot(result);
+    }  // < 获取最近 10 s 的计时结果，与重置无关
     void reset() noexcept {
-        mMs.clear();
+        mHistogram.reset();
     }  // < 重置计时结果
     float totalMilliseconds() const noexcept {
-        return std::accumulate(mMs.begin(), mMs.end(), 0.0F);
+        return mHistogram.total();
     }  // < 获取总计时（毫秒）
 
 protected:
-    std::vector<float> mMs;  // < 计时结果列表
+    void record(float ms) {
+        mHistogram.record(ms);
+        mRecent.record(ms);
+    }  // < 记录一次计时结果
+
+    LatencyHistogram  mHistogram;  // < 上次重置以来的计时结果
+    WindowedHistogram mRecent;     // < 最近 10 s 的计时结果
 };
 
 /**
@@ -113,6 +139,42 @@ private:
     std::chrono::time_point<std::chrono::high_resolution_clock> mStart, mStop;  // < 计时起止时间点
 };  // class CpuTimer
 
+/**
+ * @brief 阶段耗时回调
+ *
+ * stage 为字符串字面量，begin_ns、end_ns 为 std::chrono::steady_clock 的纳秒数。
+ * deploy 不依赖上层的追踪器，上层需要预处理等阶段的耗时时通过 setStageHook 接收。
+ */
+using StageHook = void (*)(const char* stage, int64_t begin_ns, int64_t end_ns);
+
+/**
+ * @brief 设置进程内唯一的阶段耗时回调，nullptr 表示不上报，可在任意线程调用
+ */
+DEPLOYAPI void setStageHook(StageHook hook);
+
+/**
+ * @brief 阶段计时器，构造时开始，stop 或析构时上报一次
+ *
+ * 没有设置回调时只读一次原子变量，不读时钟。
+ */
+class DEPLOYAPI StageTimer {
+public:
+    explicit StageTimer(const char* stage);
+    ~StageTimer() {
+        stop();
+    }
+    StageTimer(const StageTimer&)            = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+    void stop();  // < 上报本阶段，只有第一次调用有效
+
+private:
+    const char* mStage;    // < 阶段名
+    StageHook   mHook;     // < 构造时的回调，为 nullptr 时不计时
+    int64_t     mBeginNs;  // < 开始时刻
+};
+
+#ifdef DEPLOY_WITH_TRT
 /**
  * @brief 定义一个 GPU 计时器类
  *
@@ -131,5 +193,6 @@ private:
     cudaEvent_t  mStart, mStop;              // < 计时事件
     cudaStream_t mStream;                    // < CUDA 流
 };
+#endif
 
 }  // namespace deploy
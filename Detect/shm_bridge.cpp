@@ -0,0 +1,170 @@
+/**
+ * @file shm_bridge.cpp
+ * @brief 共享内存桥：从图像话题或录制文件取图，原地写进共享内存帧环，检测进程不再经过DDS
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>说明检测进程侧的一次拷贝和重启行为
+ * </table>
+ */
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cv_bridge/cv_bridge.h>
+#include <memory>
+#include <rclcpp/rclcpp.hpp>
+#include <sensor_msgs/image_encodings.hpp>
+#include <sensor_msgs/msg/image.hpp>
+#include <string>
+#include <thread>
+
+#include "ClockMapper.h"
+#include "FrameRecord.h"
+#include "ImageIngest.h"
+#include "ShmFrameRing.h"
+
+namespace {
+// 槽位数：检测进程拷走一帧远小于一个帧间隔，8个足够
+constexpr int SHM_CAPACITY = 8;
+
+std::atomic<bool> running{true};
+
+void onSignal(int) { running = false; }
+
+int64_t nsOf(const hitcrt::TimePoint &time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+/**
+ * @brief 订阅图像话题，消息按编码一次转换写进槽位
+ *
+ * 第一帧到来时按消息尺寸创建共享内存，槽位固定为BGR8。
+ */
+class ShmBridgeNode : public rclcpp::Node {
+   public:
+    ShmBridgeNode(const std::string &name, const std::string &topic) : rclcpp::Node("hitcrtShmBridge"), m_name(name) {
+        // 与Ros2ForUnity的best effort兼容
+        const auto qos = rclcpp::SensorDataQoS().keep_last(1);
+        m_subscription = create_subscription<sensor_msgs::msg::Image>(
+            topic, qos, [this](const sensor_msgs::msg::Image::ConstSharedPtr &msg) { onImage(*msg); });
+    }
+
+   private:
+    void onImage(const sensor_msgs::msg::Image &msg) {
+        const auto receiveTime = hitcrt::Clock::now();
+        if (!m_writer) {
+            m_writer = std::make_unique<hitcrt::ShmFrameWriter>(m_name, msg.width, msg.height, CV_8UC3, SHM_CAPACITY);
+            RCLCPP_INFO(get_logger(), "shm ring /%s: %ux%u bgr8, %d slots", m_name.c_str(), msg.width, msg.height,
+                        SHM_CAPACITY);
+        }
+        if (!m_writer->fits(msg.width, msg.height, CV_8UC3)) {
+            RCLCPP_WARN_THROTTLE(get_logger(), *get_clock(), 1000, "image size changed, dropped");
+            return;
+        }
+        cv::Mat &image = m_writer->begin();
+        if (!hitcrt::convertInto(msg.data.data(), msg.width, msg.height, msg.step, msg.encoding, image)) {
+            try {
+                cv_bridge::toCvCopy(msg, sensor_msgs::image_encodings::BGR8)->image.copyTo(image);
+            } catch (const cv_bridge::Exception &e) {
+                RCLCPP_WARN_THROTTLE(get_logger(), *get_clock(), 1000, "%s", e.what());
+                return;
+            }
+        }
+        hitcrt::ShmFrameMeta meta;
+        meta.m_seq = ++m_seq;
+        meta.m_rawStamp = static_cast<int64_t>(msg.header.stamp.sec) * 1000000000LL + msg.header.stamp.nanosec;
+        meta.m_receiveNs = nsOf(receiveTime);
+        // 仿真端时钟映射到本机时钟；没有填时间戳时用收到的时刻
+        meta.m_timeStampNs = meta.m_rawStamp > 0 ? nsOf(m_clock.update(meta.m_rawStamp, receiveTime)) : meta.m_receiveNs;
+        m_writer->commit(meta);
+    }
+
+    const std::string m_name;
+    std::unique_ptr<hitcrt::ShmFrameWriter> m_writer;
+    hitcrt::camera::ClockMapper m_clock;
+    uint64_t m_seq = 0;
+    rclcpp::Subscription<sensor_msgs::msg::Image>::SharedPtr m_subscription;
+};
+
+/**
+ * @brief 按录制时的帧间隔回放录制文件
+ * @param[in] loops     回放次数，0为一直循环
+ */
+int replayRecord(const std::string &name, const std::string &path, const int loops) {
+    hitcrt::FrameRecordReader reader(path);
+    if (reader.count() == 0) {
+        std::fprintf(stderr, "shm_bridge: %s has no frames\n", path.c_str());
+        return 1;
+    }
+    const hitcrt::RecordHeader &header = reader.header();
+    hitcrt::ShmFrameWriter writer(name, header.m_width, header.m_height, header.m_type, SHM_CAPACITY);
+    std::printf("shm ring /%s: %dx%d, %zu frames from %s%s\n", name.c_str(), header.m_width, header.m_height,
+                reader.count(), path.c_str(), reader.recovered() ? " (recovered)" : "");
+    uint64_t seq = 0;
+    for (int loop = 0; running && (loops == 0 || loop < loops); ++loop) {
+        const int64_t firstNs = reader.meta(0).m_timeStampNs;
+        const hitcrt::TimePoint start = hitcrt::Clock::now();
+        for (size_t i = 0; running && i < reader.count(); ++i) {
+            const hitcrt::RecordMeta &record = reader.meta(i);
+            const auto offset = std::chrono::nanoseconds(record.m_timeStampNs - firstNs);
+            std::this_thread::sleep_until(start + std::chrono::duration_cast<hitcrt::Clock::duration>(offset));
+            reader.prefetch(i + 1);
+            hitcrt::ShmFrameMeta meta;
+            meta.m_seq = ++seq;
+            meta.m_rawStamp = record.m_rawStamp;
+            meta.m_receiveNs = nsOf(hitcrt::Clock::now());
+            // 录制时的抓图时刻平移到现在，帧间隔保持不变
+            meta.m_timeStampNs = nsOf(start) + offset.count();
+            reader.image(i).copyTo(writer.begin());
+            writer.commit(meta);
+        }
+    }
+    return 0;
+}
+}  // namespace
+
+// 用法：shm_bridge <共享内存名> ros [图像话题]
+//       shm_bridge <共享内存名> record <录制文件> [回放次数，0为一直循环]
+// 检测进程里的shm_ring_name设为同一个名字
+// 本进程原地写槽位；检测进程读槽位时拷贝一次到自己的帧槽位再交给流水线。本进程重启后检测进程会自动重新打开共享内存
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        std::fprintf(stderr,
+                     "usage: %s <shm name> ros [topic]\n"
+                     "       %s <shm name> record <file> [loops]\n",
+                     argv[0], argv[0]);
+        return 1;
+    }
+    const std::string name = argv[1];
+    const std::string mode = argv[2];
+    if (mode == "record" && argc > 3) {
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+        try {
+            return replayRecord(name, argv[3], argc > 4 ? std::atoi(argv[4]) : 0);
+        } catch (const std::exception &e) {
+            std::fprintf(stderr, "shm_bridge: %s\n", e.what());
+            return 1;
+        }
+    }
+    if (mode != "ros") {
+        std::fprintf(stderr, "shm_bridge: unknown mode %s\n", mode.c_str());
+        return 1;
+    }
+    rclcpp::init(argc, argv);
+    try {
+        rclcpp::spin(std::make_shared<ShmBridgeNode>(name, argc > 3 ? argv[3] : "/image_raw"));
+    } catch (const std::exception &e) {
+        std::fprintf(stderr, "shm_bridge: %s\n", e.what());
+    }
+    rclcpp::shutdown();
+    return 0;
+}
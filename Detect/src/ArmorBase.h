@@ -11,6 +11,9 @@
  * <tr><th>Date       <th>Author  <th>Description
  * <tr><td>2023-12-10 <td>LiuZhihao  <td>
  * <tr><td>2024-12-17 <td>FangHengjie  <td> 给Armor加入了一些新的成员变量，用于yawToR优化的实现
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td> 拆分出ArmorObservation与ArmorSolution，Eigen成员改为定长类型
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td> m_confidence恢复为double
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td> ArmorSolution改为堆上存放，Armor本体不再带1.1KB的解算结果
  * </table>
  */
 
@@ -20,6 +23,8 @@
 #include <Eigen/Dense>
 #include <cmath>
 #include <ctime>
+#include <memory>
+#include <type_traits>
 #include <opencv2/core.hpp>
 #include <opencv2/core/eigen.hpp>
 #include <opencv2/opencv.hpp>
@@ -52,68 +57,141 @@ class LightBar {
 };
 
 /**
- * @brief 装甲板
- * @author BG2EDG (928330305@qq.com)
+ * @brief 装甲板检测结果的热数据，检测、去重和NMS只处理这一部分
+ *
+ * 全部为定长成员，拷贝不涉及堆内存，按值放在连续的vector中遍历
  */
-class Armor {
-   public:
-    // Raw from Detect (Both NN & Tradition)
+struct ArmorObservation {
     // 装甲板特征点
     cv::Point2f m_topLeft;
     cv::Point2f m_topRight;
-    cv::Point2f m_centerLeft; // 左灯条像素平面中心 基本不用 
-    cv::Point2f m_centerRight;// 右灯条像素平面中心 基本不用 
     cv::Point2f m_bottomLeft;
     cv::Point2f m_bottomRight;
-    cv::Point2f m_centerUV;  // 中心点在图像中的位置
-    cv::Point2f m_carCenterUV;
-    cv::Point2f m_predictPosUV;
+    cv::Point2f m_centerLeft;   // 左灯条像素平面中心 基本不用
+    cv::Point2f m_centerRight;  // 右灯条像素平面中心 基本不用
+    cv::Point2f m_centerUV;     // 中心点在图像中的位置
+
+    float m_width = 0;
+    float m_height = 0;
+    double m_confidence = 0;  // 模型输出的置信度，保持原来的double，阈值比较和显示不变
+    int m_classID = -1;      // 推理结果的类别编号，-1 表示未赋值
+
+    Pattern m_pattern = Pattern::UNKNOWN;  // 数字编号
+    Size m_size = Size::SMALL;
+
+    TimePoint m_timeStamp;  // 抓图时间
+};
+
+// OpenCV 4.5.5起cv::Point_的拷贝构造为默认实现，更早的版本逐成员拷贝，同样不涉及堆内存
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && (CV_VERSION_MINOR > 5 || CV_VERSION_REVISION >= 5))
+static_assert(std::is_trivially_copyable_v<ArmorObservation>, "ArmorObservation must stay trivially copyable");
+#endif
+
+/**
+ * @brief 装甲板位姿解算与滤波的冷数据，全部为定长Eigen类型，只在解算后挂到Armor上
+ */
+struct ArmorSolution {
+    static constexpr int STATE_DIM = 6;   // 滤波状态维数：x, vx, y, vy, z, vz
+    static constexpr int WEIGHT_NUM = 4;  // 轨迹匹配权重个数
+
+    Eigen::Vector3d m_rotVec = Eigen::Vector3d::Zero();    // PnP旋转向量
+    Eigen::Vector3d m_transVec = Eigen::Vector3d::Zero();  // PnP平移向量
+    Eigen::Vector3d m_rotVec1 = Eigen::Vector3d::Zero();   // 第二个解的旋转向量
+    Eigen::Vector2d m_reprojectionError = Eigen::Vector2d::Zero();  // 两个解对应的重投影误差
+
+    Eigen::Vector4d m_pointCH = Eigen::Vector4d::Zero();  // 相机系齐次坐标
+    Eigen::Vector4d m_pointGH = Eigen::Vector4d::Zero();  // 云台系齐次坐标
+    Eigen::Vector3d m_pointG3 = Eigen::Vector3d::Zero();  // 云台系坐标
+    Eigen::Vector3d m_pointR3 = Eigen::Vector3d::Zero();  // 机器人系坐标
+    Eigen::Matrix3d m_rotRoll = Eigen::Matrix3d::Identity();
+    Eigen::Matrix3d m_rotYaw = Eigen::Matrix3d::Identity();
+    Eigen::Matrix3d m_rotPitch = Eigen::Matrix3d::Identity();
+    Eigen::Matrix4d m_R2G = Eigen::Matrix4d::Identity();  // 机器人系到云台系的齐次变换
+    Eigen::Matrix4d m_G2C = Eigen::Matrix4d::Identity();  // 云台系到相机系的齐次变换
+
+    Eigen::Matrix<double, STATE_DIM, 1> m_filtMatrix = Eigen::Matrix<double, STATE_DIM, 1>::Zero();     // 滤波值
+    Eigen::Matrix<double, STATE_DIM, 1> m_filtMatrixCar = Eigen::Matrix<double, STATE_DIM, 1>::Zero();  // 整车滤波值
+    Eigen::Vector3d m_filtPos = Eigen::Vector3d::Zero();  // xyz滤波值，单位m
 
-    // 模型推理得到的额外信息
-   double m_confidence;
-   int m_classID = -1;  // 推理结果的类别编号，-1 表示未赋值
+    Eigen::Matrix<float, WEIGHT_NUM, 1> m_weights = Eigen::Matrix<float, WEIGHT_NUM, 1>::Zero();  // 轨迹匹配权重
+};
 
-    // 数字编号
-    Pattern m_pattern = Pattern::UNKNOWN;
-    // int m_pattern = 0;
+/**
+ * @brief 装甲板
+ * @author BG2EDG (928330305@qq.com)
+ *
+ * 检测得到的部分继承自ArmorObservation，解算后的位姿与滤波状态放在堆上的m_solution中，
+ * 未解算的装甲板拷贝时只拷贝定长成员和一个空指针
+ */
+class Armor : public ArmorObservation {
+   public:
+    Armor() = default;
+    explicit Armor(const ArmorObservation &observation) : ArmorObservation(observation) {}
+
+    cv::Point2f m_carCenterUV;
+    cv::Point2f m_predictPosUV;
 
     // Raw from recv/system
-    TimePoint m_timeStamp;
     double m_time = 0;  /// 获取时间，等于抓图时间
 
     float m_currPitchRAD = 0.0, m_currYawRAD = 0.0, m_currRollRAD = 0.0;  // pithc&yaw当前值
 
     // Calculate
-    float m_width;
-    float m_height;
     float m_aspectRatio;                // 宽比高，与屏幕16:9,4:3等定义方式一致
     float m_product = 0;                // 灯条平行度
-    Size m_size;                        // 定义一个TYPE型的变量
     double m_horizontalDistance = 0.0;  // 装甲到云台坐标系原点的水平面投影距离
 
     // Ttj
-    float m_dislikeValue;          // 决策
-    std::vector<float> m_weights;  // 轨迹匹配权重
-    double m_lastR;                // 小陀螺时相邻装甲板数据
+    float m_dislikeValue;  // 决策
+    double m_lastR;        // 小陀螺时相邻装甲板数据
     double m_lastY;
 
-    // 与图无关的矩阵换成Eigen矩阵，计算中间变量用double
-    Eigen::MatrixXd m_rotVec, m_transVec;
-    // 记录两个姿态解，用于后续选择出最有yawToR
-    Eigen::MatrixXd m_rotVec1; // 第二个解的旋转向量
     double m_yawToC, m_yawToR, m_pitchToR, m_rollToR, m_yawToR1; // m_yawToR1是第二个解d
-    std::vector<float> m_reprojectionErrorVector; // 记录两个解对应的重投影误差
-    Eigen::MatrixXd m_pointCH, m_pointGH, m_pointG3, m_pointR3;
-    Eigen::Matrix3d m_rotRoll, m_rotYaw, m_rotPitch;
-    Eigen::MatrixXd m_R2G, m_G2C;
-
-    Eigen::MatrixXd m_filtMatrix, m_filtMatrixCar;    // 滤波值
-    Eigen::MatrixXd m_filtPos;                        // xyz滤波值，单位m
     cv::Point3d m_predictXYZ;                         // xyz预测值，单位m
     double m_calcPitchRAD = 0.0, m_calcYawRAD = 0.0;  // pitch&yaw计算值
     double m_filtPitchDEG = 0.0, m_filtYawDEG = 0.0;  // pitch&yaw滤波值
     double m_predPitchDEG = 0.0, m_predYawDEG = 0.0;  // pitch&yaw预测值
     double m_filtYawToR;
+
+    /**
+     * @brief 获取解算结果，第一次调用时挂上
+     * @return ArmorSolution&
+     */
+    ArmorSolution &solution() {
+        if (!m_solution.m_ptr) {
+            m_solution.m_ptr = std::make_unique<ArmorSolution>();
+        }
+        return *m_solution.m_ptr;
+    }
+
+    bool solved() const { return m_solution.m_ptr != nullptr; }
+
+   private:
+    /**
+     * @brief 解算结果放在堆上，约1.1KB不占Armor本体：每帧大部分装甲板不解算，拷贝和容器扩容只搬一个指针。
+     *        拷贝时深拷贝，两边都已解算时原地赋值，不重新分配
+     */
+    struct SolutionSlot {
+        SolutionSlot() = default;
+        SolutionSlot(const SolutionSlot &other)
+            : m_ptr(other.m_ptr ? std::make_unique<ArmorSolution>(*other.m_ptr) : nullptr) {}
+        SolutionSlot(SolutionSlot &&other) noexcept = default;
+        SolutionSlot &operator=(const SolutionSlot &other) {
+            if (!other.m_ptr) {
+                m_ptr.reset();
+            } else if (m_ptr) {
+                *m_ptr = *other.m_ptr;
+            } else {
+                m_ptr = std::make_unique<ArmorSolution>(*other.m_ptr);
+            }
+            return *this;
+        }
+        SolutionSlot &operator=(SolutionSlot &&other) noexcept = default;
+
+        std::unique_ptr<ArmorSolution> m_ptr;
+    };
+
+    SolutionSlot m_solution;  // 位姿解算结果，解算前为空
 };
 
 }  // namespace hitcrt
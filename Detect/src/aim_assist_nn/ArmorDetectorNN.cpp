@@ -10,20 +10,147 @@
  * <table>
  * <tr><th>Date <th>Author <th>Description
  * <tr><td>2024-12-12 <td>Wang-yicheng <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION <td>推理、解码、NMS记录trace区间
+ * <tr><td>2026-10-17 <td>HITCRT_VISION <td>apply按ROI窗口推理，结果映射回原图坐标
+ * <tr><td>2026-10-17 <td>HITCRT_VISION <td>推理级和解码级不共享缓冲，同一级被并发调用时抛异常
+ * <tr><td>2026-10-17 <td>HITCRT_VISION <td>deploy预处理的耗时通过阶段回调写进trace
  * </table>
  */
 #include "ArmorDetectorNN.h"
 
+#include <stdexcept>
+
+#include "Trace.h"
+#include "utils/utils.hpp"
+
 namespace hitcrt {
+namespace {
+/**
+ * @brief 占用一级，析构时释放；这一级已被其他线程占用时抛异常
+ */
+class StageGuard {
+   public:
+    StageGuard(std::atomic<bool> &busy, const char *stage) : m_busy(busy) {
+        if (m_busy.exchange(true, std::memory_order_acquire)) {
+            throw std::logic_error(std::string("ArmorDetectorNN: concurrent ") + stage);
+        }
+    }
+    ~StageGuard() { m_busy.store(false, std::memory_order_release); }
+    StageGuard(const StageGuard &) = delete;
+    StageGuard &operator=(const StageGuard &) = delete;
+
+   private:
+    std::atomic<bool> &m_busy;
+};
+
+#ifdef HITCRT_TRACE
+// deploy不依赖追踪器，预处理等阶段的耗时通过回调交给这里，帧序号取调用线程的当前帧
+void traceStage(const char *stage, const int64_t beginNs, const int64_t endNs) {
+    Tracer::instance().record(stage, Tracer::frame(), beginNs, endNs);
+}
+
+[[maybe_unused]] const bool STAGE_HOOK_INSTALLED = (deploy::setStageHook(traceStage), true);
+#endif
+}  // namespace
 
+/**
+ * @brief 检测一帧
+ * @param[in] roi   预测的目标区域，开启ROI推理时据此确定窗口；为空时用上一帧检测到的目标
+ */
 bool ArmorDetectorNN::apply(const Frame &frame, const RecvInfoBase &recvInfo, const ROI &roi, std::vector<Armor> &armors) {
+    const cv::Rect2i window = m_roi.window(frame.image().size(), roi.rect());
+    infer(frame, window, m_result);
+    const bool found = decode(m_result, frame, recvInfo, armors);
+    m_roi.update(m_observations);
+    return found;
+}
+
+deploy::Image ArmorDetectorNN::toImage(const cv::Mat &img) {
+    // 相机输出Bayer原图时Frame里是单通道图像，交给预处理合并去马赛克；四通道按BGRA读，不先去掉A通道
+    const deploy::PixelFormat format = img.channels() == 1   ? deploy::PixelFormat::BayerBG
+                                       : img.channels() == 4 ? deploy::PixelFormat::BGRA
+                                                             : deploy::PixelFormat::BGR;
+    // ROI等不连续的Mat按步长读，不需要先clone
+    return deploy::Image(img.data, img.cols, img.rows, format, static_cast<int>(img.step[0]));
+}
+
+bool ArmorDetectorNN::infer(const Frame &frame, deploy::PoseResView &result) {
+    const StageGuard guard(m_inferBusy, "infer");
+    HITCRT_TRACE_SCOPE("predict");
+    m_model->predict(toImage(frame.image()), result);
+
+    return result.num > 0;
+}
+
+/**
+ * @brief 只推理原图中的一个窗口，结果映射回原图坐标
+ *
+ * 窗口是原图的视图，不拷贝；letterbox只在窗口内进行，窗口不大于网络输入时按原分辨率推理。
+ * 模型的AffineTransform把网络输入坐标映射到窗口坐标，再平移窗口左上角得到原图坐标。
+ * @param[in] window    原图中的窗口，等于整幅图时与infer(frame, result)相同；Bayer原图时左上角须为偶数
+ */
+bool ArmorDetectorNN::infer(const Frame &frame, const cv::Rect2i &window, deploy::PoseResView &result) {
+    const cv::Mat &image = frame.image();
+    if (window == cv::Rect2i(0, 0, image.cols, image.rows)) {
+        return infer(frame, result);
+    }
+    const StageGuard guard(m_inferBusy, "infer");
+    HITCRT_TRACE_SCOPE("predict roi");
+    m_model->predict(toImage(image(window)), result);  // 窗口是原图的视图
 
+    const float dx = static_cast<float>(window.x), dy = static_cast<float>(window.y);
+    for (int i = 0; i < result.num; ++i) {
+        deploy::Box &box = result.boxes[i];
+        box.left += dx;
+        box.right += dx;
+        box.top += dy;
+        box.bottom += dy;
+        float *kpts = result.kpts.data() + static_cast<size_t>(i) * result.kpt_stride;
+        for (int j = 0; j < result.num_keypoints; ++j) {
+            kpts[j * result.kpt_dim] += dx;
+            kpts[j * result.kpt_dim + 1] += dy;
+        }
+    }
+    return result.num > 0;
+}
+
+bool ArmorDetectorNN::infer(const std::vector<Frame> &frames, std::vector<deploy::PoseResView> &results) {
+    const StageGuard guard(m_inferBusy, "infer");
+    HITCRT_TRACE_SCOPE("predict batch");
+    m_images.clear();
+    for (const auto &frame : frames) {
+        m_images.push_back(toImage(frame.image()));
+    }
+    m_model->predict(m_images, results);
+
+    bool found = false;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        found = found || results[i].num > 0;
+    }
+    return found;
+}
+
+bool ArmorDetectorNN::decode(const deploy::PoseResView &result, const Frame &frame, const RecvInfoBase &recvInfo,
+                             std::vector<Armor> &armors) {
+    const StageGuard guard(m_decodeBusy, "decode");
+    const bool found = decodeObservations(result, frame, recvInfo, m_observations);
     armors.clear();
-    m_armors.clear();
-    m_img = frame.image(); // 浅拷贝
+    for (const auto &observation : m_observations) {
+        armors.emplace_back(observation);
+    }
+    return found;
+}
+
+bool ArmorDetectorNN::decode(const deploy::PoseResView &result, const Frame &frame, const RecvInfoBase &recvInfo,
+                             std::vector<ArmorObservation> &armors) {
+    const StageGuard guard(m_decodeBusy, "decode");
+    return decodeObservations(result, frame, recvInfo, armors);
+}
 
-    deploy::Image image(m_img.data, m_img.cols, m_img.rows);
-    auto result = m_model->predict(image);
+bool ArmorDetectorNN::decodeObservations(const deploy::PoseResView &result, const Frame &frame,
+                                         const RecvInfoBase &recvInfo, std::vector<ArmorObservation> &armors) {
+    HITCRT_TRACE_SCOPE("decode");
+    armors.clear();
 
     if (result.num < 1) {
         return false;
@@ -42,15 +169,14 @@ bool ArmorDetectorNN::apply(const Frame &frame, const RecvInfoBase &recvInfo, co
         return false;
     }
 
-    for (int i = 0; i < result.num; ++i) {
-        Armor armor;
-        const auto& keypoints = result.kpts[i];
+    for (const auto det : result) {
+        ArmorObservation armor;
 
         // 几何信息填充
-        armor.m_topLeft     = cv::Point2f(keypoints[0].x, keypoints[0].y);  // 左上
-        armor.m_bottomLeft  = cv::Point2f(keypoints[1].x, keypoints[1].y);  // 左下
-        armor.m_bottomRight = cv::Point2f(keypoints[2].x, keypoints[2].y);  // 右下
-        armor.m_topRight    = cv::Point2f(keypoints[3].x, keypoints[3].y);  // 右上
+        armor.m_topLeft     = cv::Point2f(det.x(0), det.y(0));  // 左上
+        armor.m_bottomLeft  = cv::Point2f(det.x(1), det.y(1));  // 左下
+        armor.m_bottomRight = cv::Point2f(det.x(2), det.y(2));  // 右下
+        armor.m_topRight    = cv::Point2f(det.x(3), det.y(3));  // 右上
 
         armor.m_centerLeft  = (armor.m_topLeft + armor.m_bottomLeft) * 0.5f;
         armor.m_centerRight = (armor.m_topRight + armor.m_bottomRight) * 0.5f;
@@ -58,8 +184,8 @@ bool ArmorDetectorNN::apply(const Frame &frame, const RecvInfoBase &recvInfo, co
         armor.m_height      = std::min(cv::norm(armor.m_topLeft - armor.m_bottomLeft), cv::norm(armor.m_topRight - armor.m_bottomRight));
         armor.m_width       = cv::norm(armor.m_centerLeft - armor.m_centerRight);
 
-        armor.m_confidence  = result.scores[i];
-        armor.m_classID     = result.classes[i];  // 记录类别编号
+        armor.m_confidence  = det.score;
+        armor.m_classID     = det.cls;  // 记录类别编号
         armor.m_timeStamp   = frame.timeStamp();  // 设置时间戳
 
         // 映射 pattern 和 size ，不识别基地小装甲板和5号
@@ -76,19 +202,14 @@ bool ArmorDetectorNN::apply(const Frame &frame, const RecvInfoBase &recvInfo, co
             default: armor.m_pattern = Pattern::UNKNOWN;            armor.m_size = Size::SMALL; break;
         }
 
-        m_armors.emplace_back(armor);  // 保存全部结果
-
         if (armor.m_classID >= classStart && armor.m_classID <= classEnd && Pattern::UNKNOWN != armor.m_pattern/* 不输出UNKNOW装甲板 */ && armor.m_confidence > m_conf) {
             armors.emplace_back(armor);  // 仅输出敌方目标
         }
     }
 
-    size_t before = armors.size();
-    filterDuplicateByClassIOU(armors, 0.9f);
-    size_t after = armors.size();
-
-    if(after - before != 0){
-    std::cout << "Filtered duplicate armors: " << "before:"<< before<< " -  after: "<<after<<" removed." << std::endl;
+    {
+        HITCRT_TRACE_SCOPE("nms");
+        m_nms.apply(armors);
     }
 
     return !armors.empty();  // 返回是否找到目标
@@ -97,62 +218,4 @@ bool ArmorDetectorNN::apply(const Frame &frame, const RecvInfoBase &recvInfo, co
 
 void ArmorDetectorNN::warmup() {}
 
-float ArmorDetectorNN::computeIOU(const cv::Rect& a, const cv::Rect& b) {
-    int x1 = std::max(a.x, b.x);
-    int y1 = std::max(a.y, b.y);
-    int x2 = std::min(a.x + a.width, b.x + b.width);
-    int y2 = std::min(a.y + a.height, b.y + b.height);
-
-    int interArea = std::max(0, x2 - x1) * std::max(0, y2 - y1);
-    int unionArea = a.area() + b.area() - interArea;
-
-    if (unionArea <= 0) return 0.0f;
-    return static_cast<float>(interArea) / static_cast<float>(unionArea);
-}
-
-void ArmorDetectorNN::filterDuplicateByClassIOU(std::vector<Armor>& armors, float iou_thresh) {
-    std::unordered_map<int, std::vector<Armor>> class_to_armors;
-
-    // 按类别归类
-    for (const auto& armor : armors) {
-        class_to_armors[armor.m_classID].emplace_back(armor);
-    }
-
-    std::vector<Armor> final_result;
-
-    for (auto& [cls, group] : class_to_armors) {
-        // 按置信度排序（从高到低）
-        std::sort(group.begin(), group.end(), [](const Armor& a, const Armor& b) {
-            return a.m_confidence > b.m_confidence;
-        });
-
-        std::vector<bool> suppressed(group.size(), false);
-
-        for (int i = 0; i < group.size(); ++i) {
-            if (suppressed[i]) continue;
-            final_result.push_back(group[i]);
-
-            cv::Rect rect1 = cv::boundingRect(std::vector<cv::Point2f>{
-                group[i].m_topLeft, group[i].m_topRight, group[i].m_bottomRight, group[i].m_bottomLeft
-            });
-
-            for (int j = i + 1; j < group.size(); ++j) {
-                if (suppressed[j]) continue;
-
-                cv::Rect rect2 = cv::boundingRect(std::vector<cv::Point2f>{
-                    group[j].m_topLeft, group[j].m_topRight, group[j].m_bottomRight, group[j].m_bottomLeft
-                });
-
-                float iou = computeIOU(rect1, rect2);
-                if (iou > iou_thresh) {
-                    suppressed[j] = true;  // 抑制置信度低的
-                }
-            }
-        }
-    }
-
-    armors.swap(final_result);
-}
-
-
 }  // namespace hitcrt
\ No newline at end of file
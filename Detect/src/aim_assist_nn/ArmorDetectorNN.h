@@ -1,11 +1,14 @@
 #pragma once
 
+#include <atomic>
 #include <iostream>
 #include <opencv2/opencv.hpp>
 #include <vector>
 #include <memory>
 
 #include "ArmorBase.h"
+#include "ArmorNMS.h"
+#include "RoiScheduler.h"
 #include "model.hpp"
 #include "option.hpp"
 #include "result.hpp"
@@ -13,20 +16,36 @@
 #include "ArmorDetectorGeneral.h"
 
 namespace hitcrt {
+/**
+ * 线程约定：infer和decode可以在两个线程上同时处理不同帧，各自只用自己那一级的缓冲；
+ * 同一级不能被多个线程同时调用，apply同时用到两级，不能与infer、decode并发。违反时抛std::logic_error。
+ */
 class ArmorDetectorNN : public ArmorDetectorGeneral {
    
    public:
-    ArmorDetectorNN(const std::string& modelpath, const float conf_thres) 
+    // backend默认按模型后缀选择：.engine走TensorRT，.onnx走OpenCV DNN（CPU）
+    ArmorDetectorNN(const std::string& modelpath, const float conf_thres,
+                    const deploy::BackendType backend = deploy::BackendType::Auto) 
         : m_modelpath(modelpath),  
-          m_conf(conf_thres) {     
+          m_conf(conf_thres),
+          m_backend(backend) {     
         loadModel();
         warmup();
     }
 
+    // 使用已创建的模型，例如自定义后端的PoseModel
+    ArmorDetectorNN(std::unique_ptr<deploy::PoseModel> model, const float conf_thres)
+        : m_model(std::move(model)),
+          m_conf(conf_thres),
+          m_backend(m_model->backend()) {
+        warmup();
+    }
+
     void loadModel() {
 
         deploy::InferOption option;
         option.enableSwapRB();
+        option.setBackend(m_backend);
 
         m_model = std::make_unique<deploy::PoseModel>(m_modelpath, option);
     }
@@ -35,18 +54,47 @@ class ArmorDetectorNN : public ArmorDetectorGeneral {
     virtual bool apply(const Frame &frame, const RecvInfoBase &recvInfo,
                        const ROI &roi, std::vector<Armor> &armors) override;
 
+    // apply拆成两步，供流水线分级调用：infer和decode可以在不同线程处理不同帧
+    // 推理，预处理在TensorRT的CUDA Graph内完成
+    // result跨帧复用，首帧分配后不再分配堆内存
+    bool infer(const Frame &frame, deploy::PoseResView &result);
+    bool infer(const Frame &frame, const cv::Rect2i &window, deploy::PoseResView &result);
+    // 多帧一次批量推理，frames.size()不超过batchSize()，results[i]对应frames[i]
+    bool infer(const std::vector<Frame> &frames, std::vector<deploy::PoseResView> &results);
+    int batchSize() const { return m_model->batch_size(); }
+    // apply按ROI推理：锁定目标时只推理目标附近的窗口，定期和丢失目标时全图
+    void setRoiConfig(const RoiConfig &config) { m_roi.setConfig(config); }
+    const RoiScheduler &roiScheduler() const { return m_roi; }
+    // 后处理：关键点转ArmorObservation，按敌方颜色筛选并去重，只拷贝定长的热数据
+    bool decode(const deploy::PoseResView &result, const Frame &frame, const RecvInfoBase &recvInfo,
+                std::vector<ArmorObservation> &armors);
+    // 同上，最后转换成Armor输出
+    bool decode(const deploy::PoseResView &result, const Frame &frame, const RecvInfoBase &recvInfo,
+                std::vector<Armor> &armors);
+
    private:
-    cv::Mat m_img;
+    // 单通道图像按BayerBG8原图处理，四通道按BGRA处理，带上行步长
+    static deploy::Image toImage(const cv::Mat &img);
+    // decode的实现，调用方已持有解码级
+    bool decodeObservations(const deploy::PoseResView &result, const Frame &frame, const RecvInfoBase &recvInfo,
+                            std::vector<ArmorObservation> &armors);
+
     const std::string m_modelpath;
     std::unique_ptr<deploy::PoseModel> m_model;
     float m_conf;
-    std::vector<Armor> m_armors;  // 保存所有推理出的装甲板，不筛颜色
+    deploy::BackendType m_backend;
+    deploy::PoseResView m_result;  // apply使用的推理结果，跨帧复用
+    // 推理级：只在infer里访问
+    std::vector<deploy::Image> m_images;  // 批量推理的输入，跨批复用
+    std::atomic<bool> m_inferBusy{false};
+    // 解码级：只在decode里访问，apply在decode之后读m_observations
+    std::vector<ArmorObservation> m_observations;  // 输出Armor前的筛选结果
+    std::atomic<bool> m_decodeBusy{false};
     std::vector<std::string> m_labels = {
         "BS", "B1", "B2", "B3", "B4", "B5", "BO", "BSB", "BLB",
         "RS", "R1", "R2", "R3", "R4", "R5", "RO", "RSB", "RLB",
         "OS", "O1", "O2", "O3", "O4", "O5", "OO", "OSB", "OLB"};
-
-    void filterDuplicateByClassIOU(std::vector<Armor>& armors, float iou_thresh = 0.9f);
-    float computeIOU(const cv::Rect& a, const cv::Rect& b);
+    ArmorNMS m_nms{NMSMode::AABB, 0.9f};  // 同类别去重，按外接矩形IOU，解码级
+    RoiScheduler m_roi;  // apply的推理窗口，默认关闭，每帧全图
 };
 }  // namespace hitcrt
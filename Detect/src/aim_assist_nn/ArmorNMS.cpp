@@ -0,0 +1,173 @@
+/**
+ * @file ArmorNMS.cpp
+ * @brief 按类别分组的装甲板NMS
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include "ArmorNMS.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace hitcrt {
+
+namespace {
+// 凸四边形被另一个凸四边形裁剪，结果最多8个顶点
+constexpr int MAX_CLIP_POINTS = 8;
+
+inline float cross(const cv::Point2f &o, const cv::Point2f &a, const cv::Point2f &b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+// 有向面积，图像坐标系下按左上、右上、右下、左下顺序为正
+float signedArea(const cv::Point2f *points, const int num) {
+    float area = 0.0f;
+    for (int i = 0, j = num - 1; i < num; j = i++) {
+        area += points[j].x * points[i].y - points[i].x * points[j].y;
+    }
+    return 0.5f * area;
+}
+
+/**
+ * @brief Sutherland-Hodgman裁剪，subject被clip的每条边依次裁剪，两者都为正向凸多边形
+ * @return 交集面积
+ */
+float intersectionArea(const cv::Point2f *subject, const cv::Point2f *clip) {
+    cv::Point2f buffer[2][MAX_CLIP_POINTS];
+    int num = 4;
+    std::copy(subject, subject + 4, buffer[0]);
+    int current = 0;
+    for (int e = 0; e < 4 && num > 0; ++e) {
+        const cv::Point2f &a = clip[e];
+        const cv::Point2f &b = clip[(e + 1) % 4];
+        const cv::Point2f *input = buffer[current];
+        cv::Point2f *output = buffer[current ^ 1];
+        int outNum = 0;
+        for (int i = 0; i < num; ++i) {
+            const cv::Point2f &p = input[i];
+            const cv::Point2f &q = input[(i + 1) % num];
+            const float dp = cross(a, b, p);
+            const float dq = cross(a, b, q);
+            if (dp >= 0.0f) {
+                output[outNum++] = p;
+            }
+            // p、q在边的两侧，加入交点
+            if ((dp >= 0.0f) != (dq >= 0.0f) && outNum < MAX_CLIP_POINTS) {
+                const float t = dp / (dp - dq);
+                output[outNum++] = p + (q - p) * t;
+            }
+            if (outNum >= MAX_CLIP_POINTS) {
+                break;
+            }
+        }
+        num = outNum;
+        current ^= 1;
+    }
+    return num < 3 ? 0.0f : std::fabs(signedArea(buffer[current], num));
+}
+}  // namespace
+
+ArmorNMS::Geometry ArmorNMS::makeGeometry(const ArmorObservation &armor) {
+    Geometry geometry;
+    geometry.m_quad[0] = armor.m_topLeft;
+    geometry.m_quad[1] = armor.m_topRight;
+    geometry.m_quad[2] = armor.m_bottomRight;
+    geometry.m_quad[3] = armor.m_bottomLeft;
+
+    float area = signedArea(geometry.m_quad, 4);
+    if (area < 0.0f) {
+        // 角点顺序反了（图像翻转等），统一为正向
+        std::swap(geometry.m_quad[1], geometry.m_quad[3]);
+        area = -area;
+    }
+    geometry.m_quadArea = area;
+
+    geometry.m_left = geometry.m_right = geometry.m_quad[0].x;
+    geometry.m_top = geometry.m_bottom = geometry.m_quad[0].y;
+    for (int i = 1; i < 4; ++i) {
+        geometry.m_left = std::min(geometry.m_left, geometry.m_quad[i].x);
+        geometry.m_right = std::max(geometry.m_right, geometry.m_quad[i].x);
+        geometry.m_top = std::min(geometry.m_top, geometry.m_quad[i].y);
+        geometry.m_bottom = std::max(geometry.m_bottom, geometry.m_quad[i].y);
+    }
+    geometry.m_boxArea = (geometry.m_right - geometry.m_left) * (geometry.m_bottom - geometry.m_top);
+    return geometry;
+}
+
+float ArmorNMS::overlap(const Geometry &a, const Geometry &b) const {
+    const float width = std::min(a.m_right, b.m_right) - std::max(a.m_left, b.m_left);
+    const float height = std::min(a.m_bottom, b.m_bottom) - std::max(a.m_top, b.m_top);
+    // 外接矩形不相交时四边形也不相交
+    if (width <= 0.0f || height <= 0.0f) {
+        return 0.0f;
+    }
+    if (m_mode == NMSMode::AABB) {
+        const float inter = width * height;
+        const float unionArea = a.m_boxArea + b.m_boxArea - inter;
+        return unionArea <= 0.0f ? 0.0f : inter / unionArea;
+    }
+    const float inter = intersectionArea(a.m_quad, b.m_quad);
+    const float unionArea = a.m_quadArea + b.m_quadArea - inter;
+    return unionArea <= 0.0f ? 0.0f : inter / unionArea;
+}
+
+float ArmorNMS::iou(const ArmorObservation &a, const ArmorObservation &b) const {
+    return overlap(makeGeometry(a), makeGeometry(b));
+}
+
+const std::vector<int> &ArmorNMS::run(const ArmorObservation *armors, const int num) {
+    m_geometry.resize(num);
+    m_order.resize(num);
+    m_suppressed.assign(num, 0);
+    m_keep.clear();
+    for (int i = 0; i < num; ++i) {
+        m_geometry[i] = makeGeometry(armors[i]);
+        m_order[i] = i;
+    }
+
+    // 只排序一次，同类别连续、类内置信度降序，置信度相同时按原下标保证结果确定
+    std::sort(m_order.begin(), m_order.end(), [armors](const int a, const int b) {
+        if (armors[a].m_classID != armors[b].m_classID) return armors[a].m_classID < armors[b].m_classID;
+        if (armors[a].m_confidence != armors[b].m_confidence) return armors[a].m_confidence > armors[b].m_confidence;
+        return a < b;
+    });
+
+    for (int begin = 0; begin < num;) {
+        int end = begin + 1;
+        while (end < num && armors[m_order[end]].m_classID == armors[m_order[begin]].m_classID) {
+            ++end;
+        }
+        for (int i = begin; i < end; ++i) {
+            if (m_suppressed[i]) continue;
+            m_keep.push_back(m_order[i]);
+            const Geometry &kept = m_geometry[m_order[i]];
+            for (int j = i + 1; j < end; ++j) {
+                if (!m_suppressed[j] && overlap(kept, m_geometry[m_order[j]]) > m_iouThresh) {
+                    m_suppressed[j] = 1;  // 抑制置信度低的
+                }
+            }
+        }
+        begin = end;
+    }
+    return m_keep;
+}
+
+void ArmorNMS::apply(std::vector<ArmorObservation> &armors) {
+    const auto &keep = run(armors.data(), static_cast<int>(armors.size()));
+    m_kept.clear();
+    for (const int index : keep) {
+        m_kept.push_back(armors[index]);
+    }
+    // 保留的数量不超过原数量，assign不会重新分配
+    armors.assign(m_kept.begin(), m_kept.end());
+}
+
+}  // namespace hitcrt
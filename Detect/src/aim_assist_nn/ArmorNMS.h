@@ -0,0 +1,96 @@
+/**
+ * @file ArmorNMS.h
+ * @brief 按类别分组的装甲板NMS，基于下标数组，缓冲区跨帧复用
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>替换filterDuplicateByClassIOU
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>注明类内抑制的复杂度和候选数上限
+ * </table>
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ArmorBase.h"
+
+namespace hitcrt {
+
+/**
+ * @brief 重叠度的计算方式
+ */
+enum class NMSMode {
+    AABB,    // 四个角点的轴对齐外接矩形
+    POLYGON  // 四个角点围成的四边形
+};
+
+/**
+ * @brief 按类别分组的NMS
+ *
+ * 先对候选下标按(类别升序, 置信度降序, 下标升序)排序一次，再在每个类别内贪心抑制，
+ * 输出顺序只取决于输入，与哈希顺序无关。外接矩形、四边形和排序用的下标都放在成员缓冲区中，
+ * 容量不增长时不分配堆内存。
+ * @note 类内两两比较，最坏O(n²)；候选来自模型输出，数量不超过引擎的max_detections（默认100），
+ *       不再另做top-k截断
+ */
+class ArmorNMS {
+   public:
+    explicit ArmorNMS(const NMSMode mode = NMSMode::AABB, const float iouThresh = 0.9f)
+        : m_mode(mode), m_iouThresh(iouThresh) {}
+
+    /**
+     * @brief 对armors[0, num)做NMS
+     * @param[in] armors    候选装甲板
+     * @param[in] num       候选数量
+     * @return 保留的下标，按(类别升序, 置信度降序)排列，下一次调用前有效
+     */
+    const std::vector<int> &run(const ArmorObservation *armors, const int num);
+
+    /**
+     * @brief 原地NMS，armors只保留未被抑制的结果，按(类别升序, 置信度降序)排列
+     * @param[in,out] armors    候选装甲板
+     */
+    void apply(std::vector<ArmorObservation> &armors);
+
+    /**
+     * @brief 计算两个装甲板的重叠度，模式与阈值同NMS
+     */
+    float iou(const ArmorObservation &a, const ArmorObservation &b) const;
+
+    void setMode(const NMSMode mode) { m_mode = mode; }
+    void setIOUThreshold(const float iouThresh) { m_iouThresh = iouThresh; }
+    NMSMode mode() const { return m_mode; }
+    float iouThreshold() const { return m_iouThresh; }
+
+   private:
+    /**
+     * @brief 预先计算的几何信息，四边形按逆时针（图像坐标系下面积为正）存放
+     */
+    struct Geometry {
+        float m_left, m_top, m_right, m_bottom;  // 外接矩形
+        float m_boxArea;                         // 外接矩形面积
+        cv::Point2f m_quad[4];                   // 四边形角点
+        float m_quadArea;                        // 四边形面积
+    };
+
+    static Geometry makeGeometry(const ArmorObservation &armor);
+    float overlap(const Geometry &a, const Geometry &b) const;
+
+    NMSMode m_mode;
+    float m_iouThresh;
+
+    std::vector<Geometry> m_geometry;    // 每个候选的几何信息
+    std::vector<int> m_order;            // 排序后的候选下标
+    std::vector<uint8_t> m_suppressed;   // 按m_order位置记录是否被抑制
+    std::vector<int> m_keep;             // 保留的下标
+    std::vector<ArmorObservation> m_kept;  // apply的输出缓冲
+};
+
+}  // namespace hitcrt
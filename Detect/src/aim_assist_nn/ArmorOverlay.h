@@ -0,0 +1,122 @@
+/**
+ * @file ArmorOverlay.h
+ * @brief 在图像上绘制装甲板检测结果：四边形、角点、中心、类别与置信度标签
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>从demo中提出，供显示线程和基准测试共用
+ * </table>
+ */
+
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+#include "ArmorBase.h"
+
+namespace hitcrt {
+
+/**
+ * @brief 绘制装甲板检测结果
+ * @tparam ArmorT Armor或ArmorObservation
+ * @param[in,out] image     BGR图像，原地绘制
+ * @param[in] armors        检测结果，坐标为原图像素
+ */
+template <typename ArmorT>
+void drawArmors(cv::Mat &image, const std::vector<ArmorT> &armors) {
+    for (size_t i = 0; i < armors.size(); ++i) {
+        const auto &armor = armors[i];
+
+        // 装甲板的四个角点
+        const cv::Point2f corners[4] = {
+            armor.m_topLeft,      // 左上
+            armor.m_topRight,     // 右上
+            armor.m_bottomRight,  // 右下
+            armor.m_bottomLeft    // 左下
+        };
+
+        // 绘制装甲板边界框
+        cv::Scalar color;
+        if (armor.m_pattern == Pattern::UNKNOWN) {
+            color = cv::Scalar(255, 255, 255);  // 白色表示未知
+        } else {
+            color = cv::Scalar(0, 255, 0);  // 绿色表示检测到的装甲板
+        }
+
+        // 绘制四边形边界
+        for (int j = 0; j < 4; j++) {
+            cv::line(image, corners[j], corners[(j + 1) % 4], color, 2);
+        }
+
+        // 绘制角点
+        for (int j = 0; j < 4; j++) {
+            cv::circle(image, corners[j], 4, cv::Scalar(0, 0, 255), -1);  // 红色圆点表示角点
+            // 标注角点序号
+            cv::putText(image, std::to_string(j), corners[j] + cv::Point2f(5, -5), cv::FONT_HERSHEY_SIMPLEX, 0.5,
+                        cv::Scalar(255, 255, 255), 1);
+        }
+
+        // 绘制中心点
+        cv::circle(image, armor.m_centerUV, 4, cv::Scalar(255, 0, 0), -1);  // 蓝色中心点
+
+        // 添加信息标签
+        std::string label =
+            "ID:" + std::to_string(armor.m_classID) + " C:" + std::to_string(armor.m_confidence).substr(0, 4);
+
+        // 根据装甲板类型添加不同颜色
+        cv::Scalar textColor;
+        switch (armor.m_pattern) {
+            case Pattern::HERO:
+                textColor = cv::Scalar(0, 165, 255);  // 橙色
+                label += " HERO";
+                break;
+            case Pattern::INFANTRY_3:
+            case Pattern::INFANTRY_4:
+                textColor = cv::Scalar(255, 255, 0);  // 青色
+                label += " INF";
+                break;
+            case Pattern::SENTRY:
+                textColor = cv::Scalar(255, 0, 255);  // 紫色
+                label += " SENTRY";
+                break;
+            case Pattern::ENGINEER:
+                textColor = cv::Scalar(0, 255, 255);  // 黄色
+                label += " ENG";
+                break;
+            case Pattern::OUTPOST:
+                textColor = cv::Scalar(128, 128, 128);  // 灰色
+                label += " OUTPOST";
+                break;
+            case Pattern::BASE:
+                textColor = cv::Scalar(255, 0, 0);  // 蓝色
+                label += " BASE";
+                break;
+            default:
+                textColor = cv::Scalar(255, 255, 255);  // 白色
+                label += " UNKNOWN";
+                break;
+        }
+
+        // 在装甲板上方显示标签
+        cv::Point2f textPosition = armor.m_topLeft;
+        if (armor.m_topLeft.y < armor.m_bottomLeft.y) {
+            textPosition.y -= 10;  // 如果左上角在上方，就在上方显示
+        } else {
+            textPosition.y += 20;  // 否则在下方显示
+        }
+
+        cv::putText(image, label, textPosition, cv::FONT_HERSHEY_SIMPLEX, 0.6, textColor, 2);
+
+        // 绘制左右中心点连线
+        cv::line(image, armor.m_centerLeft, armor.m_centerRight, cv::Scalar(255, 255, 0), 1);  // 青色连线
+    }
+}
+
+}  // namespace hitcrt
@@ -0,0 +1,153 @@
+/**
+ * @file BatchingDetector.cpp
+ * @brief 多相机批量推理
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include "BatchingDetector.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace hitcrt {
+
+BatchingDetector::BatchingDetector(std::shared_ptr<ArmorDetectorNN> detector, const int numSources,
+                                   const std::chrono::microseconds window)
+    : m_detector(std::move(detector)),
+      m_window(window),
+      m_maxBatch(std::max(1, m_detector->batchSize())),
+      m_slots(numSources) {
+    m_batch.reserve(numSources);
+    m_frames.reserve(numSources);
+    m_thread = std::thread(&BatchingDetector::run, this);
+}
+
+BatchingDetector::~BatchingDetector() { stop(); }
+
+void BatchingDetector::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_requestCond.notify_all();
+    m_resultCond.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+BatchingStats BatchingDetector::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+bool BatchingDetector::detect(const int source, const Frame &frame, const RecvInfoBase &recvInfo,
+                              std::vector<Armor> &armors) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    Slot &slot = m_slots[source];
+    if (m_stop) {
+        return false;
+    }
+    slot.m_frame.emplace(frame);
+    slot.m_recvInfo.emplace(recvInfo);
+    slot.m_armors = &armors;
+    slot.m_arrival = Clock::now();
+    slot.m_state = SlotState::PENDING;
+    m_requestCond.notify_one();
+
+    // 推理中的帧必须等写回，否则推理线程还在写armors
+    m_resultCond.wait(lock, [&] {
+        return slot.m_state == SlotState::DONE || (m_stop && slot.m_state != SlotState::RUNNING);
+    });
+    const bool detected = slot.m_state == SlotState::DONE && slot.m_detected;
+    slot.m_state = SlotState::EMPTY;
+    slot.m_frame.reset();
+    slot.m_recvInfo.reset();
+    slot.m_armors = nullptr;
+    return detected;
+}
+
+bool BatchingDetector::gather(std::unique_lock<std::mutex> &lock) {
+    auto pending = [this] {
+        return static_cast<int>(std::count_if(m_slots.begin(), m_slots.end(),
+                                              [](const Slot &slot) { return slot.m_state == SlotState::PENDING; }));
+    };
+    m_requestCond.wait(lock, [&] { return m_stop || pending() > 0; });
+    if (m_stop) {
+        return false;
+    }
+
+    // 从最早到达的一帧开始计时，等其他路到齐或凑满批量
+    TimePoint earliest = TimePoint::max();
+    for (const auto &slot : m_slots) {
+        if (slot.m_state == SlotState::PENDING) {
+            earliest = std::min(earliest, slot.m_arrival);
+        }
+    }
+    const int target = std::min(numSources(), m_maxBatch);
+    const bool full = m_requestCond.wait_until(lock, earliest + m_window, [&] { return m_stop || pending() >= target; });
+    if (m_stop) {
+        return false;
+    }
+
+    // 超过最大批量时先推理到得早的
+    m_batch.clear();
+    for (int i = 0; i < numSources(); ++i) {
+        if (m_slots[i].m_state == SlotState::PENDING) {
+            m_batch.push_back(i);
+        }
+    }
+    std::sort(m_batch.begin(), m_batch.end(),
+              [this](const int a, const int b) { return m_slots[a].m_arrival < m_slots[b].m_arrival; });
+    if (static_cast<int>(m_batch.size()) > m_maxBatch) {
+        m_batch.resize(m_maxBatch);
+    }
+
+    ++m_stats.m_batches;
+    m_stats.m_frames += m_batch.size();
+    ++(full ? m_stats.m_fullBatches : m_stats.m_deadlineBatches);
+    return true;
+}
+
+void BatchingDetector::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (gather(lock)) {
+        m_frames.clear();
+        for (const int source : m_batch) {
+            m_frames.push_back(*m_slots[source].m_frame);
+            m_slots[source].m_state = SlotState::RUNNING;
+        }
+        lock.unlock();
+
+        // RUNNING的槽位只有推理线程访问，解锁后推理和解码，其他路可以继续提交下一批
+        try {
+            m_detector->infer(m_frames, m_results);
+            for (size_t k = 0; k < m_batch.size(); ++k) {
+                Slot &slot = m_slots[m_batch[k]];
+                slot.m_detected = m_detector->decode(m_results[k], m_frames[k], *slot.m_recvInfo, *slot.m_armors);
+            }
+        } catch (const std::exception &e) {
+            std::cerr << "BatchingDetector: " << e.what() << std::endl;
+            for (const int source : m_batch) {
+                m_slots[source].m_armors->clear();
+                m_slots[source].m_detected = false;
+            }
+        }
+
+        lock.lock();
+        for (const int source : m_batch) {
+            m_slots[source].m_state = SlotState::DONE;
+        }
+        m_resultCond.notify_all();
+    }
+}
+
+}  // namespace hitcrt
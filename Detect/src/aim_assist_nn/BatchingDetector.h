@@ -0,0 +1,118 @@
+/**
+ * @file BatchingDetector.h
+ * @brief 多相机批量推理：在截止时间窗口内收集各路的帧，一次批量推理后按路分发结果
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "ArmorDetectorNN.h"
+
+namespace hitcrt {
+
+/**
+ * @brief 批量推理统计
+ */
+struct BatchingStats {
+    uint64_t m_batches = 0;       // 推理批次数
+    uint64_t m_frames = 0;        // 推理帧数
+    uint64_t m_fullBatches = 0;   // 凑满（所有路到齐或达到最大批量）的批次数
+    uint64_t m_deadlineBatches = 0;  // 截止时间到了未凑满就推理的批次数
+
+    double meanBatchSize() const { return m_batches == 0 ? 0.0 : static_cast<double>(m_frames) / m_batches; }
+};
+
+/**
+ * @brief 多路相机共用一个检测器的批量推理调度
+ *
+ * 每路相机在自己的线程中调用detect()，调用阻塞到本帧的结果返回。推理线程等到第一帧到达后开始计时，
+ * 所有路都到齐、达到检测器的最大批量或等待超过window时，把已到达的帧一次批量推理，
+ * 再按路解码，装甲板的时间戳取各自帧的抓图时间。每路同一时刻最多一帧在途。
+ */
+class BatchingDetector {
+   public:
+    /**
+     * @param[in] detector      检测器，推理和解码都在内部推理线程中执行，外部不要同时使用
+     * @param[in] numSources    相机路数
+     * @param[in] window        第一帧到达后最多等待其他路的时间
+     */
+    BatchingDetector(std::shared_ptr<ArmorDetectorNN> detector, const int numSources,
+                     const std::chrono::microseconds window);
+    ~BatchingDetector();
+
+    BatchingDetector(const BatchingDetector &) = delete;
+    BatchingDetector &operator=(const BatchingDetector &) = delete;
+
+    /**
+     * @brief 提交一路的一帧并等待结果
+     * @param[in] source    路号，[0, numSources)
+     * @param[in] frame     帧，返回前图像内存必须有效
+     * @param[in] recvInfo  这一路的下位机信息，用于按敌方颜色筛选
+     * @param[out] armors   这一路的检测结果
+     * @return 是否检测到目标，stop()之后返回false
+     */
+    bool detect(const int source, const Frame &frame, const RecvInfoBase &recvInfo, std::vector<Armor> &armors);
+
+    // 停止推理线程，唤醒所有等待中的detect
+    void stop();
+
+    BatchingStats stats() const;
+    int numSources() const { return static_cast<int>(m_slots.size()); }
+
+   private:
+    enum class SlotState { EMPTY, PENDING, RUNNING, DONE };
+
+    /**
+     * @brief 每路一个槽位，detect写入请求，推理线程写回结果
+     */
+    struct Slot {
+        SlotState m_state = SlotState::EMPTY;
+        std::optional<Frame> m_frame;
+        std::optional<RecvInfoBase> m_recvInfo;
+        std::vector<Armor> *m_armors = nullptr;
+        bool m_detected = false;
+        TimePoint m_arrival;  // 提交时间
+    };
+
+    void run();
+    // 调用时持有m_mutex，等到可以推理时把本批的路号写入m_batch，停止时返回false
+    bool gather(std::unique_lock<std::mutex> &lock);
+
+    std::shared_ptr<ArmorDetectorNN> m_detector;
+    const std::chrono::microseconds m_window;
+    const int m_maxBatch;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_requestCond;  // 有新请求或停止
+    std::condition_variable m_resultCond;   // 有结果写回或停止
+    std::vector<Slot> m_slots;
+    bool m_stop = false;
+    BatchingStats m_stats;
+
+    // 以下只在推理线程中访问，跨批复用
+    std::vector<int> m_batch;
+    std::vector<Frame> m_frames;
+    std::vector<deploy::PoseResView> m_results;
+
+    std::thread m_thread;
+};
+
+}  // namespace hitcrt
@@ -0,0 +1,145 @@
+/**
+ * @file CornerTracker.cpp
+ * @brief 装甲板角点的图像空间跟踪
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include "CornerTracker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace hitcrt {
+
+namespace {
+double seconds(const TimePoint &from, const TimePoint &to) { return std::chrono::duration<double>(to - from).count(); }
+
+// 关联门限：中心距离不超过装甲板高度的2倍，且至少24像素
+float gate(const ArmorObservation &armor) { return std::max(2.0f * static_cast<float>(armor.m_height), 24.0f); }
+}  // namespace
+
+float CornerTracker::correct(const std::vector<ArmorObservation> &armors, const TimePoint &time) {
+    m_next.clear();
+    m_matched.assign(m_tracks.size(), false);
+    float residual = 0.0f;
+    int compared = 0;
+    for (const auto &armor : armors) {
+        // 同类别中外推中心最近的轨迹
+        int best = -1;
+        float bestDistance = std::numeric_limits<float>::max();
+        std::array<cv::Point2f, 4> bestPredicted{};
+        for (size_t i = 0; i < m_tracks.size(); ++i) {
+            if (m_matched[i] || m_tracks[i].m_armor.m_classID != armor.m_classID) {
+                continue;
+            }
+            const std::array<cv::Point2f, 4> predicted = extrapolate(m_tracks[i], time);
+            const cv::Point2f center = (predicted[0] + predicted[1] + predicted[2] + predicted[3]) * 0.25f;
+            const float distance = static_cast<float>(cv::norm(center - armor.m_centerUV));
+            if (distance < bestDistance && distance < gate(armor)) {
+                best = static_cast<int>(i);
+                bestDistance = distance;
+                bestPredicted = predicted;
+            }
+        }
+
+        Track track;
+        track.m_armor = armor;
+        track.m_time = time;
+        track.m_observations = 1;
+        if (best >= 0) {
+            m_matched[best] = true;
+            const Track &previous = m_tracks[best];
+            const std::array<cv::Point2f, 4> observed = corners(armor), last = corners(previous.m_armor);
+            const double dt = seconds(previous.m_time, time);
+            const float alpha = m_config.m_smoothing;
+            for (int j = 0; j < 4; ++j) {
+                if (previous.m_observations >= 2) {
+                    residual += static_cast<float>(cv::norm(bestPredicted[j] - observed[j]));
+                    ++compared;
+                }
+                if (dt <= 0.0) {
+                    track.m_velocity[j] = previous.m_velocity[j];
+                    track.m_acceleration[j] = previous.m_acceleration[j];
+                    track.m_meanVelocity[j] = previous.m_meanVelocity[j];
+                    continue;
+                }
+                // 两次检测之间的平均速度是区间中点的速度
+                const cv::Point2f mean = (observed[j] - last[j]) * static_cast<float>(1.0 / dt);
+                track.m_meanVelocity[j] = mean;
+                if (previous.m_observations == 1) {
+                    track.m_velocity[j] = mean;
+                    continue;
+                }
+                const float span = static_cast<float>(0.5 * (dt + previous.m_interval));
+                const cv::Point2f acceleration = (mean - previous.m_meanVelocity[j]) * (1.0f / span);
+                track.m_acceleration[j] = acceleration * alpha + previous.m_acceleration[j] * (1.0f - alpha);
+                // 中点速度推到本次检测时刻，再与上次的速度按模型推到本时刻的结果平滑
+                const float fdt = static_cast<float>(dt);
+                const cv::Point2f current = m_config.m_acceleration ? mean + track.m_acceleration[j] * (0.5f * fdt) : mean;
+                const cv::Point2f carried = m_config.m_acceleration
+                                                ? previous.m_velocity[j] + previous.m_acceleration[j] * fdt
+                                                : previous.m_velocity[j];
+                track.m_velocity[j] = current * alpha + carried * (1.0f - alpha);
+            }
+            track.m_interval = dt;
+            track.m_observations = previous.m_observations + 1;
+        }
+        m_next.push_back(track);
+    }
+    m_tracks.swap(m_next);
+    return compared == 0 ? 0.0f : residual / compared;
+}
+
+void CornerTracker::predict(const TimePoint &time, const float confidenceScale,
+                            std::vector<ArmorObservation> &armors) const {
+    armors.clear();
+    for (const auto &track : m_tracks) {
+        ArmorObservation armor = track.m_armor;
+        setCorners(armor, extrapolate(track, time));
+        armor.m_confidence *= confidenceScale;
+        armor.m_timeStamp = time;
+        armors.push_back(armor);
+    }
+}
+
+bool CornerTracker::ready() const {
+    return std::all_of(m_tracks.begin(), m_tracks.end(), [](const Track &track) { return track.m_observations >= 2; });
+}
+
+void CornerTracker::setCorners(ArmorObservation &armor, const std::array<cv::Point2f, 4> &corners) {
+    armor.m_topLeft = corners[0];
+    armor.m_bottomLeft = corners[1];
+    armor.m_bottomRight = corners[2];
+    armor.m_topRight = corners[3];
+    armor.m_centerLeft = (armor.m_topLeft + armor.m_bottomLeft) * 0.5f;
+    armor.m_centerRight = (armor.m_topRight + armor.m_bottomRight) * 0.5f;
+    armor.m_centerUV = (armor.m_centerLeft + armor.m_centerRight) * 0.5f;
+    armor.m_height = std::min(cv::norm(armor.m_topLeft - armor.m_bottomLeft), cv::norm(armor.m_topRight - armor.m_bottomRight));
+    armor.m_width = cv::norm(armor.m_centerLeft - armor.m_centerRight);
+}
+
+// 左上、左下、右下、右上，与关键点顺序一致
+std::array<cv::Point2f, 4> CornerTracker::corners(const ArmorObservation &armor) {
+    return {armor.m_topLeft, armor.m_bottomLeft, armor.m_bottomRight, armor.m_topRight};
+}
+
+std::array<cv::Point2f, 4> CornerTracker::extrapolate(const Track &track, const TimePoint &time) const {
+    std::array<cv::Point2f, 4> result = corners(track.m_armor);
+    const float dt = static_cast<float>(seconds(track.m_time, time));
+    const float half = m_config.m_acceleration ? 0.5f * dt * dt : 0.0f;
+    for (int j = 0; j < 4; ++j) {
+        result[j] += track.m_velocity[j] * dt + track.m_acceleration[j] * half;
+    }
+    return result;
+}
+
+}  // namespace hitcrt
@@ -0,0 +1,95 @@
+/**
+ * @file CornerTracker.h
+ * @brief 装甲板角点的图像空间跟踪：两次推理之间按匀加速模型外推四个角点
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+
+#pragma once
+
+#include <array>
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+#include "ArmorBase.h"
+
+namespace hitcrt {
+
+/**
+ * @brief 跳帧跟踪的参数
+ */
+struct TrackerConfig {
+    int m_maxSkip = 2;               // 两次推理之间最多跳过的帧数，2时有效检测帧率为推理帧率的3倍；0为每帧推理
+    double m_maxGapSeconds = 0.05;   // 距上次推理超过这个时间必须推理，帧率低时不长时间外推
+    float m_confidenceDecay = 0.85f; // 每跳过一帧，输出的置信度乘以这个系数
+    float m_minConfidence = 0.5f;    // 外推结果的置信度低于此值时推理
+    float m_maxResidual = 2.0f;      // 推理帧上外推角点与检测角点的平均偏差超过此值（像素）时，下一帧继续推理
+    bool m_acceleration = true;      // 匀加速模型；关闭时为匀速模型
+    float m_smoothing = 0.6f;        // 速度、加速度的指数平滑系数，取新估计的权重
+    bool m_opticalFlow = false;      // 跳帧时用稀疏光流修正外推的角点
+    float m_maxFlowError = 1.0f;     // 光流前后向误差上限（像素），超过时本帧改为推理
+};
+
+/**
+ * @brief 按类别和中心距离关联相邻两次推理的装甲板，每个装甲板的四个角点各自维护速度和加速度
+ *
+ * 目标平移时四个角点速度相同；小陀螺旋转时左右两边的角点速度不同、随时间变化，用各角点独立的匀加速模型近似。
+ * 轨迹只在推理帧用检测结果修正，推理帧没有关联上的轨迹直接删除：出现和消失都以网络结果为准。
+ */
+class CornerTracker {
+   public:
+    explicit CornerTracker(const TrackerConfig &config = TrackerConfig()) : m_config(config) {}
+
+    /**
+     * @brief 推理帧：用检测结果修正轨迹
+     * @param[in] armors    本帧检测结果，原图坐标
+     * @param[in] time      本帧抓图时间
+     * @return float        修正前外推角点与关联上的检测角点的平均偏差，像素；没有可比较的轨迹时为0
+     */
+    float correct(const std::vector<ArmorObservation> &armors, const TimePoint &time);
+
+    /**
+     * @brief 外推到time，按轨迹顺序写出四个角点更新后的装甲板，其余字段取最近一次检测结果
+     * @param[in] confidenceScale   置信度乘以这个系数
+     */
+    void predict(const TimePoint &time, const float confidenceScale, std::vector<ArmorObservation> &armors) const;
+
+    // 所有轨迹都至少有两次观测，可以外推
+    bool ready() const;
+    bool empty() const { return m_tracks.empty(); }
+    size_t size() const { return m_tracks.size(); }
+    void reset() { m_tracks.clear(); }
+    const TrackerConfig &config() const { return m_config; }
+
+    // 按角点重新计算中心、宽高等几何字段，与ArmorDetectorNN::decode一致
+    static void setCorners(ArmorObservation &armor, const std::array<cv::Point2f, 4> &corners);
+    static std::array<cv::Point2f, 4> corners(const ArmorObservation &armor);
+
+   private:
+    struct Track {
+        ArmorObservation m_armor;  // 最近一次检测结果
+        TimePoint m_time;          // 最近一次检测的时间
+        std::array<cv::Point2f, 4> m_velocity{};      // 像素/秒
+        std::array<cv::Point2f, 4> m_acceleration{};  // 像素/秒^2
+        std::array<cv::Point2f, 4> m_meanVelocity{};  // 最近两次检测之间的平均速度
+        double m_interval = 0.0;                      // 最近两次检测的间隔，秒
+        int m_observations = 0;
+    };
+
+    std::array<cv::Point2f, 4> extrapolate(const Track &track, const TimePoint &time) const;
+
+    TrackerConfig m_config;
+    std::vector<Track> m_tracks;
+    std::vector<Track> m_next;      // correct的输出缓冲，跨帧复用
+    std::vector<bool> m_matched;
+};
+
+}  // namespace hitcrt
@@ -0,0 +1,217 @@
+/**
+ * @file InferencePool.cpp
+ * @brief 多个模型副本并行推理
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include "InferencePool.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace hitcrt {
+
+InferencePool::InferencePool(std::unique_ptr<deploy::PoseModel> model, const float confThres, const int numWorkers,
+                             const size_t capacity, const DropPolicy policy)
+    : m_capacity(std::max<size_t>(capacity, 1)), m_policy(policy) {
+    const int count = std::max(1, numWorkers);
+    // 先克隆再转移原模型的所有权
+    std::vector<std::unique_ptr<deploy::PoseModel>> models;
+    for (int i = 1; i < count; ++i) {
+        models.push_back(model->clone());
+    }
+    models.insert(models.begin(), std::move(model));
+
+    for (auto &replica : models) {
+        auto worker = std::make_unique<Worker>();
+        worker->m_detector = std::make_unique<ArmorDetectorNN>(std::move(replica), confThres);
+        m_workers.push_back(std::move(worker));
+    }
+    for (int i = 0; i < count; ++i) {
+        m_workers[i]->m_thread = std::thread(&InferencePool::run, this, i);
+    }
+}
+
+InferencePool::~InferencePool() { stop(); }
+
+void InferencePool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_workCond.notify_all();
+    m_spaceCond.notify_all();
+    for (auto &worker : m_workers) {
+        if (worker->m_thread.joinable()) {
+            worker->m_thread.join();
+        }
+    }
+}
+
+InferencePoolStats InferencePool::stats() const {
+    InferencePoolStats stats;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        stats.m_submitted = m_sequence;
+        stats.m_dropped = m_dropped;
+    }
+    for (const auto &worker : m_workers) {
+        const uint64_t completed = worker->m_completed.load(std::memory_order_relaxed);
+        stats.m_perWorker.push_back(completed);
+        stats.m_completed += completed;
+        stats.m_stolen += worker->m_stolen.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+size_t InferencePool::queued() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queued;
+}
+
+std::future<InferenceResult> InferencePool::dropped(const Frame &frame) {
+    std::promise<InferenceResult> promise;
+    InferenceResult result;
+    result.m_dropped = true;
+    result.m_timeStamp = frame.timeStamp();
+    promise.set_value(std::move(result));
+    return promise.get_future();
+}
+
+std::future<InferenceResult> InferencePool::submit(const Frame &frame, const RecvInfoBase &recvInfo) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ++m_sequence;
+    if (!m_stop && m_queued >= m_capacity) {
+        switch (m_policy) {
+            case DropPolicy::BLOCK:
+                m_spaceCond.wait(lock, [this] { return m_queued < m_capacity || m_stop; });
+                break;
+            case DropPolicy::DROP_OLDEST:
+                // 队首可能刚被工作线程取走、计数还没减，此时找不到就暂时超出一帧
+                dropOldest();
+                break;
+            case DropPolicy::SKIP:
+                ++m_dropped;
+                return dropped(frame);
+        }
+    }
+    if (m_stop) {
+        ++m_dropped;
+        return dropped(frame);
+    }
+
+    Worker &worker = *m_workers[m_next];
+    m_next = (m_next + 1) % m_workers.size();
+    std::future<InferenceResult> future;
+    {
+        std::lock_guard<std::mutex> queueLock(worker.m_mutex);
+        worker.m_queue.emplace_back(frame, recvInfo, m_sequence);
+        future = worker.m_queue.back().m_promise.get_future();
+    }
+    ++m_queued;
+    lock.unlock();
+    m_workCond.notify_one();
+    return future;
+}
+
+bool InferencePool::dropOldest() {
+    Worker *oldest = nullptr;
+    uint64_t sequence = 0;
+    for (auto &worker : m_workers) {
+        std::lock_guard<std::mutex> queueLock(worker->m_mutex);
+        if (!worker->m_queue.empty() && (oldest == nullptr || worker->m_queue.front().m_sequence < sequence)) {
+            oldest = worker.get();
+            sequence = worker->m_queue.front().m_sequence;
+        }
+    }
+    if (oldest == nullptr) {
+        return false;
+    }
+
+    std::optional<Task> task;
+    {
+        std::lock_guard<std::mutex> queueLock(oldest->m_mutex);
+        // 两次加锁之间队首可能被取走
+        if (oldest->m_queue.empty() || oldest->m_queue.front().m_sequence != sequence) {
+            return false;
+        }
+        task.emplace(std::move(oldest->m_queue.front()));
+        oldest->m_queue.pop_front();
+    }
+    --m_queued;
+    ++m_dropped;
+    InferenceResult result;
+    result.m_dropped = true;
+    result.m_timeStamp = task->m_frame.timeStamp();
+    task->m_promise.set_value(std::move(result));
+    return true;
+}
+
+bool InferencePool::pop(const int index, std::optional<Task> &task) {
+    const int count = static_cast<int>(m_workers.size());
+    for (int offset = 0; offset < count; ++offset) {
+        Worker &victim = *m_workers[(index + offset) % count];
+        std::lock_guard<std::mutex> queueLock(victim.m_mutex);
+        if (victim.m_queue.empty()) {
+            continue;
+        }
+        // 窃取也取队首：队首是等得最久的帧，被窃取的线程正忙，留给它只会更晚
+        task.emplace(std::move(victim.m_queue.front()));
+        victim.m_queue.pop_front();
+        if (offset != 0) {
+            m_workers[index]->m_stolen.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+    return false;
+}
+
+void InferencePool::run(const int index) {
+    Worker &self = *m_workers[index];
+    std::optional<Task> task;
+    while (true) {
+        if (!pop(index, task)) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workCond.wait(lock, [this] { return m_queued > 0 || m_stop; });
+            if (m_queued == 0 && m_stop) {
+                return;
+            }
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_queued;
+        }
+        m_spaceCond.notify_one();
+
+        process(self, *task);
+        task.reset();
+    }
+}
+
+void InferencePool::process(Worker &worker, Task &task) {
+    InferenceResult result;
+    result.m_timeStamp = task.m_frame.timeStamp();
+    try {
+        worker.m_detector->infer(task.m_frame, worker.m_result);
+        result.m_detected = worker.m_detector->decode(worker.m_result, task.m_frame, task.m_recvInfo, result.m_armors);
+    } catch (const std::exception &e) {
+        std::cerr << "InferencePool: " << e.what() << std::endl;
+        worker.m_completed.fetch_add(1, std::memory_order_relaxed);
+        task.m_promise.set_exception(std::current_exception());
+        return;
+    }
+    // 先计数再写回，future就绪时统计已包含这一帧
+    worker.m_completed.fetch_add(1, std::memory_order_relaxed);
+    task.m_promise.set_value(std::move(result));
+}
+
+}  // namespace hitcrt
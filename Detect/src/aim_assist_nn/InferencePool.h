@@ -0,0 +1,146 @@
+/**
+ * @file InferencePool.h
+ * @brief 多个模型副本并行推理：每个工作线程独占一个克隆的模型，空闲线程从其他线程的队列中窃取任务
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "ArmorDetectorNN.h"
+#include "StagePipeline.h"
+
+namespace hitcrt {
+
+/**
+ * @brief 一帧的推理结果
+ */
+struct InferenceResult {
+    bool m_detected = false;  // 是否检测到敌方装甲板
+    bool m_dropped = false;   // 因队列满或已停止被丢弃，没有推理
+    TimePoint m_timeStamp;    // 帧的抓图时间
+    std::vector<ArmorObservation> m_armors;
+};
+
+/**
+ * @brief 推理池统计
+ */
+struct InferencePoolStats {
+    uint64_t m_submitted = 0;  // 提交的帧数
+    uint64_t m_completed = 0;  // 推理完成的帧数
+    uint64_t m_dropped = 0;    // 被丢弃的帧数
+    uint64_t m_stolen = 0;     // 从其他线程队列窃取执行的帧数
+    std::vector<uint64_t> m_perWorker;  // 每个工作线程完成的帧数
+};
+
+/**
+ * @brief 推理池
+ *
+ * 持有K个模型副本（第一个是传入的模型，其余由clone()得到，TensorRT下各有独立的执行上下文、CUDA流和CUDA Graph），
+ * 每个副本固定由一个工作线程使用。submit()按轮转放入某个线程的队列并返回future；
+ * 线程自己的队列空了就从其他线程队列的队首窃取，慢的副本不会让帧积压。
+ * 多帧同时在途时，不同副本的拷贝、推理和回传在各自的流上重叠。
+ * OpenCV DNN后端的副本共用进程级线程池，推理池不修改线程数：K个副本同时推理时，由应用在创建推理池前
+ * 调用cv::setNumThreads按副本数分配核心（例如核心数除以K），否则每个副本都按全部核心并行，会超额订阅。
+ *
+ * 所有队列中未开始推理的帧总数不超过capacity，满了按DropPolicy处理：
+ * BLOCK阻塞submit，DROP_OLDEST丢掉最早提交的一帧，SKIP丢掉新提交的这一帧。被丢弃的帧的future返回m_dropped。
+ */
+class InferencePool {
+   public:
+    /**
+     * @param[in] model         模型，作为第一个副本，其余副本由它克隆
+     * @param[in] confThres     置信度阈值
+     * @param[in] numWorkers    模型副本数（工作线程数）
+     * @param[in] capacity      排队帧数上限
+     * @param[in] policy        队列满时的处理策略
+     */
+    InferencePool(std::unique_ptr<deploy::PoseModel> model, const float confThres, const int numWorkers,
+                  const size_t capacity, const DropPolicy policy = DropPolicy::BLOCK);
+    ~InferencePool();
+
+    InferencePool(const InferencePool &) = delete;
+    InferencePool &operator=(const InferencePool &) = delete;
+
+    /**
+     * @brief 提交一帧
+     * @param[in] frame     帧，推理完成前图像内存必须有效
+     * @param[in] recvInfo  下位机信息，用于按敌方颜色筛选
+     * @return 这一帧的结果
+     */
+    std::future<InferenceResult> submit(const Frame &frame, const RecvInfoBase &recvInfo);
+
+    // 不再接受新帧，等已排队的帧推理完后退出工作线程
+    void stop();
+
+    InferencePoolStats stats() const;
+    int numWorkers() const { return static_cast<int>(m_workers.size()); }
+    // 排队中（未开始推理）的帧数
+    size_t queued() const;
+
+   private:
+    struct Task {
+        Task(const Frame &frame, const RecvInfoBase &recvInfo, const uint64_t sequence)
+            : m_frame(frame), m_recvInfo(recvInfo), m_sequence(sequence) {}
+
+        Frame m_frame;
+        RecvInfoBase m_recvInfo;
+        uint64_t m_sequence;  // 提交序号，DROP_OLDEST时按它找最早的帧
+        std::promise<InferenceResult> m_promise;
+    };
+
+    /**
+     * @brief 工作线程，独占一个检测器
+     */
+    struct Worker {
+        std::unique_ptr<ArmorDetectorNN> m_detector;
+        deploy::PoseResView m_result;  // 跨帧复用
+        std::mutex m_mutex;            // 保护m_queue
+        std::deque<Task> m_queue;
+        std::atomic<uint64_t> m_completed{0};
+        std::atomic<uint64_t> m_stolen{0};
+        std::thread m_thread;
+    };
+
+    void run(const int index);
+    // 先取自己队列的队首，没有再依次从其他队列的队首窃取
+    bool pop(const int index, std::optional<Task> &task);
+    // 调用时持有m_mutex，从所有队列中移除最早提交的一帧
+    bool dropOldest();
+    void process(Worker &worker, Task &task);
+    static std::future<InferenceResult> dropped(const Frame &frame);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    const size_t m_capacity;
+    const DropPolicy m_policy;
+
+    mutable std::mutex m_mutex;           // 保护以下状态，加锁顺序为m_mutex在前、队列锁在后
+    std::condition_variable m_workCond;   // 有新帧或停止
+    std::condition_variable m_spaceCond;  // 有空位或停止
+    size_t m_queued = 0;
+    size_t m_next = 0;  // 轮转分配的下一个工作线程
+    uint64_t m_sequence = 0;
+    uint64_t m_dropped = 0;
+    bool m_stop = false;
+};
+
+}  // namespace hitcrt
@@ -0,0 +1,109 @@
+/**
+ * @file RoiScheduler.cpp
+ * @brief ROI推理窗口调度
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include "RoiScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace hitcrt {
+
+namespace {
+// 向下取偶数
+int evenFloor(const int value) { return value & ~1; }
+
+// 向上取偶数
+int evenCeil(const int value) { return (value + 1) & ~1; }
+}  // namespace
+
+cv::Rect2i RoiScheduler::window(const cv::Size &frameSize, const cv::Rect2i &hint) {
+    const cv::Rect2i full(0, 0, frameSize.width, frameSize.height);
+    const bool haveTarget = hint.area() > 0 || m_tracking;
+    const bool sweep = !m_config.m_enable || m_config.m_sweepInterval <= 1 || !haveTarget ||
+                       m_sinceSweep + 1 >= m_config.m_sweepInterval;
+
+    m_window = full;
+    if (!sweep) {
+        const cv::Rect2i roi = expand(hint.area() > 0 ? hint : m_target, frameSize);
+        if (roi.width < frameSize.width || roi.height < frameSize.height) {
+            m_window = roi;
+        }
+    }
+    m_fullFrame = m_window == full;
+    if (m_fullFrame) {
+        m_sinceSweep = 0;
+        ++m_stats.m_fullFrames;
+    } else {
+        ++m_sinceSweep;
+        ++m_stats.m_roiFrames;
+    }
+    return m_window;
+}
+
+void RoiScheduler::update(const std::vector<ArmorObservation> &armors) {
+    if (armors.empty()) {
+        // 全图没有检测到不代表目标消失，可能只是缩小后太小
+        if (!m_fullFrame && m_tracking && ++m_missed >= m_config.m_lostFrames) {
+            m_tracking = false;
+            ++m_stats.m_lost;
+        }
+        return;
+    }
+    float left = armors.front().m_topLeft.x, top = armors.front().m_topLeft.y;
+    float right = left, bottom = top;
+    for (const auto &armor : armors) {
+        for (const auto &corner : {armor.m_topLeft, armor.m_topRight, armor.m_bottomRight, armor.m_bottomLeft}) {
+            left = std::min(left, corner.x);
+            top = std::min(top, corner.y);
+            right = std::max(right, corner.x);
+            bottom = std::max(bottom, corner.y);
+        }
+    }
+    const cv::Rect2i detected(static_cast<int>(std::floor(left)), static_cast<int>(std::floor(top)),
+                              static_cast<int>(std::ceil(right - left)) + 1, static_cast<int>(std::ceil(bottom - top)) + 1);
+    // 窗口帧只看得到窗口内，窗口外原来跟踪的目标已经不在窗口覆盖的区域里；全图帧的结果合并上一次的目标
+    m_target = m_fullFrame && m_tracking ? (m_target | detected) : detected;
+    m_tracking = true;
+    m_missed = 0;
+}
+
+void RoiScheduler::reset() {
+    m_stats = RoiStats();
+    m_target = cv::Rect2i();
+    m_tracking = false;
+    m_missed = 0;
+    m_sinceSweep = 0;
+    m_fullFrame = true;
+    m_window = cv::Rect2i();
+}
+
+/**
+ * @brief 目标外接矩形按中心放大，不小于最小尺寸，再平移到图内，超出图的部分裁掉
+ */
+cv::Rect2i RoiScheduler::expand(const cv::Rect2i &target, const cv::Size &frameSize) const {
+    const int width = std::min(
+        evenCeil(std::max({static_cast<int>(std::ceil(target.width * m_config.m_expand)),
+                           target.width + 2 * m_config.m_margin, m_config.m_minWidth})),
+        evenFloor(frameSize.width));
+    const int height = std::min(
+        evenCeil(std::max({static_cast<int>(std::ceil(target.height * m_config.m_expand)),
+                           target.height + 2 * m_config.m_margin, m_config.m_minHeight})),
+        evenFloor(frameSize.height));
+    const int centerX = target.x + target.width / 2, centerY = target.y + target.height / 2;
+    const int x = evenFloor(std::clamp(centerX - width / 2, 0, frameSize.width - width));
+    const int y = evenFloor(std::clamp(centerY - height / 2, 0, frameSize.height - height));
+    return cv::Rect2i(x, y, width, height);
+}
+
+}  // namespace hitcrt
@@ -0,0 +1,101 @@
+/**
+ * @file RoiScheduler.h
+ * @brief ROI推理窗口调度：锁定目标时只推理目标附近的窗口，定期或丢失目标时全图推理
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+#include "ArmorBase.h"
+
+namespace hitcrt {
+
+/**
+ * @brief ROI推理的参数，像素单位都是原图像素
+ */
+struct RoiConfig {
+    bool m_enable = false;     // 关闭时每帧都推理全图
+    int m_sweepInterval = 10;  // 每隔多少帧全图推理一次，发现新进入视野的目标；不大于1时每帧全图
+    int m_lostFrames = 2;      // 窗口内连续多少帧没有目标算作丢失，下一帧全图
+    float m_expand = 3.0f;     // 窗口相对目标外接矩形的放大倍数，留出两帧之间的运动余量
+    int m_margin = 48;         // 窗口每边至少比目标外接矩形多出的像素
+    int m_minWidth = 640;      // 窗口最小尺寸，取网络输入尺寸时窗口内按原分辨率推理，不缩小
+    int m_minHeight = 640;
+};
+
+/**
+ * @brief ROI调度统计
+ */
+struct RoiStats {
+    uint64_t m_fullFrames = 0;  // 全图推理的帧数
+    uint64_t m_roiFrames = 0;   // 窗口推理的帧数
+    uint64_t m_lost = 0;        // 窗口内丢失目标回到全图的次数
+};
+
+/**
+ * @brief ROI推理窗口调度
+ *
+ * 每帧先用window()取本帧推理的窗口，推理、解码后用update()交回本帧原图坐标下的检测结果。
+ * 有目标时窗口是目标（或调用方预测的区域）外接矩形按m_expand放大、不小于最小尺寸、平移到图内的矩形；
+ * 没有目标、距上次全图已满m_sweepInterval帧、或者窗口覆盖了整幅图时推理全图。
+ * 全图帧没有检测到已跟踪的目标不算丢失：远处的小目标缩小到网络输入后可能检测不到，而在窗口内按原分辨率能检测到，
+ * 只有窗口帧连续m_lostFrames帧没有目标才放弃跟踪。
+ * 窗口的左上角和宽高都取偶数，Bayer原图裁剪后仍是BG排列。
+ */
+class RoiScheduler {
+   public:
+    explicit RoiScheduler(const RoiConfig &config = RoiConfig()) : m_config(config) {}
+
+    /**
+     * @brief 本帧推理的窗口
+     * @param[in] frameSize     原图尺寸
+     * @param[in] hint          调用方预测的目标区域，为空时用上一次检测到的目标
+     * @return cv::Rect2i       推理的窗口，全图时为(0, 0, 宽, 高)
+     */
+    cv::Rect2i window(const cv::Size &frameSize, const cv::Rect2i &hint = cv::Rect2i());
+
+    /**
+     * @brief 交回本帧的检测结果，更新跟踪的目标区域
+     * @param[in] armors    本帧在window()窗口内检测到的目标，原图坐标
+     */
+    void update(const std::vector<ArmorObservation> &armors);
+
+    void reset();
+    void setConfig(const RoiConfig &config) {
+        m_config = config;
+        reset();
+    }
+
+    const RoiConfig &config() const { return m_config; }
+    const RoiStats &stats() const { return m_stats; }
+    bool tracking() const { return m_tracking; }
+    bool fullFrame() const { return m_fullFrame; }  // 最近一次window()是否为全图
+    const cv::Rect2i &lastWindow() const { return m_window; }
+
+   private:
+    cv::Rect2i expand(const cv::Rect2i &target, const cv::Size &frameSize) const;
+
+    RoiConfig m_config;
+    RoiStats m_stats;
+    cv::Rect2i m_target;      // 跟踪的目标外接矩形，原图坐标
+    bool m_tracking = false;  // m_target是否有效
+    int m_missed = 0;         // 窗口帧连续没有目标的帧数
+    int m_sinceSweep = 0;     // 距上次全图的帧数
+    bool m_fullFrame = true;
+    cv::Rect2i m_window;
+};
+
+}  // namespace hitcrt
@@ -0,0 +1,158 @@
+/**
+ * @file TrackingDetector.cpp
+ * @brief 跳帧检测
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include "TrackingDetector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+#include "Trace.h"
+
+namespace hitcrt {
+
+TrackingDetector::TrackingDetector(std::shared_ptr<ArmorDetectorNN> detector, const TrackerConfig &config)
+    : m_detector(std::move(detector)), m_config(config), m_tracker(config) {
+    if (!m_detector) {
+        throw std::invalid_argument("TrackingDetector: detector is null");
+    }
+}
+
+bool TrackingDetector::apply(const Frame &frame, const RecvInfoBase &recvInfo, const ROI &roi,
+                             std::vector<Armor> &armors) {
+    ++m_stats.m_frames;
+    const TimePoint time = frame.timeStamp();
+    if (m_config.m_opticalFlow) {
+        keepGray(frame.image());
+    }
+
+    // 按计划本帧可以跳过，但上次推理时外推偏差过大
+    const bool scheduled = needInference(time);
+    const bool forced = !scheduled && m_residual > m_config.m_maxResidual;
+    if (!scheduled && !forced) {
+        HITCRT_TRACE_SCOPE("track");
+        m_tracker.predict(time, std::pow(m_config.m_confidenceDecay, static_cast<float>(m_skipped + 1)), m_predicted);
+        if (!m_config.m_opticalFlow || refine()) {
+            armors.clear();
+            for (const auto &observation : m_predicted) {
+                armors.emplace_back(observation);
+            }
+            m_previousOutput.swap(m_predicted);
+            if (m_config.m_opticalFlow) {
+                std::swap(m_gray, m_previousGray);
+            }
+            ++m_skipped;
+            ++m_stats.m_predicted;
+            m_lastInferred = false;
+            return !armors.empty();
+        }
+        ++m_stats.m_flowForced;
+    } else if (forced) {
+        ++m_stats.m_residualForced;
+    }
+
+    const bool found = m_detector->apply(frame, recvInfo, roi, armors);
+    m_observations.assign(armors.begin(), armors.end());
+    m_residual = m_tracker.correct(m_observations, time);
+    m_previousOutput.swap(m_observations);
+    if (m_config.m_opticalFlow) {
+        std::swap(m_gray, m_previousGray);
+    }
+    m_skipped = 0;
+    m_lastInference = time;
+    ++m_stats.m_inferred;
+    m_lastInferred = true;
+    return found;
+}
+
+void TrackingDetector::reset() {
+    m_tracker.reset();
+    m_stats = TrackerStats();
+    m_skipped = 0;
+    m_lastInference = TimePoint();
+    m_residual = 0.0f;
+    m_lastInferred = false;
+    m_previousOutput.clear();
+    m_previousGray.release();
+}
+
+bool TrackingDetector::needInference(const TimePoint &time) const {
+    if (m_config.m_maxSkip <= 0 || m_skipped >= m_config.m_maxSkip || m_tracker.empty() || !m_tracker.ready() ||
+        std::chrono::duration<double>(time - m_lastInference).count() > m_config.m_maxGapSeconds) {
+        return true;
+    }
+    // 上一帧输出的置信度已经按跳过的帧数衰减，再跳一帧乘一次系数
+    return std::any_of(m_previousOutput.begin(), m_previousOutput.end(), [this](const ArmorObservation &armor) {
+        return armor.m_confidence * m_config.m_confidenceDecay < m_config.m_minConfidence;
+    });
+}
+
+/**
+ * @brief 从上一帧输出的角点跟踪到本帧，前后向检查后替换外推的角点
+ *
+ * 上一帧输出和外推结果都按轨迹顺序排列，逐个对应。
+ */
+bool TrackingDetector::refine() {
+    if (m_previousGray.empty() || m_previousGray.size() != m_gray.size() ||
+        m_previousOutput.size() != m_predicted.size()) {
+        return false;
+    }
+    m_points.clear();
+    for (const auto &armor : m_previousOutput) {
+        for (const auto &corner : CornerTracker::corners(armor)) {
+            m_points.push_back(corner);
+        }
+    }
+    cv::calcOpticalFlowPyrLK(m_previousGray, m_gray, m_points, m_flowed, m_status, m_errors);
+    cv::calcOpticalFlowPyrLK(m_gray, m_previousGray, m_flowed, m_backward, m_backStatus, m_errors);
+    if (m_status.size() != m_points.size() || m_backStatus.size() != m_points.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < m_points.size(); ++i) {
+        if (!m_status[i] || !m_backStatus[i] || cv::norm(m_backward[i] - m_points[i]) > m_config.m_maxFlowError) {
+            return false;
+        }
+    }
+
+    for (size_t k = 0; k < m_predicted.size(); ++k) {
+        const std::array<cv::Point2f, 4> predicted = CornerTracker::corners(m_predicted[k]);
+        std::array<cv::Point2f, 4> flowed{};
+        float distance = 0.0f;
+        for (int j = 0; j < 4; ++j) {
+            flowed[j] = m_flowed[k * 4 + j];
+            distance += static_cast<float>(cv::norm(flowed[j] - predicted[j]));
+        }
+        // 光流与运动模型差得多时两者都不可信
+        if (distance / 4 > m_config.m_maxResidual) {
+            return false;
+        }
+        CornerTracker::setCorners(m_predicted[k], flowed);
+    }
+    return true;
+}
+
+// 单通道按BayerBG原图处理，与ArmorDetectorNN一致
+void TrackingDetector::keepGray(const cv::Mat &image) {
+    HITCRT_TRACE_SCOPE("gray");
+    if (image.channels() == 1) {
+        cv::cvtColor(image, m_gray, cv::COLOR_BayerBG2GRAY);
+    } else if (image.channels() == 4) {
+        cv::cvtColor(image, m_gray, cv::COLOR_BGRA2GRAY);
+    } else {
+        cv::cvtColor(image, m_gray, cv::COLOR_BGR2GRAY);
+    }
+}
+
+}  // namespace hitcrt
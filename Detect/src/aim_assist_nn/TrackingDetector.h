@@ -0,0 +1,89 @@
+/**
+ * @file TrackingDetector.h
+ * @brief 跳帧检测：网络隔帧推理，跳过的帧由角点跟踪外推（可选稀疏光流修正）给出装甲板
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ArmorDetectorNN.h"
+#include "CornerTracker.h"
+
+namespace hitcrt {
+
+/**
+ * @brief 跳帧检测统计
+ */
+struct TrackerStats {
+    uint64_t m_frames = 0;         // 处理的帧数
+    uint64_t m_inferred = 0;       // 推理的帧数
+    uint64_t m_predicted = 0;      // 由跟踪给出结果的帧数
+    uint64_t m_residualForced = 0; // 外推偏差过大而连续推理的帧数
+    uint64_t m_flowForced = 0;     // 光流失败或与外推不一致而改为推理的帧数
+
+    double effectiveRate() const { return m_inferred == 0 ? 0.0 : static_cast<double>(m_frames) / m_inferred; }
+};
+
+/**
+ * @brief 跳帧检测
+ *
+ * 每帧决定推理还是外推：没有轨迹、有新出现的装甲板（只观测过一次）、已连续跳过m_maxSkip帧、距上次推理超过m_maxGapSeconds、
+ * 外推结果的置信度（最近一次检测的置信度乘以m_confidenceDecay的跳过帧数次方）低于m_minConfidence、
+ * 或上次推理时外推偏差超过m_maxResidual时推理，否则由CornerTracker外推四个角点输出Armor。
+ * 开启光流时，跳过的帧从上一帧输出的角点计算金字塔LK光流，前后向误差过大或与外推偏差过大则改为推理本帧，
+ * 否则输出光流修正后的角点。轨迹只用推理结果修正，外推和光流不改变轨迹。
+ * 外推帧不调用检测器，ArmorDetectorNN的ROI调度不会因为这些帧推进。
+ */
+class TrackingDetector : public ArmorDetectorGeneral {
+   public:
+    explicit TrackingDetector(std::shared_ptr<ArmorDetectorNN> detector, const TrackerConfig &config = TrackerConfig());
+
+    bool apply(const Frame &frame, const RecvInfoBase &recvInfo, const ROI &roi, std::vector<Armor> &armors) override;
+
+    void reset();
+    const TrackerStats &stats() const { return m_stats; }
+    bool lastInferred() const { return m_lastInferred; }  // 最近一帧是否推理
+    float lastResidual() const { return m_residual; }     // 最近一次推理时的外推偏差，像素
+
+   private:
+    // 按跳帧计划、轨迹和置信度判断本帧是否推理，不含外推偏差
+    bool needInference(const TimePoint &time) const;
+    // 光流修正m_predicted中的角点，m_gray为本帧，失败或偏差过大时返回false
+    bool refine();
+    void keepGray(const cv::Mat &image);
+
+    std::shared_ptr<ArmorDetectorNN> m_detector;
+    TrackerConfig m_config;
+    CornerTracker m_tracker;
+    TrackerStats m_stats;
+
+    int m_skipped = 0;  // 距上次推理跳过的帧数
+    TimePoint m_lastInference;
+    float m_residual = 0.0f;
+    bool m_lastInferred = false;
+
+    // 跨帧复用
+    std::vector<ArmorObservation> m_observations;
+    std::vector<ArmorObservation> m_predicted;
+    std::vector<ArmorObservation> m_previousOutput;  // 上一帧输出，光流的起点
+    cv::Mat m_gray, m_previousGray;
+    std::vector<cv::Point2f> m_points, m_flowed, m_backward;
+    std::vector<uint8_t> m_status, m_backStatus;
+    std::vector<float> m_errors;
+};
+
+}  // namespace hitcrt
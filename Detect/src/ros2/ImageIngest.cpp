@@ -0,0 +1,186 @@
+/**
+ * @file ImageIngest.cpp
+ * @brief 图像接入节点
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>替换cv_bridge的仿真图像接入
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>收图到交给下游记录trace区间
+ * </table>
+ */
+#include "ImageIngest.h"
+
+#include <cv_bridge/cv_bridge.h>
+
+#include <iostream>
+#include <opencv2/imgproc.hpp>
+#include <sensor_msgs/image_encodings.hpp>
+
+#include "Trace.h"
+
+namespace hitcrt {
+
+namespace {
+std::atomic<FrameRing *> ingestPool{nullptr};
+}  // namespace
+
+void setIngestPool(FrameRing *ring) { ingestPool.store(ring, std::memory_order_release); }
+
+/**
+ * @brief 按编码把消息缓冲区一次转换写进dst
+ * @param[in] data      消息像素
+ * @param[in] width     宽度
+ * @param[in] height    高度
+ * @param[in] step      每行字节数
+ * @param[in] encoding  sensor_msgs编码
+ * @param[out] dst      预分配的BGR8槽位，尺寸必须一致，不会重新分配
+ * @return true
+ * @return false 编码不支持或尺寸不符
+ */
+bool convertInto(const uint8_t *data, const int width, const int height, const size_t step,
+                 const std::string &encoding, cv::Mat &dst) {
+    namespace enc = sensor_msgs::image_encodings;
+    if (dst.cols != width || dst.rows != height || dst.type() != CV_8UC3) {
+        return false;
+    }
+    uint8_t *src = const_cast<uint8_t *>(data);
+    if (encoding == enc::BGR8) {
+        cv::Mat(height, width, CV_8UC3, src, step).copyTo(dst);
+        return true;
+    }
+    // dst尺寸和类型已经对上，cvtColor直接写进槽位，读一遍写一遍
+    int code = -1;
+    int type = CV_8UC1;
+    if (encoding == enc::RGB8) {
+        code = cv::COLOR_RGB2BGR;
+        type = CV_8UC3;
+    } else if (encoding == enc::BGRA8) {
+        code = cv::COLOR_BGRA2BGR;
+        type = CV_8UC4;
+    } else if (encoding == enc::RGBA8) {
+        code = cv::COLOR_RGBA2BGR;
+        type = CV_8UC4;
+    } else if (encoding == enc::MONO8) {
+        code = cv::COLOR_GRAY2BGR;
+    } else if (encoding == enc::BAYER_RGGB8) {
+        // ROS与OpenCV的Bayer命名错开一位，与cv_bridge的对应关系一致
+        code = cv::COLOR_BayerBG2BGR;
+    } else if (encoding == enc::BAYER_BGGR8) {
+        code = cv::COLOR_BayerRG2BGR;
+    } else if (encoding == enc::BAYER_GBRG8) {
+        code = cv::COLOR_BayerGR2BGR;
+    } else if (encoding == enc::BAYER_GRBG8) {
+        code = cv::COLOR_BayerGB2BGR;
+    } else {
+        return false;
+    }
+    cv::cvtColor(cv::Mat(height, width, type, src, step), dst, code);
+    return true;
+}
+
+}  // namespace hitcrt
+
+// ============================== TypeAdapter ==============================
+void rclcpp::TypeAdapter<hitcrt::IngestImage, sensor_msgs::msg::Image>::convert_to_ros_message(
+    const custom_type &source, ros_message_type &destination) {
+    if (source.m_handle.empty()) {
+        return;
+    }
+    const cv::Mat &image = source.m_handle.image();
+    destination.header.stamp.sec = static_cast<int32_t>(source.m_rawStamp / 1000000000LL);
+    destination.header.stamp.nanosec = static_cast<uint32_t>(source.m_rawStamp % 1000000000LL);
+    destination.header.frame_id = source.m_frameId;
+    destination.height = image.rows;
+    destination.width = image.cols;
+    destination.encoding = sensor_msgs::image_encodings::BGR8;
+    destination.is_bigendian = false;
+    destination.step = static_cast<uint32_t>(image.cols * image.elemSize());
+    destination.data.resize(static_cast<size_t>(destination.step) * image.rows);
+    image.copyTo(cv::Mat(image.rows, image.cols, CV_8UC3, destination.data.data(), destination.step));
+}
+
+void rclcpp::TypeAdapter<hitcrt::IngestImage, sensor_msgs::msg::Image>::convert_to_custom(
+    const ros_message_type &source, custom_type &destination) {
+    destination.m_receiveTime = hitcrt::Clock::now();
+    destination.m_rawStamp = static_cast<int64_t>(source.header.stamp.sec) * 1000000000LL + source.header.stamp.nanosec;
+    destination.m_frameId = source.header.frame_id;
+    destination.m_fromMessage = true;
+
+    hitcrt::FrameRing *ring = hitcrt::ingestPool.load(std::memory_order_acquire);
+    if (ring == nullptr || !ring->fits(source.width, source.height, CV_8UC3)) {
+        return;
+    }
+    // 槽位全被占用说明下游太慢，留空由节点计为丢帧
+    hitcrt::FrameHandle handle = ring->acquire();
+    if (handle.empty()) {
+        return;
+    }
+    if (!hitcrt::convertInto(source.data.data(), source.width, source.height, source.step, source.encoding,
+                             handle.image())) {
+        // 少见的编码退回cv_bridge
+        try {
+            cv_bridge::toCvCopy(source, sensor_msgs::image_encodings::BGR8)->image.copyTo(handle.image());
+        } catch (const cv_bridge::Exception &e) {
+            std::cerr << "ImageIngest: " << e.what() << std::endl;
+            return;
+        }
+    }
+    destination.m_handle = std::move(handle);
+}
+
+namespace hitcrt {
+// ============================== ImageIngestNode ==============================
+/**
+ * @brief 创建订阅，并把ring设为跨进程消息的转换目标
+ * @param[in] ring      帧槽位，必须比节点活得久
+ * @param[in] sink      收到一帧时调用，在executor线程里执行
+ * @param[in] topic     图像话题
+ * @param[in] options   节点选项，默认开启intra-process
+ */
+ImageIngestNode::ImageIngestNode(FrameRing &ring, const Sink &sink, const std::string &topic,
+                                 const rclcpp::NodeOptions &options)
+    : rclcpp::Node("hitcrtImageIngest", options), m_ring(ring), m_sink(sink) {
+    setIngestPool(&m_ring);
+    // 兼容Ros2ForUnity的best effort，只留最新一帧
+    const auto qos = rclcpp::SensorDataQoS().keep_last(1);
+    m_subscription = create_subscription<AdaptedImage>(
+        topic, qos, [this](std::unique_ptr<IngestImage> image) { onImage(std::move(image)); });
+}
+
+ImageIngestNode::~ImageIngestNode() { setIngestPool(nullptr); }
+
+/**
+ * @brief 打时间戳并交给下游
+ * @param[in] image     收到的一帧
+ */
+void ImageIngestNode::onImage(std::unique_ptr<IngestImage> image) {
+    m_received.fetch_add(1, std::memory_order_relaxed);
+    if (image->m_handle.empty()) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    (image->m_fromMessage ? m_converted : m_loaned).fetch_add(1, std::memory_order_relaxed);
+
+    const TimePoint receiveTime = image->m_receiveTime == TimePoint() ? Clock::now() : image->m_receiveTime;
+    // 仿真消息的时间戳是仿真端的时钟，映射到本机时钟；没有填时间戳时用收到的时刻
+    if (image->m_rawStamp > 0) {
+        image->m_handle.commit(m_clock.update(image->m_rawStamp, receiveTime), image->m_rawStamp, receiveTime);
+    } else {
+        image->m_handle.commit(receiveTime);
+    }
+    // 从消息转换开始到交给下游，帧序号在commit时才确定
+    HITCRT_TRACE_SPAN("ingest", image->m_handle.seq(), receiveTime, Clock::now());
+    m_sink(std::move(image->m_handle));
+}
+
+ImageIngestNode::IngestStat ImageIngestNode::stat() const {
+    return std::make_tuple(m_received.load(std::memory_order_relaxed), m_loaned.load(std::memory_order_relaxed),
+                           m_converted.load(std::memory_order_relaxed), m_dropped.load(std::memory_order_relaxed));
+}
+
+}  // namespace hitcrt
@@ -0,0 +1,111 @@
+/**
+ * @file ImageIngest.h
+ * @brief 图像接入节点：TypeAdapter把sensor_msgs/Image直接转换进帧槽位，进程内借槽位发布时不拷贝
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>替换cv_bridge的仿真图像接入
+ * </table>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp/type_adapter.hpp>
+#include <sensor_msgs/msg/image.hpp>
+#include <string>
+#include <tuple>
+
+#include "ClockMapper.h"
+#include "FrameRing.h"
+
+namespace hitcrt {
+
+/**
+ * @brief 接入的一帧，像素在FrameRing的槽位里
+ *
+ * 进程内的发布者先用ImageIngestNode::loan()借一个槽位直接写像素再发布，开启intra-process时
+ * unique_ptr原样交给订阅回调，既不序列化也不拷贝；跨进程的消息由TypeAdapter一次转换写进槽位。
+ */
+struct IngestImage {
+    FrameHandle m_handle;      // 像素所在的槽位，槽位不够时为空
+    int64_t m_rawStamp = 0;    // header.stamp，ns，没有时为0
+    TimePoint m_receiveTime;   // 收到的时刻，进程内发布时可不填
+    std::string m_frameId;
+    bool m_fromMessage = false;  // 由sensor_msgs/Image转换而来
+};
+
+// 跨进程消息转换的目标槽位，ImageIngestNode构造时设置，一个进程只接一路图像
+void setIngestPool(FrameRing *ring);
+
+/**
+ * @brief 按编码把消息缓冲区一次转换写进dst，步长不等于宽度时逐行处理
+ * @return false 编码不支持或尺寸不符
+ */
+bool convertInto(const uint8_t *data, const int width, const int height, const size_t step,
+                 const std::string &encoding, cv::Mat &dst);
+
+}  // namespace hitcrt
+
+template <>
+struct rclcpp::TypeAdapter<hitcrt::IngestImage, sensor_msgs::msg::Image> {
+    using is_specialized = std::true_type;
+    using custom_type = hitcrt::IngestImage;
+    using ros_message_type = sensor_msgs::msg::Image;
+
+    // 发给跨进程订阅者（rviz、录包）时才会调用，拷贝一次
+    static void convert_to_ros_message(const custom_type &source, ros_message_type &destination);
+    // 跨进程消息反序列化之后调用，取一个槽位直接转换写入
+    static void convert_to_custom(const ros_message_type &source, custom_type &destination);
+};
+
+namespace hitcrt {
+
+using AdaptedImage = rclcpp::TypeAdapter<IngestImage, sensor_msgs::msg::Image>;
+
+/**
+ * @brief 图像接入节点，收到的帧打好时间戳后以句柄交给sink
+ *
+ * 默认开启intra-process，QoS为best effort、只保留最新一帧，与Ros2ForUnity兼容；
+ * 下游来不及处理时在源头就被新帧顶掉，不在DDS队列里积压。
+ */
+class ImageIngestNode : public rclcpp::Node {
+   public:
+    using Sink = std::function<void(FrameHandle &&)>;
+    // 收到的帧数，进程内借槽位直接收到的帧数，由消息转换的帧数，槽位不够或尺寸不符丢掉的帧数
+    using IngestStat = std::tuple<uint64_t, uint64_t, uint64_t, uint64_t>;
+
+    ImageIngestNode(FrameRing &ring, const Sink &sink, const std::string &topic = "/image_raw",
+                    const rclcpp::NodeOptions &options = rclcpp::NodeOptions().use_intra_process_comms(true));
+    ~ImageIngestNode() override;
+
+    // 进程内发布者借一个槽位，全部占用时为空
+    FrameHandle loan() { return m_ring.acquire(); }
+    IngestStat stat() const;
+
+   private:
+    void onImage(std::unique_ptr<IngestImage> image);
+
+    FrameRing &m_ring;
+    Sink m_sink;
+    camera::ClockMapper m_clock;  // 消息时间戳到本机时钟的映射，只在回调里更新
+    rclcpp::Subscription<AdaptedImage>::SharedPtr m_subscription;
+
+    std::atomic<uint64_t> m_received{0};
+    std::atomic<uint64_t> m_loaned{0};
+    std::atomic<uint64_t> m_converted{0};
+    std::atomic<uint64_t> m_dropped{0};
+};
+
+}  // namespace hitcrt
+
+RCLCPP_USING_CUSTOM_TYPE_AS_ROS_MESSAGE_TYPE(hitcrt::IngestImage, sensor_msgs::msg::Image);
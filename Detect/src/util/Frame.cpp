@@ -10,12 +10,14 @@
  * <table>
  * <tr><th>Date       <th>Author  <th>Description
  * <tr><td>2021-12-18 <td>BG2EDG  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>加入源时钟原始时间戳和收到时刻
  * </table>
  */
 #include "Frame.h"
 
 namespace hitcrt {
-Frame::Frame(const cv::Mat &img, const TimePoint &timeStamp) : m_img(img), m_timeStamp(timeStamp) {
+Frame::Frame(const cv::Mat &img, const TimePoint &timeStamp)
+    : m_img(img), m_timeStamp(timeStamp), m_rawStamp(0), m_receiveTime(timeStamp) {
     // m_img = img.clone();
     // m_timeStamp = timeStamp;
     // m_recvInfoPtr = std::make_shared<RecvInfo>(recvInfoPtr);
@@ -38,6 +40,9 @@ Frame::Frame(const cv::Mat &img, const TimePoint &timeStamp) : m_img(img), m_tim
 //     m_isUsed = frame.m_isUsed;
 // }
 
+Frame::Frame(const cv::Mat &img, const TimePoint &timeStamp, const int64_t rawStamp, const TimePoint &receiveTime)
+    : m_img(img), m_timeStamp(timeStamp), m_rawStamp(rawStamp), m_receiveTime(receiveTime) {}
+
 bool Frame::empty() const { return m_img.empty(); }
 
 bool Frame::isUsed() const { return m_isUsed; }
@@ -45,4 +50,8 @@ bool Frame::isUsed() const { return m_isUsed; }
 const cv::Mat &Frame::image() const { return m_img; }
 
 const TimePoint Frame::timeStamp() const { return m_timeStamp; }
+
+const int64_t Frame::rawStamp() const { return m_rawStamp; }
+
+const TimePoint Frame::receiveTime() const { return m_receiveTime; }
 }  // namespace hitcrt
\ No newline at end of file
@@ -10,6 +10,7 @@
  * <table>
  * <tr><th>Date       <th>Author  <th>Description
  * <tr><td>2021-12-17 <td>BG2EDG  <td>
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>加入源时钟原始时间戳和收到时刻
  * </table>
  */
 
@@ -26,6 +27,8 @@ namespace hitcrt {
 class Frame {
    public:
     Frame(const cv::Mat &img, const TimePoint &timeStamp);
+    // timeStamp为源时钟（相机硬件时钟、仿真消息时间戳）映射到本机时钟的抓图时间
+    Frame(const cv::Mat &img, const TimePoint &timeStamp, const int64_t rawStamp, const TimePoint &receiveTime);
     // void set(const cv::Mat &img, const double grab_time, const
     // std::shared_ptr<RecvInfo> &recvInfoPtr); void copy(const Frame &frame);
     bool empty() const;
@@ -35,10 +38,14 @@ class Frame {
     bool isUsed() const;
     const cv::Mat &image() const;
     const TimePoint timeStamp() const;
+    const int64_t rawStamp() const;
+    const TimePoint receiveTime() const;
 
    private:
     const cv::Mat m_img;          //原图
-    const TimePoint m_timeStamp;  //抓图时间
+    const TimePoint m_timeStamp;  //抓图时间，已映射到本机时钟
+    const int64_t m_rawStamp;     //源时钟原始时间戳，ns，没有时为0
+    const TimePoint m_receiveTime;  //本机收到的时刻
     bool m_isUsed = false;
 };
 
@@ -0,0 +1,539 @@
+/**
+ * @file FrameRecord.cpp
+ * @brief 只追加的帧录制格式
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>满帧率录制场地和仿真数据
+ * </table>
+ */
+#include "FrameRecord.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace hitcrt {
+
+namespace {
+constexpr char HEADER_MAGIC[8] = {'H', 'I', 'T', 'R', 'E', 'C', '0', '1'};
+constexpr char TRAILER_MAGIC[8] = {'H', 'I', 'T', 'I', 'D', 'X', '0', '1'};
+constexpr uint32_t META_MAGIC = 0x4d524648;  // "HFRM"
+constexpr uint32_t VERSION = 1;
+constexpr uint64_t PAGE_SIZE = FrameRing::PAGE_SIZE;
+
+// FNV-1a，只校验元数据和索引，像素不校验
+uint32_t checksum(const void *data, const size_t size) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+uint32_t metaChecksum(const RecordMeta &meta) {
+    const size_t skip = offsetof(RecordMeta, m_index);
+    return checksum(reinterpret_cast<const uint8_t *>(&meta) + skip, sizeof(RecordMeta) - skip);
+}
+
+int64_t nsOf(const TimePoint &time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+TimePoint timeOf(const int64_t ns) {
+    return TimePoint(std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(ns)));
+}
+
+uint64_t strideOf(const uint64_t frameBytes) {
+    return (frameBytes + sizeof(RecordMeta) + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+}
+
+// pwrite直到写完或出错
+bool writeAll(const int fd, const void *data, size_t size, off_t offset) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    while (size > 0) {
+        const ssize_t written = ::pwrite(fd, bytes, size, offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+        offset += written;
+    }
+    return true;
+}
+
+RecordMeta makeMeta(const uint64_t seq, const TimePoint &timeStamp, const int64_t rawStamp,
+                    const TimePoint &receiveTime, const RecvInfoBase *recvInfo, const float exposureUs) {
+    RecordMeta meta{};
+    meta.m_magic = META_MAGIC;
+    meta.m_seq = seq;
+    meta.m_timeStampNs = nsOf(timeStamp);
+    meta.m_rawStamp = rawStamp;
+    meta.m_receiveNs = nsOf(receiveTime);
+    if (recvInfo != nullptr) {
+        meta.m_pitch = recvInfo->pitch();
+        meta.m_yaw = recvInfo->yaw();
+        meta.m_roll = recvInfo->roll();
+    }
+    meta.m_exposureUs = exposureUs;
+    return meta;
+}
+}  // namespace
+
+// ============================== FrameRecorder ==============================
+/**
+ * @brief 创建录制文件并启动写线程
+ * @param[in] path          文件路径，已存在时覆盖
+ * @param[in] width         图像宽度
+ * @param[in] height        图像高度
+ * @param[in] type          图像类型，BGR8或单通道Bayer原图
+ * @param[in] queueSize     排队等待写入的最多帧数，也是内部拷贝用的槽位数
+ * @param[in] growFrames    文件空间不够时一次fallocate的帧数
+ */
+FrameRecorder::FrameRecorder(const std::string &path, const int width, const int height, const int type,
+                             const int queueSize, const int growFrames)
+    : m_path(path),
+      m_width(width),
+      m_height(height),
+      m_type(type),
+      m_queueSize(static_cast<size_t>(std::max(queueSize, 1))),
+      m_staging(std::max(queueSize, 1), width, height, type) {
+    m_frameBytes = static_cast<size_t>(width) * height * CV_ELEM_SIZE(type);
+    m_stride = strideOf(m_frameBytes);
+    m_growBytes = static_cast<uint64_t>(std::max(growFrames, 1)) * m_stride;
+
+    m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (m_fd < 0) {
+        throw std::runtime_error("FrameRecorder: open " + path + " failed: " + std::strerror(errno));
+    }
+    RecordHeader header{};
+    std::memcpy(header.m_magic, HEADER_MAGIC, sizeof(HEADER_MAGIC));
+    header.m_version = VERSION;
+    header.m_width = width;
+    header.m_height = height;
+    header.m_type = type;
+    header.m_frameBytes = m_frameBytes;
+    header.m_stride = m_stride;
+    header.m_wallStartNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    header.m_steadyStartNs = nsOf(Clock::now());
+    // 文件头独占一页，帧块从页边界开始
+    std::vector<uint8_t> page(PAGE_SIZE, 0);
+    std::memcpy(page.data(), &header, sizeof(header));
+    if (!reserve(PAGE_SIZE + m_growBytes) || !writeAll(m_fd, page.data(), page.size(), 0)) {
+        ::close(m_fd);
+        throw std::runtime_error("FrameRecorder: write header of " + path + " failed: " + std::strerror(errno));
+    }
+    m_written = PAGE_SIZE;
+    m_flushStart = PAGE_SIZE;
+    m_dropStart = 0;
+    m_index.reserve(1 << 16);
+    m_writeThread = std::thread(&FrameRecorder::writeLoop, this);
+}
+
+FrameRecorder::~FrameRecorder() { close(); }
+
+/**
+ * @brief 拷贝一帧进队列
+ * @param[in] frame         帧，尺寸和类型必须与录制文件一致
+ * @param[in] seq           序号
+ * @param[in] recvInfo      同一时刻的下位机数据，取云台角度
+ * @param[in] exposureUs    曝光时间
+ * @return true
+ * @return false 尺寸不符、队列满或已关闭，这一帧丢弃
+ */
+bool FrameRecorder::record(const Frame &frame, const uint64_t seq, const RecvInfoBase *recvInfo,
+                           const float exposureUs) {
+    const cv::Mat &image = frame.image();
+    if (!m_staging.fits(image.cols, image.rows, image.type())) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    FrameHandle handle = m_staging.acquire();
+    if (handle.empty()) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    image.copyTo(handle.image());
+    return push(std::move(handle), makeMeta(seq, frame.timeStamp(), frame.rawStamp(), frame.receiveTime(),
+                                            recvInfo, exposureUs));
+}
+
+/**
+ * @brief 持有句柄进队列，不拷贝像素
+ * @param[in] handle        已commit的句柄，尺寸和类型必须与录制文件一致
+ * @param[in] recvInfo      同一时刻的下位机数据，取云台角度
+ * @param[in] exposureUs    曝光时间
+ * @return true
+ * @return false 尺寸不符、队列满或已关闭，这一帧丢弃
+ */
+bool FrameRecorder::record(const FrameHandle &handle, const RecvInfoBase *recvInfo, const float exposureUs) {
+    if (handle.empty() || !m_staging.fits(handle.image().cols, handle.image().rows, handle.image().type())) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return push(FrameHandle(handle), makeMeta(handle.seq(), handle.timeStamp(), handle.rawStamp(),
+                                              handle.receiveTime(), recvInfo, exposureUs));
+}
+
+bool FrameRecorder::push(FrameHandle &&handle, const RecordMeta &meta) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping || m_queue.size() >= m_queueSize) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        m_queue.push_back(Pending{std::move(handle), meta});
+        m_maxQueued = std::max(m_maxQueued, m_queue.size());
+    }
+    m_cond.notify_one();
+    return true;
+}
+
+/**
+ * @brief 写完队列里的帧，写入索引和文件尾，截掉预分配的空间
+ * @return true
+ * @return false 写入出错，文件仍可用FrameRecordReader恢复
+ */
+bool FrameRecorder::close() {
+    if (m_closed) {
+        return m_closeOk;
+    }
+    m_closed = true;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_cond.notify_all();
+    if (m_writeThread.joinable()) {
+        m_writeThread.join();
+    }
+    m_closeOk = !failed() && writeIndex();
+    ::close(m_fd);
+    m_fd = -1;
+    return m_closeOk;
+}
+
+/**
+ * @brief 写线程：取出队列里的帧依次写入，停止时先写完剩下的
+ */
+void FrameRecorder::writeLoop() {
+    while (true) {
+        Pending pending;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                break;
+            }
+            pending = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        if (failed()) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (!writeFrame(pending)) {
+            std::cerr << "FrameRecorder: write " << m_path << " failed: " << std::strerror(errno) << std::endl;
+            m_failed.store(true, std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief 写一个帧块：先写像素再写元数据
+ * @param[in] pending   队列里的帧
+ * @return true
+ * @return false
+ */
+bool FrameRecorder::writeFrame(const Pending &pending) {
+    const uint64_t index = m_index.size();
+    const uint64_t offset = PAGE_SIZE + index * m_stride;
+    if (!reserve(offset + m_stride)) {
+        return false;
+    }
+    const cv::Mat &image = pending.m_handle.image();
+    if (image.isContinuous()) {
+        if (!writeAll(m_fd, image.data, m_frameBytes, static_cast<off_t>(offset))) {
+            return false;
+        }
+    } else {
+        const size_t rowBytes = m_frameBytes / m_height;
+        for (int row = 0; row < m_height; ++row) {
+            if (!writeAll(m_fd, image.ptr(row), rowBytes, static_cast<off_t>(offset + row * rowBytes))) {
+                return false;
+            }
+        }
+    }
+    RecordMeta meta = pending.m_meta;
+    meta.m_index = index;
+    meta.m_checksum = metaChecksum(meta);
+    if (!writeAll(m_fd, &meta, sizeof(meta), static_cast<off_t>(offset + m_stride - sizeof(meta)))) {
+        return false;
+    }
+    m_index.push_back(RecordIndexEntry{meta.m_timeStampNs, meta.m_seq});
+    m_recorded.fetch_add(1, std::memory_order_relaxed);
+    writeback(offset + m_stride);
+    return true;
+}
+
+/**
+ * @brief 文件空间不够end时一次预分配m_growBytes，避免每帧扩展文件的元数据更新
+ * @param[in] end   要写到的位置
+ * @return true
+ * @return false
+ */
+bool FrameRecorder::reserve(const uint64_t end) {
+    if (end <= m_allocated) {
+        return true;
+    }
+    const uint64_t target = std::max(end, m_allocated + m_growBytes);
+    // 文件系统不支持fallocate时退回posix_fallocate
+    if (::fallocate(m_fd, 0, static_cast<off_t>(m_allocated), static_cast<off_t>(target - m_allocated)) != 0 &&
+        ::posix_fallocate(m_fd, static_cast<off_t>(m_allocated), static_cast<off_t>(target - m_allocated)) != 0) {
+        return false;
+    }
+    m_allocated = target;
+    return true;
+}
+
+/**
+ * @brief 每写WRITEBACK_BYTES触发一次异步回写，并等上一段落盘后丢掉它的页缓存
+ * @param[in] end   已写到的位置
+ */
+void FrameRecorder::writeback(const uint64_t end) {
+    m_written = end;
+    if (m_written - m_flushStart < WRITEBACK_BYTES) {
+        return;
+    }
+    ::sync_file_range(m_fd, static_cast<off_t>(m_flushStart), static_cast<off_t>(m_written - m_flushStart),
+                      SYNC_FILE_RANGE_WRITE);
+    if (m_flushStart > m_dropStart) {
+        ::sync_file_range(m_fd, static_cast<off_t>(m_dropStart), static_cast<off_t>(m_flushStart - m_dropStart),
+                          SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+        ::posix_fadvise(m_fd, static_cast<off_t>(m_dropStart), static_cast<off_t>(m_flushStart - m_dropStart),
+                        POSIX_FADV_DONTNEED);
+    }
+    m_dropStart = m_flushStart;
+    m_flushStart = m_written;
+}
+
+/**
+ * @brief 在最后一帧之后写索引和文件尾，截掉多余的预分配空间
+ * @return true
+ * @return false
+ */
+bool FrameRecorder::writeIndex() {
+    const uint64_t indexOffset = PAGE_SIZE + m_index.size() * m_stride;
+    const size_t indexBytes = m_index.size() * sizeof(RecordIndexEntry);
+    RecordTrailer trailer{};
+    trailer.m_count = m_index.size();
+    trailer.m_indexOffset = indexOffset;
+    trailer.m_checksum = checksum(m_index.data(), indexBytes);
+    std::memcpy(trailer.m_magic, TRAILER_MAGIC, sizeof(TRAILER_MAGIC));
+    const uint64_t end = indexOffset + indexBytes + sizeof(trailer);
+    if (!writeAll(m_fd, m_index.data(), indexBytes, static_cast<off_t>(indexOffset)) ||
+        !writeAll(m_fd, &trailer, sizeof(trailer), static_cast<off_t>(indexOffset + indexBytes)) ||
+        ::ftruncate(m_fd, static_cast<off_t>(end)) != 0 || ::fdatasync(m_fd) != 0) {
+        std::cerr << "FrameRecorder: write index of " << m_path << " failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ============================== FrameRecordReader ==============================
+/**
+ * @brief 映射整个录制文件，有完整文件尾时直接用索引，否则扫描帧块恢复
+ * @param[in] path  文件路径
+ */
+FrameRecordReader::FrameRecordReader(const std::string &path) {
+    m_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_fd < 0) {
+        throw std::runtime_error("FrameRecordReader: open " + path + " failed: " + std::strerror(errno));
+    }
+    struct stat info;
+    if (::fstat(m_fd, &info) != 0 || static_cast<uint64_t>(info.st_size) < PAGE_SIZE) {
+        ::close(m_fd);
+        throw std::runtime_error("FrameRecordReader: " + path + " is too short");
+    }
+    m_size = static_cast<size_t>(info.st_size);
+    void *map = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, m_fd, 0);
+    if (map == MAP_FAILED) {
+        ::close(m_fd);
+        throw std::runtime_error("FrameRecordReader: mmap " + path + " failed: " + std::strerror(errno));
+    }
+    m_map = static_cast<uint8_t *>(map);
+    // 回放基本是顺序读
+    ::madvise(m_map, m_size, MADV_SEQUENTIAL);
+
+    m_header = reinterpret_cast<const RecordHeader *>(m_map);
+    if (std::memcmp(m_header->m_magic, HEADER_MAGIC, sizeof(HEADER_MAGIC)) != 0 || m_header->m_version != VERSION ||
+        m_header->m_stride != strideOf(m_header->m_frameBytes) ||
+        m_header->m_frameBytes != static_cast<uint64_t>(m_header->m_width) * m_header->m_height *
+                                      CV_ELEM_SIZE(m_header->m_type)) {
+        ::munmap(m_map, m_size);
+        ::close(m_fd);
+        throw std::runtime_error("FrameRecordReader: " + path + " is not a frame record");
+    }
+    if (!loadIndex()) {
+        scan();
+    }
+}
+
+FrameRecordReader::~FrameRecordReader() {
+    ::munmap(m_map, m_size);
+    ::close(m_fd);
+}
+
+/**
+ * @brief 读文件尾，校验通过时索引直接指向映射内存
+ * @return true
+ * @return false 没有文件尾或校验不通过
+ */
+bool FrameRecordReader::loadIndex() {
+    if (m_size < PAGE_SIZE + sizeof(RecordTrailer)) {
+        return false;
+    }
+    RecordTrailer trailer;
+    std::memcpy(&trailer, m_map + m_size - sizeof(trailer), sizeof(trailer));
+    if (std::memcmp(trailer.m_magic, TRAILER_MAGIC, sizeof(TRAILER_MAGIC)) != 0) {
+        return false;
+    }
+    const uint64_t indexBytes = trailer.m_count * sizeof(RecordIndexEntry);
+    if (trailer.m_indexOffset != PAGE_SIZE + trailer.m_count * m_header->m_stride ||
+        trailer.m_indexOffset + indexBytes + sizeof(trailer) != m_size ||
+        checksum(m_map + trailer.m_indexOffset, indexBytes) != trailer.m_checksum) {
+        return false;
+    }
+    m_index = reinterpret_cast<const RecordIndexEntry *>(m_map + trailer.m_indexOffset);
+    m_count = trailer.m_count;
+    return true;
+}
+
+/**
+ * @brief 从头扫描帧块，遇到第一个不完整或校验不通过的块停止
+ */
+void FrameRecordReader::scan() {
+    m_recovered = true;
+    const uint64_t stride = m_header->m_stride;
+    for (uint64_t index = 0; PAGE_SIZE + (index + 1) * stride <= m_size; ++index) {
+        RecordMeta meta;
+        std::memcpy(&meta, m_map + PAGE_SIZE + (index + 1) * stride - sizeof(meta), sizeof(meta));
+        if (meta.m_magic != META_MAGIC || meta.m_index != index || meta.m_checksum != metaChecksum(meta)) {
+            break;
+        }
+        m_scanned.push_back(RecordIndexEntry{meta.m_timeStampNs, meta.m_seq});
+    }
+    m_index = m_scanned.data();
+    m_count = m_scanned.size();
+    m_trailingBytes = m_size - (PAGE_SIZE + m_count * stride);
+}
+
+/**
+ * @brief 给没有文件尾的文件补上索引和文件尾
+ * @param[in] path  文件路径
+ * @return int64_t 保留的帧数，失败为-1
+ */
+int64_t FrameRecordReader::repair(const std::string &path) {
+    std::vector<RecordIndexEntry> index;
+    try {
+        const FrameRecordReader reader(path);
+        if (!reader.recovered()) {
+            return static_cast<int64_t>(reader.count());
+        }
+        index = reader.m_scanned;
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+    const int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    RecordHeader header;
+    bool ok = ::pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+    const uint64_t indexOffset = PAGE_SIZE + index.size() * header.m_stride;
+    const size_t indexBytes = index.size() * sizeof(RecordIndexEntry);
+    RecordTrailer trailer{};
+    trailer.m_count = index.size();
+    trailer.m_indexOffset = indexOffset;
+    trailer.m_checksum = checksum(index.data(), indexBytes);
+    std::memcpy(trailer.m_magic, TRAILER_MAGIC, sizeof(TRAILER_MAGIC));
+    // 先截掉不完整的帧再追加，索引不会和残留数据混在一起
+    ok = ok && ::ftruncate(fd, static_cast<off_t>(indexOffset)) == 0 &&
+         writeAll(fd, index.data(), indexBytes, static_cast<off_t>(indexOffset)) &&
+         writeAll(fd, &trailer, sizeof(trailer), static_cast<off_t>(indexOffset + indexBytes)) && ::fsync(fd) == 0;
+    ::close(fd);
+    return ok ? static_cast<int64_t>(index.size()) : -1;
+}
+
+const uint8_t *FrameRecordReader::chunk(const size_t index) const { return m_map + PAGE_SIZE + index * m_header->m_stride; }
+
+/**
+ * @brief 第index帧的元数据
+ */
+const RecordMeta &FrameRecordReader::meta(const size_t index) const {
+    return *reinterpret_cast<const RecordMeta *>(chunk(index) + m_header->m_stride - sizeof(RecordMeta));
+}
+
+/**
+ * @brief 第index帧的图像，直接指向映射内存，只读
+ */
+cv::Mat FrameRecordReader::image(const size_t index) const {
+    return cv::Mat(m_header->m_height, m_header->m_width, m_header->m_type, const_cast<uint8_t *>(chunk(index)));
+}
+
+/**
+ * @brief 第index帧，图像不拷贝，时间戳来自元数据
+ */
+Frame FrameRecordReader::frame(const size_t index) const {
+    const RecordMeta &record = meta(index);
+    return Frame(image(index), timeOf(record.m_timeStampNs), record.m_rawStamp, timeOf(record.m_receiveNs));
+}
+
+/**
+ * @brief 在索引上二分查找，不碰帧块
+ * @param[in] timeStamp     抓图时间
+ * @return size_t 第一帧时间戳不早于timeStamp的序号
+ */
+size_t FrameRecordReader::find(const TimePoint &timeStamp) const {
+    const int64_t ns = nsOf(timeStamp);
+    const RecordIndexEntry *found = std::lower_bound(
+        m_index, m_index + m_count, ns,
+        [](const RecordIndexEntry &entry, const int64_t value) { return entry.m_timeStampNs < value; });
+    return static_cast<size_t>(found - m_index);
+}
+
+/**
+ * @brief 提示内核预读，回放前调用可避开首次访问的缺页
+ * @param[in] index     起始帧
+ * @param[in] num       帧数
+ */
+void FrameRecordReader::prefetch(const size_t index, const size_t num) const {
+    if (index >= m_count) {
+        return;
+    }
+    const size_t last = std::min(index + num, m_count);
+    ::madvise(const_cast<uint8_t *>(chunk(index)), (last - index) * m_header->m_stride, MADV_WILLNEED);
+}
+
+}  // namespace hitcrt
@@ -0,0 +1,210 @@
+/**
+ * @file FrameRecord.h
+ * @brief 只追加的帧录制格式：定长帧块存原始像素和元数据，文件尾索引，异步写入，mmap零拷贝回放
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>满帧率录制场地和仿真数据
+ * </table>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Basic.h"
+#include "Frame.h"
+#include "FrameRing.h"
+
+namespace hitcrt {
+
+/*
+ * 文件布局，全部小端：
+ *   [RecordHeader，占一页]
+ *   [帧块0][帧块1]...[帧块n-1]     每块stride字节，页对齐；像素在块首，RecordMeta在块尾
+ *   [RecordIndexEntry x n]        关闭时写入
+ *   [RecordTrailer]               在文件最后，读的时候从这里找到索引
+ * 第i帧在 PAGE_SIZE + i * stride，按序号定位不需要扫描。
+ * 元数据在像素写完之后才写，读到校验通过的元数据说明这一帧完整；没有文件尾（断电、崩溃）时按块扫描恢复。
+ */
+
+// 文件头
+struct RecordHeader {
+    char m_magic[8];            // "HITREC01"
+    uint32_t m_version;
+    int32_t m_width;
+    int32_t m_height;
+    int32_t m_type;             // cv::Mat类型，单通道为BayerBG8原图
+    uint64_t m_frameBytes;      // 一帧像素的字节数
+    uint64_t m_stride;          // 帧块字节数
+    int64_t m_wallStartNs;      // 开始录制时的system_clock
+    int64_t m_steadyStartNs;    // 同一时刻的steady_clock，用于把帧时间戳换算成墙上时间
+};
+
+// 帧元数据，写在帧块末尾
+struct RecordMeta {
+    uint32_t m_magic;
+    uint32_t m_checksum;        // m_index及之后字段的校验和
+    uint64_t m_index;           // 文件内序号
+    uint64_t m_seq;             // 相机或帧环形缓冲区的序号
+    int64_t m_timeStampNs;      // 抓图时间，steady_clock
+    int64_t m_rawStamp;         // 源时钟原始时间戳，没有时为0
+    int64_t m_receiveNs;        // 本机收到的时刻，steady_clock
+    float m_pitch;              // 云台角度，取自RecvInfoBase，没有时为0
+    float m_yaw;
+    float m_roll;
+    float m_exposureUs;         // 曝光时间，us
+};
+
+// 文件尾索引的一项，按时间戳或序号查找时只读索引，不碰帧块
+struct RecordIndexEntry {
+    int64_t m_timeStampNs;
+    uint64_t m_seq;
+};
+
+// 文件尾
+struct RecordTrailer {
+    uint64_t m_count;
+    uint64_t m_indexOffset;
+    uint32_t m_checksum;        // 索引的校验和
+    uint32_t m_reserved;
+    char m_magic[8];            // "HITIDX01"
+};
+
+/**
+ * @brief 异步录制
+ *
+ * record()只把帧放进队列：拷贝进内部预分配的FrameRing，或者直接持有调用方FrameRing的句柄，不做磁盘IO。
+ * 写线程按块pwrite，提前fallocate一段文件空间，并分段触发回写、丢弃已落盘的页缓存，
+ * 长时间录制时脏页不会堆积导致写入突然卡住。队列满时丢帧并计数，不阻塞调用方。
+ */
+class FrameRecorder {
+   public:
+    FrameRecorder(const std::string &path, const int width = 1280, const int height = 1024,
+                  const int type = CV_8UC3, const int queueSize = 16, const int growFrames = 64);
+    ~FrameRecorder();
+    FrameRecorder(const FrameRecorder &) = delete;
+    FrameRecorder &operator=(const FrameRecorder &) = delete;
+
+    // 拷贝一帧进队列，recvInfo为空时云台角度记为0
+    bool record(const Frame &frame, const uint64_t seq, const RecvInfoBase *recvInfo = nullptr,
+                const float exposureUs = 0.0f);
+    // 直接持有句柄，不拷贝像素；写完之前槽位不会归还给调用方的FrameRing
+    bool record(const FrameHandle &handle, const RecvInfoBase *recvInfo = nullptr, const float exposureUs = 0.0f);
+    // 写完队列里的帧，写入索引和文件尾
+    bool close();
+
+    // getters
+    const std::string &path() const { return m_path; }
+    const uint64_t recorded() const { return m_recorded.load(std::memory_order_relaxed); }
+    const uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    const uint64_t bytes() const { return m_recorded.load(std::memory_order_relaxed) * m_stride; }
+    const size_t maxQueued() const { return m_maxQueued; }
+    const bool failed() const { return m_failed.load(std::memory_order_relaxed); }
+    const size_t stride() const { return m_stride; }
+
+   private:
+    struct Pending {
+        FrameHandle m_handle;
+        RecordMeta m_meta;
+    };
+
+    bool push(FrameHandle &&handle, const RecordMeta &meta);
+    void writeLoop();
+    bool writeFrame(const Pending &pending);
+    bool reserve(const uint64_t end);
+    void writeback(const uint64_t end);
+    bool writeIndex();
+
+    const std::string m_path;
+    const int m_width;
+    const int m_height;
+    const int m_type;
+    const size_t m_queueSize;
+    size_t m_frameBytes = 0;
+    size_t m_stride = 0;
+    uint64_t m_growBytes = 0;
+    int m_fd = -1;
+    bool m_closed = false;
+    bool m_closeOk = false;
+
+    FrameRing m_staging;  // record(Frame)拷贝的目标
+    std::deque<Pending> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_stopping = false;
+    size_t m_maxQueued = 0;
+    std::thread m_writeThread;
+
+    // 以下只在写线程里访问
+    std::vector<RecordIndexEntry> m_index;
+    uint64_t m_allocated = 0;   // 已fallocate到的位置
+    uint64_t m_written = 0;     // 已写到的位置
+    uint64_t m_flushStart = 0;  // 已触发回写但未等待的起点
+    uint64_t m_dropStart = 0;   // 页缓存未丢弃的起点
+
+    std::atomic<uint64_t> m_recorded{0};
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<bool> m_failed{false};
+
+    static constexpr uint64_t WRITEBACK_BYTES = 32ull << 20;  // 每写这么多触发一次回写
+};
+
+/**
+ * @brief 录制文件的读取，整个文件mmap进来，取帧不拷贝
+ * @note image()/frame()返回的图像直接指向映射内存，只读，reader必须比它们活得久
+ */
+class FrameRecordReader {
+   public:
+    explicit FrameRecordReader(const std::string &path);
+    ~FrameRecordReader();
+    FrameRecordReader(const FrameRecordReader &) = delete;
+    FrameRecordReader &operator=(const FrameRecordReader &) = delete;
+
+    // 没有文件尾的文件补上索引和文件尾，截掉不完整的帧，返回保留的帧数，失败返回-1
+    static int64_t repair(const std::string &path);
+
+    const size_t count() const { return m_count; }
+    const RecordHeader &header() const { return *m_header; }
+    const RecordMeta &meta(const size_t index) const;
+    cv::Mat image(const size_t index) const;
+    Frame frame(const size_t index) const;
+    // 第一帧时间戳不早于timeStamp的序号，都早于时返回count()
+    size_t find(const TimePoint &timeStamp) const;
+    // 预读第index帧起的num帧
+    void prefetch(const size_t index, const size_t num = 1) const;
+
+    // 没有完整的文件尾，帧是扫描帧块恢复出来的
+    const bool recovered() const { return m_recovered; }
+    // 文件中完整帧之后多出的字节数（不完整的帧、预分配的空间）
+    const uint64_t trailingBytes() const { return m_trailingBytes; }
+
+   private:
+    bool loadIndex();
+    void scan();
+    const uint8_t *chunk(const size_t index) const;
+
+    int m_fd = -1;
+    uint8_t *m_map = nullptr;
+    size_t m_size = 0;
+    const RecordHeader *m_header = nullptr;
+    const RecordIndexEntry *m_index = nullptr;
+    std::vector<RecordIndexEntry> m_scanned;  // 恢复时重建的索引
+    size_t m_count = 0;
+    bool m_recovered = false;
+    uint64_t m_trailingBytes = 0;
+};
+
+}  // namespace hitcrt
@@ -0,0 +1,148 @@
+/**
+ * @file FrameRing.cpp
+ * @brief 预分配的定长帧环形缓冲区，带引用计数的帧句柄
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>替换回调->检测之间逐跳clone的取图路径
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>槽位记录源时钟原始时间戳和收到时刻
+ * </table>
+ */
+#include "FrameRing.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace hitcrt {
+// ============================== FrameHandle ==============================
+FrameHandle::FrameHandle(const FrameHandle &other) : m_slot(other.m_slot), m_ring(other.m_ring) {
+    if (m_slot != nullptr) {
+        m_slot->m_refs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+FrameHandle::FrameHandle(FrameHandle &&other) noexcept : m_slot(other.m_slot), m_ring(other.m_ring) {
+    other.m_slot = nullptr;
+    other.m_ring = nullptr;
+}
+
+FrameHandle &FrameHandle::operator=(const FrameHandle &other) {
+    if (this != &other) {
+        // 先加后减，自赋值同一槽位时也不会提前归还
+        if (other.m_slot != nullptr) {
+            other.m_slot->m_refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        reset();
+        m_slot = other.m_slot;
+        m_ring = other.m_ring;
+    }
+    return *this;
+}
+
+FrameHandle &FrameHandle::operator=(FrameHandle &&other) noexcept {
+    if (this != &other) {
+        reset();
+        m_slot = other.m_slot;
+        m_ring = other.m_ring;
+        other.m_slot = nullptr;
+        other.m_ring = nullptr;
+    }
+    return *this;
+}
+
+FrameHandle::~FrameHandle() { reset(); }
+
+/**
+ * @brief 释放对槽位的引用，最后一个引用归还槽位
+ */
+void FrameHandle::reset() {
+    if (m_slot != nullptr) {
+        m_ring->release(m_slot);
+        m_slot = nullptr;
+        m_ring = nullptr;
+    }
+}
+
+/**
+ * @brief 生产者写完像素后调用
+ * @param[in] timeStamp     抓图时间
+ */
+void FrameHandle::commit(const TimePoint &timeStamp) { commit(timeStamp, 0, timeStamp); }
+
+/**
+ * @brief 生产者写完像素后调用
+ * @param[in] timeStamp     映射到本机时钟的抓图时间
+ * @param[in] rawStamp      源时钟原始时间戳，ns
+ * @param[in] receiveTime   本机收到的时刻
+ */
+void FrameHandle::commit(const TimePoint &timeStamp, const int64_t rawStamp, const TimePoint &receiveTime) {
+    m_slot->m_timeStamp = timeStamp;
+    m_slot->m_rawStamp = rawStamp;
+    m_slot->m_receiveTime = receiveTime;
+    m_slot->m_seq = m_ring->m_seq.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ============================== FrameRing ==============================
+/**
+ * @brief 一次性分配全部槽位，每个槽位按页对齐
+ * @param[in] capacity      槽位数，至少要覆盖 生产者1 + 队列深度 + 消费者同时持有 的数量
+ * @param[in] width         图像宽度
+ * @param[in] height        图像高度
+ * @param[in] type          图像类型，默认BGR8
+ */
+FrameRing::FrameRing(const int capacity, const int width, const int height, const int type)
+    : m_width(width), m_height(height), m_type(type) {
+    if (capacity <= 0 || width <= 0 || height <= 0) {
+        throw std::invalid_argument("FrameRing: capacity, width and height must be positive");
+    }
+    const size_t imageBytes = static_cast<size_t>(width) * height * CV_ELEM_SIZE(type);
+    m_slotBytes = (imageBytes + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+
+    m_memory = static_cast<uint8_t *>(std::aligned_alloc(PAGE_SIZE, m_slotBytes * capacity));
+    if (m_memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    // 提前触页，避免第一轮写入时产生缺页中断
+    std::memset(m_memory, 0, m_slotBytes * capacity);
+
+    m_slots.reserve(capacity);
+    for (int i = 0; i < capacity; ++i) {
+        auto slot = std::make_unique<FrameSlot>();
+        slot->m_image = cv::Mat(height, width, type, m_memory + i * m_slotBytes);
+        m_slots.emplace_back(std::move(slot));
+    }
+}
+
+FrameRing::~FrameRing() {
+    m_slots.clear();
+    std::free(m_memory);
+}
+
+/**
+ * @brief 从游标位置开始找一个空闲槽位
+ * @return FrameHandle 空闲槽位的句柄，全部占用时为空
+ */
+FrameHandle FrameRing::acquire() {
+    const uint64_t start = m_cursor.fetch_add(1, std::memory_order_relaxed);
+    const size_t num = m_slots.size();
+    for (size_t i = 0; i < num; ++i) {
+        FrameSlot *slot = m_slots[(start + i) % num].get();
+        int expected = 0;
+        if (slot->m_refs.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+            return FrameHandle(slot, this);
+        }
+    }
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return FrameHandle();
+}
+
+void FrameRing::release(FrameSlot *slot) { slot->m_refs.fetch_sub(1, std::memory_order_acq_rel); }
+
+}  // namespace hitcrt
@@ -0,0 +1,127 @@
+/**
+ * @file FrameRing.h
+ * @brief 预分配的定长帧环形缓冲区，带引用计数的帧句柄
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>替换回调->检测之间逐跳clone的取图路径
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>槽位记录源时钟原始时间戳和收到时刻
+ * </table>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <opencv2/core.hpp>
+#include <vector>
+
+#include "Basic.h"
+
+namespace hitcrt {
+
+class FrameRing;
+
+/**
+ * @brief 帧槽位，由FrameRing统一分配，外部只能通过FrameHandle访问
+ */
+struct FrameSlot {
+    cv::Mat m_image;               // 包装槽位内存，不持有数据
+    TimePoint m_timeStamp;         // 抓图时间，已映射到本机时钟
+    int64_t m_rawStamp = 0;        // 源时钟原始时间戳，ns，没有时为0
+    TimePoint m_receiveTime;       // 本机收到的时刻
+    uint64_t m_seq = 0;            // 写入序号，单调递增
+    std::atomic<int> m_refs{0};    // 引用计数，0表示空闲
+};
+
+/**
+ * @brief 帧句柄，拷贝只增加引用计数，不拷贝像素
+ * @note 最后一个句柄析构时槽位自动归还给FrameRing，FrameRing必须比所有句柄活得久
+ */
+class FrameHandle {
+   public:
+    FrameHandle() = default;
+    FrameHandle(const FrameHandle &other);
+    FrameHandle(FrameHandle &&other) noexcept;
+    FrameHandle &operator=(const FrameHandle &other);
+    FrameHandle &operator=(FrameHandle &&other) noexcept;
+    ~FrameHandle();
+
+    bool empty() const { return m_slot == nullptr; }
+    void reset();
+
+    // 生产者写完像素后调用，记录时间戳和序号
+    void commit(const TimePoint &timeStamp);
+    // 有源时钟时同时记录原始时间戳和收到时刻，timeStamp为映射后的抓图时间
+    void commit(const TimePoint &timeStamp, const int64_t rawStamp, const TimePoint &receiveTime);
+
+    // getters
+    cv::Mat &image() { return m_slot->m_image; }
+    const cv::Mat &image() const { return m_slot->m_image; }
+    const TimePoint timeStamp() const { return m_slot->m_timeStamp; }
+    const int64_t rawStamp() const { return m_slot->m_rawStamp; }
+    const TimePoint receiveTime() const { return m_slot->m_receiveTime; }
+    const uint64_t seq() const { return m_slot->m_seq; }
+    const int useCount() const { return m_slot ? m_slot->m_refs.load(std::memory_order_relaxed) : 0; }
+
+   private:
+    friend class FrameRing;
+    FrameHandle(FrameSlot *slot, FrameRing *ring) : m_slot(slot), m_ring(ring) {}
+
+    FrameSlot *m_slot = nullptr;
+    FrameRing *m_ring = nullptr;
+};
+
+/**
+ * @brief 定长帧环形缓冲区
+ *
+ * 构造时一次性分配 capacity 个页对齐的槽位，运行期间不再申请内存。
+ * 生产者 acquire() 拿到一个空闲槽位直接往里写，写完 commit() 后把句柄交给下游，
+ * 检测和画图读的都是同一块内存，没有逐跳的 clone。
+ */
+class FrameRing {
+   public:
+    static constexpr size_t PAGE_SIZE = 4096;
+
+    FrameRing(const int capacity, const int width = 1280, const int height = 1024, const int type = CV_8UC3);
+    ~FrameRing();
+    FrameRing(const FrameRing &) = delete;
+    FrameRing &operator=(const FrameRing &) = delete;
+
+    // 取一个空闲槽位，全部被占用时返回空句柄（由调用方决定丢帧）
+    FrameHandle acquire();
+
+    // getters
+    const int capacity() const { return static_cast<int>(m_slots.size()); }
+    const int width() const { return m_width; }
+    const int height() const { return m_height; }
+    const int type() const { return m_type; }
+    const size_t slotBytes() const { return m_slotBytes; }
+    const uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    // 尺寸和类型与槽位一致才能写入
+    bool fits(const int width, const int height, const int type) const {
+        return width == m_width && height == m_height && type == m_type;
+    }
+
+   private:
+    friend class FrameHandle;
+    void release(FrameSlot *slot);
+
+    const int m_width;
+    const int m_height;
+    const int m_type;
+    size_t m_slotBytes = 0;
+    uint8_t *m_memory = nullptr;
+    std::vector<std::unique_ptr<FrameSlot>> m_slots;
+    std::atomic<uint64_t> m_cursor{0};
+    std::atomic<uint64_t> m_seq{0};
+    std::atomic<uint64_t> m_dropped{0};
+};
+
+}  // namespace hitcrt
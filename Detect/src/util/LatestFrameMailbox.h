@@ -0,0 +1,184 @@
+/**
+ * @file LatestFrameMailbox.h
+ * @brief 只保留最新一帧的无锁信箱（三缓冲交换）
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>替换demo中互斥锁+条件变量实现的ThreadSafeQueue
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>公开MAX_PRODUCERS，调用方据此计算信箱占用的帧槽位
+ * </table>
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+namespace hitcrt {
+
+/**
+ * @brief 最新帧信箱
+ *
+ * 经典三缓冲：消费者持有front，生产者持有back，中间一个latest槽位通过一次原子exchange交换。
+ * 多生产者时每个生产者各持有一个back，槽位数为 MaxProducers + 2，发布依然只有一次exchange，是wait-free的。
+ * 消费者没拿走的帧被新帧顶掉时计入overwritten。
+ *
+ * 单生产者直接调用publish()；多生产者时每个线程先调用producer()拿到自己的Producer再发布。
+ * 消费者只能有一个。
+ *
+ * @tparam T 帧类型，需可默认构造、可移动。FrameHandle这类带引用计数的句柄最合适
+ * @tparam MaxProducers 最大生产者数
+ */
+template <typename T, int MaxProducers = 1>
+class LatestFrameMailbox {
+    static_assert(MaxProducers >= 1 && MaxProducers <= 64, "LatestFrameMailbox: MaxProducers must be in [1, 64]");
+
+    static constexpr uint32_t NUM_SLOTS = MaxProducers + 2;
+    static constexpr uint32_t INDEX_MASK = 0xFF;
+    static constexpr uint32_t DIRTY = 0x100;  // latest槽位里有消费者还没取走的新帧
+    static constexpr uint32_t WAKE = 0x200;   // 仅用于stop()时改变状态字唤醒消费者
+
+   public:
+    static constexpr int MAX_PRODUCERS = MaxProducers;
+
+    /**
+     * @brief 生产者句柄，持有一个back槽位
+     */
+    class Producer {
+       public:
+        Producer() = default;
+
+        /**
+         * @brief 发布一帧，wait-free
+         * @param[in] value     新帧
+         * @return true     顶掉了一帧消费者还没取走的帧
+         * @return false
+         */
+        bool publish(T value) {
+            LatestFrameMailbox &box = *m_box;
+            box.m_slots[m_back] = std::move(value);
+            const uint32_t old = box.m_state.exchange(m_back | DIRTY, std::memory_order_acq_rel);
+            m_back = old & INDEX_MASK;
+            // 换回来的槽位里是旧帧，立即释放，不让它占着下游资源（比如帧环形缓冲区的槽位）
+            box.m_slots[m_back] = T();
+            box.m_published.fetch_add(1, std::memory_order_relaxed);
+            const bool overwritten = (old & DIRTY) != 0;
+            if (overwritten) {
+                box.m_overwritten.fetch_add(1, std::memory_order_relaxed);
+            }
+            box.m_state.notify_one();
+            return overwritten;
+        }
+
+        bool valid() const { return m_box != nullptr; }
+
+       private:
+        friend class LatestFrameMailbox;
+        Producer(LatestFrameMailbox *box, uint32_t back) : m_box(box), m_back(back) {}
+
+        LatestFrameMailbox *m_box = nullptr;
+        uint32_t m_back = 0;
+    };
+
+    LatestFrameMailbox() : m_defaultProducer(producer()) {}
+    LatestFrameMailbox(const LatestFrameMailbox &) = delete;
+    LatestFrameMailbox &operator=(const LatestFrameMailbox &) = delete;
+
+    /**
+     * @brief 注册一个生产者，每个生产者线程调用一次
+     * @return Producer
+     * @note 第一个生产者在构造时已注册给publish()使用，多生产者时publish()也占一个名额
+     */
+    Producer producer() {
+        const uint32_t id = m_producers.fetch_add(1, std::memory_order_relaxed);
+        if (id >= static_cast<uint32_t>(MaxProducers)) {
+            throw std::logic_error("LatestFrameMailbox: too many producers");
+        }
+        // 槽位0给消费者做front，槽位1初始为latest，生产者依次占用2..
+        return Producer(this, id + 2);
+    }
+
+    /**
+     * @brief 单生产者发布
+     */
+    bool publish(T value) { return m_defaultProducer.publish(std::move(value)); }
+
+    /**
+     * @brief 非阻塞取最新帧
+     * @param[out] value    取到的帧
+     * @return true     取到了新帧
+     * @return false    没有新帧
+     */
+    bool try_consume(T &value) {
+        if ((m_state.load(std::memory_order_acquire) & DIRTY) == 0) {
+            return false;
+        }
+        const uint32_t old = m_state.exchange(m_front, std::memory_order_acq_rel);
+        m_front = old & INDEX_MASK;
+        value = std::move(m_slots[m_front]);
+        m_consumed.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief 阻塞取最新帧，没有新帧时在状态字上atomic wait（Linux下即futex）
+     * @param[out] value    取到的帧
+     * @return true     取到了新帧
+     * @return false    信箱已stop
+     */
+    bool consume(T &value) {
+        while (true) {
+            if (m_stopped.load(std::memory_order_acquire)) {
+                return false;
+            }
+            if (try_consume(value)) {
+                return true;
+            }
+            const uint32_t state = m_state.load(std::memory_order_acquire);
+            if ((state & DIRTY) != 0) {
+                continue;
+            }
+            if (m_stopped.load(std::memory_order_acquire)) {
+                return false;
+            }
+            m_state.wait(state, std::memory_order_acquire);
+        }
+    }
+
+    /**
+     * @brief 停止信箱，唤醒阻塞中的消费者
+     */
+    void stop() {
+        m_stopped.store(true, std::memory_order_release);
+        m_state.fetch_xor(WAKE, std::memory_order_acq_rel);
+        m_state.notify_all();
+    }
+
+    // getters
+    bool stopped() const { return m_stopped.load(std::memory_order_acquire); }
+    uint64_t published() const { return m_published.load(std::memory_order_relaxed); }
+    uint64_t consumed() const { return m_consumed.load(std::memory_order_relaxed); }
+    // 没被消费就被新帧顶掉的帧数
+    uint64_t overwritten() const { return m_overwritten.load(std::memory_order_relaxed); }
+
+   private:
+    std::array<T, NUM_SLOTS> m_slots{};
+    alignas(64) std::atomic<uint32_t> m_state{1};  // latest槽位下标 | DIRTY | WAKE
+    alignas(64) uint32_t m_front = 0;              // 仅消费者访问
+    std::atomic<bool> m_stopped{false};
+    std::atomic<uint32_t> m_producers{0};
+    alignas(64) std::atomic<uint64_t> m_published{0};
+    std::atomic<uint64_t> m_overwritten{0};
+    alignas(64) std::atomic<uint64_t> m_consumed{0};
+    Producer m_defaultProducer;
+};
+
+}  // namespace hitcrt
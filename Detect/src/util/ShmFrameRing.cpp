@@ -0,0 +1,308 @@
+/**
+ * @file ShmFrameRing.cpp
+ * @brief 进程间共享内存帧环
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>仿真桥到检测进程的图像传输不再经过DDS
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>读者可检查写者退出或共享内存被重建
+ * </table>
+ */
+#include "ShmFrameRing.h"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <stdexcept>
+
+namespace hitcrt {
+
+namespace {
+constexpr char MAGIC[8] = {'H', 'I', 'T', 'S', 'H', 'M', '0', '1'};
+constexpr uint32_t VERSION = 1;
+constexpr uint64_t PAGE_SIZE = 4096;
+
+uint64_t pageAlign(const uint64_t bytes) { return (bytes + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE; }
+
+// shm_open要求名字以/开头
+std::string shmName(const std::string &name) { return name.empty() || name[0] != '/' ? "/" + name : name; }
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// 共享映射上的futex，不能用FUTEX_PRIVATE_FLAG
+void futexWake(std::atomic<uint32_t> *word) {
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+void futexWait(const std::atomic<uint32_t> *word, const uint32_t expect, const int64_t timeoutNs) {
+    timespec timeout;
+    timeout.tv_sec = static_cast<time_t>(timeoutNs / 1000000000LL);
+    timeout.tv_nsec = static_cast<long>(timeoutNs % 1000000000LL);
+    ::syscall(SYS_futex, reinterpret_cast<const uint32_t *>(word), FUTEX_WAIT, expect, &timeout, nullptr, 0);
+}
+}  // namespace
+
+// ============================== ShmFrameWriter ==============================
+/**
+ * @brief 创建共享内存并预先映射所有页，同名的旧段（上次崩溃留下的）先删掉
+ * @param[in] name      共享内存名，如"hitcrt_image"
+ * @param[in] width     宽度
+ * @param[in] height    高度
+ * @param[in] type      图像类型
+ * @param[in] capacity  槽位数
+ */
+ShmFrameWriter::ShmFrameWriter(const std::string &name, const int width, const int height, const int type,
+                               const int capacity)
+    : m_name(shmName(name)) {
+    if (width <= 0 || height <= 0 || capacity <= 0) {
+        throw std::invalid_argument("ShmFrameWriter: invalid size or capacity");
+    }
+    const uint64_t frameBytes = static_cast<uint64_t>(width) * height * CV_ELEM_SIZE(type);
+    const uint64_t slotStride = pageAlign(frameBytes);
+    const uint64_t dataOffset = pageAlign(sizeof(ShmRingHeader) + capacity * sizeof(ShmSlotHeader));
+    m_size = dataOffset + capacity * slotStride;
+
+    ::shm_unlink(m_name.c_str());
+    const int fd = ::shm_open(m_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("ShmFrameWriter: shm_open " + m_name + " failed: " + std::strerror(errno));
+    }
+    if (::ftruncate(fd, static_cast<off_t>(m_size)) != 0) {
+        const int error = errno;
+        ::close(fd);
+        ::shm_unlink(m_name.c_str());
+        throw std::runtime_error("ShmFrameWriter: ftruncate " + m_name + " failed: " + std::strerror(error));
+    }
+    // MAP_POPULATE预先分配物理页，第一圈写入不再缺页
+    void *map = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        ::shm_unlink(m_name.c_str());
+        throw std::runtime_error("ShmFrameWriter: mmap " + m_name + " failed: " + std::strerror(errno));
+    }
+    m_map = static_cast<uint8_t *>(map);
+
+    m_header = new (m_map) ShmRingHeader();
+    m_header->m_version = VERSION;
+    m_header->m_width = width;
+    m_header->m_height = height;
+    m_header->m_type = type;
+    m_header->m_capacity = static_cast<uint32_t>(capacity);
+    m_header->m_frameBytes = frameBytes;
+    m_header->m_slotStride = slotStride;
+    m_header->m_dataOffset = dataOffset;
+    m_header->m_writerPid = static_cast<int32_t>(::getpid());
+    m_slots = reinterpret_cast<ShmSlotHeader *>(m_map + sizeof(ShmRingHeader));
+    for (int i = 0; i < capacity; ++i) {
+        new (&m_slots[i]) ShmSlotHeader();
+    }
+    // 魔数最后写，读者看到魔数时其余字段都已就绪
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(m_header->m_magic, MAGIC, sizeof(MAGIC));
+}
+
+ShmFrameWriter::~ShmFrameWriter() {
+    // 已经映射的读者不受影响，只是不会再有新帧
+    ::munmap(m_map, m_size);
+    ::shm_unlink(m_name.c_str());
+}
+
+/**
+ * @brief 开始写下一个槽位，seqlock置为奇数
+ * @return 槽位图像，尺寸类型与构造时一致，不要重新分配
+ * @note 上一次begin()没有commit()时继续写同一个槽位
+ */
+cv::Mat &ShmFrameWriter::begin() {
+    if (m_writing) {
+        return m_current;
+    }
+    m_currentSlot = static_cast<uint32_t>(m_header->m_published.load(std::memory_order_relaxed) % m_header->m_capacity);
+    ShmSlotHeader &slot = m_slots[m_currentSlot];
+    slot.m_lock.store(slot.m_lock.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_current = cv::Mat(m_header->m_height, m_header->m_width, m_header->m_type,
+                        m_map + m_header->m_dataOffset + m_currentSlot * m_header->m_slotStride);
+    m_writing = true;
+    return m_current;
+}
+
+/**
+ * @brief 发布begin()的槽位并唤醒等待的读者
+ * @param[in] meta  帧元数据，m_publishNs在这里填
+ */
+void ShmFrameWriter::commit(const ShmFrameMeta &meta) {
+    if (!m_writing) {
+        return;
+    }
+    ShmSlotHeader &slot = m_slots[m_currentSlot];
+    slot.m_meta = meta;
+    slot.m_meta.m_publishNs = nowNs();
+    slot.m_lock.store(slot.m_lock.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    m_header->m_published.fetch_add(1, std::memory_order_release);
+    m_header->m_notify.fetch_add(1, std::memory_order_release);
+    futexWake(&m_header->m_notify);
+    m_writing = false;
+}
+
+/**
+ * @brief 拷贝一帧进下一个槽位并发布
+ * @return false 尺寸或类型不符
+ */
+bool ShmFrameWriter::write(const cv::Mat &image, const ShmFrameMeta &meta) {
+    if (!fits(image.cols, image.rows, image.type())) {
+        return false;
+    }
+    image.copyTo(begin());
+    commit(meta);
+    return true;
+}
+
+// ============================== ShmFrameReader ==============================
+/**
+ * @brief 只读映射写者创建的共享内存
+ * @param[in] name  与写者相同的名字
+ * @note 写者还没创建或还没初始化完时抛出std::runtime_error，调用方可以稍后重试
+ */
+ShmFrameReader::ShmFrameReader(const std::string &name) {
+    const std::string path = shmName(name);
+    const int fd = ::shm_open(path.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw std::runtime_error("ShmFrameReader: shm_open " + path + " failed: " + std::strerror(errno));
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<uint64_t>(info.st_size) < PAGE_SIZE) {
+        ::close(fd);
+        throw std::runtime_error("ShmFrameReader: " + path + " is not initialized");
+    }
+    m_path = path;
+    m_device = static_cast<uint64_t>(info.st_dev);
+    m_inode = static_cast<uint64_t>(info.st_ino);
+    m_size = static_cast<size_t>(info.st_size);
+    void *map = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED | MAP_POPULATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        throw std::runtime_error("ShmFrameReader: mmap " + path + " failed: " + std::strerror(errno));
+    }
+    m_map = static_cast<const uint8_t *>(map);
+    m_header = reinterpret_cast<const ShmRingHeader *>(m_map);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (std::memcmp(m_header->m_magic, MAGIC, sizeof(MAGIC)) != 0 || m_header->m_version != VERSION ||
+        m_header->m_dataOffset + m_header->m_capacity * m_header->m_slotStride > m_size) {
+        ::munmap(const_cast<uint8_t *>(m_map), m_size);
+        throw std::runtime_error("ShmFrameReader: " + path + " is not a frame ring");
+    }
+    m_slots = reinterpret_cast<const ShmSlotHeader *>(m_map + sizeof(ShmRingHeader));
+}
+
+ShmFrameReader::~ShmFrameReader() { ::munmap(const_cast<uint8_t *>(m_map), m_size); }
+
+/**
+ * @brief 在futex上睡到写者发布新帧
+ * @param[in] timeoutMs     超时
+ * @return true 有比上次latest()取到的更新的帧
+ * @return false 超时，写者可能已经退出
+ */
+bool ShmFrameReader::wait(const uint timeoutMs) {
+    const int64_t deadline = nowNs() + static_cast<int64_t>(timeoutMs) * 1000000LL;
+    while (true) {
+        // 先读futex字再检查条件，期间发布的帧会让FUTEX_WAIT立即返回
+        const uint32_t notify = m_header->m_notify.load(std::memory_order_acquire);
+        if (m_header->m_published.load(std::memory_order_acquire) > m_lastIndex) {
+            return true;
+        }
+        const int64_t left = deadline - nowNs();
+        if (left <= 0) {
+            return false;
+        }
+        futexWait(&m_header->m_notify, notify, left);
+    }
+}
+
+/**
+ * @brief 取最新发布的帧，图像指向共享内存
+ * @param[out] view     帧，用完后用intact()确认没有被覆盖
+ * @return false 还没有帧，或写者写得太快一直取不到完整的帧
+ */
+bool ShmFrameReader::latest(ShmFrameView &view) {
+    const uint32_t capacity = m_header->m_capacity;
+    for (int retry = 0; retry < 8; ++retry) {
+        const uint64_t index = m_header->m_published.load(std::memory_order_acquire);
+        if (index == 0) {
+            return false;
+        }
+        const uint32_t slot = static_cast<uint32_t>((index - 1) % capacity);
+        // 槽位每写一次seqlock加2，第index帧写完后应为这个值，更大说明已经被更新的帧覆盖
+        const uint64_t expect = 2 * ((index - 1) / capacity + 1);
+        const uint64_t lock = m_slots[slot].m_lock.load(std::memory_order_acquire);
+        if (lock != expect) {
+            continue;
+        }
+        view.m_meta = m_slots[slot].m_meta;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_slots[slot].m_lock.load(std::memory_order_relaxed) != lock) {
+            continue;
+        }
+        view.m_image = cv::Mat(m_header->m_height, m_header->m_width, m_header->m_type,
+                               const_cast<uint8_t *>(m_map + m_header->m_dataOffset + slot * m_header->m_slotStride));
+        view.m_index = index;
+        view.m_slot = slot;
+        view.m_lock = lock;
+        if (m_lastIndex > 0 && index > m_lastIndex + 1) {
+            m_skipped += index - m_lastIndex - 1;
+        }
+        m_lastIndex = index;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 取帧以来槽位没有被写者重新写过，读完像素后调用
+ */
+bool ShmFrameReader::intact(const ShmFrameView &view) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return view.m_slot < m_header->m_capacity &&
+           m_slots[view.m_slot].m_lock.load(std::memory_order_relaxed) == view.m_lock;
+}
+
+/**
+ * @brief 写者重启时会删掉旧的共享内存再建一个同名的新段，已有的映射仍指向旧段，在上面永远等不到新帧
+ *
+ * 写者进程不存在，或按名字打开的共享内存与映射的不是同一个文件（已删除、已重建）时返回true。
+ * 写者在其他PID命名空间时kill返回EPERM，按仍存活处理，只看共享内存是否被重建。
+ */
+bool ShmFrameReader::stale() const {
+    const pid_t pid = static_cast<pid_t>(m_header->m_writerPid);
+    if (pid > 0 && ::kill(pid, 0) != 0 && errno == ESRCH) {
+        return true;
+    }
+    const int fd = ::shm_open(m_path.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return true;
+    }
+    struct stat info;
+    const bool same = ::fstat(fd, &info) == 0 && static_cast<uint64_t>(info.st_dev) == m_device &&
+                      static_cast<uint64_t>(info.st_ino) == m_inode;
+    ::close(fd);
+    return !same;
+}
+
+}  // namespace hitcrt
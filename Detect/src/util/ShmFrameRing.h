@@ -0,0 +1,156 @@
+/**
+ * @file ShmFrameRing.h
+ * @brief 进程间共享内存帧环：定长槽位，每个槽位一个seqlock，futex通知，读者原地读取像素
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>仿真桥到检测进程的图像传输不再经过DDS
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>读者可检查写者退出或共享内存被重建
+ * </table>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <opencv2/core.hpp>
+#include <string>
+
+#include "Basic.h"
+
+namespace hitcrt {
+
+/*
+ * 共享内存布局（/dev/shm/<name>）：
+ *   [ShmRingHeader][ShmSlotHeader x capacity]   头部，页对齐
+ *   [槽位0像素][槽位1像素]...                  每个槽位页对齐
+ * 写者（一个）按序号轮流写槽位，读者（任意多个）只读映射。
+ * 槽位的seqlock为奇数表示正在写，读者拿到图像前后各读一次，相同才说明这段时间内没有被覆盖。
+ */
+
+// 一帧的元数据，时间戳都是steady_clock（CLOCK_MONOTONIC），同一台机器上跨进程可比
+struct ShmFrameMeta {
+    uint64_t m_seq = 0;          // 源的帧序号
+    int64_t m_timeStampNs = 0;   // 抓图时间，已映射到本机时钟
+    int64_t m_rawStamp = 0;      // 源时钟原始时间戳，没有时为0
+    int64_t m_receiveNs = 0;     // 写者收到的时刻
+    int64_t m_publishNs = 0;     // 写完槽位的时刻，commit时填
+};
+
+struct ShmSlotHeader {
+    alignas(64) std::atomic<uint64_t> m_lock{0};  // seqlock，奇数为正在写
+    ShmFrameMeta m_meta;
+};
+
+struct ShmRingHeader {
+    char m_magic[8];
+    uint32_t m_version;
+    int32_t m_width;
+    int32_t m_height;
+    int32_t m_type;
+    uint32_t m_capacity;
+    uint64_t m_frameBytes;   // 一帧像素字节数
+    uint64_t m_slotStride;   // 槽位间距，页对齐
+    uint64_t m_dataOffset;   // 槽位0的偏移
+    int32_t m_writerPid;
+    alignas(64) std::atomic<uint64_t> m_published{0};  // 已发布的帧数，最新一帧在槽位(m_published-1)%capacity
+    alignas(64) std::atomic<uint32_t> m_notify{0};     // futex字，每发布一帧加一
+};
+
+/**
+ * @brief 读者拿到的一帧，图像直接指向共享内存，只读
+ */
+struct ShmFrameView {
+    cv::Mat m_image;
+    ShmFrameMeta m_meta;
+    uint64_t m_index = 0;  // 写者的发布序号，从1开始
+    uint32_t m_slot = 0;
+    uint64_t m_lock = 0;   // 取帧时槽位的seqlock
+};
+
+/**
+ * @brief 写者，创建共享内存，析构时删除
+ *
+ * begin()返回下一个槽位的图像，直接往里写（转换、拷贝、解码都可以原地做），写完commit()发布并唤醒读者。
+ */
+class ShmFrameWriter {
+   public:
+    ShmFrameWriter(const std::string &name, const int width = 1280, const int height = 1024,
+                   const int type = CV_8UC3, const int capacity = 8);
+    ~ShmFrameWriter();
+    ShmFrameWriter(const ShmFrameWriter &) = delete;
+    ShmFrameWriter &operator=(const ShmFrameWriter &) = delete;
+
+    // 开始写下一个槽位
+    cv::Mat &begin();
+    // 发布begin()的槽位，meta.m_publishNs由这里填
+    void commit(const ShmFrameMeta &meta);
+    // 拷贝image并发布
+    bool write(const cv::Mat &image, const ShmFrameMeta &meta);
+
+    // getters
+    const std::string &name() const { return m_name; }
+    const uint64_t published() const { return m_header->m_published.load(std::memory_order_relaxed); }
+    bool fits(const int width, const int height, const int type) const {
+        return width == m_header->m_width && height == m_header->m_height && type == m_header->m_type;
+    }
+
+   private:
+    const std::string m_name;
+    uint8_t *m_map = nullptr;
+    size_t m_size = 0;
+    ShmRingHeader *m_header = nullptr;
+    ShmSlotHeader *m_slots = nullptr;
+    cv::Mat m_current;
+    uint32_t m_currentSlot = 0;
+    bool m_writing = false;
+};
+
+/**
+ * @brief 读者，只读映射写者创建的共享内存
+ * @note 读者不占用槽位，写者转一圈回来会覆盖；用完图像后调用intact()确认期间没有被覆盖，
+ *       槽位数应大于读者处理一帧期间写者写入的帧数
+ */
+class ShmFrameReader {
+   public:
+    explicit ShmFrameReader(const std::string &name);
+    ~ShmFrameReader();
+    ShmFrameReader(const ShmFrameReader &) = delete;
+    ShmFrameReader &operator=(const ShmFrameReader &) = delete;
+
+    // 等到有比上次latest()取到的更新的帧，超时返回false
+    bool wait(const uint timeoutMs);
+    // 取最新的完整帧，原地，不拷贝像素
+    bool latest(ShmFrameView &view);
+    // 取帧之后槽位没有被覆盖
+    bool intact(const ShmFrameView &view) const;
+    // 写者进程已退出，或同名共享内存已被删除、重建；为true时映射上不会再有新帧，应重新构造读者
+    bool stale() const;
+
+    // getters
+    const int width() const { return m_header->m_width; }
+    const int height() const { return m_header->m_height; }
+    const int type() const { return m_header->m_type; }
+    const uint32_t capacity() const { return m_header->m_capacity; }
+    const int writerPid() const { return m_header->m_writerPid; }
+    // 两次取帧之间没取到的帧数
+    const uint64_t skipped() const { return m_skipped; }
+
+   private:
+    std::string m_path;
+    uint64_t m_device = 0;  // 打开时共享内存文件的设备号和inode，用来识别重建
+    uint64_t m_inode = 0;
+    const uint8_t *m_map = nullptr;
+    size_t m_size = 0;
+    const ShmRingHeader *m_header = nullptr;
+    const ShmSlotHeader *m_slots = nullptr;
+    uint64_t m_lastIndex = 0;
+    uint64_t m_skipped = 0;
+};
+
+}  // namespace hitcrt
@@ -0,0 +1,390 @@
+/**
+ * @file StagePipeline.h
+ * @brief 多级流水线执行器：每级一个工作线程，级间有界通道
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>检测与显示由串行改为流水线
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>各级线程按级名记录trace区间
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>各级耗时记入直方图，统计加入分位数
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>处理完和被丢弃的项回收复用，保留缓冲区容量
+ * </table>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Trace.h"
+#include "utils/histogram.hpp"
+
+namespace hitcrt {
+
+/**
+ * @brief 通道满时的处理策略
+ */
+enum class DropPolicy {
+    BLOCK = 0,    // 阻塞上游直到有空位
+    DROP_OLDEST,  // 丢掉通道里最旧的一项，放入新项
+    SKIP          // 丢掉新来的这一项
+};
+
+/**
+ * @brief 放入通道的结果
+ */
+enum class PushResult {
+    ACCEPTED = 0,  // 放入成功
+    EVICTED,       // 放入成功，按DROP_OLDEST挤出的最旧一项换回给调用方
+    REJECTED       // 按SKIP丢弃或通道已关闭，这一项仍在调用方手里
+};
+
+/**
+ * @brief 单级统计信息，时间单位ms
+ */
+struct StageStats {
+    std::string name;
+    uint64_t processed = 0;       // 处理完成并交给下一级的数量，最后一级为处理完成的数量
+    uint64_t rejected = 0;        // 本级函数返回false而终止的数量
+    uint64_t dropped = 0;         // 输入通道因满而丢弃的数量
+    uint64_t forwardDropped = 0;  // 处理完成但下一级通道满了，按SKIP被拒绝或按DROP_OLDEST挤出一项的数量
+    double lastMs = 0.0;
+    double meanMs = 0.0;
+    double maxMs = 0.0;
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+};
+
+/**
+ * @brief 有界通道，容量在构造时确定，运行期间不分配内存
+ *
+ * 项只被移动，不被销毁重建：丢弃的项交还调用方，Item的移动构造不分配内存时整个通道不分配内存。
+ */
+template <typename Item>
+class StageChannel {
+   public:
+    StageChannel(const size_t capacity, const DropPolicy policy)
+        : m_items(std::max<size_t>(capacity, 1)), m_policy(policy) {}
+
+    /**
+     * @brief 按策略放入一项
+     * @param[in,out] item  放入的项；返回EVICTED时换成被挤出的最旧一项，REJECTED时不变
+     * @return PushResult
+     */
+    PushResult push(Item &item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_closed) {
+            return PushResult::REJECTED;
+        }
+        if (m_size == m_items.size()) {
+            switch (m_policy) {
+                case DropPolicy::BLOCK:
+                    m_notFull.wait(lock, [this] { return m_size < m_items.size() || m_closed; });
+                    if (m_closed) {
+                        return PushResult::REJECTED;
+                    }
+                    break;
+                case DropPolicy::DROP_OLDEST:
+                    // 新项放进最旧一项的位置，成为最新一项，最旧一项交还调用方
+                    std::swap(item, *m_items[m_head]);
+                    m_head = (m_head + 1) % m_items.size();
+                    ++m_dropped;
+                    m_notEmpty.notify_one();
+                    return PushResult::EVICTED;
+                case DropPolicy::SKIP:
+                    ++m_dropped;
+                    return PushResult::REJECTED;
+            }
+        }
+        m_items[(m_head + m_size) % m_items.size()].emplace(std::move(item));
+        ++m_size;
+        m_notEmpty.notify_one();
+        return PushResult::ACCEPTED;
+    }
+
+    /**
+     * @brief 阻塞取出一项
+     * @return true
+     * @return false    通道已关闭且为空
+     */
+    bool pop(Item &item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this] { return m_size > 0 || m_closed; });
+        if (m_size == 0) {
+            return false;
+        }
+        item = std::move(*m_items[m_head]);
+        m_items[m_head].reset();
+        m_head = (m_head + 1) % m_items.size();
+        --m_size;
+        m_notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_notEmpty.notify_all();
+        m_notFull.notify_all();
+    }
+
+    uint64_t dropped() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_dropped;
+    }
+
+   private:
+    std::vector<std::optional<Item>> m_items;
+    const DropPolicy m_policy;
+    size_t m_head = 0;
+    size_t m_size = 0;
+    uint64_t m_dropped = 0;
+    bool m_closed = false;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+};
+
+/**
+ * @brief 多级流水线
+ *
+ * 每级一个工作线程，从自己的输入通道取数据，执行完交给下一级的输入通道。
+ * 第N帧在推理时第N+1帧可以在前一级，第N-1帧可以在后一级，持续帧率由最慢的一级决定而不是各级之和。
+ * 各级处理同一种Item，Item里携带这一帧在各级之间传递的全部数据。
+ *
+ * 最后一级处理完、被某一级拒绝或被通道丢弃的项不销毁，用setReset设置的函数复位后放回回收池，
+ * acquire()从池里取出复用，Item里的vector等缓冲区保留容量，稳态下各级之间传递不分配内存。
+ * 回收池的容量为流水线里最多同时存在的项数，在start()时一次分配。
+ *
+ * @tparam Item 流水线中传递的数据，需可默认构造、可移动，移动构造和移动赋值不分配内存
+ */
+template <typename Item>
+class StagePipeline {
+   public:
+    // 返回false表示这一项到此为止，不再交给下一级
+    using StageFunc = std::function<bool(Item &)>;
+    // 回收时复位一项：释放帧句柄等占着外部资源的成员，缓冲区只清空不释放
+    using ResetFunc = std::function<void(Item &)>;
+
+    StagePipeline() = default;
+    ~StagePipeline() { stop(); }
+    StagePipeline(const StagePipeline &) = delete;
+    StagePipeline &operator=(const StagePipeline &) = delete;
+
+    /**
+     * @brief 追加一级，必须在start()之前调用
+     * @param[in] name      名称，用于统计输出
+     * @param[in] func      本级处理函数
+     * @param[in] capacity  本级输入通道容量
+     * @param[in] policy    本级输入通道满时的策略
+     */
+    StagePipeline &addStage(const std::string &name, StageFunc func, const size_t capacity = 1,
+                            const DropPolicy policy = DropPolicy::DROP_OLDEST) {
+        if (m_running) {
+            throw std::logic_error("StagePipeline: addStage after start");
+        }
+        m_stages.emplace_back(std::make_unique<Stage>(name, std::move(func), capacity, policy));
+        return *this;
+    }
+
+    /**
+     * @brief 设置回收时的复位函数，必须在start()之前调用；不设置时复位为默认构造的Item，不保留容量
+     */
+    StagePipeline &setReset(ResetFunc reset) {
+        if (m_running) {
+            throw std::logic_error("StagePipeline: setReset after start");
+        }
+        m_reset = std::move(reset);
+        return *this;
+    }
+
+    /**
+     * @brief 启动各级工作线程
+     */
+    void start() {
+        if (m_running || m_stages.empty()) {
+            return;
+        }
+        // 各级通道里的项 + 各级正在处理的一项 + 提交方手里的一项
+        size_t capacity = m_stages.size() + 1;
+        for (const auto &stage : m_stages) {
+            capacity += stage->m_capacity;
+        }
+        m_pool.reserve(capacity);
+        m_running = true;
+        for (size_t i = 0; i < m_stages.size(); ++i) {
+            Stage *stage = m_stages[i].get();
+            Stage *next = i + 1 < m_stages.size() ? m_stages[i + 1].get() : nullptr;
+            stage->m_worker = std::thread([this, stage, next]() { run(*stage, next); });
+        }
+    }
+
+    /**
+     * @brief 取一个复位过的项用于submit，回收池为空时（启动后的前几帧）返回默认构造的Item
+     */
+    Item acquire() {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        if (m_pool.empty()) {
+            return Item();
+        }
+        Item item(std::move(m_pool.back()));
+        m_pool.pop_back();
+        return item;
+    }
+
+    /**
+     * @brief 从第一级送入一项
+     * @return true     被第一级接收
+     * @return false    被丢弃或流水线已停止
+     */
+    bool submit(Item item) {
+        if (!m_running) {
+            return false;
+        }
+        const PushResult result = m_stages.front()->m_input.push(item);
+        if (result != PushResult::ACCEPTED) {
+            recycle(item);
+        }
+        return result != PushResult::REJECTED;
+    }
+
+    /**
+     * @brief 关闭全部通道并等待工作线程退出
+     */
+    void stop() {
+        if (!m_running) {
+            return;
+        }
+        m_running = false;
+        for (auto &stage : m_stages) {
+            stage->m_input.close();
+        }
+        for (auto &stage : m_stages) {
+            if (stage->m_worker.joinable()) {
+                stage->m_worker.join();
+            }
+        }
+    }
+
+    /**
+     * @brief 获取各级统计信息
+     */
+    std::vector<StageStats> stats() const {
+        std::vector<StageStats> result;
+        result.reserve(m_stages.size());
+        for (const auto &stage : m_stages) {
+            std::lock_guard<std::mutex> lock(stage->m_statsMutex);
+            StageStats stats = stage->m_stats;
+            stats.dropped = stage->m_input.dropped();
+            stats.p50Ms = stage->m_histogram.percentile(50.0f);
+            stats.p99Ms = stage->m_histogram.percentile(99.0f);
+            result.emplace_back(std::move(stats));
+        }
+        return result;
+    }
+
+    // 回收池里等待复用的项数
+    size_t pooled() const {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        return m_pool.size();
+    }
+
+    const size_t size() const { return m_stages.size(); }
+    const bool running() const { return m_running; }
+
+   private:
+    struct Stage {
+        Stage(const std::string &name, StageFunc func, const size_t capacity, const DropPolicy policy)
+            : m_func(std::move(func)), m_capacity(std::max<size_t>(capacity, 1)), m_input(capacity, policy) {
+            m_stats.name = name;
+        }
+        StageFunc m_func;
+        size_t m_capacity;
+        StageChannel<Item> m_input;
+        std::thread m_worker;
+        StageStats m_stats;
+        deploy::LatencyHistogram m_histogram;  // 内存固定，长时间运行不增长
+        mutable std::mutex m_statsMutex;
+    };
+
+    /**
+     * @brief 复位一项放回回收池；池满时（提交方自己构造了多于流水线容量的项）不放回，由调用方销毁
+     */
+    void recycle(Item &item) {
+        if (m_reset) {
+            m_reset(item);
+        } else {
+            item = Item();
+        }
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        if (m_pool.size() < m_pool.capacity()) {
+            m_pool.push_back(std::move(item));
+        }
+    }
+
+    void run(Stage &stage, Stage *next) {
+        HITCRT_TRACE_THREAD(stage.m_stats.name);
+#ifdef HITCRT_TRACE
+        const char *traceName = Tracer::intern(stage.m_stats.name);
+#endif
+        Item item;
+        while (stage.m_input.pop(item)) {
+            // 本级函数里用HITCRT_TRACE_FRAME标明帧序号，本级区间在结束时取到
+            HITCRT_TRACE_FRAME(Tracer::NO_FRAME);
+            const auto start = std::chrono::steady_clock::now();
+            bool pass;
+            {
+                HITCRT_TRACE_SCOPE(traceName);
+                pass = stage.m_func(item);
+            }
+            const double ms =
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            // 先交给下一级再计数，被下一级丢弃的项不算处理完成
+            const PushResult handoff =
+                pass && next != nullptr ? next->m_input.push(item) : PushResult::ACCEPTED;
+            {
+                std::lock_guard<std::mutex> lock(stage.m_statsMutex);
+                StageStats &stats = stage.m_stats;
+                if (!pass) {
+                    ++stats.rejected;
+                } else if (handoff == PushResult::ACCEPTED) {
+                    ++stats.processed;
+                } else {
+                    ++stats.forwardDropped;
+                }
+                stage.m_histogram.record(static_cast<float>(ms));
+                stats.lastMs = ms;
+                stats.maxMs = std::max(stats.maxMs, ms);
+                stats.meanMs = stage.m_histogram.mean();
+            }
+            // 交给下一级后item只剩移动后的空壳，下次pop直接覆盖；没交出去的或被挤出的复位后回收
+            if (!pass || next == nullptr || handoff != PushResult::ACCEPTED) {
+                recycle(item);
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Stage>> m_stages;
+    std::atomic<bool> m_running{false};
+    ResetFunc m_reset;
+    std::vector<Item> m_pool;  // 回收池，容量在start()时确定
+    mutable std::mutex m_poolMutex;
+};
+
+}  // namespace hitcrt
@@ -0,0 +1,256 @@
+/**
+ * @file Trace.cpp
+ * @brief 逐帧耗时追踪
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include "Trace.h"
+
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace hitcrt {
+
+namespace {
+thread_local TraceBuffer *localTraceBuffer = nullptr;
+thread_local uint64_t localTraceFrame = Tracer::NO_FRAME;
+
+/**
+ * @brief 写一个JSON字符串，转义引号、反斜杠和控制字符
+ */
+void writeString(std::FILE *file, const char *text) {
+    std::fputc('"', file);
+    for (const char *c = text; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            std::fputc('\\', file);
+            std::fputc(*c, file);
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            std::fprintf(file, "\\u%04x", *c);
+        } else {
+            std::fputc(*c, file);
+        }
+    }
+    std::fputc('"', file);
+}
+}  // namespace
+
+Tracer &Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::~Tracer() { stop(); }
+
+/**
+ * @brief 新建trace文件并启动写文件线程，开始之前各线程缓冲区里的旧区间丢弃
+ * @param[in] path              输出文件，Chrome的chrome://tracing或ui.perfetto.dev直接打开
+ * @param[in] flushIntervalMs   写文件间隔
+ * @return true
+ * @return false 已经开始
+ */
+bool Tracer::start(const std::string &path, const int flushIntervalMs) {
+    if (active() || m_writeThread.joinable()) {
+        return false;
+    }
+    m_file = std::fopen(path.c_str(), "w");
+    if (m_file == nullptr) {
+        throw std::runtime_error("Tracer: open " + path + " failed");
+    }
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", m_file);
+    m_firstEvent = true;
+    m_written = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        for (auto &buffer : m_buffers) {
+            buffer->m_tail.store(buffer->m_head.load(std::memory_order_acquire), std::memory_order_release);
+            buffer->m_dropped.store(0, std::memory_order_relaxed);
+        }
+    }
+    m_stopping = false;
+    m_active.store(true, std::memory_order_release);
+    m_writeThread = std::thread(&Tracer::writeLoop, this, std::max(flushIntervalMs, 1));
+    return true;
+}
+
+/**
+ * @brief 停止记录，写出剩余区间、线程名和文件尾
+ */
+void Tracer::stop() {
+    if (!m_writeThread.joinable()) {
+        return;
+    }
+    m_active.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_cond.notify_all();
+    m_writeThread.join();
+    writeMetadata();
+    std::fputs("\n]}\n", m_file);
+    std::fclose(m_file);
+    m_file = nullptr;
+}
+
+/**
+ * @brief 把一个区间写进本线程的缓冲区，满了丢弃
+ * @param[in] name      区间名，必须在stop()之前一直有效
+ * @param[in] frame     帧序号，NO_FRAME为不属于某一帧
+ */
+void Tracer::record(const char *name, const uint64_t frame, const int64_t beginNs, const int64_t endNs) {
+    if (!active()) {
+        return;
+    }
+    TraceBuffer *buffer = localBuffer();
+    const uint64_t head = buffer->m_head.load(std::memory_order_relaxed);
+    if (head - buffer->m_tail.load(std::memory_order_acquire) >= buffer->m_events.size()) {
+        buffer->m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->m_events[head & (buffer->m_events.size() - 1)] = TraceEvent{name, frame, beginNs, endNs};
+    buffer->m_head.store(head + 1, std::memory_order_release);
+}
+
+void Tracer::record(const char *name, const uint64_t frame, const TimePoint &begin, const TimePoint &end) {
+    record(name, frame, std::chrono::duration_cast<std::chrono::nanoseconds>(begin.time_since_epoch()).count(),
+           std::chrono::duration_cast<std::chrono::nanoseconds>(end.time_since_epoch()).count());
+}
+
+/**
+ * @brief 设置本线程在trace里的名字，同时设置内核线程名（截断到15个字符）便于top、perf查看
+ */
+void Tracer::setThreadName(const std::string &name) {
+    Tracer &tracer = instance();
+    TraceBuffer *buffer = tracer.localBuffer();
+    const char *interned = intern(name);
+    {
+        std::lock_guard<std::mutex> lock(tracer.m_registryMutex);
+        buffer->m_name = interned;
+    }
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+}
+
+/**
+ * @brief 设置本线程当前处理的帧，之后结束的区间都带这个序号，直到再次设置
+ */
+void Tracer::setFrame(const uint64_t frame) { localTraceFrame = frame; }
+
+uint64_t Tracer::frame() { return localTraceFrame; }
+
+/**
+ * @brief 保存一份字符串并返回不会失效的指针，用于运行时拼出的区间名
+ */
+const char *Tracer::intern(const std::string &name) {
+    Tracer &tracer = instance();
+    std::lock_guard<std::mutex> lock(tracer.m_registryMutex);
+    for (const auto &stored : tracer.m_names) {
+        if (stored == name) {
+            return stored.c_str();
+        }
+    }
+    tracer.m_names.push_back(name);
+    return tracer.m_names.back().c_str();
+}
+
+uint64_t Tracer::dropped() const {
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    uint64_t dropped = 0;
+    for (const auto &buffer : m_buffers) {
+        dropped += buffer->m_dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+/**
+ * @brief 本线程的缓冲区，第一次调用时创建并登记
+ */
+TraceBuffer *Tracer::localBuffer() {
+    if (localTraceBuffer == nullptr) {
+        auto buffer = std::make_shared<TraceBuffer>(BUFFER_CAPACITY);
+        buffer->m_tid = static_cast<int>(::syscall(SYS_gettid));
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        m_buffers.push_back(buffer);
+        localTraceBuffer = buffer.get();
+    }
+    return localTraceBuffer;
+}
+
+void Tracer::writeLoop(const int flushIntervalMs) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping) {
+        m_cond.wait_for(lock, std::chrono::milliseconds(flushIntervalMs), [this] { return m_stopping; });
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+    lock.unlock();
+    drain();
+    std::fflush(m_file);
+}
+
+/**
+ * @brief 取走各缓冲区里已写完的区间写进文件
+ */
+void Tracer::drain() {
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        buffers = m_buffers;
+    }
+    for (auto &buffer : buffers) {
+        const uint64_t tail = buffer->m_tail.load(std::memory_order_relaxed);
+        const uint64_t head = buffer->m_head.load(std::memory_order_acquire);
+        const uint64_t mask = buffer->m_events.size() - 1;
+        for (uint64_t i = tail; i < head; ++i) {
+            writeEvent(buffer->m_events[i & mask], buffer->m_tid);
+        }
+        buffer->m_tail.store(head, std::memory_order_release);
+    }
+}
+
+void Tracer::writeEvent(const TraceEvent &event, const int tid) {
+    std::fputs(m_firstEvent ? "" : ",\n", m_file);
+    m_firstEvent = false;
+    std::fputs("{\"ph\":\"X\",\"name\":", m_file);
+    writeString(m_file, event.m_name);
+    // 时间单位us，取steady_clock原值，与日志里的时间戳可以直接对照
+    std::fprintf(m_file, ",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f", static_cast<int>(::getpid()), tid,
+                 event.m_beginNs / 1e3, (event.m_endNs - event.m_beginNs) / 1e3);
+    if (event.m_frame != NO_FRAME) {
+        std::fprintf(m_file, ",\"args\":{\"frame\":%llu}", static_cast<unsigned long long>(event.m_frame));
+    }
+    std::fputc('}', m_file);
+    m_written.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief 写线程名的"M"事件，放在文件最后，Perfetto和Chrome都按pid、tid对应到轨道
+ */
+void Tracer::writeMetadata() {
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    for (const auto &buffer : m_buffers) {
+        if (buffer->m_name == nullptr) {
+            continue;
+        }
+        std::fputs(m_firstEvent ? "" : ",\n", m_file);
+        m_firstEvent = false;
+        std::fprintf(m_file, "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":",
+                     static_cast<int>(::getpid()), buffer->m_tid);
+        writeString(m_file, buffer->m_name);
+        std::fputs("}}", m_file);
+    }
+}
+
+}  // namespace hitcrt
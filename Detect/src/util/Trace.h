@@ -0,0 +1,163 @@
+/**
+ * @file Trace.h
+ * @brief 逐帧耗时追踪：每线程无锁缓冲区记录区间，后台线程写成Chrome trace / Perfetto可读的JSON
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Basic.h"
+
+/*
+ * 用法：
+ *   HITCRT_TRACE_THREAD("infer");          线程名，显示在trace的轨道上
+ *   HITCRT_TRACE_FRAME(handle.seq());      本线程接下来的区间属于这一帧
+ *   HITCRT_TRACE_SCOPE("nms");             记录到作用域结束
+ *   HITCRT_TRACE_SPAN("ingest", seq, begin, end);  起止时刻已知的区间
+ * 用Tracer::instance().start(path)开始写文件，stop()写完文件尾。
+ * 编译时没有定义HITCRT_TRACE（cmake -DENABLE_TRACE=ON）时这些宏展开为空，热路径上不留任何代码。
+ */
+#ifdef HITCRT_TRACE
+#define HITCRT_TRACE_CONCAT_INNER(a, b) a##b
+#define HITCRT_TRACE_CONCAT(a, b) HITCRT_TRACE_CONCAT_INNER(a, b)
+#define HITCRT_TRACE_SCOPE(name) const ::hitcrt::TraceScope HITCRT_TRACE_CONCAT(traceScope, __LINE__)(name)
+#define HITCRT_TRACE_FRAME(frame) ::hitcrt::Tracer::setFrame(frame)
+#define HITCRT_TRACE_SPAN(name, frame, begin, end) ::hitcrt::Tracer::instance().record(name, frame, begin, end)
+#define HITCRT_TRACE_THREAD(name) ::hitcrt::Tracer::setThreadName(name)
+#else
+#define HITCRT_TRACE_SCOPE(name) ((void)0)
+#define HITCRT_TRACE_FRAME(frame) ((void)0)
+#define HITCRT_TRACE_SPAN(name, frame, begin, end) ((void)0)
+#define HITCRT_TRACE_THREAD(name) ((void)0)
+#endif
+
+namespace hitcrt {
+
+// 一个区间
+struct TraceEvent {
+    const char *m_name;  // 字符串字面量或Tracer::intern返回的指针，写文件时才读
+    uint64_t m_frame;    // 帧序号，Tracer::NO_FRAME为不属于某一帧
+    int64_t m_beginNs;   // steady_clock
+    int64_t m_endNs;
+};
+
+/**
+ * @brief 单个线程的区间缓冲区，单生产者（所属线程）单消费者（写文件线程）的环形队列
+ *
+ * 满了丢弃新区间并计数，不阻塞所属线程。
+ */
+struct TraceBuffer {
+    explicit TraceBuffer(const size_t capacity) : m_events(capacity) {}
+
+    std::vector<TraceEvent> m_events;  // 容量为2的幂
+    alignas(64) std::atomic<uint64_t> m_head{0};  // 所属线程写入的总数
+    alignas(64) std::atomic<uint64_t> m_tail{0};  // 写文件线程取走的总数
+    std::atomic<uint64_t> m_dropped{0};
+    int m_tid = 0;                 // 内核线程号，与top、perf一致
+    const char *m_name = nullptr;  // 线程名，受Tracer::m_registryMutex保护
+};
+
+/**
+ * @brief 进程内唯一的追踪器
+ *
+ * 记录一个区间只写所属线程的缓冲区：两次读steady_clock加一次写入，没有锁和系统调用。
+ * 后台线程按间隔取走各缓冲区的区间写成JSON的"X"事件，args里带帧序号，
+ * 在Perfetto里按frame过滤就能看到一帧从收图到显示经过的各级及其间隔。
+ */
+class Tracer {
+   public:
+    // 帧环的序号从0开始，用最大值表示不属于某一帧
+    static constexpr uint64_t NO_FRAME = UINT64_MAX;
+
+    static Tracer &instance();
+
+    ~Tracer();
+    Tracer(const Tracer &) = delete;
+    Tracer &operator=(const Tracer &) = delete;
+
+    bool start(const std::string &path, const int flushIntervalMs = 100);
+    void stop();
+    bool active() const { return m_active.load(std::memory_order_relaxed); }
+
+    void record(const char *name, const uint64_t frame, const int64_t beginNs, const int64_t endNs);
+    void record(const char *name, const uint64_t frame, const TimePoint &begin, const TimePoint &end);
+
+    static void setThreadName(const std::string &name);
+    static void setFrame(const uint64_t frame);
+    static uint64_t frame();
+    static const char *intern(const std::string &name);
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    uint64_t written() const { return m_written.load(std::memory_order_relaxed); }
+    uint64_t dropped() const;
+
+   private:
+    // 每线程缓冲区容量：100ms取一次，每线程每秒几千个区间时远用不满
+    static constexpr size_t BUFFER_CAPACITY = 1 << 13;
+
+    Tracer() = default;
+    TraceBuffer *localBuffer();
+    void writeLoop(const int flushIntervalMs);
+    void drain();
+    void writeEvent(const TraceEvent &event, const int tid);
+    void writeMetadata();
+
+    std::atomic<bool> m_active{false};
+    mutable std::mutex m_registryMutex;
+    std::vector<std::shared_ptr<TraceBuffer>> m_buffers;  // 线程退出后缓冲区仍保留，剩余区间照常写出
+    std::deque<std::string> m_names;                      // intern的字符串，地址不变
+
+    std::FILE *m_file = nullptr;
+    bool m_firstEvent = true;
+    std::atomic<uint64_t> m_written{0};
+    std::thread m_writeThread;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_stopping = false;
+};
+
+/**
+ * @brief 从构造记录到析构，帧序号取析构时本线程的当前帧
+ *
+ * 追踪器没有开始时只读一次原子变量。
+ */
+class TraceScope {
+   public:
+    explicit TraceScope(const char *name) : m_name(name), m_beginNs(Tracer::instance().active() ? Tracer::nowNs() : -1) {}
+    ~TraceScope() {
+        if (m_beginNs >= 0) {
+            Tracer::instance().record(m_name, Tracer::frame(), m_beginNs, Tracer::nowNs());
+        }
+    }
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+   private:
+    const char *m_name;
+    const int64_t m_beginNs;
+};
+
+}  // namespace hitcrt
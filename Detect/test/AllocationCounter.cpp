@@ -0,0 +1,91 @@
+/**
+ * @file AllocationCounter.cpp
+ * @brief 替换malloc族，计数期间统计后转给glibc内部实现
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+
+namespace {
+std::atomic<bool> g_counting{false};
+std::atomic<long> g_allocations{0};
+std::atomic<long> g_bytes{0};
+std::atomic<long> g_largest{0};
+
+void countAllocation(const size_t size) {
+    if (!g_counting.load(std::memory_order_relaxed)) {
+        return;
+    }
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(static_cast<long>(size), std::memory_order_relaxed);
+    long largest = g_largest.load(std::memory_order_relaxed);
+    while (static_cast<long>(size) > largest &&
+           !g_largest.compare_exchange_weak(largest, static_cast<long>(size), std::memory_order_relaxed)) {
+    }
+}
+}  // namespace
+
+namespace hitcrt::test {
+
+AllocationStat countAllocations(const std::function<void()> &func) {
+    g_allocations = 0;
+    g_bytes = 0;
+    g_largest = 0;
+    g_counting = true;
+    func();
+    g_counting = false;
+    return AllocationStat{g_allocations.load(), g_bytes.load(), g_largest.load()};
+}
+
+}  // namespace hitcrt::test
+
+// glibc允许可执行文件替换malloc，operator new也经过这里
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+
+void *malloc(size_t size) noexcept {
+    countAllocation(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) noexcept {
+    countAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) noexcept {
+    countAllocation(size);
+    return __libc_realloc(ptr, size);
+}
+
+void *memalign(size_t alignment, size_t size) noexcept {
+    countAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) noexcept {
+    countAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **ptr, size_t alignment, size_t size) noexcept {
+    countAllocation(size);
+    *ptr = __libc_memalign(alignment, size);
+    return *ptr == nullptr ? ENOMEM : 0;
+}
+}
@@ -0,0 +1,33 @@
+/**
+ * @file AllocationCounter.h
+ * @brief 统计一段代码期间malloc族的调用，检查稳态零堆分配的测试共用
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#pragma once
+
+#include <functional>
+
+namespace hitcrt::test {
+
+/**
+ * @brief 一段代码的堆分配统计
+ */
+struct AllocationStat {
+    long m_allocations = 0;  // malloc族的调用次数，operator new和OpenCV的fastMalloc都会计入
+    long m_bytes = 0;        // 申请的字节数
+    long m_largest = 0;      // 最大的一次申请
+};
+
+// 统计func执行期间的堆分配，期间其他线程的申请也会计入
+AllocationStat countAllocations(const std::function<void()> &func);
+
+}  // namespace hitcrt::test
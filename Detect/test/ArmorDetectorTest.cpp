@@ -0,0 +1,83 @@
+/**
+ * @file ArmorDetectorTest.cpp
+ * @brief ArmorDetectorNN的线程约定：推理和解码可以在两个线程上同时进行，同一级被并发调用时抛异常
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "ArmorDetectorNN.h"
+#include "FakePoseBackend.h"
+
+namespace {
+constexpr int NET_SIZE = 640;
+
+const hitcrt::RecvInfoBase RECV_INFO(0.0, 0.0, 0.0, 25.0, hitcrt::BLUE, true);
+
+/**
+ * @brief 推理时通知测试线程已进入，等放行后才返回，用来让推理级一直处于占用状态
+ */
+class BlockingBackend : public hitcrt::bench::FakePoseBackend {
+   public:
+    BlockingBackend(std::promise<void> *entered, std::shared_future<void> release)
+        : FakePoseBackend(1, 4), m_entered(entered), m_release(std::move(release)) {
+        setDetection(0, 0, 3, 0.9f, 100.0f, 100.0f, 130.0f, 112.0f);
+        setNum(0, 1);
+    }
+
+    void infer(const std::vector<deploy::Image> &inputs) override {
+        updateTransforms(inputs);
+        if (m_entered != nullptr) {
+            m_entered->set_value();
+            m_entered = nullptr;
+            m_release.wait();
+        }
+    }
+
+   private:
+    std::promise<void> *m_entered;
+    std::shared_future<void> m_release;
+};
+}  // namespace
+
+// 推理级占用时解码另一帧的结果；推理级被第二个线程调用时抛异常
+TEST(ArmorDetectorNN, DecodeRunsWhileInferIsBusy) {
+    std::promise<void> entered;
+    std::promise<void> release;
+    hitcrt::ArmorDetectorNN detector(std::make_unique<deploy::PoseModel>(std::make_unique<BlockingBackend>(
+                                         &entered, release.get_future().share())),
+                                     0.5f);
+    const cv::Mat image(NET_SIZE, NET_SIZE, CV_8UC3, cv::Scalar::all(0));
+    const hitcrt::Frame frame(image, hitcrt::Clock::now());
+
+    deploy::PoseResView first;
+    std::thread inferThread([&] { detector.infer(frame, first); });
+    entered.get_future().wait();
+
+    deploy::PoseResView second;
+    std::vector<hitcrt::Armor> armors;
+    EXPECT_NO_THROW(detector.decode(second, frame, RECV_INFO, armors));
+    EXPECT_THROW(detector.infer(frame, second), std::logic_error);
+
+    release.set_value();
+    inferThread.join();
+    EXPECT_EQ(first.num, 1);
+    EXPECT_TRUE(detector.decode(first, frame, RECV_INFO, armors));
+    ASSERT_EQ(armors.size(), 1u);
+    // 两级都释放后可以再次推理
+    EXPECT_TRUE(detector.infer(frame, second));
+}
@@ -0,0 +1,141 @@
+/**
+ * @file ArmorNMSTest.cpp
+ * @brief 按类别分组的装甲板NMS：同分时的输出顺序、外接矩形与四边形重叠度、只在类内抑制、缓冲区复用
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "ArmorNMS.h"
+
+namespace {
+using hitcrt::ArmorNMS;
+using hitcrt::ArmorObservation;
+using hitcrt::NMSMode;
+
+constexpr float PI = 3.14159265358979323846f;
+
+/**
+ * @brief 中心(x, y)、长length宽width、长边与x轴夹角angle（弧度）的装甲板
+ */
+ArmorObservation quad(const float x, const float y, const float length, const float width, const float angle,
+                      const int classID, const double confidence) {
+    const cv::Point2f center(x, y);
+    const cv::Point2f u(std::cos(angle) * length * 0.5f, std::sin(angle) * length * 0.5f);
+    const cv::Point2f v(-std::sin(angle) * width * 0.5f, std::cos(angle) * width * 0.5f);
+    ArmorObservation armor;
+    armor.m_topLeft = center - u - v;
+    armor.m_topRight = center + u - v;
+    armor.m_bottomRight = center + u + v;
+    armor.m_bottomLeft = center - u + v;
+    armor.m_classID = classID;
+    armor.m_confidence = confidence;
+    return armor;
+}
+
+ArmorObservation box(const float x, const int classID, const double confidence) {
+    return quad(x, 100.0f, 40.0f, 16.0f, 0.0f, classID, confidence);
+}
+}  // namespace
+
+// 输出按(类别升序, 置信度降序, 下标升序)，置信度相同时与排序实现无关
+TEST(ArmorNMS, TiedScoresKeepInputOrder) {
+    const std::vector<ArmorObservation> armors = {box(0.0f, 2, 0.8), box(100.0f, 1, 0.5), box(200.0f, 2, 0.9),
+                                                  box(300.0f, 1, 0.5), box(400.0f, 2, 0.8), box(500.0f, 1, 0.7),
+                                                  box(600.0f, 1, 0.5)};
+    ArmorNMS nms;
+    const std::vector<int> expected = {5, 1, 3, 6, 2, 0, 4};
+    EXPECT_EQ(nms.run(armors.data(), static_cast<int>(armors.size())), expected);
+    // 再跑一次结果相同
+    EXPECT_EQ(nms.run(armors.data(), static_cast<int>(armors.size())), expected);
+}
+
+// 完全重叠、置信度相同的两个，保留下标小的
+TEST(ArmorNMS, TiedOverlapKeepsLowerIndex) {
+    const std::vector<ArmorObservation> armors = {box(300.0f, 1, 0.5), box(0.0f, 1, 0.6), box(0.0f, 1, 0.6)};
+    ArmorNMS nms;
+    const std::vector<int> expected = {1, 0};
+    EXPECT_EQ(nms.run(armors.data(), static_cast<int>(armors.size())), expected);
+}
+
+/*
+ * 两块沿45度方向摆放的细长装甲板，垂直方向错开两倍宽度：四边形不相交，外接矩形大部分重叠。
+ * 外接矩形模式会误删一个，四边形模式两个都保留
+ */
+TEST(ArmorNMS, RotatedQuadsPolygonAndAabbDisagree) {
+    const float length = 100.0f * std::sqrt(2.0f);
+    const float offset = 20.0f / std::sqrt(2.0f);
+    const std::vector<ArmorObservation> armors = {quad(50.0f, 50.0f, length, 10.0f, PI / 4, 3, 0.9),
+                                                  quad(50.0f + offset, 50.0f - offset, length, 10.0f, PI / 4, 3, 0.8)};
+    ArmorNMS aabb(NMSMode::AABB, 0.5f);
+    ArmorNMS polygon(NMSMode::POLYGON, 0.5f);
+    EXPECT_GT(aabb.iou(armors[0], armors[1]), 0.5f);
+    EXPECT_FLOAT_EQ(polygon.iou(armors[0], armors[1]), 0.0f);
+    EXPECT_EQ(aabb.run(armors.data(), 2), std::vector<int>({0}));
+    EXPECT_EQ(polygon.run(armors.data(), 2), std::vector<int>({0, 1}));
+}
+
+// 旋转的四边形沿长边平移半个长度，交集为一半面积，IoU为1/3；角点顺序反向时结果不变
+TEST(ArmorNMS, PolygonIouOfRotatedQuads) {
+    const float angle = 0.6f;
+    const ArmorObservation a = quad(200.0f, 150.0f, 80.0f, 20.0f, angle, 0, 0.9);
+    const ArmorObservation b = quad(200.0f + 20.0f * std::cos(angle) * 2.0f, 150.0f + 20.0f * std::sin(angle) * 2.0f,
+                                    80.0f, 20.0f, angle, 0, 0.8);
+    ArmorObservation flipped = b;
+    std::swap(flipped.m_topRight, flipped.m_bottomLeft);
+    const ArmorNMS nms(NMSMode::POLYGON);
+    EXPECT_NEAR(nms.iou(a, a), 1.0f, 1e-4f);
+    EXPECT_NEAR(nms.iou(a, b), 1.0f / 3.0f, 1e-3f);
+    EXPECT_NEAR(nms.iou(a, flipped), 1.0f / 3.0f, 1e-3f);
+}
+
+// 完全重叠但类别不同的不互相抑制
+TEST(ArmorNMS, SuppressesWithinClassOnly) {
+    std::vector<ArmorObservation> armors = {box(0.0f, 4, 0.6), box(0.0f, 3, 0.9), box(0.0f, 4, 0.7),
+                                            box(0.0f, 3, 0.5)};
+    ArmorNMS nms;
+    nms.apply(armors);
+    ASSERT_EQ(armors.size(), 2u);
+    EXPECT_EQ(armors[0].m_classID, 3);
+    EXPECT_DOUBLE_EQ(armors[0].m_confidence, 0.9);
+    EXPECT_EQ(armors[1].m_classID, 4);
+    EXPECT_DOUBLE_EQ(armors[1].m_confidence, 0.7);
+}
+
+// 候选数不超过之前的最大值时，run和apply都不分配堆内存
+TEST(ArmorNMS, ReusesScratchBuffers) {
+    std::vector<ArmorObservation> candidates;
+    for (int i = 0; i < 64; ++i) {
+        candidates.push_back(box(30.0f * i, i % 9, 0.5 + 0.001 * (i % 7)));
+    }
+    std::vector<ArmorObservation> armors;
+    armors.reserve(candidates.size());
+    ArmorNMS nms(NMSMode::POLYGON);
+    armors.assign(candidates.begin(), candidates.end());
+    nms.apply(armors);
+
+    size_t kept = 0;
+    const auto stat = hitcrt::test::countAllocations([&] {
+        for (int round = 0; round < 100; ++round) {
+            const int num = 16 + round % 48;
+            kept += nms.run(candidates.data(), num).size();
+            armors.assign(candidates.begin(), candidates.begin() + num);
+            nms.apply(armors);
+            kept += armors.size();
+        }
+    });
+    EXPECT_EQ(stat.m_allocations, 0);
+    EXPECT_GT(kept, 0u);
+}
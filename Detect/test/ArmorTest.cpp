@@ -0,0 +1,64 @@
+/**
+ * @file ArmorTest.cpp
+ * @brief Armor的解算结果放在堆上：未解算的拷贝不分配，已解算的深拷贝
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "ArmorBase.h"
+
+// 解算结果不占Armor本体
+TEST(Armor, SolutionIsStoredOutOfLine) { EXPECT_LT(sizeof(hitcrt::Armor), sizeof(hitcrt::ArmorSolution)); }
+
+// 未解算的装甲板拷贝只拷贝定长成员，不分配堆内存
+TEST(Armor, CopyingUnsolvedArmorDoesNotAllocate) {
+    hitcrt::Armor armor;
+    armor.m_classID = 3;
+    std::vector<hitcrt::Armor> armors(8);
+    const auto stat = hitcrt::test::countAllocations([&] {
+        for (int i = 0; i < 100; ++i) {
+            armors[i % armors.size()] = armor;
+        }
+    });
+    EXPECT_EQ(stat.m_allocations, 0);
+    EXPECT_FALSE(armors.front().solved());
+    EXPECT_EQ(armors.front().m_classID, 3);
+}
+
+// 已解算的拷贝互不影响；赋值给已解算的装甲板时原地拷贝，赋值为未解算时释放
+TEST(Armor, SolutionIsCopiedDeep) {
+    hitcrt::Armor solved;
+    solved.solution().m_transVec = Eigen::Vector3d(1.0, 2.0, 3.0);
+    ASSERT_TRUE(solved.solved());
+
+    hitcrt::Armor copy(solved);
+    ASSERT_TRUE(copy.solved());
+    copy.solution().m_transVec.x() = 9.0;
+    EXPECT_DOUBLE_EQ(solved.solution().m_transVec.x(), 1.0);
+
+    const hitcrt::ArmorSolution *address = &copy.solution();
+    const auto stat = hitcrt::test::countAllocations([&] { copy = solved; });
+    EXPECT_EQ(stat.m_allocations, 0);
+    EXPECT_EQ(&copy.solution(), address);
+    EXPECT_DOUBLE_EQ(copy.solution().m_transVec.x(), 1.0);
+
+    copy = hitcrt::Armor();
+    EXPECT_FALSE(copy.solved());
+
+    hitcrt::Armor moved(std::move(solved));
+    EXPECT_TRUE(moved.solved());
+    EXPECT_DOUBLE_EQ(moved.solution().m_transVec.z(), 3.0);
+}
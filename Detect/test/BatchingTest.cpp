@@ -0,0 +1,91 @@
+/**
+ * @file BatchingTest.cpp
+ * @brief 多相机批量推理：多路并发提交时每路拿回自己那一帧的类别、坐标和时间戳
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "BatchingDetector.h"
+#include "FakePoseBackend.h"
+
+namespace {
+using namespace std::chrono_literals;
+
+constexpr int NUM_SOURCES = 4;
+constexpr int FRAMES_PER_SOURCE = 30;
+constexpr int NET_SIZE = 640;
+
+// 每路每帧的图像：第一个像素为路号（即期望的类别），第二个像素为帧号（即期望的x坐标）
+cv::Mat makeImage(const int source, const int frame) {
+    cv::Mat image(NET_SIZE, NET_SIZE, CV_8UC3, cv::Scalar::all(0));
+    image.data[0] = static_cast<uint8_t>(source);
+    image.data[1] = static_cast<uint8_t>(frame);
+    return image;
+}
+}  // namespace
+
+TEST(BatchingDetector, ScattersEachResultToItsSource) {
+    auto model = std::make_unique<deploy::PoseModel>(std::make_unique<hitcrt::bench::PixelCodedBackend>(NUM_SOURCES, 1ms));
+    hitcrt::BatchingDetector batching(std::make_shared<hitcrt::ArmorDetectorNN>(std::move(model), 0.5f), NUM_SOURCES,
+                                      2ms);
+    const hitcrt::RecvInfoBase recvInfo(0.0, 0.0, 0.0, 25.0, hitcrt::BLUE, true);  // 敌方蓝色，类别0-8
+    const hitcrt::TimePoint epoch = hitcrt::Clock::now();
+    deploy::AffineTransform transform{};  // 原图与网络输入同尺寸，期望坐标由同一变换映射回原图
+    transform.updateMatrix(NET_SIZE, NET_SIZE, NET_SIZE, NET_SIZE);
+
+    std::atomic<int> errors{0};
+    std::vector<std::thread> cameras;
+    for (int s = 0; s < NUM_SOURCES; ++s) {
+        cameras.emplace_back([&, s] {
+            std::vector<hitcrt::Armor> result;
+            for (int f = 0; f < FRAMES_PER_SOURCE; ++f) {
+                const hitcrt::TimePoint stamp = epoch + std::chrono::milliseconds(1000 * s + f);
+                const cv::Mat image = makeImage(s, f);
+                const bool detected = batching.detect(s, hitcrt::Frame(image, stamp), recvInfo, result);
+                float expectedX = 0.0f, expectedY = 0.0f;
+                transform.applyTransform(static_cast<float>(f), 100.0f, &expectedX, &expectedY);
+                if (!detected || result.size() != 1 || result[0].m_classID != s || result[0].m_timeStamp != stamp ||
+                    std::abs(result[0].m_topLeft.x - expectedX) > 1e-3f) {
+                    ++errors;
+                }
+            }
+        });
+    }
+    for (auto &camera : cameras) {
+        camera.join();
+    }
+    batching.stop();
+
+    EXPECT_EQ(errors.load(), 0);
+    const auto stats = batching.stats();
+    EXPECT_GT(stats.m_batches, 0u);
+    EXPECT_LE(stats.meanBatchSize(), NUM_SOURCES);
+    // 四路同时提交，至少有一批不止一张图
+    EXPECT_GT(stats.meanBatchSize(), 1.0);
+}
+
+TEST(BatchingDetector, DetectAfterStopReturnsFalse) {
+    auto model = std::make_unique<deploy::PoseModel>(std::make_unique<hitcrt::bench::PixelCodedBackend>(2, 0ms));
+    hitcrt::BatchingDetector batching(std::make_shared<hitcrt::ArmorDetectorNN>(std::move(model), 0.5f), 2, 1ms);
+    batching.stop();
+    const cv::Mat image = makeImage(0, 0);
+    std::vector<hitcrt::Armor> result;
+    EXPECT_FALSE(batching.detect(0, hitcrt::Frame(image, hitcrt::Clock::now()),
+                                 hitcrt::RecvInfoBase(0.0, 0.0, 0.0, 25.0, hitcrt::BLUE, true), result));
+}
@@ -0,0 +1,162 @@
+/**
+ * @file BayerTest.cpp
+ * @brief Bayer原图2x2合并去马赛克与letterbox融合核：原图样例、与半分辨率BGR核一致、SIMD与参考实现一致
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "infer/affine.hpp"
+#include "infer/cpu_warpaffine.hpp"
+
+namespace {
+constexpr int SRC_WIDTH = 1280;
+constexpr int SRC_HEIGHT = 1024;
+constexpr int DST_SIZE = 640;
+constexpr float FLOAT_TOLERANCE = 1e-3f;
+constexpr float HALF_TOLERANCE = 2e-3f;
+}  // namespace
+
+/*
+ * 手写的4x4原图，两个2x2单元合并后的像素值已知
+ *
+ * 单元排列 R G / G B，合并后 B、R 取原值，G 取两个 G 的平均
+ */
+TEST(BayerWarpAffine, RawFixture) {
+    // clang-format off
+    const uint8_t raw[4 * 4] = {
+        200, 100,  10,  60,
+        120,  30,  90,  40,
+         50,  70, 250,   0,
+         80,  20,   1,   3,
+    };
+    // 合并后2x2，按(B, G, R)
+    const float expected[4][3] = {{30, 110, 200}, {40, 75, 10}, {20, 75, 50}, {3, 0.5f, 250}};
+    // clang-format on
+
+    // 输出像素(x, y)正好落在合并后像素(x, y)的中心：原图坐标 2x + 0.5
+    const deploy::float3 matrix[2] = {deploy::make_float3(2.0f, 0.0f, 0.5f), deploy::make_float3(0.0f, 2.0f, 0.5f)};
+    deploy::ProcessConfig config;
+    config.setNormalizeParams({0.0f, 0.0f, 0.0f}, {1.0f / 255.0f, 1.0f / 255.0f, 1.0f / 255.0f});  // 不归一化
+
+    for (const bool simd : {false, true}) {
+        SCOPED_TRACE(simd ? "simd" : "reference");
+        float out[3 * 4];
+        if (simd) {
+            deploy::cpuBayerWarpAffine(raw, 4, 4, out, 2, 2, matrix, config);
+        } else {
+            deploy::cpuBayerWarpAffineReference(raw, 4, 4, out, 2, 2, matrix, config);
+        }
+        for (int i = 0; i < 4; ++i) {
+            for (int c = 0; c < 3; ++c) {
+                EXPECT_NEAR(out[c * 4 + i], expected[i][c], 1e-3f) << "pixel " << i << " channel " << c;
+            }
+        }
+    }
+}
+
+/*
+ * 由半分辨率BGR图像生成原图（两个G取同一值），融合核在原图上的输出应等于BGR核在半分辨率图像上的输出
+ *
+ * 同时说明矩阵在全分辨率坐标下给出时，检测结果映射回的是原图坐标
+ */
+TEST(BayerWarpAffine, MatchesBgrKernelOnBinnedImage) {
+    std::mt19937 rng(2026);
+    const int half_cols = SRC_WIDTH / 2, half_rows = SRC_HEIGHT / 2;
+    std::vector<uint8_t> binned(static_cast<size_t>(half_cols) * half_rows * 3);
+    std::generate(binned.begin(), binned.end(), [&rng] { return static_cast<uint8_t>(rng()); });
+    std::vector<uint8_t> raw(static_cast<size_t>(SRC_WIDTH) * SRC_HEIGHT);
+    for (int y = 0; y < half_rows; ++y) {
+        for (int x = 0; x < half_cols; ++x) {
+            const uint8_t *bgr = &binned[(static_cast<size_t>(y) * half_cols + x) * 3];
+            uint8_t *top = &raw[static_cast<size_t>(2 * y) * SRC_WIDTH + 2 * x];
+            uint8_t *bottom = top + SRC_WIDTH;
+            top[0] = bgr[2];
+            top[1] = bgr[1];
+            bottom[0] = bgr[1];
+            bottom[1] = bgr[0];
+        }
+    }
+
+    deploy::AffineTransform full, half;
+    full.updateMatrix(SRC_WIDTH, SRC_HEIGHT, DST_SIZE, DST_SIZE);
+    half.updateMatrix(half_cols, half_rows, DST_SIZE, DST_SIZE);
+    deploy::ProcessConfig config;
+    config.enableSwapRB();
+
+    const size_t size = static_cast<size_t>(3) * DST_SIZE * DST_SIZE;
+    std::vector<float> fused(size), reference(size);
+    deploy::cpuBayerWarpAffine(raw.data(), SRC_WIDTH, SRC_HEIGHT, fused.data(), DST_SIZE, DST_SIZE, full.matrix, config);
+    deploy::cpuWarpAffineReference(binned.data(), half_cols, half_rows, reference.data(), DST_SIZE, DST_SIZE,
+                                   half.matrix, config);
+    float error = 0.0f;
+    for (size_t i = 0; i < size; ++i) {
+        error = std::max(error, std::fabs(fused[i] - reference[i]));
+    }
+    EXPECT_LE(error, FLOAT_TOLERANCE);
+}
+
+/*
+ * 随机原图、letterbox与带旋转的矩阵、不同输出宽度下检查SIMD实现与参考实现一致
+ */
+TEST(BayerWarpAffine, SimdMatchesReference) {
+    std::mt19937 rng(7);
+    const int sizes[][4] = {{SRC_WIDTH, SRC_HEIGHT, DST_SIZE, DST_SIZE}, {38, 54, 61, 45}, {2, 2, 13, 9}, {4, 2, 640, 7}};
+    for (const auto &size : sizes) {
+        const int cols = size[0], rows = size[1], dst_cols = size[2], dst_rows = size[3];
+        std::vector<uint8_t> raw(static_cast<size_t>(cols) * rows);
+        std::generate(raw.begin(), raw.end(), [&rng] { return static_cast<uint8_t>(rng()); });
+
+        for (int rotate = 0; rotate < 2; ++rotate) {
+            deploy::AffineTransform transform;
+            transform.updateMatrix(cols, rows, dst_cols, dst_rows);
+            deploy::float3 matrix[2] = {transform.matrix[0], transform.matrix[1]};
+            deploy::ProcessConfig config;
+            if (rotate) {
+                const float c = std::cos(0.3f), s = std::sin(0.3f);
+                matrix[0] = deploy::make_float3(1.8f * c, -2.0f * s, 9.3f);
+                matrix[1] = deploy::make_float3(2.0f * s, 2.2f * c, -13.1f);
+                config.enableSwapRB();
+            }
+            for (const auto type : {deploy::PlanarType::Float32, deploy::PlanarType::Float16}) {
+                const bool is_float = type == deploy::PlanarType::Float32;
+                const size_t count = static_cast<size_t>(3) * dst_cols * dst_rows;
+                std::vector<float> fused(count), reference(count);
+                if (is_float) {
+                    deploy::cpuBayerWarpAffine(raw.data(), cols, rows, fused.data(), dst_cols, dst_rows, matrix, config);
+                    deploy::cpuBayerWarpAffineReference(raw.data(), cols, rows, reference.data(), dst_cols, dst_rows,
+                                                        matrix, config);
+                } else {
+                    std::vector<uint16_t> fused_half(count), reference_half(count);
+                    deploy::cpuBayerWarpAffine(raw.data(), cols, rows, fused_half.data(), dst_cols, dst_rows, matrix,
+                                               config, type);
+                    deploy::cpuBayerWarpAffineReference(raw.data(), cols, rows, reference_half.data(), dst_cols,
+                                                        dst_rows, matrix, config, type);
+                    std::transform(fused_half.begin(), fused_half.end(), fused.begin(), deploy::halfToFloat);
+                    std::transform(reference_half.begin(), reference_half.end(), reference.begin(), deploy::halfToFloat);
+                }
+                float error = 0.0f;
+                for (size_t i = 0; i < count; ++i) {
+                    error = std::max(error, std::fabs(fused[i] - reference[i]));
+                }
+                EXPECT_LE(error, is_float ? FLOAT_TOLERANCE : HALF_TOLERANCE)
+                    << cols << "x" << rows << " -> " << dst_cols << "x" << dst_rows << (rotate ? " rotate" : " letterbox")
+                    << (is_float ? " fp32" : " fp16");
+            }
+        }
+    }
+}
@@ -0,0 +1,43 @@
+/**
+ * @file ClockMapperTest.cpp
+ * @brief 时钟域映射：合成时钟上检查漂移估计、映射误差和源时钟重置
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "ClockMapperSim.h"
+
+// 收敛后漂移估计误差在2ppm以内，映射误差远小于回调打戳的抖动
+TEST(ClockMapper, EstimatesDriftAndMapsExposure) {
+    const double drifts[] = {0.0, 80.0, -150.0};
+    for (const double drift : drifts) {
+        SCOPED_TRACE(drift);
+        std::vector<double> mapped;
+        std::vector<double> received;
+        const double estimate = hitcrt::bench::runClock(drift, 60, mapped, received);
+        const hitcrt::bench::ErrorStat stat = hitcrt::bench::statOf(mapped);
+        EXPECT_NEAR(estimate, drift, 2.0);
+        EXPECT_LT(stat.m_p99, 50.0);
+        EXPECT_LT(stat.m_max, 100.0);
+    }
+}
+
+// 相机重启后源时钟归零，立即重置并重新收敛
+TEST(ClockMapper, ResetsOnSourceClockRestart) {
+    hitcrt::camera::ClockMapper mapper;
+    const int64_t lastError = hitcrt::bench::runReset(mapper);
+    EXPECT_EQ(mapper.resets(), 1u);
+    EXPECT_LT(std::llabs(lastError), 100000);
+}
@@ -0,0 +1,148 @@
+/**
+ * @file HistogramTest.cpp
+ * @brief 耗时直方图：分桶、分位数误差上界、合并、时间窗口
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "utils/histogram.hpp"
+
+namespace {
+using deploy::LatencyHistogram;
+using deploy::WindowedHistogram;
+
+constexpr int SAMPLES = 1000000;
+const std::vector<float> PERCENTILES = {0.0f, 1.0f, 50.0f, 90.0f, 99.0f, 99.9f, 99.99f, 100.0f};
+
+/**
+ * @brief 与排序后的精确样本比较，各分位数的相对误差不超过kMaxRelativeError，最小、最大、平均值精确；
+ *        按1:2拆成两个直方图再合并，分位数与整体记录的完全一致
+ */
+void checkQuantiles(const std::function<int64_t(std::mt19937_64 &)> &draw) {
+    std::mt19937_64 rng(42);
+    std::vector<int64_t> samples(SAMPLES);
+    LatencyHistogram histogram, first, second;
+    double sum = 0.0;
+    for (int i = 0; i < SAMPLES; ++i) {
+        samples[i] = std::clamp<int64_t>(draw(rng), 0, LatencyHistogram::kMaxTrackableNs);
+        histogram.recordNs(samples[i]);
+        (i % 3 == 0 ? first : second).recordNs(samples[i]);
+        sum += samples[i];
+    }
+    first.merge(second);
+    std::sort(samples.begin(), samples.end());
+
+    EXPECT_EQ(histogram.count(), static_cast<uint64_t>(SAMPLES));
+    EXPECT_LE(std::fabs(histogram.min() - samples.front() * 1e-6f), 1e-6f);
+    EXPECT_LE(std::fabs(histogram.max() - samples.back() * 1e-6f), samples.back() * 1e-6f * 1e-6f);
+    EXPECT_LE(std::fabs(histogram.mean() - sum / SAMPLES * 1e-6), sum / SAMPLES * 1e-6 * 1e-5);
+    for (const float p : PERCENTILES) {
+        SCOPED_TRACE(p);
+        const auto rank = std::max<size_t>(1, static_cast<size_t>(std::ceil(p / 100.0 * SAMPLES - 1e-9)));
+        const double exact = samples[rank - 1] * 1e-6;
+        // 中点到桶内任一值的距离不超过半个桶宽；再留float输出的舍入和1ns的整数中点
+        const double bound = exact * (LatencyHistogram::kMaxRelativeError + 1e-6) + 1e-6;
+        EXPECT_LE(std::fabs(histogram.percentile(p) - exact), bound);
+        EXPECT_EQ(first.percentile(p), histogram.percentile(p));
+    }
+}
+}  // namespace
+
+// 每个值落在所在桶的范围内，桶宽不超过下界的1/128，桶号随值单调不减
+TEST(LatencyHistogram, BucketsCoverValuesWithBoundedWidth) {
+    std::mt19937_64 rng(1);
+    std::vector<int64_t> values;
+    for (int64_t v = 0; v < 4096; ++v) {
+        values.push_back(v);
+    }
+    for (int i = 0; i < 200000; ++i) {
+        values.push_back(static_cast<int64_t>(rng() % LatencyHistogram::kMaxTrackableNs));
+    }
+    for (int shift = 12; shift < LatencyHistogram::kMaxMagnitude; ++shift) {
+        values.push_back((int64_t{1} << shift) - 1);
+        values.push_back(int64_t{1} << shift);
+    }
+    std::sort(values.begin(), values.end());
+    int previous = -1;
+    for (const int64_t v : values) {
+        const int index = LatencyHistogram::bucketIndex(v);
+        const int64_t lower = LatencyHistogram::bucketLower(index);
+        const int64_t width = LatencyHistogram::bucketWidth(index);
+        ASSERT_GE(index, 0) << v;
+        ASSERT_LT(index, LatencyHistogram::kBucketCount) << v;
+        ASSERT_LE(lower, v);
+        ASSERT_LT(v, lower + width);
+        ASSERT_TRUE(width == 1 || width * LatencyHistogram::kSubBucketCount <= lower) << v;
+        ASSERT_GE(index, previous) << v;
+        previous = index;
+    }
+}
+
+TEST(LatencyHistogram, QuantilesLognormal) {
+    checkQuantiles([](std::mt19937_64 &rng) {
+        return static_cast<int64_t>(std::lognormal_distribution<double>(std::log(5e6), 0.4)(rng));
+    });
+}
+
+TEST(LatencyHistogram, QuantilesUniform) {
+    checkQuantiles([](std::mt19937_64 &rng) {
+        return static_cast<int64_t>(std::uniform_real_distribution<double>(1e5, 4e7)(rng));
+    });
+}
+
+TEST(LatencyHistogram, QuantilesBimodal) {
+    checkQuantiles([](std::mt19937_64 &rng) {
+        return static_cast<int64_t>(rng() % 100 < 97 ? std::normal_distribution<double>(3e6, 2e5)(rng)
+                                                     : std::normal_distribution<double>(2.5e7, 3e6)(rng));
+    });
+}
+
+TEST(LatencyHistogram, QuantilesSubMicrosecond) {
+    checkQuantiles([](std::mt19937_64 &rng) { return static_cast<int64_t>(rng() % 300); });
+}
+
+TEST(LatencyHistogram, QuantilesHeavyTail) {
+    checkQuantiles([](std::mt19937_64 &rng) {
+        const double u = std::uniform_real_distribution<double>(1e-9, 1.0)(rng);
+        return static_cast<int64_t>(1e6 / std::pow(u, 1.0 / 1.2));
+    });
+}
+
+// 窗口外的片在快照中不出现，被复用时清空
+TEST(WindowedHistogram, ExpiresSlicesOutsideWindow) {
+    using Clock = WindowedHistogram::Clock;
+    const Clock::time_point t0{std::chrono::hours(1)};
+    WindowedHistogram window(std::chrono::seconds(10), 5);
+    LatencyHistogram snapshot;
+    for (int i = 0; i < 100; ++i) {
+        window.record(100.0f, t0 + std::chrono::milliseconds(i));
+    }
+    window.snapshot(snapshot, t0 + std::chrono::seconds(5));
+    EXPECT_EQ(snapshot.count(), 100u);
+    EXPECT_GT(snapshot.max(), 99.0f);
+    for (int i = 0; i < 50; ++i) {
+        window.record(1.0f, t0 + std::chrono::seconds(30) + std::chrono::milliseconds(i));
+    }
+    window.snapshot(snapshot, t0 + std::chrono::seconds(30));
+    EXPECT_EQ(snapshot.count(), 50u);
+    EXPECT_LT(snapshot.max(), 1.01f);
+    window.snapshot(snapshot, t0 + std::chrono::seconds(45));
+    EXPECT_EQ(snapshot.count(), 0u);
+}
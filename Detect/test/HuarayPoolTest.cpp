@@ -0,0 +1,211 @@
+/**
+ * @file HuarayPoolTest.cpp
+ * @brief Huaray取图缓冲池：驱动源码在SDK替身上运行，检查稳态零分配、句柄持有与归还
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "HuarayCam.h"
+#include "IMVShim.h"
+
+namespace {
+constexpr int WIDTH = 1280;
+constexpr int HEIGHT = 1024;
+constexpr int WARMUP = 10;
+constexpr int FRAMES = 200;
+
+/**
+ * @brief 把受保护的格式转换接口公开出来，直接测SDK转换
+ */
+class ShimHuaray : public hitcrt::camera::Huaray {
+   public:
+    using Huaray::sdkCvtMatBGR8;
+};
+
+// 每帧原图的像素都等于帧号，最近邻去马赛克后BGR三通道也都等于帧号
+std::vector<std::vector<uint8_t>> makeRawFrames(const int count) {
+    std::vector<std::vector<uint8_t>> frames;
+    for (int i = 0; i < count; ++i) {
+        frames.emplace_back(static_cast<size_t>(WIDTH) * HEIGHT, static_cast<uint8_t>(i + 1));
+    }
+    return frames;
+}
+
+hitcrt::camera::HuarayParams makeParams(const hitcrt::camera::Mode mode, const bool rawBayer,
+                                        const hitcrt::camera::CallBack &onCall) {
+    hitcrt::camera::HuarayParams params(onCall, 1, mode, WIDTH, HEIGHT, 0, 50, 0, 0, 5000.0, 1.0, 1.0,
+                                        {1.0, 1.0, 1.0});
+    params.setRawBayer(rawBayer);
+    return params;
+}
+
+/**
+ * @brief 拉流回调模式：回调里拿到的图像来自缓冲池，稳态没有图像大小的申请
+ * @param[in] rawBayer  原图模式下只做拷贝，必须零分配；BGR模式下OpenCV内部可能有小的临时申请
+ */
+void checkStream(const bool rawBayer, const std::vector<std::vector<uint8_t>> &raws) {
+    hitcrt::camera::imvshim::reset(WIDTH, HEIGHT);
+    long received = 0;
+    bool inPool = true;
+    hitcrt::camera::Huaray *camera = nullptr;
+    auto onCall = [&](const hitcrt::camera::TimePoint &, const cv::Mat &image) {
+        ++received;
+        const auto *pool = camera->framePool();
+        inPool = inPool && image.data != nullptr && pool->fits(image.cols, image.rows, rawBayer ? CV_8UC1 : CV_8UC3);
+    };
+    hitcrt::camera::Huaray cam;
+    camera = &cam;
+    ASSERT_TRUE(cam.initiate(makeParams(hitcrt::camera::STREAM, rawBayer, onCall)));
+    for (int i = 0; i < WARMUP; ++i) {
+        hitcrt::camera::imvshim::deliver(raws[i % raws.size()].data(), i);
+    }
+    const auto stat = hitcrt::test::countAllocations([&] {
+        for (int i = 0; i < FRAMES; ++i) {
+            hitcrt::camera::imvshim::deliver(raws[i % raws.size()].data(), WARMUP + i);
+        }
+    });
+    EXPECT_EQ(received, WARMUP + FRAMES);
+    EXPECT_TRUE(inPool);
+    EXPECT_EQ(cam.framePool()->inUse(), 0);
+    if (rawBayer) {
+        EXPECT_EQ(stat.m_allocations, 0);
+    } else {
+        const long imageBytes = static_cast<long>(WIDTH) * HEIGHT * 3;
+        EXPECT_LT(stat.m_largest, imageBytes);
+    }
+    cam.terminate();
+}
+}  // namespace
+
+TEST(HuarayFramePool, StreamRawBayerDoesNotAllocate) { checkStream(true, makeRawFrames(8)); }
+
+// BGR模式下OpenCV内部可能有小的临时申请，但不会有图像大小的申请
+TEST(HuarayFramePool, StreamBgrHasNoImageSizedAllocation) { checkStream(false, makeRawFrames(8)); }
+
+// SDK转换：直接写进槽位，不再逐帧malloc；持有的句柄在后续转换中不被覆盖
+TEST(HuarayFramePool, SdkConvertWritesIntoSlots) {
+    const auto raws = makeRawFrames(8);
+    hitcrt::camera::imvshim::reset(WIDTH, HEIGHT);
+    hitcrt::camera::FramePool pool(4, WIDTH, HEIGHT, CV_8UC3);
+    IMV_Frame frame;
+    std::memset(&frame, 0, sizeof(frame));
+    frame.frameInfo.width = WIDTH;
+    frame.frameInfo.height = HEIGHT;
+    frame.frameInfo.size = WIDTH * HEIGHT;
+    frame.frameInfo.pixelFormat = gvspPixelBayRG8;
+    IMV_HANDLE handle = nullptr;
+    IMV_CreateHandle(&handle, modeByIndex, nullptr);
+
+    bool ok = true;
+    const auto convert = [&](const int index) {
+        frame.pData = const_cast<uint8_t *>(raws[index % raws.size()].data());
+        return ShimHuaray::sdkCvtMatBGR8(frame, handle, pool);
+    };
+    for (int i = 0; i < WARMUP; ++i) {
+        ok = convert(i).first && ok;
+    }
+    const auto stat = hitcrt::test::countAllocations([&] {
+        for (int i = 0; i < FRAMES; ++i) {
+            ok = convert(i).first && ok;
+        }
+    });
+    EXPECT_EQ(stat.m_allocations, 0);
+    EXPECT_EQ(pool.inUse(), 0);
+
+    // 下游持有3帧，再转换若干帧，持有的图像内容不变
+    std::vector<hitcrt::camera::FrameBuffer> held;
+    for (int i = 0; i < 3; ++i) {
+        held.push_back(convert(i).second);
+    }
+    for (int i = 3; i < 20; ++i) {
+        ok = convert(i).first && ok;
+    }
+    EXPECT_TRUE(ok);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_FALSE(held[i].empty());
+        const cv::Mat &image = held[i].image();
+        EXPECT_EQ(image.data[0], i + 1);
+        EXPECT_EQ(image.data[WIDTH * HEIGHT * 3 - 1], i + 1);
+    }
+}
+
+// 回调传出句柄：下游占满缓冲池时丢帧并计数，释放后槽位回到池里
+TEST(HuarayFramePool, HeldHandlesDropAndReuseSlots) {
+    const auto raws = makeRawFrames(8);
+    hitcrt::camera::imvshim::reset(WIDTH, HEIGHT);
+    std::vector<hitcrt::camera::FrameBuffer> held;
+    held.reserve(16);
+    auto params = makeParams(hitcrt::camera::STREAM, true, hitcrt::camera::CameraParams::noUse);
+    params.setOnFrame([&](const hitcrt::camera::TimePoint &, const hitcrt::camera::FrameBuffer &buffer) {
+        held.push_back(buffer);
+    });
+    hitcrt::camera::Huaray cam;
+    ASSERT_TRUE(cam.initiate(params));
+    const auto *pool = cam.framePool();
+    for (int i = 0; i < pool->capacity() + 2; ++i) {
+        hitcrt::camera::imvshim::deliver(raws[i % raws.size()].data(), i);
+    }
+    EXPECT_EQ(static_cast<int>(held.size()), pool->capacity());
+    EXPECT_EQ(pool->dropped(), 2u);
+    EXPECT_EQ(pool->inUse(), pool->capacity());
+    for (size_t i = 0; i < held.size(); ++i) {
+        for (size_t j = i + 1; j < held.size(); ++j) {
+            EXPECT_NE(held[i].image().data, held[j].image().data);
+        }
+    }
+    const uint8_t *released = held.front().image().data;
+    held.erase(held.begin());
+    hitcrt::camera::imvshim::deliver(raws[0].data(), 100);
+    EXPECT_EQ(held.back().image().data, released);
+    EXPECT_EQ(pool->dropped(), 2u);
+    held.clear();
+    EXPECT_EQ(pool->inUse(), 0);
+    cam.terminate();
+}
+
+// 多线程取图：getFrameImage取取图线程转换好的帧，SDK缓冲区全部归还
+TEST(HuarayFramePool, GetFrameImageReleasesSdkFrames) {
+    const auto raws = makeRawFrames(8);
+    hitcrt::camera::imvshim::reset(WIDTH, HEIGHT);
+    hitcrt::camera::Huaray cam;
+    ASSERT_TRUE(cam.initiate(makeParams(hitcrt::camera::STREAM_MULTITHREAD, true,
+                                        hitcrt::camera::CameraParams::noUse)));
+    bool ok = true;
+    const auto grab = [&](const int index) {
+        hitcrt::camera::imvshim::queue(raws[index % raws.size()].data(), index);
+        // getFrameImage只等TIMEOUT_MS，单核机器上取图线程可能还没被调度到，多等几次
+        auto result = cam.getFrameImage();
+        for (int retry = 0; retry < 20 && !std::get<0>(result); ++retry) {
+            result = cam.getFrameImage();
+        }
+        ok = ok && std::get<0>(result) && !std::get<2>(result).empty();
+    };
+    for (int i = 0; i < WARMUP; ++i) {
+        grab(i);
+    }
+    const auto stat = hitcrt::test::countAllocations([&] {
+        for (int i = 0; i < FRAMES; ++i) {
+            grab(i);
+        }
+    });
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(stat.m_allocations, 0);
+    // 取图线程一直持有最新一帧
+    EXPECT_EQ(cam.framePool()->inUse(), 1);
+    EXPECT_EQ(hitcrt::camera::imvshim::releasedFrames(), static_cast<uint64_t>(WARMUP + FRAMES));
+    cam.terminate();
+}
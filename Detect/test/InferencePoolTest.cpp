@@ -0,0 +1,120 @@
+/**
+ * @file InferencePoolTest.cpp
+ * @brief 推理池：结果对应到自己的帧、慢副本的任务被窃取、三种背压策略丢掉的帧
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "FakePoseBackend.h"
+#include "InferencePool.h"
+
+namespace {
+using namespace std::chrono_literals;
+
+constexpr int NET_SIZE = 640;
+constexpr int NUM_FRAMES = 80;
+
+const hitcrt::RecvInfoBase RECV_INFO(0.0, 0.0, 0.0, 25.0, hitcrt::BLUE, true);
+
+// 第一个实例的单帧耗时为firstLatency，克隆出的副本为latency
+std::unique_ptr<deploy::PoseModel> makeModel(const std::chrono::microseconds latency,
+                                             const std::chrono::microseconds firstLatency) {
+    auto backend = std::make_unique<hitcrt::bench::PixelCodedBackend>(1, firstLatency);
+    backend->setCloneLatency(latency);
+    return std::make_unique<deploy::PoseModel>(std::move(backend));
+}
+
+// 第一个像素为帧号对5取余，即期望的类别（敌方蓝色，类别0-4都保留）
+cv::Mat makeImage(const int index) {
+    cv::Mat image(NET_SIZE, NET_SIZE, CV_8UC3, cv::Scalar::all(0));
+    image.data[0] = static_cast<uint8_t>(index % 5);
+    return image;
+}
+
+/**
+ * @brief 连续提交NUM_FRAMES帧，返回类别或时间戳与自己那一帧不符的结果数
+ */
+int submitAll(hitcrt::InferencePool &pool) {
+    const hitcrt::TimePoint epoch = hitcrt::Clock::now();
+    std::vector<cv::Mat> images;
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        images.push_back(makeImage(i));
+    }
+    std::vector<std::future<hitcrt::InferenceResult>> futures;
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        futures.push_back(pool.submit(hitcrt::Frame(images[i], epoch + std::chrono::microseconds(i)), RECV_INFO));
+    }
+    int errors = 0;
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        const auto result = futures[i].get();
+        if (result.m_dropped || !result.m_detected || result.m_armors.size() != 1 ||
+            result.m_armors[0].m_classID != i % 5 || result.m_timeStamp != epoch + std::chrono::microseconds(i)) {
+            ++errors;
+        }
+    }
+    return errors;
+}
+
+/**
+ * @brief 唯一的工作线程被第0帧占住时突发提交，返回被背压策略丢掉的帧号
+ */
+std::vector<int> burst(const hitcrt::DropPolicy policy, const size_t capacity, const int count) {
+    hitcrt::InferencePool pool(makeModel(20ms, 20ms), 0.5f, 1, capacity, policy);
+    const hitcrt::TimePoint epoch = hitcrt::Clock::now();
+    std::vector<cv::Mat> images;
+    std::vector<std::future<hitcrt::InferenceResult>> futures;
+    images.push_back(makeImage(0));
+    futures.push_back(pool.submit(hitcrt::Frame(images[0], epoch), RECV_INFO));
+    std::this_thread::sleep_for(5ms);
+    for (int i = 1; i <= count; ++i) {
+        images.push_back(makeImage(i));
+        futures.push_back(pool.submit(hitcrt::Frame(images[i], epoch + std::chrono::microseconds(i)), RECV_INFO));
+    }
+    std::vector<int> dropped;
+    for (int i = 0; i <= count; ++i) {
+        if (futures[i].get().m_dropped) {
+            dropped.push_back(i);
+        }
+    }
+    return dropped;
+}
+}  // namespace
+
+TEST(InferencePool, ResultsMatchTheirFrames) {
+    for (const int workers : {1, 4}) {
+        hitcrt::InferencePool pool(makeModel(1ms, 1ms), 0.5f, workers, NUM_FRAMES, hitcrt::DropPolicy::BLOCK);
+        EXPECT_EQ(submitAll(pool), 0) << "workers = " << workers;
+        EXPECT_EQ(pool.stats().m_completed, static_cast<uint64_t>(NUM_FRAMES));
+    }
+}
+
+TEST(InferencePool, IdleWorkersStealFromSlowReplica) {
+    // 第一个副本比其他副本慢4倍
+    hitcrt::InferencePool pool(makeModel(2ms, 8ms), 0.5f, 4, NUM_FRAMES, hitcrt::DropPolicy::BLOCK);
+    EXPECT_EQ(submitAll(pool), 0);
+    const auto stats = pool.stats();
+    EXPECT_GT(stats.m_stolen, 0u);
+    EXPECT_EQ(stats.m_completed, static_cast<uint64_t>(NUM_FRAMES));
+}
+
+TEST(InferencePool, BackpressurePolicies) {
+    // 容量2，工作线程忙时突发提交6帧
+    EXPECT_EQ(burst(hitcrt::DropPolicy::SKIP, 2, 6), (std::vector<int>{3, 4, 5, 6}));
+    EXPECT_EQ(burst(hitcrt::DropPolicy::DROP_OLDEST, 2, 6), (std::vector<int>{1, 2, 3, 4}));
+    EXPECT_TRUE(burst(hitcrt::DropPolicy::BLOCK, 2, 6).empty());
+}
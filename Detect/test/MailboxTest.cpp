@@ -0,0 +1,113 @@
+/**
+ * @file MailboxTest.cpp
+ * @brief 最新帧信箱：多生产者全速发布时的序号单调、内容完整和计数平衡
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "LatestFrameMailbox.h"
+
+namespace {
+constexpr int MAX_PRODUCERS = 4;
+
+struct Stamp {
+    uint32_t producer = 0;
+    uint64_t seq = 0;
+    uint64_t check = 0;
+};
+
+uint64_t checksum(uint32_t producer, uint64_t seq) { return (seq * 0x9E3779B97F4A7C15ULL) ^ producer; }
+
+/**
+ * @brief 生产者全速发布，消费者检查每个生产者的序号单调且内容未撕裂
+ */
+void stress(const int producers, const uint64_t perProducer) {
+    hitcrt::LatestFrameMailbox<Stamp, MAX_PRODUCERS> mailbox;
+    std::atomic<int> running{producers};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        auto producer = p == 0 ? decltype(mailbox.producer())() : mailbox.producer();
+        threads.emplace_back([&mailbox, &running, producer, p, perProducer]() mutable {
+            for (uint64_t seq = 1; seq <= perProducer; ++seq) {
+                const Stamp stamp{static_cast<uint32_t>(p), seq, checksum(p, seq)};
+                if (p == 0) {
+                    mailbox.publish(stamp);
+                } else {
+                    producer.publish(stamp);
+                }
+            }
+            running.fetch_sub(1);
+        });
+    }
+
+    std::vector<uint64_t> lastSeq(producers, 0);
+    uint64_t torn = 0, reordered = 0, received = 0;
+    Stamp stamp;
+    auto check = [&]() {
+        ++received;
+        if (stamp.check != checksum(stamp.producer, stamp.seq)) {
+            ++torn;
+        }
+        if (stamp.seq <= lastSeq[stamp.producer]) {
+            ++reordered;
+        }
+        lastSeq[stamp.producer] = stamp.seq;
+    };
+    while (running.load() > 0) {
+        if (mailbox.try_consume(stamp)) {
+            check();
+        }
+    }
+    while (mailbox.try_consume(stamp)) {
+        check();
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(torn, 0u);
+    EXPECT_EQ(reordered, 0u);
+    EXPECT_EQ(received, mailbox.consumed());
+    EXPECT_EQ(mailbox.published(), producers * perProducer);
+    EXPECT_EQ(mailbox.published(), mailbox.consumed() + mailbox.overwritten());
+    // 最后一帧一定能取到
+    for (int p = 0; p < producers; ++p) {
+        if (lastSeq[p] == perProducer) {
+            return;
+        }
+    }
+    ADD_FAILURE() << "no producer's last frame was consumed";
+}
+}  // namespace
+
+TEST(LatestFrameMailbox, SingleProducerStress) { stress(1, 200000); }
+
+TEST(LatestFrameMailbox, MultiProducerStress) {
+    for (int producers = 2; producers <= MAX_PRODUCERS; ++producers) {
+        stress(producers, 200000);
+    }
+}
+
+TEST(LatestFrameMailbox, StopWakesConsumer) {
+    hitcrt::LatestFrameMailbox<Stamp> mailbox;
+    std::thread consumer([&mailbox]() {
+        Stamp stamp;
+        EXPECT_FALSE(mailbox.consume(stamp));
+    });
+    mailbox.stop();
+    consumer.join();
+}
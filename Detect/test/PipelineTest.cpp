@@ -0,0 +1,215 @@
+/**
+ * @file PipelineTest.cpp
+ * @brief 多级流水线：通道丢弃的项交还调用方，交接时被丢弃的项不计为处理完成，检测流水线回收任务后稳态零堆分配
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "ArmorDetectorNN.h"
+#include "FakePoseBackend.h"
+#include "FrameRing.h"
+#include "StagePipeline.h"
+
+namespace {
+constexpr int NET_SIZE = 640;
+constexpr int NUM_DETECTIONS = 6;
+constexpr int BURST = 3;
+constexpr int WARMUP_BURSTS = 10;
+constexpr int BURSTS = 200;
+
+const hitcrt::RecvInfoBase RECV_INFO(0.0, 0.0, 0.0, 25.0, hitcrt::BLUE, true);
+
+// 与demo.cpp的DetectionTask相同
+struct DetectionTask {
+    hitcrt::FrameHandle m_handle;
+    deploy::PoseResView m_result;
+    std::vector<hitcrt::ArmorObservation> m_armors;
+    bool m_detected = false;
+};
+
+std::unique_ptr<deploy::PoseModel> makeModel() {
+    auto backend = std::make_unique<hitcrt::bench::FakePoseBackend>(1, 100, NET_SIZE);
+    for (int i = 0; i < NUM_DETECTIONS; ++i) {
+        const float x = 90.0f * i;
+        backend->setDetection(0, i, i % 5, 0.9f, x, 100.0f, x + 30.0f, 112.0f);
+    }
+    backend->setNum(0, NUM_DETECTIONS);
+    return std::make_unique<deploy::PoseModel>(std::move(backend));
+}
+
+std::vector<int> makeItem(const int value) { return std::vector<int>(16, value); }
+}  // namespace
+
+// DROP_OLDEST挤出的最旧一项连同缓冲区交还调用方，通道里的顺序不变
+TEST(StageChannel, DropOldestHandsBackEvictedItem) {
+    hitcrt::StageChannel<std::vector<int>> channel(2, hitcrt::DropPolicy::DROP_OLDEST);
+    std::vector<int> item = makeItem(1);
+    EXPECT_EQ(channel.push(item), hitcrt::PushResult::ACCEPTED);
+    item = makeItem(2);
+    EXPECT_EQ(channel.push(item), hitcrt::PushResult::ACCEPTED);
+    item = makeItem(3);
+    EXPECT_EQ(channel.push(item), hitcrt::PushResult::EVICTED);
+    EXPECT_EQ(item, makeItem(1));
+    EXPECT_EQ(channel.dropped(), 1u);
+
+    std::vector<int> popped;
+    ASSERT_TRUE(channel.pop(popped));
+    EXPECT_EQ(popped, makeItem(2));
+    ASSERT_TRUE(channel.pop(popped));
+    EXPECT_EQ(popped, makeItem(3));
+}
+
+// SKIP和关闭后放入的项留在调用方手里
+TEST(StageChannel, RejectedItemStaysWithCaller) {
+    hitcrt::StageChannel<std::vector<int>> channel(1, hitcrt::DropPolicy::SKIP);
+    std::vector<int> item = makeItem(1);
+    EXPECT_EQ(channel.push(item), hitcrt::PushResult::ACCEPTED);
+    item = makeItem(2);
+    EXPECT_EQ(channel.push(item), hitcrt::PushResult::REJECTED);
+    EXPECT_EQ(item, makeItem(2));
+    channel.close();
+    EXPECT_EQ(channel.push(item), hitcrt::PushResult::REJECTED);
+    EXPECT_EQ(item, makeItem(2));
+}
+
+// 下一级按SKIP拒绝的项不算本级处理完成，记在本级的forwardDropped和下一级的dropped里
+TEST(StagePipeline, HandoffDropIsNotCountedAsProcessed) {
+    std::atomic<bool> entered{false};
+    std::atomic<bool> release{false};
+    hitcrt::StagePipeline<std::vector<int>> pipeline;
+    pipeline.addStage("first", [](std::vector<int> &) { return true; }, 4, hitcrt::DropPolicy::BLOCK)
+        .addStage(
+            "second",
+            [&](std::vector<int> &) {
+                entered = true;
+                while (!release) {
+                    std::this_thread::yield();
+                }
+                return true;
+            },
+            1, hitcrt::DropPolicy::SKIP);
+    pipeline.start();
+
+    const auto firstHandled = [&pipeline] {
+        const hitcrt::StageStats stats = pipeline.stats().front();
+        return stats.processed + stats.forwardDropped;
+    };
+    // 第一项被第二级取走并卡住，第二项占满第二级的通道，第三项被拒绝
+    ASSERT_TRUE(pipeline.submit(makeItem(1)));
+    while (!entered) {
+        std::this_thread::yield();
+    }
+    for (int i = 2; i <= 3; ++i) {
+        ASSERT_TRUE(pipeline.submit(makeItem(i)));
+        while (firstHandled() < static_cast<uint64_t>(i)) {
+            std::this_thread::yield();
+        }
+    }
+    release = true;
+    while (pipeline.stats().back().processed < 2) {
+        std::this_thread::yield();
+    }
+    const std::vector<hitcrt::StageStats> stats = pipeline.stats();
+    pipeline.stop();
+
+    EXPECT_EQ(stats[0].processed, 2u);
+    EXPECT_EQ(stats[0].forwardDropped, 1u);
+    EXPECT_EQ(stats[1].dropped, 1u);
+    EXPECT_EQ(stats[1].processed, 2u);
+    EXPECT_EQ(stats[1].forwardDropped, 0u);
+}
+
+// 按demo.cpp的方式搭推理 -> 后处理 -> 画图三级：任务回收复用，帧句柄在回收时归还，稳态没有堆分配
+TEST(StagePipeline, DetectionPathDoesNotAllocate) {
+    hitcrt::FrameRing ring(8, NET_SIZE, NET_SIZE, CV_8UC3);
+    hitcrt::ArmorDetectorNN detector(makeModel(), 0.5f);
+    std::atomic<int> done{0};
+    std::atomic<bool> ok{true};
+
+    hitcrt::StagePipeline<DetectionTask> pipeline;
+    pipeline
+        .addStage(
+            "infer",
+            [&](DetectionTask &task) {
+                const hitcrt::Frame frame(task.m_handle.image(), task.m_handle.timeStamp());
+                detector.infer(frame, task.m_result);
+                return true;
+            },
+            1, hitcrt::DropPolicy::BLOCK)
+        .addStage(
+            "postprocess",
+            [&](DetectionTask &task) {
+                const hitcrt::Frame frame(task.m_handle.image(), task.m_handle.timeStamp());
+                task.m_detected = detector.decode(task.m_result, frame, RECV_INFO, task.m_armors);
+                return true;
+            },
+            1, hitcrt::DropPolicy::BLOCK)
+        .addStage(
+            "draw",
+            [&](DetectionTask &task) {
+                if (!task.m_detected || task.m_armors.size() != NUM_DETECTIONS) {
+                    ok = false;
+                }
+                done.fetch_add(1, std::memory_order_release);
+                return true;
+            },
+            1, hitcrt::DropPolicy::BLOCK)
+        .setReset([](DetectionTask &task) {
+            task.m_handle.reset();
+            task.m_result.num = 0;
+            task.m_armors.clear();
+            task.m_detected = false;
+        });
+    pipeline.start();
+
+    // 一次送入BURST帧，等全部处理完并回到回收池，流水线里同时存在的任务数固定
+    int submitted = 0;
+    const auto burst = [&] {
+        for (int i = 0; i < BURST; ++i) {
+            DetectionTask task = pipeline.acquire();
+            task.m_handle = ring.acquire();
+            task.m_handle.commit(hitcrt::Clock::now());
+            pipeline.submit(std::move(task));
+        }
+        submitted += BURST;
+        while (done.load(std::memory_order_acquire) < submitted || pipeline.pooled() < BURST) {
+            std::this_thread::yield();
+        }
+    };
+    for (int i = 0; i < WARMUP_BURSTS; ++i) {
+        burst();
+    }
+    const auto stat = hitcrt::test::countAllocations([&] {
+        for (int i = 0; i < BURSTS; ++i) {
+            burst();
+        }
+    });
+    pipeline.stop();
+
+    EXPECT_EQ(stat.m_allocations, 0);
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(done.load(), (WARMUP_BURSTS + BURSTS) * BURST);
+    EXPECT_EQ(pipeline.pooled(), static_cast<size_t>(BURST));
+    // 回收池里的任务不占帧槽位
+    std::vector<hitcrt::FrameHandle> held;
+    for (int i = 0; i < ring.capacity(); ++i) {
+        held.push_back(ring.acquire());
+        EXPECT_FALSE(held.back().empty());
+    }
+}
@@ -0,0 +1,123 @@
+/**
+ * @file PixelFormatTest.cpp
+ * @brief 输入布局描述：RGB/BGRA/RGBA、行间填充、倒序行直接进letterbox核，结果与整块BGR输入一致
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "PixelLayout.h"
+#include "infer/affine.hpp"
+#include "infer/cpu_warpaffine.hpp"
+
+namespace {
+using deploy::PixelFormat;
+
+constexpr float FLOAT_TOLERANCE = 1e-3f;
+
+float maxError(const std::vector<float> &a, const std::vector<float> &b) {
+    float error = 0.0f;
+    for (size_t i = 0; i < a.size(); ++i) {
+        error = std::max(error, std::fabs(a[i] - b[i]));
+    }
+    return error;
+}
+}  // namespace
+
+/*
+ * 各格式、填充、行序、swap_rb组合下，融合核与参考实现都等于整块BGR输入的参考结果，cpuPackBgr还原出原图
+ */
+TEST(PixelFormat, LayoutsMatchPackedBgr) {
+    std::mt19937 rng(2026);
+    const int sizes[][4] = {{1280, 1024, 640, 640}, {37, 29, 61, 45}, {7, 3, 13, 9}};
+    for (const auto &size : sizes) {
+        const int cols = size[0], rows = size[1], dst_cols = size[2], dst_rows = size[3];
+        std::vector<uint8_t> bgr(static_cast<size_t>(cols) * rows * 3);
+        std::generate(bgr.begin(), bgr.end(), [&rng] { return static_cast<uint8_t>(rng()); });
+        deploy::AffineTransform transform;
+        transform.updateMatrix(cols, rows, dst_cols, dst_rows);
+        const size_t count = static_cast<size_t>(3) * dst_cols * dst_rows;
+
+        for (const bool swap : {false, true}) {
+            deploy::ProcessConfig config;
+            if (swap) {
+                config.enableSwapRB();
+            }
+            std::vector<float> expected(count);
+            deploy::cpuWarpAffineReference(bgr.data(), cols, rows, expected.data(), dst_cols, dst_rows,
+                                           transform.matrix, config);
+            for (const PixelFormat format : {PixelFormat::BGR, PixelFormat::RGB, PixelFormat::BGRA, PixelFormat::RGBA}) {
+                for (const int padding : {0, 40}) {
+                    for (const bool flip : {false, true}) {
+                        SCOPED_TRACE(::testing::Message()
+                                     << cols << "x" << rows << " " << deploy::formatName(format) << " pad " << padding
+                                     << (flip ? " flip" : " top-down") << (swap ? " swap_rb" : ""));
+                        const int stride = cols * deploy::pixelBytes(format) + padding;
+                        std::vector<uint8_t> buffer = hitcrt::bench::layout(bgr, cols, rows, format, stride, flip, rng);
+                        const deploy::Image image(buffer.data(), cols, rows, format, stride, flip);
+                        std::vector<float> fused(count), reference(count);
+                        deploy::cpuWarpAffine(image, fused.data(), dst_cols, dst_rows, transform.matrix, config);
+                        deploy::cpuWarpAffineReference(image, reference.data(), dst_cols, dst_rows, transform.matrix,
+                                                       config);
+                        EXPECT_LE(maxError(fused, expected), FLOAT_TOLERANCE);
+                        EXPECT_LE(maxError(reference, expected), FLOAT_TOLERANCE);
+
+                        std::vector<uint8_t> packed(bgr.size());
+                        deploy::cpuPackBgr(image, packed.data());
+                        EXPECT_TRUE(packed == bgr);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Bayer原图带行间填充、按2x2单元倒序存储时与整块原图的结果一致
+ */
+TEST(PixelFormat, BayerPaddedAndFlippedByCells) {
+    std::mt19937 rng(11);
+    const int cols = 64, rows = 48, stride = cols + 24, dst_size = 40;
+    std::vector<uint8_t> raw(static_cast<size_t>(cols) * rows);
+    std::generate(raw.begin(), raw.end(), [&rng] { return static_cast<uint8_t>(rng()); });
+    std::vector<uint8_t> flipped(static_cast<size_t>(stride) * rows, 0);
+    for (int cell = 0; cell < rows / 2; ++cell) {
+        const int to = rows / 2 - 1 - cell;
+        std::memcpy(&flipped[static_cast<size_t>(2 * to) * stride], &raw[static_cast<size_t>(2 * cell) * cols], cols);
+        std::memcpy(&flipped[static_cast<size_t>(2 * to + 1) * stride], &raw[static_cast<size_t>(2 * cell + 1) * cols],
+                    cols);
+    }
+    deploy::AffineTransform transform;
+    transform.updateMatrix(cols, rows, dst_size, dst_size);
+    deploy::ProcessConfig config;
+    config.enableSwapRB();
+    const size_t count = static_cast<size_t>(3) * dst_size * dst_size;
+    std::vector<float> expected(count), fused(count);
+    deploy::cpuBayerWarpAffineReference(raw.data(), cols, rows, expected.data(), dst_size, dst_size, transform.matrix,
+                                        config);
+    const deploy::Image image(flipped.data(), cols, rows, PixelFormat::BayerBG, stride, true);
+    deploy::cpuWarpAffine(image, fused.data(), dst_size, dst_size, transform.matrix, config);
+    EXPECT_LE(maxError(fused, expected), FLOAT_TOLERANCE);
+}
+
+// Bayer原图没有对应的BGR排列，整理成BGR时报错
+TEST(PixelFormat, PackBgrRejectsBayer) {
+    std::vector<uint8_t> raw(8 * 8), packed(8 * 8 * 3);
+    const deploy::Image image(raw.data(), 8, 8, PixelFormat::BayerBG);
+    EXPECT_THROW(deploy::cpuPackBgr(image, packed.data()), std::invalid_argument);
+}
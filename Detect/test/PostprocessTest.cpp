@@ -0,0 +1,79 @@
+/**
+ * @file PostprocessTest.cpp
+ * @brief PoseModel后处理：PoseResView稳态零堆分配，结果与PoseRes一致
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "FakePoseBackend.h"
+#include "model.hpp"
+
+namespace {
+constexpr int NUM_DETECTIONS = 12;
+constexpr int MAX_DETECTIONS = 100;
+constexpr int NUM_KEYPOINTS = 4;
+
+std::unique_ptr<deploy::PoseModel> makeModel() {
+    auto backend = std::make_unique<hitcrt::bench::FakePoseBackend>(1, MAX_DETECTIONS);
+    for (int i = 0; i < NUM_DETECTIONS; ++i) {
+        const float x = 40.0f * i, y = 20.0f * i;
+        backend->setDetection(0, i, i % 18, 0.9f - 0.01f * i, x, y, x + 30.0f, y + 15.0f);
+    }
+    backend->setNum(0, NUM_DETECTIONS);
+    return std::make_unique<deploy::PoseModel>(std::move(backend));
+}
+
+std::vector<unsigned char> g_pixels(1024 * 1280 * 3);
+}  // namespace
+
+TEST(PoseResView, SteadyStateDoesNotAllocate) {
+    auto model = makeModel();
+    const deploy::Image image(g_pixels.data(), 1280, 1024);
+    // 首帧分配容量，之后复用
+    deploy::PoseResView view;
+    model->predict(image, view);
+
+    const auto stat = hitcrt::test::countAllocations([&] {
+        for (int i = 0; i < 1000; ++i) {
+            model->predict(image, view);
+        }
+    });
+    EXPECT_EQ(stat.m_allocations, 0);
+    EXPECT_EQ(view.num, NUM_DETECTIONS);
+}
+
+TEST(PoseResView, MatchesPoseRes) {
+    auto model = makeModel();
+    const deploy::Image image(g_pixels.data(), 1280, 1024);
+    deploy::PoseResView view;
+    model->predict(image, view);
+    const deploy::PoseRes legacy = model->predict(image);
+
+    ASSERT_EQ(legacy.num, view.num);
+    for (int i = 0; i < view.num; ++i) {
+        const auto det = view[i];
+        EXPECT_EQ(det.score, legacy.scores[i]);
+        EXPECT_EQ(det.cls, legacy.classes[i]);
+        EXPECT_EQ(det.box->left, legacy.boxes[i].left);
+        EXPECT_EQ(det.box->top, legacy.boxes[i].top);
+        EXPECT_EQ(det.box->right, legacy.boxes[i].right);
+        EXPECT_EQ(det.box->bottom, legacy.boxes[i].bottom);
+        for (int j = 0; j < NUM_KEYPOINTS; ++j) {
+            EXPECT_EQ(det.x(j), legacy.kpts[i][j].x);
+            EXPECT_EQ(det.y(j), legacy.kpts[i][j].y);
+        }
+    }
+}
@@ -0,0 +1,209 @@
+/**
+ * @file RecordTest.cpp
+ * @brief 帧录制格式：mmap回读校验，截断、预分配未写和元数据损坏文件的恢复
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FrameRecord.h"
+
+namespace {
+using hitcrt::Clock;
+using hitcrt::FrameHandle;
+using hitcrt::FrameRecorder;
+using hitcrt::FrameRecordReader;
+using hitcrt::FrameRing;
+
+// 小分辨率即可覆盖帧块对齐和索引，不需要实际录制的1280x1024
+constexpr int WIDTH = 320;
+constexpr int HEIGHT = 256;
+constexpr uint64_t FRAMES = 16;
+constexpr uint64_t PAGE = FrameRing::PAGE_SIZE;
+
+// 每帧像素开头和结尾写入序号，回读时校验
+void stamp(cv::Mat &image, const uint64_t seq) {
+    const size_t bytes = image.total() * image.elemSize();
+    std::memcpy(image.data, &seq, sizeof(seq));
+    std::memcpy(image.data + bytes - sizeof(seq), &seq, sizeof(seq));
+}
+
+bool stamped(const cv::Mat &image, const uint64_t seq) {
+    const size_t bytes = image.total() * image.elemSize();
+    uint64_t head = 0;
+    uint64_t tail = 0;
+    std::memcpy(&head, image.data, sizeof(head));
+    std::memcpy(&tail, image.data + bytes - sizeof(tail), sizeof(tail));
+    return head == seq && tail == seq;
+}
+
+float pitchOf(const uint64_t seq) { return static_cast<float>(seq % 1000) * 0.01f; }
+
+/**
+ * @brief 写一段录制，按写线程的速度喂帧，不丢帧
+ * @param[in] handle    true走句柄零拷贝，false走Frame拷贝
+ * @return 写入的帧数
+ */
+uint64_t writeRecording(const std::string &path, const int type, const bool handle) {
+    FrameRing source(32, WIDTH, HEIGHT, type);
+    FrameRecorder recorder(path, WIDTH, HEIGHT, type);
+    for (uint64_t offered = 0; offered < FRAMES; ++offered) {
+        while (offered - recorder.recorded() >= 8) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        FrameHandle frame = source.acquire();
+        while (frame.empty()) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+            frame = source.acquire();
+        }
+        const auto now = Clock::now();
+        frame.commit(now, 0, now);
+        // 句柄路径的序号由帧环形缓冲区在commit时分配
+        const uint64_t seq = handle ? frame.seq() : offered;
+        stamp(frame.image(), seq);
+        const hitcrt::RecvInfoBase recvInfo(pitchOf(seq), -pitchOf(seq), 0.0f, 15.0f, hitcrt::RED, true);
+        if (handle) {
+            recorder.record(frame, &recvInfo, 3000.0f);
+        } else {
+            recorder.record(hitcrt::Frame(frame.image(), frame.timeStamp()), seq, &recvInfo, 3000.0f);
+        }
+    }
+    EXPECT_TRUE(recorder.close());
+    EXPECT_EQ(recorder.dropped(), 0u);
+    return recorder.recorded();
+}
+
+// 索引完整，序号递增，像素和元数据与写入时一致，时间戳查找正确，图像直接指向映射内存
+void verify(const std::string &path, const uint64_t expect) {
+    FrameRecordReader reader(path);
+    EXPECT_FALSE(reader.recovered());
+    ASSERT_EQ(reader.count(), expect);
+    ASSERT_GT(reader.count(), 1u);
+    uint64_t lastSeq = 0;
+    for (size_t i = 0; i < reader.count(); ++i) {
+        SCOPED_TRACE(i);
+        const hitcrt::RecordMeta &meta = reader.meta(i);
+        const hitcrt::Frame frame = reader.frame(i);
+        if (i > 0) {
+            EXPECT_GT(meta.m_seq, lastSeq);
+        }
+        EXPECT_TRUE(stamped(frame.image(), meta.m_seq));
+        EXPECT_EQ(meta.m_pitch, pitchOf(meta.m_seq));
+        EXPECT_EQ(meta.m_exposureUs, 3000.0f);
+        EXPECT_EQ(frame.timeStamp(), frame.receiveTime());
+        EXPECT_LE(reader.find(frame.timeStamp()), i);
+        lastSeq = meta.m_seq;
+    }
+    EXPECT_EQ(static_cast<size_t>(reader.image(1).data - reader.image(0).data), reader.header().m_stride);
+    EXPECT_EQ(reader.find(reader.frame(reader.count() - 1).timeStamp() + std::chrono::seconds(1)), reader.count());
+}
+
+/**
+ * @brief 复制src的前bytes字节，之后补zeros字节0（模拟fallocate预分配但没写到的空间）
+ */
+bool copyPrefix(const std::string &src, const std::string &dst, const uint64_t bytes, const uint64_t zeros = 0) {
+    const int in = ::open(src.c_str(), O_RDONLY);
+    const int out = ::open(dst.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (in < 0 || out < 0) {
+        return false;
+    }
+    std::vector<char> buffer(1 << 20);
+    uint64_t left = bytes;
+    bool ok = true;
+    while (ok && left > 0) {
+        const ssize_t got = ::read(in, buffer.data(), std::min<uint64_t>(left, buffer.size()));
+        ok = got > 0 && ::write(out, buffer.data(), got) == got;
+        left -= got > 0 ? got : 0;
+    }
+    ok = ok && ::ftruncate(out, static_cast<off_t>(bytes + zeros)) == 0;
+    ::close(in);
+    ::close(out);
+    return ok;
+}
+
+/**
+ * @brief 每个用例写一段完整的BGR录制，损坏的副本从它复制
+ */
+class FrameRecordTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        m_path = ::testing::TempDir() + "recordTest.hrec";
+        m_broken = ::testing::TempDir() + "recordTestBroken.hrec";
+        ASSERT_EQ(writeRecording(m_path, CV_8UC3, true), FRAMES);
+        m_stride = FrameRecordReader(m_path).header().m_stride;
+    }
+
+    void TearDown() override {
+        ::unlink(m_path.c_str());
+        ::unlink(m_broken.c_str());
+    }
+
+    std::string m_path;
+    std::string m_broken;
+    uint64_t m_stride = 0;
+};
+}  // namespace
+
+TEST_F(FrameRecordTest, ReadsBackHandleRecordingThroughMmap) { verify(m_path, FRAMES); }
+
+TEST_F(FrameRecordTest, ReadsBackCopiedBayerRecording) {
+    ASSERT_EQ(writeRecording(m_path, CV_8UC1, false), FRAMES);
+    verify(m_path, FRAMES);
+}
+
+// 写到第11帧一半时断电：恢复出10帧，修复后索引完整
+TEST_F(FrameRecordTest, RecoversAndRepairsTruncatedFrame) {
+    ASSERT_TRUE(copyPrefix(m_path, m_broken, PAGE + 10 * m_stride + m_stride / 2));
+    {
+        FrameRecordReader reader(m_broken);
+        EXPECT_TRUE(reader.recovered());
+        EXPECT_EQ(reader.count(), 10u);
+        EXPECT_EQ(reader.trailingBytes(), m_stride / 2);
+    }
+    EXPECT_EQ(FrameRecordReader::repair(m_broken), 10);
+    FrameRecordReader reader(m_broken);
+    EXPECT_FALSE(reader.recovered());
+    ASSERT_EQ(reader.count(), 10u);
+    EXPECT_EQ(reader.trailingBytes(), 0u);
+    EXPECT_TRUE(stamped(reader.image(9), reader.meta(9).m_seq));
+}
+
+// 崩溃时预分配的空间还在：5个完整帧之后是全0的块
+TEST_F(FrameRecordTest, RecoversBeforePreallocatedTail) {
+    ASSERT_TRUE(copyPrefix(m_path, m_broken, PAGE + 5 * m_stride, 3 * m_stride));
+    FrameRecordReader reader(m_broken);
+    EXPECT_TRUE(reader.recovered());
+    EXPECT_EQ(reader.count(), 5u);
+    EXPECT_EQ(reader.trailingBytes(), 3 * m_stride);
+}
+
+// 第7帧元数据损坏：只保留之前的7帧
+TEST_F(FrameRecordTest, StopsAtCorruptedMetadata) {
+    ASSERT_TRUE(copyPrefix(m_path, m_broken, PAGE + 12 * m_stride));
+    const int fd = ::open(m_broken.c_str(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    const char garbage = 0x5a;
+    EXPECT_EQ(::pwrite(fd, &garbage, 1, PAGE + 8 * m_stride - sizeof(hitcrt::RecordMeta) + 20), 1);
+    ::close(fd);
+    FrameRecordReader reader(m_broken);
+    EXPECT_TRUE(reader.recovered());
+    EXPECT_EQ(reader.count(), 7u);
+}
@@ -0,0 +1,233 @@
+/**
+ * @file ReplayTest.cpp
+ * @brief 回放相机：合成图片目录，检查各模式的出帧顺序、时间戳节奏和预加载
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <opencv2/imgcodecs.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ReplayCam.h"
+
+namespace {
+using hitcrt::camera::Clock;
+using hitcrt::camera::Mode;
+using hitcrt::camera::ReplayCamera;
+using hitcrt::camera::ReplayPace;
+using hitcrt::camera::ReplayParams;
+using hitcrt::camera::TimePoint;
+
+constexpr int NUM_FRAMES = 60;
+constexpr int WIDTH = 64;
+constexpr int HEIGHT = 48;
+// 录制间隔交替4ms/8ms，一遍约360ms
+constexpr int64_t SHORT_NS = 4000000;
+constexpr int64_t LONG_NS = 8000000;
+
+/**
+ * @brief 回调收到的帧
+ */
+struct Record {
+    int m_index;
+    TimePoint m_stamp;
+};
+
+int64_t nsOf(const Clock::duration &duration) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+// 每遍按序号0..NUM_FRAMES-1出帧，不跳帧
+void expectInOrder(const std::vector<Record> &records, const int loops) {
+    ASSERT_EQ(records.size(), static_cast<size_t>(NUM_FRAMES * loops));
+    for (size_t i = 0; i < records.size(); ++i) {
+        ASSERT_EQ(records[i].m_index, static_cast<int>(i % NUM_FRAMES)) << "frame " << i;
+    }
+}
+
+/**
+ * @brief 每个用例写NUM_FRAMES张图和timestamps.txt，每张图第一个字节为序号
+ */
+class ReplayTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        std::string pattern = ::testing::TempDir() + "replayTestXXXXXX";
+        ASSERT_NE(mkdtemp(pattern.data()), nullptr);
+        m_dir = pattern;
+        std::ofstream stamps(m_dir + "/timestamps.txt");
+        int64_t stamp = 1700000000000000000LL;
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            cv::Mat image(HEIGHT, WIDTH, CV_8UC3, cv::Scalar::all(0));
+            image.data[0] = static_cast<uint8_t>(i);
+            ASSERT_TRUE(cv::imwrite(imagePath(i), image));
+            stamps << stamp << "\n";
+            stamp += i % 2 == 0 ? SHORT_NS : LONG_NS;
+        }
+    }
+
+    void TearDown() override { removeDirectory(); }
+
+    std::string imagePath(const int index) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "/%04d.png", index);
+        return m_dir + name;
+    }
+
+    void removeDirectory() {
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            ::unlink(imagePath(i).c_str());
+        }
+        ::unlink((m_dir + "/timestamps.txt").c_str());
+        ::rmdir(m_dir.c_str());
+    }
+
+    /**
+     * @brief STREAM模式回放到结束，返回回调记录
+     */
+    std::vector<Record> stream(const ReplayPace pace, const int loops, const double fps = 100.0) {
+        std::vector<Record> records;
+        records.reserve(NUM_FRAMES * loops);
+        auto onCall = [&records](const TimePoint &stamp, const cv::Mat &image) {
+            records.push_back(Record{image.data[0], stamp});
+        };
+        ReplayCamera camera(ReplayParams(onCall, m_dir, Mode::STREAM, pace, fps, loops));
+        camera.waitFinished(10000);
+        return records;
+    }
+
+    std::string m_dir;
+};
+}  // namespace
+
+// 时间戳间隔与录制间隔一致，第二遍接着第一遍按平均间隔排
+TEST_F(ReplayTest, RecordedPaceKeepsStampGaps) {
+    const std::vector<Record> records = stream(ReplayPace::RECORDED, 2);
+    expectInOrder(records, 2);
+    const int64_t span = (NUM_FRAMES / 2) * SHORT_NS + (NUM_FRAMES / 2 - 1) * LONG_NS;
+    for (size_t i = 1; i < records.size(); ++i) {
+        const int64_t expect = i % NUM_FRAMES == 0 ? span / (NUM_FRAMES - 1) : (i % 2 == 1 ? SHORT_NS : LONG_NS);
+        EXPECT_NEAR(nsOf(records[i].m_stamp - records[i - 1].m_stamp), expect, 1) << "frame " << i;
+    }
+}
+
+// 固定帧率下时间戳等间隔，与录制时刻无关
+TEST_F(ReplayTest, FixedFpsSpacesStampsEvenly) {
+    const std::vector<Record> records = stream(ReplayPace::FIXED_FPS, 1, 200.0);
+    expectInOrder(records, 1);
+    ASSERT_FALSE(records.empty());
+    EXPECT_NEAR(nsOf(records.back().m_stamp - records.front().m_stamp), (NUM_FRAMES - 1) * 5000000LL, 10000);
+}
+
+TEST_F(ReplayTest, AsFastReplaysEveryLoopInOrder) { expectInOrder(stream(ReplayPace::AS_FAST, 20), 20); }
+
+// 软触发在调用线程里同步回调，放完之后再触发被拒绝
+TEST_F(ReplayTest, SoftTriggerDeliversSynchronously) {
+    std::vector<Record> records;
+    auto onCall = [&records](const TimePoint &stamp, const cv::Mat &image) {
+        records.push_back(Record{image.data[0], stamp});
+    };
+    ReplayCamera camera(ReplayParams(onCall, m_dir, Mode::SOFT, ReplayPace::RECORDED, 100.0, 1));
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        ASSERT_TRUE(camera.softTrigger());
+        ASSERT_EQ(records.size(), static_cast<size_t>(i + 1));
+    }
+    EXPECT_FALSE(camera.softTrigger());
+    EXPECT_TRUE(camera.finished());
+    expectInOrder(records, 1);
+}
+
+// 多线程模式尽快回放时取图方跟得上，逐帧取到不跳帧
+TEST_F(ReplayTest, PullAsFastTakesEveryFrame) {
+    ReplayCamera camera(
+        ReplayParams(ReplayParams::noUse, m_dir, Mode::STREAM_MULTITHREAD, ReplayPace::AS_FAST, 100.0, 1));
+    std::vector<Record> records;
+    while (true) {
+        auto frame = camera.getFrameImage(10);
+        if (!std::get<0>(frame)) {
+            break;
+        }
+        records.push_back(Record{std::get<2>(frame).data[0], std::get<1>(frame)});
+    }
+    expectInOrder(records, 1);
+    EXPECT_TRUE(camera.finished());
+}
+
+// 下游每帧耗时12ms，比录制间隔慢，应跳到最新帧而不是排队，回放完之后仍能取到最后一帧
+TEST_F(ReplayTest, SlowConsumerSkipsToLatest) {
+    ReplayCamera camera(
+        ReplayParams(ReplayParams::noUse, m_dir, Mode::STREAM_MULTITHREAD, ReplayPace::RECORDED, 100.0, 1));
+    int last = -1;
+    int taken = 0;
+    while (true) {
+        auto frame = camera.getFrameImage(50);
+        if (!std::get<0>(frame)) {
+            if (camera.finished()) {
+                break;
+            }
+            continue;
+        }
+        const int index = std::get<2>(frame).data[0];
+        EXPECT_GT(index, last);
+        last = index;
+        ++taken;
+        std::this_thread::sleep_for(std::chrono::milliseconds(12));
+    }
+    EXPECT_LT(taken, NUM_FRAMES);
+    EXPECT_EQ(last, NUM_FRAMES - 1);
+}
+
+// 回放线程在跑时再次start被拒绝，stop之后可以重新开始
+TEST_F(ReplayTest, RestartRequiresStop) {
+    ReplayParams params(ReplayParams::noUse, m_dir, Mode::STREAM, ReplayPace::RECORDED, 100.0, 0);
+    ReplayCamera camera(params);
+    EXPECT_FALSE(camera.start(params));
+    EXPECT_FALSE(camera.finished());
+    EXPECT_TRUE(camera.stop(params));
+    EXPECT_TRUE(camera.start(params));
+    EXPECT_TRUE(camera.stop(params));
+}
+
+// 回放中途stop不算放完
+TEST_F(ReplayTest, StopBeforeEndIsNotFinished) {
+    ReplayParams params(ReplayParams::noUse, m_dir, Mode::STREAM, ReplayPace::RECORDED, 100.0, 1);
+    ReplayCamera camera(params);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_TRUE(camera.stop(params));
+    EXPECT_FALSE(camera.finished());
+    EXPECT_FALSE(camera.waitFinished(10));
+}
+
+// LINE模式没有外部触发
+TEST_F(ReplayTest, LineModeIsRejected) {
+    ReplayCamera line;
+    EXPECT_FALSE(line.initiate(ReplayParams(ReplayParams::noUse, m_dir, Mode::LINE)));
+}
+
+// 预加载之后删掉源文件，回放照常
+TEST_F(ReplayTest, PreloadedFramesSurviveSourceRemoval) {
+    std::vector<Record> records;
+    auto onCall = [&records](const TimePoint &stamp, const cv::Mat &image) {
+        records.push_back(Record{image.data[0], stamp});
+    };
+    ReplayCamera camera(ReplayParams(onCall, m_dir, Mode::SOFT, ReplayPace::AS_FAST, 100.0, 1));
+    removeDirectory();
+    while (camera.softTrigger()) {
+    }
+    EXPECT_EQ(camera.frameCount(), static_cast<size_t>(NUM_FRAMES));
+    expectInOrder(records, 1);
+}
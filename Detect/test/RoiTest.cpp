@@ -0,0 +1,144 @@
+/**
+ * @file RoiTest.cpp
+ * @brief ROI推理：窗口的位置、对齐和全图调度，窗口内的检测映射回原图坐标后与真值一致
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "ArmorDetectorNN.h"
+#include "RoiScene.h"
+#include "RoiScheduler.h"
+
+namespace {
+using hitcrt::bench::SCENE_HEIGHT;
+using hitcrt::bench::SCENE_WIDTH;
+using hitcrt::bench::Scene;
+using hitcrt::bench::SceneBackend;
+using hitcrt::bench::Target;
+using hitcrt::bench::Truth;
+
+constexpr int FRAMES = 40;
+constexpr float MAX_CORNER_ERROR = 0.05f;
+
+const hitcrt::RecvInfoBase RECV_INFO(0.0, 0.0, 0.0, 25.0, hitcrt::BLUE, true);
+
+hitcrt::ArmorObservation observation(const float x, const float y) {
+    hitcrt::ArmorObservation armor;
+    armor.m_topLeft = cv::Point2f(x - 9.0f, y - 3.0f);
+    armor.m_topRight = cv::Point2f(x + 9.0f, y - 3.0f);
+    armor.m_bottomRight = cv::Point2f(x + 9.0f, y + 3.0f);
+    armor.m_bottomLeft = cv::Point2f(x - 9.0f, y + 3.0f);
+    return armor;
+}
+
+float cornerError(const hitcrt::Armor &armor, const Target &target) {
+    const float left = target.m_x - target.width() * 0.5f, right = target.m_x + target.width() * 0.5f;
+    const float top = target.m_y - target.m_height * 0.5f, bottom = target.m_y + target.m_height * 0.5f;
+    const auto distance = [](const cv::Point2f &p, const float x, const float y) {
+        return std::max(std::fabs(p.x - x), std::fabs(p.y - y));
+    };
+    return std::max({distance(armor.m_topLeft, left, top), distance(armor.m_topRight, right, top),
+                     distance(armor.m_bottomRight, right, bottom), distance(armor.m_bottomLeft, left, bottom)});
+}
+}  // namespace
+
+// 目标从右上角扫到左下角、经过图边：窗口在图内、宽高和左上角为偶数、不小于最小尺寸、包含目标，每5帧一次全图
+TEST(RoiScheduler, WindowsStayInsideAlignedAndCoverTarget) {
+    hitcrt::RoiConfig config;
+    config.m_enable = true;
+    config.m_sweepInterval = 5;
+    hitcrt::RoiScheduler scheduler(config);
+    const cv::Size size(SCENE_WIDTH, SCENE_HEIGHT);
+    EXPECT_EQ(scheduler.window(size).area(), size.area());
+    EXPECT_TRUE(scheduler.fullFrame());
+
+    int sweeps = 0;
+    for (int i = 0; i < 40; ++i) {
+        const float x = 1270.0f - 31.0f * i, y = 3.0f + 24.0f * i;
+        scheduler.update({observation(x, y)});
+        const cv::Rect2i window = scheduler.window(size);
+        sweeps += scheduler.fullFrame();
+        const cv::Rect2i target(cv::Point2i(static_cast<int>(x - 9.0f), static_cast<int>(y - 3.0f)),
+                                cv::Point2i(static_cast<int>(x + 9.0f), static_cast<int>(y + 3.0f)));
+        SCOPED_TRACE(::testing::Message() << "frame " << i);
+        EXPECT_TRUE(window.x >= 0 && window.y >= 0 && window.br().x <= size.width && window.br().y <= size.height);
+        EXPECT_TRUE(window.x % 2 == 0 && window.y % 2 == 0 && window.width % 2 == 0 && window.height % 2 == 0);
+        EXPECT_EQ(window & target, target & cv::Rect2i(0, 0, size.width, size.height));
+        EXPECT_GE(window.width, config.m_minWidth);
+        EXPECT_GE(window.height, config.m_minHeight);
+    }
+    EXPECT_EQ(sweeps, 8);
+}
+
+// 窗口内连续丢失m_lostFrames帧后回到全图并放弃跟踪
+TEST(RoiScheduler, FallsBackToFullFrameAfterLostFrames) {
+    hitcrt::RoiConfig config;
+    config.m_enable = true;
+    config.m_sweepInterval = 100;
+    hitcrt::RoiScheduler scheduler(config);
+    const cv::Size size(SCENE_WIDTH, SCENE_HEIGHT);
+    scheduler.window(size);
+    scheduler.update({observation(640.0f, 512.0f)});
+    scheduler.window(size);
+    ASSERT_FALSE(scheduler.fullFrame());
+    for (int i = 0; i < config.m_lostFrames && !scheduler.fullFrame(); ++i) {
+        scheduler.update({});
+        scheduler.window(size);
+    }
+    EXPECT_TRUE(scheduler.fullFrame());
+    EXPECT_FALSE(scheduler.tracking());
+    EXPECT_EQ(scheduler.stats().m_lost, 1u);
+}
+
+/*
+ * 目标扫过整幅图，窗口被平移到图边时偏移不再是目标中心减半宽；旁边的小目标全图缩小后检测不到，窗口内按原分辨率检测到。
+ * 窗口帧和全图帧的关键点、框都按窗口原点映射回原图，角点与真值的偏差在浮点误差以内
+ */
+TEST(ArmorDetectorNN, RoiDetectionsMapBackToFullFrame) {
+    Scene scene;
+    const cv::Mat image(SCENE_HEIGHT, SCENE_WIDTH, CV_8UC3, cv::Scalar(40, 40, 40));
+    scene.m_base = image.data;
+    scene.m_stride = static_cast<int>(image.step[0]);
+    hitcrt::ArmorDetectorNN detector(std::make_unique<deploy::PoseModel>(std::make_unique<SceneBackend>(&scene)), 0.5f);
+    hitcrt::RoiConfig config;
+    config.m_enable = true;
+    config.m_sweepInterval = 10;
+    detector.setRoiConfig(config);
+
+    int smallFound = 0;
+    std::vector<hitcrt::Armor> armors;
+    for (int i = 0; i < FRAMES; ++i) {
+        const float t = static_cast<float>(i) / (FRAMES - 1);
+        const Target large{40.0f + 1180.0f * t, 30.0f + 940.0f * t, 16.0f};
+        const Truth truth = {large, Target{large.m_x + (t < 0.5f ? 60.0f : -60.0f), large.m_y, 8.0f}};
+        scene.m_truth = &truth;
+        detector.apply(hitcrt::Frame(image, std::chrono::steady_clock::now()), RECV_INFO, hitcrt::ROI(), armors);
+        const bool full = detector.roiScheduler().fullFrame();
+
+        SCOPED_TRACE(::testing::Message() << "frame " << i << (full ? " full" : " roi"));
+        ASSERT_EQ(armors.size(), full ? 1u : 2u);
+        for (const hitcrt::Armor &armor : armors) {
+            const bool small = std::fabs(armor.m_topLeft.y - armor.m_bottomLeft.y) < 12.0f;
+            EXPECT_LE(cornerError(armor, truth[small ? 1 : 0]), MAX_CORNER_ERROR);
+            smallFound += small;
+        }
+    }
+    const hitcrt::RoiStats &stats = detector.roiScheduler().stats();
+    EXPECT_GT(stats.m_roiFrames, 0u);
+    EXPECT_EQ(smallFound, static_cast<int>(stats.m_roiFrames));
+    EXPECT_LT(scene.m_inputBytes, static_cast<uint64_t>(FRAMES) * SCENE_WIDTH * SCENE_HEIGHT * 3);
+}
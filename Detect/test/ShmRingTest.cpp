@@ -0,0 +1,148 @@
+/**
+ * @file ShmRingTest.cpp
+ * @brief 共享内存帧环：读者按序取最新帧，seqlock检测写者绕回覆盖，完好的帧像素与元数据一致
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "ShmFrameRing.h"
+
+namespace {
+using hitcrt::ShmFrameMeta;
+using hitcrt::ShmFrameReader;
+using hitcrt::ShmFrameView;
+using hitcrt::ShmFrameWriter;
+
+constexpr int CAPACITY = 4;
+const std::string NAME = "hitcrt_shm_test";
+
+// 每帧像素开头和结尾写入序号，读完后校验
+void stamp(cv::Mat &image, const uint64_t seq) {
+    const size_t bytes = image.total() * image.elemSize();
+    std::memcpy(image.data, &seq, sizeof(seq));
+    std::memcpy(image.data + bytes - sizeof(seq), &seq, sizeof(seq));
+}
+
+bool stamped(const cv::Mat &image, const uint64_t seq) {
+    const size_t bytes = image.total() * image.elemSize();
+    uint64_t head = 0;
+    uint64_t tail = 0;
+    std::memcpy(&head, image.data, sizeof(head));
+    std::memcpy(&tail, image.data + bytes - sizeof(tail), sizeof(tail));
+    return head == seq && tail == seq;
+}
+
+void writeFrames(ShmFrameWriter &writer, const uint64_t first, const uint64_t last) {
+    cv::Mat image(48, 64, CV_8UC3, cv::Scalar(0, 0, 0));
+    ShmFrameMeta meta;
+    for (uint64_t seq = first; seq <= last; ++seq) {
+        stamp(image, seq);
+        meta.m_seq = seq;
+        ASSERT_TRUE(writer.write(image, meta));
+    }
+}
+}  // namespace
+
+// 还没有写过帧时读者取不到，写了几帧后直接取到最新一帧，没有新帧时不唤醒
+TEST(ShmFrameRing, ReaderTakesLatestFrame) {
+    ShmFrameWriter writer(NAME + "_latest", 64, 48, CV_8UC3, CAPACITY);
+    ShmFrameReader reader(NAME + "_latest");
+    ShmFrameView view;
+    EXPECT_FALSE(reader.latest(view));
+    EXPECT_FALSE(reader.wait(1));
+
+    writeFrames(writer, 1, 6);
+    ASSERT_TRUE(reader.wait(1));
+    ASSERT_TRUE(reader.latest(view));
+    EXPECT_EQ(view.m_meta.m_seq, 6u);
+    EXPECT_TRUE(stamped(view.m_image, 6));
+    EXPECT_TRUE(reader.intact(view));
+    EXPECT_FALSE(reader.wait(1));
+}
+
+// 读者取帧后写者又写了capacity-1帧时仍完好，写满一圈回到该槽位后能检测到覆盖
+TEST(ShmFrameRing, DetectsWriterLappingReader) {
+    ShmFrameWriter writer(NAME + "_lap", 64, 48, CV_8UC3, CAPACITY);
+    ShmFrameReader reader(NAME + "_lap");
+    writeFrames(writer, 1, 6);
+    ShmFrameView view;
+    ASSERT_TRUE(reader.latest(view));
+    ASSERT_EQ(view.m_meta.m_seq, 6u);
+
+    writeFrames(writer, 7, 6 + CAPACITY - 1);
+    EXPECT_TRUE(reader.intact(view));
+    EXPECT_TRUE(stamped(view.m_image, 6));
+
+    // 写者开始写同一个槽位，还没写完也算被覆盖
+    writer.begin();
+    EXPECT_FALSE(reader.intact(view));
+    ShmFrameMeta meta;
+    meta.m_seq = 6 + CAPACITY;
+    writer.commit(meta);
+    EXPECT_FALSE(reader.intact(view));
+
+    ShmFrameView next;
+    ASSERT_TRUE(reader.latest(next));
+    EXPECT_EQ(next.m_meta.m_seq, static_cast<uint64_t>(6 + CAPACITY));
+    EXPECT_EQ(reader.skipped(), static_cast<uint64_t>(CAPACITY - 1));
+}
+
+// 尺寸与槽位不符的图像不写入
+TEST(ShmFrameRing, RejectsMismatchedImage) {
+    ShmFrameWriter writer(NAME + "_size", 64, 48, CV_8UC3, CAPACITY);
+    ShmFrameMeta meta;
+    EXPECT_FALSE(writer.write(cv::Mat(10, 10, CV_8UC3), meta));
+    EXPECT_EQ(writer.published(), 0u);
+}
+
+// 同进程写者不等待全速写：读者取到的序号递增，判为完好的帧像素必须与元数据一致
+TEST(ShmFrameRing, IntactFramesMatchMetadataUnderContention) {
+    constexpr uint64_t FRAMES = 3000;
+    ShmFrameWriter writer(NAME + "_torn", 640, 512, CV_8UC3, 3);
+    ShmFrameReader reader(NAME + "_torn");
+    std::thread producer([&writer] {
+        for (uint64_t seq = 1; seq <= FRAMES; ++seq) {
+            cv::Mat &image = writer.begin();
+            stamp(image, seq);
+            ShmFrameMeta meta;
+            meta.m_seq = seq;
+            writer.commit(meta);
+        }
+    });
+    uint64_t intact = 0;
+    uint64_t mismatched = 0;
+    uint64_t reordered = 0;
+    uint64_t lastSeq = 0;
+    while (lastSeq < FRAMES && reader.wait(1000)) {
+        ShmFrameView view;
+        if (!reader.latest(view)) {
+            continue;
+        }
+        const bool match = stamped(view.m_image, view.m_meta.m_seq);
+        if (reader.intact(view)) {
+            ++intact;
+            mismatched += match ? 0 : 1;
+        }
+        reordered += view.m_meta.m_seq <= lastSeq ? 1 : 0;
+        lastSeq = view.m_meta.m_seq;
+    }
+    producer.join();
+    EXPECT_EQ(mismatched, 0u);
+    EXPECT_EQ(reordered, 0u);
+    EXPECT_GT(intact, 0u);
+    EXPECT_EQ(lastSeq, FRAMES);
+}
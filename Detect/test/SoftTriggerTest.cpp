@@ -0,0 +1,49 @@
+/**
+ * @file SoftTriggerTest.cpp
+ * @brief 软触发调度：模拟时钟上检查预测触发的帧龄、吞吐和传输估计的收敛
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "SoftTriggerSim.h"
+
+using hitcrt::bench::Us;
+
+// 预测触发的帧龄明显短于拉流，吞吐不低于拉流的95%，也高于空闲才触发
+TEST(SoftTrigger, PredictiveBeatsStreamAndIdleTrigger) {
+    const auto stream = hitcrt::bench::runStream();
+    hitcrt::camera::TriggerScheduler naiveScheduler{Us(hitcrt::bench::EXPOSURE_US)};
+    const auto naive = hitcrt::bench::runSoft(false, naiveScheduler);
+    hitcrt::camera::TriggerScheduler scheduler(Us(hitcrt::bench::EXPOSURE_US), Us(1000));
+    const auto predictive = hitcrt::bench::runSoft(true, scheduler);
+
+    EXPECT_LT(hitcrt::bench::meanOf(predictive.m_ages), hitcrt::bench::meanOf(stream.m_ages));
+    EXPECT_GT(predictive.m_fps, 0.95 * stream.m_fps);
+    EXPECT_GT(predictive.m_fps, naive.m_fps);
+}
+
+// 传输初值故意给错，估计收敛到真值附近；每次触发都对上回调
+TEST(SoftTrigger, TransferEstimateConverges) {
+    hitcrt::camera::TriggerScheduler scheduler(Us(hitcrt::bench::EXPOSURE_US), Us(1000));
+    hitcrt::bench::runSoft(true, scheduler);
+
+    const double transferError =
+        std::abs(static_cast<double>(scheduler.transferEstimate().count() - hitcrt::bench::TRANSFER_US));
+    EXPECT_LT(transferError, 200.0);
+    const hitcrt::camera::TriggerReport report = scheduler.report();
+    EXPECT_EQ(report.m_received, static_cast<uint64_t>(hitcrt::bench::NUM_FRAMES));
+    EXPECT_EQ(report.m_lost, 0u);
+    EXPECT_EQ(report.m_unmatched, 0u);
+    EXPECT_GT(report.m_p50, hitcrt::bench::EXPOSURE_US / 1000.0);
+}
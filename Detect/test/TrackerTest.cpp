@@ -0,0 +1,241 @@
+/**
+ * @file TrackerTest.cpp
+ * @brief 跳帧检测：合成序列上的外推误差，外推偏差、新轨迹、时间间隔和置信度触发的推理，外推结果的角点顺序和置信度衰减
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "CornerTracker.h"
+#include "TrackerScene.h"
+#include "TrackingDetector.h"
+
+namespace {
+using hitcrt::bench::CornerTruth;
+using hitcrt::bench::Corners;
+using hitcrt::bench::TRACK_HEIGHT;
+using hitcrt::bench::TRACK_WIDTH;
+using hitcrt::bench::TrackResult;
+using hitcrt::bench::TrackScene;
+
+const hitcrt::RecvInfoBase RECV_INFO(0.0, 0.0, 0.0, 25.0, hitcrt::BLUE, true);
+
+/**
+ * @brief 无噪声场景上逐帧调用跳帧检测，检测结果与真值一致，外推偏差只来自运动模型
+ */
+class TrackerHarness {
+   public:
+    explicit TrackerHarness(const hitcrt::TrackerConfig &config = hitcrt::TrackerConfig())
+        : m_image(TRACK_HEIGHT, TRACK_WIDTH, CV_8UC3, cv::Scalar(40, 40, 40)),
+          m_detector(hitcrt::bench::makeTrackDetector(&m_scene), config),
+          m_origin(std::chrono::steady_clock::now()) {
+        m_scene.m_noise = 0.0f;
+    }
+
+    // 在ms毫秒处理一帧真值为truth的画面，返回本帧是否推理
+    bool step(const CornerTruth &truth, const double ms) {
+        m_scene.m_truth = &truth;
+        const hitcrt::Frame frame(m_image, m_origin + std::chrono::microseconds(static_cast<int64_t>(ms * 1000.0)));
+        m_detector.apply(frame, RECV_INFO, hitcrt::ROI(), m_armors);
+        ++m_scene.m_frame;
+        return m_detector.lastInferred();
+    }
+
+    const std::vector<hitcrt::Armor> &armors() const { return m_armors; }
+    const hitcrt::TrackingDetector &detector() const { return m_detector; }
+
+   private:
+    TrackScene m_scene;
+    cv::Mat m_image;
+    hitcrt::TrackingDetector m_detector;
+    hitcrt::TimePoint m_origin;
+    std::vector<hitcrt::Armor> m_armors;
+};
+
+CornerTruth single(const float x, const float y) { return {hitcrt::bench::makeArmor(x, y, 28.0f, 12.0f, 12.0f)}; }
+
+// 四个角点各不相同的梯形，角点顺序错了就对不上
+hitcrt::ArmorObservation trapezoid(const int classID, const float dx, const hitcrt::TimePoint &time) {
+    hitcrt::ArmorObservation armor;
+    hitcrt::CornerTracker::setCorners(armor, {cv::Point2f(100.0f + dx, 200.0f), cv::Point2f(102.0f + dx, 230.0f),
+                                              cv::Point2f(160.0f + dx, 226.0f), cv::Point2f(158.0f + dx, 204.0f)});
+    armor.m_classID = classID;
+    armor.m_confidence = 0.9;
+    armor.m_timeStamp = time;
+    return armor;
+}
+}  // namespace
+
+// 每帧推理时与参照检测器的输出完全一致
+TEST(TrackingDetector, EveryFrameMatchesReference) {
+    hitcrt::TrackerConfig every;
+    every.m_maxSkip = 0;
+    std::vector<CornerTruth> sequence = hitcrt::bench::makeTrackSequence("translate");
+    sequence.resize(100);
+    const TrackResult result = hitcrt::bench::replayTrack(sequence, every);
+    EXPECT_EQ(result.m_stats.m_inferred, sequence.size());
+    EXPECT_EQ(result.percentile(100), 0.0f);
+    EXPECT_EQ(result.m_missed, 0);
+    EXPECT_EQ(result.m_false, 0);
+}
+
+/*
+ * 最多跳2帧。平滑平移时有效检测帧率接近3倍，匀加速模型的外推误差在检测噪声量级，小于匀速模型；
+ * 小陀螺的装甲板出现和消失时要等下一次推理，其余帧按各角点的模型外推，两种模型的误差都有界
+ */
+TEST(TrackingDetector, ExtrapolationErrorOnSmoothSequences) {
+    hitcrt::TrackerConfig acceleration;
+    hitcrt::TrackerConfig velocity = acceleration;
+    velocity.m_acceleration = false;
+
+    const std::vector<CornerTruth> translate = hitcrt::bench::makeTrackSequence("translate");
+    const TrackResult translateAcceleration = hitcrt::bench::replayTrack(translate, acceleration);
+    const TrackResult translateVelocity = hitcrt::bench::replayTrack(translate, velocity);
+    EXPECT_GE(translateAcceleration.m_stats.effectiveRate(), 2.5);
+    EXPECT_LT(translateAcceleration.mean(), 0.5f);
+    EXPECT_LT(translateAcceleration.percentile(95), 1.0f);
+    EXPECT_LT(translateAcceleration.mismatched(), 0.01);
+    EXPECT_LT(translateAcceleration.mean(), translateVelocity.mean());
+    EXPECT_LT(translateVelocity.mean(), 2.0f);
+
+    const std::vector<CornerTruth> spin = hitcrt::bench::makeTrackSequence("spin");
+    const TrackResult spinAcceleration = hitcrt::bench::replayTrack(spin, acceleration);
+    const TrackResult spinVelocity = hitcrt::bench::replayTrack(spin, velocity);
+    EXPECT_GE(spinAcceleration.m_stats.effectiveRate(), 1.9);
+    EXPECT_LT(spinAcceleration.mean(), 1.0f);
+    EXPECT_LT(spinAcceleration.mismatched(), 0.08);
+    EXPECT_LT(spinVelocity.mean(), 2.0f);
+}
+
+// 方向突变后推理帧上的外推偏差超过m_maxResidual，下一帧不按计划跳过而是继续推理
+TEST(TrackingDetector, DirectionChangeForcesRerun) {
+    TrackerHarness harness;
+    const float maxResidual = hitcrt::TrackerConfig().m_maxResidual;
+    bool expectRerun = false;
+    for (int i = 0; i < 40; ++i) {
+        const float x = i <= 20 ? 400.0f + 4.0f * i : 480.0f - 4.0f * (i - 20);
+        const bool inferred = harness.step(single(x, 500.0f), i * 10.0);
+        SCOPED_TRACE(::testing::Message() << "frame " << i);
+        if (expectRerun) {
+            EXPECT_TRUE(inferred);
+        }
+        expectRerun = inferred && harness.detector().lastResidual() > maxResidual;
+        if (i == 20) {
+            // 匀速运动时外推没有偏差
+            EXPECT_EQ(harness.detector().stats().m_residualForced, 0u);
+        }
+    }
+    EXPECT_GT(harness.detector().stats().m_residualForced, 0u);
+
+    const TrackResult jitter = hitcrt::bench::replayTrack(hitcrt::bench::makeTrackSequence("jitter"),
+                                                          hitcrt::TrackerConfig());
+    EXPECT_GT(jitter.m_stats.m_residualForced, 0u);
+    EXPECT_GE(jitter.m_stats.effectiveRate(), 2.0);
+    EXPECT_LT(jitter.mean(), 1.0f);
+    EXPECT_LT(jitter.mismatched(), 0.08);
+}
+
+// 只观测过一次的轨迹不能外推：开始的两帧都推理，新装甲板第一次被检测到的下一帧也推理
+TEST(TrackingDetector, OnceSeenTrackForcesInference) {
+    TrackerHarness harness;
+    const CornerTruth other = single(900.0f, 700.0f);
+    std::vector<bool> inferred;
+    std::vector<size_t> counts;
+    for (int i = 0; i < 30; ++i) {
+        CornerTruth truth = single(300.0f + 3.0f * i, 300.0f);
+        if (i >= 10) {
+            truth.push_back(other.front());
+        }
+        inferred.push_back(harness.step(truth, i * 10.0));
+        counts.push_back(harness.armors().size());
+    }
+    EXPECT_TRUE(inferred[0]);
+    EXPECT_TRUE(inferred[1]);
+    EXPECT_FALSE(inferred[2]);
+
+    int first = -1;
+    for (int i = 10; i < 30 && first < 0; ++i) {
+        if (inferred[i] && counts[i] == 2) {
+            first = i;
+        }
+    }
+    ASSERT_GE(first, 0);
+    ASSERT_LT(first + 2, 30);
+    EXPECT_TRUE(inferred[first + 1]);
+    EXPECT_FALSE(inferred[first + 2]);
+    EXPECT_EQ(harness.detector().stats().m_residualForced, 0u);
+}
+
+// 按计划跳2帧；距上次推理超过m_maxGapSeconds时，即使还没跳满也推理
+TEST(TrackingDetector, LongGapForcesInference) {
+    TrackerHarness harness;
+    const std::array<double, 6> times = {0.0, 10.0, 20.0, 30.0, 40.0, 100.0};
+    const std::array<bool, 6> expected = {true, true, false, false, true, true};
+    for (size_t i = 0; i < times.size(); ++i) {
+        EXPECT_EQ(harness.step(single(300.0f + 0.3f * static_cast<float>(times[i]), 300.0f), times[i]), expected[i])
+            << "frame " << i;
+    }
+    EXPECT_EQ(harness.detector().stats().m_residualForced, 0u);
+}
+
+// 外推结果的置信度每跳一帧乘一次m_confidenceDecay：0.9 -> 0.765 -> 0.65，低于m_minConfidence之前必须推理
+TEST(TrackingDetector, LowConfidenceForcesInference) {
+    hitcrt::TrackerConfig config;
+    config.m_maxSkip = 5;
+    config.m_minConfidence = 0.7f;
+    TrackerHarness harness(config);
+    for (int i = 0; i < 12; ++i) {
+        const bool inferred = harness.step(single(300.0f + 3.0f * i, 300.0f), i * 10.0);
+        SCOPED_TRACE(::testing::Message() << "frame " << i);
+        EXPECT_EQ(inferred, i < 2 || i % 2 == 1);
+        ASSERT_EQ(harness.armors().size(), 1u);
+        EXPECT_NEAR(harness.armors().front().m_confidence, inferred ? 0.9 : 0.9 * config.m_confidenceDecay, 1e-5);
+    }
+}
+
+// 外推按轨迹顺序输出，左上、左下、右下、右上各自外推，几何字段按新角点重算，置信度乘以系数，时间戳为外推时刻
+TEST(CornerTracker, PredictKeepsCornerOrderAndDecaysConfidence) {
+    hitcrt::CornerTracker tracker;
+    const hitcrt::TimePoint origin = std::chrono::steady_clock::now();
+    const hitcrt::TimePoint second = origin + std::chrono::milliseconds(10);
+    const hitcrt::TimePoint third = origin + std::chrono::milliseconds(20);
+    tracker.correct({trapezoid(3, 0.0f, origin), trapezoid(5, 400.0f, origin)}, origin);
+    EXPECT_FALSE(tracker.ready());
+    const std::vector<hitcrt::ArmorObservation> last = {trapezoid(3, 10.0f, second), trapezoid(5, 395.0f, second)};
+    tracker.correct(last, second);
+    ASSERT_TRUE(tracker.ready());
+
+    std::vector<hitcrt::ArmorObservation> armors;
+    tracker.predict(third, 0.85f, armors);
+    ASSERT_EQ(armors.size(), 2u);
+    const std::array<float, 2> shift = {10.0f, -5.0f};
+    for (size_t k = 0; k < armors.size(); ++k) {
+        SCOPED_TRACE(::testing::Message() << "armor " << k);
+        const hitcrt::ArmorObservation &armor = armors[k];
+        EXPECT_EQ(armor.m_classID, last[k].m_classID);
+        const Corners expected = hitcrt::CornerTracker::corners(last[k]);
+        const Corners actual = hitcrt::CornerTracker::corners(armor);
+        for (int j = 0; j < 4; ++j) {
+            EXPECT_NEAR(actual[j].x, expected[j].x + shift[k], 1e-3f) << "corner " << j;
+            EXPECT_NEAR(actual[j].y, expected[j].y, 1e-3f) << "corner " << j;
+        }
+        EXPECT_NEAR(armor.m_centerUV.x, (actual[0].x + actual[1].x + actual[2].x + actual[3].x) * 0.25f, 1e-3f);
+        EXPECT_NEAR(armor.m_height, last[k].m_height, 1e-3f);
+        EXPECT_NEAR(armor.m_width, last[k].m_width, 1e-3f);
+        EXPECT_NEAR(armor.m_confidence, 0.9 * 0.85, 1e-6);
+        EXPECT_EQ(armor.m_timeStamp, third);
+    }
+}
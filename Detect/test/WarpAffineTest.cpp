@@ -0,0 +1,135 @@
+/**
+ * @file WarpAffineTest.cpp
+ * @brief CPU预处理融合核：标量与SIMD（x86为AVX2，ARM为NEON）两条路径都与逐像素参考实现一致
+ * @author HITCRT_VISION
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (C) 2026, HITCRT_VISION, all rights reserved.
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>Date       <th>Author  <th>Description
+ * <tr><td>2026-10-17 <td>HITCRT_VISION  <td>
+ * </table>
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "infer/affine.hpp"
+#include "infer/cpu_warpaffine.hpp"
+
+namespace {
+// 输出经过1/255归一化，允许的最大误差：float为坐标计算顺序带来的舍入差，half再加上半个ulp
+constexpr float FLOAT_TOLERANCE = 1e-3f;
+constexpr float HALF_TOLERANCE = 2e-3f;
+
+/**
+ * @brief 同一输入分别跑融合实现和参考实现，返回最大绝对误差
+ */
+float maxError(const deploy::Image &image, const int dst_cols, const int dst_rows, const deploy::float3 matrix[2],
+               const deploy::ProcessConfig &config, const deploy::PlanarType type) {
+    const size_t count = static_cast<size_t>(3) * dst_cols * dst_rows;
+    std::vector<float> fused(count), reference(count);
+    if (type == deploy::PlanarType::Float32) {
+        deploy::cpuWarpAffine(image, fused.data(), dst_cols, dst_rows, matrix, config, type);
+        deploy::cpuWarpAffineReference(image, reference.data(), dst_cols, dst_rows, matrix, config, type);
+    } else {
+        std::vector<uint16_t> fused_half(count), reference_half(count);
+        deploy::cpuWarpAffine(image, fused_half.data(), dst_cols, dst_rows, matrix, config, type);
+        deploy::cpuWarpAffineReference(image, reference_half.data(), dst_cols, dst_rows, matrix, config, type);
+        std::transform(fused_half.begin(), fused_half.end(), fused.begin(), deploy::halfToFloat);
+        std::transform(reference_half.begin(), reference_half.end(), reference.begin(), deploy::halfToFloat);
+    }
+    float error = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        error = std::max(error, std::fabs(fused[i] - reference[i]));
+    }
+    return error;
+}
+
+/**
+ * @brief 参数为是否开启SIMD，关闭时在任何机器上都检查标量路径
+ */
+class WarpAffinePath : public ::testing::TestWithParam<bool> {
+   protected:
+    void SetUp() override {
+        deploy::setCpuSimdEnabled(GetParam());
+        RecordProperty("path", deploy::cpuSimdPath());
+    }
+    void TearDown() override { deploy::setCpuSimdEnabled(true); }
+};
+}  // namespace
+
+/*
+ * 随机图像、letterbox与带旋转的矩阵、不同输出宽度（奇数宽度覆盖向量宽度之外的尾部）下检查一致性
+ */
+TEST_P(WarpAffinePath, MatchesReference) {
+    std::mt19937 rng(2026);
+    const int sizes[][4] = {{1280, 1024, 640, 640}, {37, 53, 61, 45}, {1, 1, 13, 9}, {3, 2, 640, 7}};
+    for (const auto &size : sizes) {
+        const int cols = size[0], rows = size[1], dst_cols = size[2], dst_rows = size[3];
+        std::vector<uint8_t> pixels(static_cast<size_t>(cols) * rows * 3);
+        std::generate(pixels.begin(), pixels.end(), [&rng] { return static_cast<uint8_t>(rng()); });
+        const deploy::Image image(pixels.data(), cols, rows);
+
+        for (int rotate = 0; rotate < 2; ++rotate) {
+            deploy::AffineTransform transform;
+            transform.updateMatrix(cols, rows, dst_cols, dst_rows);
+            deploy::float3 matrix[2] = {transform.matrix[0], transform.matrix[1]};
+            deploy::ProcessConfig config;
+            if (rotate) {
+                // 大部分输出落在图像外，覆盖所有越界分支
+                const float c = std::cos(0.3f), s = std::sin(0.3f);
+                matrix[0] = deploy::make_float3(0.9f * c, -s, 5.3f);
+                matrix[1] = deploy::make_float3(s, 1.1f * c, -7.1f);
+                config.enableSwapRB();
+                config.setNormalizeParams({0.485f, 0.456f, 0.406f}, {0.229f, 0.224f, 0.225f});
+            }
+            for (const auto type : {deploy::PlanarType::Float32, deploy::PlanarType::Float16}) {
+                const bool is_float = type == deploy::PlanarType::Float32;
+                EXPECT_LE(maxError(image, dst_cols, dst_rows, matrix, config, type),
+                          is_float ? FLOAT_TOLERANCE : HALF_TOLERANCE)
+                    << deploy::cpuSimdPath() << " " << cols << "x" << rows << " -> " << dst_cols << "x" << dst_rows
+                    << (rotate ? " rotate" : " letterbox") << (is_float ? " fp32" : " fp16");
+            }
+        }
+    }
+}
+
+/*
+ * 输出与输入同尺寸、采样点铺满整幅图，最后一行的最后几个像素落在缓冲区末尾：
+ * SIMD每个像素整读4字节，越过末尾时改从lastWord()读再移位，三通道和四通道的末尾都要读对
+ */
+TEST_P(WarpAffinePath, BufferTailMatchesReference) {
+    std::mt19937 rng(11);
+    for (const auto format : {deploy::PixelFormat::BGR, deploy::PixelFormat::BGRA}) {
+        const int channels = format == deploy::PixelFormat::BGRA ? 4 : 3;
+        for (const int cols : {1, 2, 5, 9, 17}) {
+            const int rows = 3;
+            // 缓冲区正好是图像大小，末尾之后没有可读的字节
+            std::vector<uint8_t> pixels(static_cast<size_t>(cols) * rows * channels);
+            std::generate(pixels.begin(), pixels.end(), [&rng] { return static_cast<uint8_t>(rng()); });
+            const deploy::Image image(pixels.data(), cols, rows, format);
+
+            // 采样点在相邻像素之间，最后一个输出像素的右下邻域就是缓冲区里的最后一个像素
+            const float sx = cols > 1 ? (cols - 1.25f) / (cols - 1) : 1.0f;
+            const float sy = (rows - 1.25f) / (rows - 1);
+            const deploy::float3 matrix[2] = {deploy::make_float3(sx, 0.0f, 0.25f), deploy::make_float3(0.0f, sy, 0.25f)};
+            deploy::ProcessConfig config;
+            for (const auto type : {deploy::PlanarType::Float32, deploy::PlanarType::Float16}) {
+                const bool is_float = type == deploy::PlanarType::Float32;
+                EXPECT_LE(maxError(image, cols, rows, matrix, config, type), is_float ? FLOAT_TOLERANCE : HALF_TOLERANCE)
+                    << deploy::cpuSimdPath() << " " << channels << " channels, width " << cols
+                    << (is_float ? " fp32" : " fp16");
+            }
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(CpuWarpAffine, WarpAffinePath, ::testing::Values(false, true),
+                         [](const ::testing::TestParamInfo<bool> &info) { return info.param ? "Simd" : "Scalar"; });